@@ -72,6 +72,9 @@ endif()
 
 if (ENABLE_CPU)
     add_compile_definitions(ENABLE_CPU)
+    if (NOT CMAKE_SYSTEM_NAME MATCHES "Windows")
+        set(ENABLE_CPUQUE ON)
+    endif()
 endif()
 
 if (ENABLE_GE)
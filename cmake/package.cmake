@@ -196,6 +196,14 @@ if (ENABLE_GPU)
     )
 endif ()
 
+if (ENABLE_CPUQUE)
+    install(
+        TARGETS cpu_queue
+        DESTINATION ${INSTALL_LIB_DIR}
+        COMPONENT mindspore
+    )
+endif ()
+
 if (ENABLE_CPU AND (ENABLE_D OR ENABLE_GPU))
     install(
         TARGETS ps_cache
@@ -14,9 +14,20 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include <algorithm>
+#include <exception>
+#include <set>
+#include "common/thread_pool.h"
+#include "utils/trace_base.h"
 
 namespace mindspore {
 namespace kernel {
+namespace {
+// The Init of these kernels registers embedding tables or optimizer shapes with the parameter server worker, they are
+// initialized one at a time in node order. Init of every other cpu kernel only reads and writes its own node.
+const std::set<std::string> kSerialInitKernels = {"EmbeddingLookupProxy", "Push", "Pull"};
+}  // namespace
+
 void CPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
@@ -117,5 +128,56 @@ std::vector<size_t> CPUKernelUtils::FlatShapeByAxis(const std::vector<size_t> &s
   return flat_shape;
 }
 
+void CPUKernelUtils::InitKernels(const std::vector<CNodePtr> &kernel_nodes,
+                                 const std::vector<std::shared_ptr<CPUKernel>> &kernels) {
+  if (kernel_nodes.size() != kernels.size()) {
+    MS_LOG(EXCEPTION) << "The number of kernels " << kernels.size() << " is not the number of nodes "
+                      << kernel_nodes.size();
+  }
+  std::vector<std::string> errors(kernel_nodes.size());
+  auto init_kernel = [&kernel_nodes, &kernels, &errors](size_t i) {
+    MS_LOG(INFO) << "Cpu building operator[" << AnfAlgo::GetCNodeName(kernel_nodes[i]) << "].";
+    try {
+      MS_EXCEPTION_IF_NULL(kernels[i]);
+      kernels[i]->Init(kernel_nodes[i]);
+    } catch (std::exception &e) {
+      errors[i] = e.what();
+    } catch (...) {
+      errors[i] = "Unknown exception.";
+    }
+  };
+  std::vector<size_t> parallel_kernels;
+  for (size_t i = 0; i < kernel_nodes.size(); ++i) {
+    if (kSerialInitKernels.count(AnfAlgo::GetCNodeName(kernel_nodes[i])) != 0) {
+      init_kernel(i);
+    } else {
+      parallel_kernels.push_back(i);
+    }
+  }
+  size_t thread_num = std::min(parallel_kernels.size(), common::ThreadPool::GetInstance().GetSyncRunThreadNum());
+  if (thread_num > 1) {
+    std::vector<common::Task> tasks;
+    for (size_t task_id = 0; task_id < thread_num; ++task_id) {
+      // interleaved, so the expensive convolutions of a network spread over the tasks
+      tasks.emplace_back([&parallel_kernels, &init_kernel, task_id, thread_num]() {
+        for (size_t i = task_id; i < parallel_kernels.size(); i += thread_num) {
+          init_kernel(parallel_kernels[i]);
+        }
+        return common::SUCCESS;
+      });
+    }
+    (void)common::ThreadPool::GetInstance().SyncRun(tasks);
+  } else {
+    for (size_t i : parallel_kernels) {
+      init_kernel(i);
+    }
+  }
+
+  for (size_t i = 0; i < kernel_nodes.size(); ++i) {
+    if (!errors[i].empty()) {
+      MS_LOG(EXCEPTION) << errors[i] << "\nTrace: " << trace::DumpSourceLines(kernel_nodes[i]);
+    }
+  }
+}
 }  // namespace kernel
 }  // namespace mindspore
@@ -108,6 +108,9 @@ class CPUKernel : public kernel::KernelMod {
   const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
   const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
   const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+  // Buffers which hold the outputs of the last launch instead of the output addresses, empty if the outputs were
+  // written to the output addresses. The buffers stay valid until the next launch.
+  virtual std::vector<void *> OutputBuffers() const { return {}; }
 
  protected:
   virtual void InitInputOutputSize(const CNodePtr &kernel_node);
@@ -124,6 +127,10 @@ class CPUKernelUtils {
   static void GetElementNumEveryDim(const std::vector<size_t> &shape, std::vector<size_t> *element_num);
   static void ParallelFor(const CTask &task, size_t count);
   static std::vector<size_t> FlatShapeByAxis(const std::vector<size_t> &shape, int axis);
+  // Init kernels[i] with kernel_nodes[i], on the common thread pool unless the kernel changes process wide state.
+  // Raises the error of the first failed kernel in node order once all kernels are done.
+  static void InitKernels(const std::vector<CNodePtr> &kernel_nodes,
+                          const std::vector<std::shared_ptr<CPUKernel>> &kernels);
 };
 }  // namespace kernel
 }  // namespace mindspore
@@ -66,6 +66,9 @@ std::pair<bool, size_t> CPUKernelFactory::CPUKernelAttrCheck(const std::string &
 }
 
 bool CPUKernelFactory::CPUKernelSingleAttrCheck(const KernelAttr &kernel_attr, const KernelBuildInfo &kernel_info) {
+  if (kernel_attr.GetAnyType()) {
+    return true;
+  }
   for (size_t i = 0; i < kernel_info.GetInputNum(); ++i) {
     auto dtype = kernel_attr.GetAllSame() ? kernel_attr.GetInputAttr(0).first : kernel_attr.GetInputAttr(i).first;
     if (kernel_info.GetInputDeviceType(i) != dtype) {
@@ -0,0 +1,36 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/kernel_compiler/cpu/dataset_init_cpu_kernel.h"
+#include "runtime/device/cpu/cpu_data_queue.h"
+
+namespace mindspore {
+namespace kernel {
+void DatasetInitCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  queue_name_ = AnfAlgo::GetNodeAttr<std::string>(kernel_node, "queue_name");
+}
+
+bool DatasetInitCPUKernel::Launch(const std::vector<kernel::AddressPtr> & /*inputs*/,
+                                  const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                  const std::vector<kernel::AddressPtr> & /*outputs*/) {
+  auto queue = device::cpu::CPUDataQueueMgr::GetInstance().Create(queue_name_, device::cpu::kDataQueueCapacity);
+  MS_EXCEPTION_IF_NULL(queue);
+  MS_LOG(INFO) << "Create the data queue " << queue_name_ << ", capacity " << queue->Capacity();
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
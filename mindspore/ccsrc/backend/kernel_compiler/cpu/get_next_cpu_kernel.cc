@@ -0,0 +1,76 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/kernel_compiler/cpu/get_next_cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr unsigned int kPopTimeoutInSec = 30;
+constexpr int kMaxPopRetry = 10;
+}  // namespace
+
+// The graph is released, so is the queue of the channel with the batches still in it
+GetNextCPUKernel::~GetNextCPUKernel() {
+  if (!queue_name_.empty()) {
+    device::cpu::CPUDataQueueMgr::GetInstance().Destroy(queue_name_);
+  }
+}
+
+void GetNextCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  queue_name_ = AnfAlgo::GetNodeAttr<std::string>(kernel_node, "shared_name");
+}
+
+bool GetNextCPUKernel::Launch(const std::vector<kernel::AddressPtr> & /*inputs*/,
+                              const std::vector<kernel::AddressPtr> & /*workspace*/,
+                              const std::vector<kernel::AddressPtr> & /*outputs*/) {
+  auto queue = device::cpu::CPUDataQueueMgr::GetInstance().Get(queue_name_);
+  if (queue == nullptr) {
+    MS_LOG(EXCEPTION) << "The data queue " << queue_name_ << " is not created";
+  }
+  // Release the previous batch, its tensors are no longer read
+  output_buffers_.clear();
+  batch_ = device::cpu::DataBatch();
+
+  auto status = device::cpu::DataQueueStatus::kTimeout;
+  for (int repeat = 1; repeat <= kMaxPopRetry && status == device::cpu::DataQueueStatus::kTimeout; ++repeat) {
+    status = queue->Pop(&batch_, kPopTimeoutInSec);
+    if (status == device::cpu::DataQueueStatus::kTimeout) {
+      MS_LOG(INFO) << "Waiting for data...(" << repeat << " / " << kMaxPopRetry << ")";
+    }
+  }
+  if (status != device::cpu::DataQueueStatus::kSuccess) {
+    MS_LOG(ERROR) << "Get data from the queue " << queue_name_ << " failed, status " << static_cast<int>(status);
+    return false;
+  }
+
+  if (batch_.items_.size() != output_size_list_.size()) {
+    MS_LOG(ERROR) << "The batch has " << batch_.items_.size() << " tensors, expect " << output_size_list_.size();
+    return false;
+  }
+  for (size_t i = 0; i < batch_.items_.size(); ++i) {
+    if (batch_.items_[i].data_len_ != output_size_list_[i]) {
+      MS_LOG(ERROR) << "The tensor " << i << " of the batch has " << batch_.items_[i].data_len_ << " bytes, expect "
+                    << output_size_list_[i];
+      return false;
+    }
+    output_buffers_.push_back(batch_.items_[i].data_ptr_);
+  }
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,51 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_GET_NEXT_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_GET_NEXT_CPU_KERNEL_H_
+
+#include <string>
+#include <vector>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "runtime/device/cpu/cpu_data_queue.h"
+
+namespace mindspore {
+namespace kernel {
+// Takes the next batch of the dataset from the CPU data queue. The outputs are the tensors of the batch, which the
+// kernel keeps until the next launch, so nothing is copied.
+class GetNextCPUKernel : public CPUKernel {
+ public:
+  GetNextCPUKernel() = default;
+  ~GetNextCPUKernel() override;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+  std::vector<void *> OutputBuffers() const override { return output_buffers_; }
+
+ private:
+  std::string queue_name_;
+  device::cpu::DataBatch batch_;
+  std::vector<void *> output_buffers_;
+};
+
+MS_REG_CPU_KERNEL(GetNext, KernelAttr().SetAnyTypeAttr(true), GetNextCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_GET_NEXT_CPU_KERNEL_H_
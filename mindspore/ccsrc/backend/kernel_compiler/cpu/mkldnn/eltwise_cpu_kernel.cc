@@ -56,9 +56,11 @@ void EltWiseCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   }
   dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
 
-  auto desc = GetForwardEltwiseDesc(kernel_node, src_desc);
-  auto prim_desc = dnnl::eltwise_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::eltwise_forward>(prim_desc);
+  SetPrimitive(kernel_node, [&]() {
+    auto desc = GetForwardEltwiseDesc(kernel_node, src_desc);
+    auto prim_desc = dnnl::eltwise_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
+    return std::make_shared<dnnl::eltwise_forward>(prim_desc);
+  });
 
   AddArgument(DNNL_ARG_SRC, src_desc);
   AddArgument(DNNL_ARG_DST, src_desc);
@@ -17,6 +17,8 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <map>
+#include <sstream>
 #include "utils/ms_utils.h"
 #include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
 
@@ -152,6 +154,30 @@ void MKLCPUKernel::SetArgumentHandle(int arg_key, void *ptr) {
 
 void MKLCPUKernel::ExecutePrimitive() { MKLKernelEngine::Get().Execute(primitive_, arguments_); }
 
+void MKLCPUKernel::SetPrimitive(const CNodePtr &kernel_node,
+                                const std::function<std::shared_ptr<dnnl::primitive>()> &creator) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto prim = AnfAlgo::GetCNodePrimitive(kernel_node);
+  MS_EXCEPTION_IF_NULL(prim);
+  std::ostringstream key;
+  key << prim->name() << "{";
+  std::map<std::string, ValuePtr> attrs(prim->attrs().begin(), prim->attrs().end());
+  for (const auto &attr : attrs) {
+    key << attr.first << "=" << (attr.second == nullptr ? "" : attr.second->ToString()) << ",";
+  }
+  key << "}";
+  for (size_t i = 0; i < AnfAlgo::GetInputTensorNum(kernel_node); ++i) {
+    key << " " << TypeIdLabel(AnfAlgo::GetInputDeviceDataType(kernel_node, i))
+        << AnfAlgo::GetInputDeviceShape(kernel_node, i);
+  }
+  key << " ->";
+  for (size_t i = 0; i < AnfAlgo::GetOutputTensorNum(kernel_node); ++i) {
+    key << " " << TypeIdLabel(AnfAlgo::GetOutputDeviceDataType(kernel_node, i))
+        << AnfAlgo::GetOutputDeviceShape(kernel_node, i);
+  }
+  primitive_ = MKLKernelEngine::Get().GetPrimitive(key.str(), creator);
+}
+
 void MKLCPUKernel::Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem) {
   MKLKernelEngine::Get().Reorder(src_mem, dst_mem);
 }
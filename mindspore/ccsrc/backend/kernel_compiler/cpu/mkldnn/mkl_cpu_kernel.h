@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MKL_CPU_KERNEL_H_
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MKL_CPU_KERNEL_H_
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <memory>
@@ -42,6 +43,9 @@ class MKLCPUKernel : public CPUKernel {
   dnnl::memory::format_tag GetDefaultFormatTag(const dnnl::memory::dims &dims) const;
   dnnl::memory::desc GetDefaultMemDesc(const std::vector<size_t> &shape);
   void ExecutePrimitive();
+  // Set primitive_ from the primitive cache of the engine, keyed by the op type, attributes, types and shapes of the
+  // kernel node. Only for kernels which need nothing else from the primitive descriptor.
+  void SetPrimitive(const CNodePtr &kernel_node, const std::function<std::shared_ptr<dnnl::primitive>()> &creator);
   std::unordered_map<int, dnnl::memory> arguments_;
   std::shared_ptr<dnnl::primitive> primitive_{nullptr};
   inline dnnl::memory::desc formatted_md(const dnnl::memory::dims &dimensions, dnnl::memory::format_tag layout) {
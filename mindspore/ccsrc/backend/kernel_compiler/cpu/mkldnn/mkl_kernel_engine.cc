@@ -36,5 +36,22 @@ dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, b
 void MKLKernelEngine::Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem) {
   dnnl::reorder(*src_mem, *dst_mem).execute(stream_, *src_mem, *dst_mem);
 }
+
+std::shared_ptr<dnnl::primitive> MKLKernelEngine::GetPrimitive(
+  const std::string &key, const std::function<std::shared_ptr<dnnl::primitive>()> &creator) {
+  {
+    std::lock_guard<std::mutex> lock(primitives_mutex_);
+    auto iter = primitives_.find(key);
+    if (iter != primitives_.end()) {
+      return iter->second;
+    }
+  }
+  // kernels are built in parallel, create outside the lock. If another kernel created the same primitive meanwhile,
+  // the first one inserted is kept.
+  auto primitive = creator();
+  MS_EXCEPTION_IF_NULL(primitive);
+  std::lock_guard<std::mutex> lock(primitives_mutex_);
+  return primitives_.emplace(key, primitive).first->second;
+}
 }  // namespace kernel
 }  // namespace mindspore
@@ -22,6 +22,8 @@
 #include <unordered_map>
 #include <vector>
 #include <memory>
+#include <functional>
+#include <mutex>
 #include "dnnl.hpp"
 #include "utils/ms_utils.h"
 
@@ -43,11 +45,18 @@ class MKLKernelEngine {
                const std::unordered_map<int, dnnl::memory> &arguments);
   void Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem);
 
+  // Get a primitive from the process wide cache, creating it on the first use of the key. Creating a primitive
+  // descriptor can take a long time, kernels with the same op type, attributes and shapes share their primitive.
+  std::shared_ptr<dnnl::primitive> GetPrimitive(const std::string &key,
+                                                const std::function<std::shared_ptr<dnnl::primitive>()> &creator);
+
  private:
   MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0), stream_(engine_) {}
   ~MKLKernelEngine() = default;
   dnnl::engine engine_;
   dnnl::stream stream_;
+  std::mutex primitives_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<dnnl::primitive>> primitives_;
 };
 }  // namespace kernel
 }  // namespace mindspore
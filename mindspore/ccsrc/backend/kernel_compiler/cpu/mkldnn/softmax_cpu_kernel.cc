@@ -39,9 +39,11 @@ void SoftmaxCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     axis += SizeToInt(src_shape.size());
   }
   dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
-  dnnl::softmax_forward::desc desc = dnnl::softmax_forward::desc(dnnl::prop_kind::forward_training, src_desc, axis);
-  auto prim_desc = dnnl::softmax_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::softmax_forward>(prim_desc);
+  SetPrimitive(kernel_node, [&]() {
+    dnnl::softmax_forward::desc desc = dnnl::softmax_forward::desc(dnnl::prop_kind::forward_training, src_desc, axis);
+    auto prim_desc = dnnl::softmax_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
+    return std::make_shared<dnnl::softmax_forward>(prim_desc);
+  });
   AddArgument(DNNL_ARG_SRC, src_desc);
   AddArgument(DNNL_ARG_DST, src_desc);
 }
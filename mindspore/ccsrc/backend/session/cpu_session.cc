@@ -21,6 +21,7 @@
 #include "ir/anf.h"
 #include "utils/ms_utils.h"
 #include "utils/trace_base.h"
+#include "utils/config_manager.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "runtime/device/kernel_runtime.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
@@ -133,9 +134,17 @@ void CPUSession::RunGraphImpl(const GraphId &graph_id, const std::vector<tensor:
     runtime_.IncreaseSummaryRefCount(summary_outputs);
   }
 
-  bool ret = runtime_.Run(kernel_graph.get(), false);
-  if (!ret) {
-    MS_LOG(EXCEPTION) << "Run graph failed";
+  // A graph which gets its inputs from the dataset runs all the steps of the sink size at once
+  auto kernels = kernel_graph->execution_order();
+  bool has_get_next = std::any_of(kernels.begin(), kernels.end(), [](const CNodePtr &kernel) {
+    return AnfAlgo::GetCNodeName(kernel) == kGetNextOpName;
+  });
+  int64_t loop_size = has_get_next ? ConfigManager::GetInstance().gpu_loopsink_size() : 1;
+  for (int64_t i = 0; i < loop_size; i++) {
+    bool ret = runtime_.Run(kernel_graph.get(), false);
+    if (!ret) {
+      MS_LOG(EXCEPTION) << "Run graph failed";
+    }
   }
 
   if (enable_summary) {
@@ -266,22 +275,23 @@ void KernelNotSupportException(const AnfNodePtr &kernel_node) {
 void CPUSession::BuildKernel(const KernelGraph *kernel_graph) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
   auto &kernel_nodes = kernel_graph->execution_order();
+  std::vector<std::shared_ptr<kernel::CPUKernel>> cpu_kernels;
   for (const auto &kernel_node : kernel_nodes) {
     MS_EXCEPTION_IF_NULL(kernel_node);
     std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
-    MS_LOG(INFO) << "Cpu building operator[" << kernel_name << "].";
     std::shared_ptr<kernel::CPUKernel> cpu_kernel =
       kernel::CPUKernelFactory::GetInstance().Create(kernel_name, kernel_node);
     if (cpu_kernel == nullptr) {
       KernelNotSupportException(kernel_node);
     }
-    try {
-      cpu_kernel->Init(kernel_node);
-    } catch (std::exception &e) {
-      MS_LOG(EXCEPTION) << e.what() << "\nTrace: " << trace::DumpSourceLines(kernel_node);
-    }
-    AnfAlgo::SetKernelMod(cpu_kernel, kernel_node.get());
-    MS_LOG(INFO) << "Cpu build success operator[" << kernel_name << "].";
+    cpu_kernels.push_back(cpu_kernel);
+  }
+
+  // Init builds the oneDNN primitives, which is most of the build time, so the kernels are initialized in parallel
+  kernel::CPUKernelUtils::InitKernels(kernel_nodes, cpu_kernels);
+  for (size_t i = 0; i < kernel_nodes.size(); ++i) {
+    AnfAlgo::SetKernelMod(cpu_kernels[i], kernel_nodes[i].get());
+    MS_LOG(INFO) << "Cpu build success operator[" << AnfAlgo::GetCNodeName(kernel_nodes[i]) << "].";
   }
 }
 }  // namespace session
@@ -20,6 +20,7 @@
 #include <memory>
 #include <unordered_map>
 #include <algorithm>
+#include <iterator>
 
 #include "ir/anf.h"
 #include "ir/manager.h"
@@ -32,7 +33,11 @@ namespace opt {
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name, const PrimitivePtr &prim,
                                  const RenormAction &renorm_action) {
   auto fn = [prim](const AnfNodePtr &node) -> bool { return IsPrimitiveCNode(node, prim); };
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  auto substitution = std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  if (prim != nullptr) {
+    substitution->prim_names_.push_back(prim->name());
+  }
+  return substitution;
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -59,7 +64,11 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
     return false;
   };
 
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  auto substitution = std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  for (auto &prim : prims) {
+    substitution->prim_names_.push_back(prim->name());
+  }
+  return substitution;
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -180,21 +189,190 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNo
   return changes;
 }
 
-bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const {
-  MS_EXCEPTION_IF_NULL(optimizer);
-  MS_EXCEPTION_IF_NULL(func_graph);
+SubstitutionList::SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once)
+    : list_(patterns), is_once_(is_once) {
+  for (size_t i = 0; i < list_.size(); i++) {
+    if (list_[i]->prim_names_.empty()) {
+      generic_.push_back(i);
+      for (auto &iter : prim_index_) {
+        iter.second.push_back(i);
+      }
+      continue;
+    }
+    for (auto &name : list_[i]->prim_names_) {
+      auto iter = prim_index_.find(name);
+      if (iter == prim_index_.end()) {
+        // the generic substitutions before this one also apply to the primitive
+        iter = prim_index_.emplace(name, generic_).first;
+      }
+      if (iter->second.empty() || iter->second.back() != i) {
+        iter->second.push_back(i);
+      }
+    }
+  }
+}
+
+const std::vector<size_t> &SubstitutionList::Candidates(const AnfNodePtr &node) const {
+  auto cnode = node->cast<CNodePtr>();
+  if (cnode == nullptr || cnode->inputs().empty()) {
+    return generic_;
+  }
+  auto prim = GetValueNode<PrimitivePtr>(cnode->input(0));
+  if (prim == nullptr) {
+    return generic_;
+  }
+  auto iter = prim_index_.find(prim->name());
+  return iter == prim_index_.end() ? generic_ : iter->second;
+}
+
+namespace {
+// Collects the nodes which got new inputs while it is alive, through the edge signal of the manager
+class DirtyNodes {
+ public:
+  explicit DirtyNodes(const FuncGraphManagerPtr &manager) : manager_(manager) {
+    slot_ = manager_->signals()->EdgeAdded.add_slot([this](const AnfNodePtr &node) { nodes_.push_back(node); });
+  }
+
+  ~DirtyNodes() { manager_->signals()->EdgeAdded.remove_slot(slot_); }
+
+  bool empty() const { return nodes_.empty(); }
+
+  // Take the dirty nodes and their users, whose patterns may match now
+  std::deque<AnfNodePtr> Take() {
+    std::deque<AnfNodePtr> todo;
+    todo.swap(nodes_);
+    auto &node_users = manager_->node_users();
+    size_t num_dirty = todo.size();
+    for (size_t i = 0; i < num_dirty; i++) {
+      auto iter = node_users.find(todo[i]);
+      if (iter == node_users.end()) {
+        continue;
+      }
+      for (auto &use : iter->second) {
+        todo.push_back(use.first);
+      }
+    }
+    return todo;
+  }
+
+ private:
+  FuncGraphManagerPtr manager_;
+  std::shared_ptr<Slot<void(const AnfNodePtr &)>> slot_;
+  std::deque<AnfNodePtr> nodes_;
+};
+}  // namespace
+
+bool SubstitutionList::ApplySubstitutions(const OptimizerPtr &optimizer, std::deque<AnfNodePtr> *todo, bool walk,
+                                          std::vector<bool> *applied) const {
+#ifdef ENABLE_PROFILE
+  double start = GetTime();
+#endif
   FuncGraphManagerPtr manager = optimizer->manager();
-  manager->AddFuncGraph(func_graph);
+  auto seen = NewSeenGeneration();
+  bool changes = false;
 
-  // for transform status counting
-  size_t space = 0;
-  std::unordered_map<std::string, std::vector<bool>> status;
-  if (optimizer->is_on_debug_) {
-    for (size_t i = 0; i < list_.size(); i++) {
-      status[list_[i]->name_ + std::to_string(i)] = {};
+  auto &all_nodes = manager->all_nodes();
+  while (!todo->empty()) {
+    AnfNodePtr node = todo->front();
+    todo->pop_front();
+
+    if (node == nullptr || node->seen_ == seen || !isTraversable(node) || !all_nodes.contains(node)) {
+      continue;
+    }
+    node->seen_ = seen;
+
+    // apply the substitutions in list order, each at most once, a replaced node is tested against the rest
+    bool change = false;
+    size_t next = 0;
+    while (next < list_.size() && isTraversable(node)) {
+      const auto &candidates = Candidates(node);
+      auto iter = std::lower_bound(candidates.begin(), candidates.end(), next);
+      AnfNodePtr ret = nullptr;
+      for (; iter != candidates.end(); ++iter) {
+        auto &transform = list_[*iter];
+        if (!transform->predicate_(node)) {
+          continue;
+        }
+        TraceGuard trace_guard(std::make_shared<TraceOpt>(node->debug_info()));
+        ret = (*transform)(optimizer, node);
+        if (ret != nullptr && ret != node) {
+          break;
+        }
+      }
+      if (iter == candidates.end()) {
+        break;
+      }
+#ifdef ENABLE_PROFILE
+      double t = GetTime();
+#endif
+      (void)manager->Replace(node, ret);
+#ifdef ENABLE_PROFILE
+      MsProfile::StatTime("replace." + list_[*iter]->name_, GetTime() - t);
+#endif
+      (*applied)[*iter] = true;
+      change = true;
+      changes = true;
+      next = *iter + 1;
+      node = ret;
+    }
+
+    if (walk && IsValueNode<FuncGraph>(node)) {
+      todo->push_back(GetValueNode<FuncGraphPtr>(node)->output());
+    }
+
+    if (walk && node->isa<CNode>()) {
+      auto &inputs = node->cast<CNodePtr>()->inputs();
+      (void)std::copy(inputs.begin(), inputs.end(), std::back_inserter(*todo));
+    }
+
+    auto &node_users = manager->node_users();
+    if (change && node_users.find(node) != node_users.end()) {
+      for (auto &use : node_users[node]) {
+        auto use_node = use.first;
+        if (use_node == nullptr) {
+          continue;
+        }
+        todo->push_back(use_node);
+        if (use_node->seen_ == seen) {
+          use_node->seen_--;
+        }
+      }
     }
   }
 
+#ifdef ENABLE_PROFILE
+  MsProfile::StatTime("opt.transform." + optimizer->name(), GetTime() - start);
+#endif
+  return changes;
+}
+
+bool SubstitutionList::ApplyByWorklist(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer,
+                                       StatusMap *status) const {
+  DirtyNodes dirty(optimizer->manager());
+  bool changes = false;
+  bool loop = false;
+  do {
+    std::vector<bool> applied(list_.size(), false);
+    std::deque<AnfNodePtr> todo{func_graph->output()};
+    loop = ApplySubstitutions(optimizer, &todo, true, &applied);
+    // only the nodes touched by the rewrites can match again, until the next walk checks the whole graph
+    while (!dirty.empty()) {
+      todo = dirty.Take();
+      loop = ApplySubstitutions(optimizer, &todo, false, &applied) || loop;
+    }
+    changes = changes || loop;
+
+    if (optimizer->is_on_debug_) {
+      for (size_t i = 0; i < list_.size(); i++) {
+        (*status)[list_[i]->name_ + std::to_string(i)].push_back(applied[i]);
+      }
+    }
+  } while (loop);
+  return changes;
+}
+
+bool SubstitutionList::ApplyBySweeps(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer,
+                                     StatusMap *status) const {
   bool loop = false;
   bool changes = false;
 
@@ -217,8 +395,7 @@ bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const Optimize
         }
       }
       if (optimizer->is_on_debug_) {
-        status[list_[i]->name_ + std::to_string(i)].push_back(change);
-        space = std::max(list_[i]->name_.size(), space);
+        (*status)[list_[i]->name_ + std::to_string(i)].push_back(change);
       }
     }
 
@@ -226,6 +403,31 @@ bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const Optimize
       break;
     }
   } while (loop);
+  return changes;
+}
+
+bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const {
+  MS_EXCEPTION_IF_NULL(optimizer);
+  MS_EXCEPTION_IF_NULL(func_graph);
+  FuncGraphManagerPtr manager = optimizer->manager();
+  manager->AddFuncGraph(func_graph);
+
+  // for transform status counting
+  size_t space = 0;
+  StatusMap status;
+  if (optimizer->is_on_debug_) {
+    for (size_t i = 0; i < list_.size(); i++) {
+      status[list_[i]->name_ + std::to_string(i)] = {};
+      space = std::max(list_[i]->name_.size(), space);
+    }
+  }
+
+  // the dumps after each substitution need the sweeps
+  static const auto full_sweep = (common::GetEnv("ENV_OPT_FULL_SWEEP") == "1" ||
+                                  (common::GetEnv("ENV_DUMP_PASS_IR") == "1" &&
+                                   MsContext::GetInstance()->get_param<bool>(MS_CTX_SAVE_GRAPHS_FLAG)));
+  bool changes = (is_once_ || full_sweep) ? ApplyBySweeps(func_graph, optimizer, &status)
+                                          : ApplyByWorklist(func_graph, optimizer, &status);
 
   // display the status of each transform
   if (optimizer->is_on_debug_) {
@@ -17,8 +17,10 @@
 #ifndef MINDSPORE_CCSRC_FRONTEND_OPTIMIZER_OPT_H_
 #define MINDSPORE_CCSRC_FRONTEND_OPTIMIZER_OPT_H_
 
+#include <deque>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ir/anf.h"
@@ -42,6 +44,8 @@ class Substitution {
   PredicateFuncType predicate_{nullptr};
   // an enum to mark this Substitution relation to renormalize pass
   RenormAction renorm_action_;
+  // names of the primitives a CNode must apply to match, empty if the predicate may match any node
+  std::vector<std::string> prim_names_;
   Substitution(const OptimizerCallerPtr &transform, const std::string &name, const PredicateFuncType &predicate,
                const RenormAction &renorm_action)
       : transform_(transform), name_(name), predicate_(predicate), renorm_action_(renorm_action) {}
@@ -59,19 +63,39 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
                                  const PredicateFuncType &predicate, const RenormAction &action_renorm = CHECK_RENORM);
 
+// Applies a list of Substitution until none of them changes the graph.
+// By default all substitutions are tried in one walk of the graph, a node only being tested against the
+// substitutions of its primitive, and the nodes whose inputs change are then revisited from a worklist until it is
+// empty. The walks are repeated until one makes no change. Lists executed once, or all lists when ENV_OPT_FULL_SWEEP
+// or ENV_DUMP_PASS_IR is set, walk the whole graph for each substitution in turn instead.
 class SubstitutionList {
  public:
-  explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false)
-      : list_(patterns), is_once_(is_once) {}
+  explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false);
   ~SubstitutionList() = default;
 
   bool operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const;
 
  private:
+  using StatusMap = std::unordered_map<std::string, std::vector<bool>>;
+
   bool ApplyTransform(const OptimizerPtr &optimizer, const AnfNodePtr &node, const SubstitutionPtr &transform) const;
+  // walk the whole graph for each substitution in turn, until no change
+  bool ApplyBySweeps(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer, StatusMap *status) const;
+  // walk the graph once for all substitutions then follow the worklist, until a walk makes no change
+  bool ApplyByWorklist(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer, StatusMap *status) const;
+  // apply the substitutions to the nodes in todo, walking down their inputs if walk is set
+  bool ApplySubstitutions(const OptimizerPtr &optimizer, std::deque<AnfNodePtr> *todo, bool walk,
+                          std::vector<bool> *applied) const;
+  // indexes in list_ of the substitutions which may match the node, in order
+  const std::vector<size_t> &Candidates(const AnfNodePtr &node) const;
+
   std::vector<SubstitutionPtr> list_;
   // a flag to mark this list of Substitution can only be executed only once
   bool is_once_;
+  // primitive name to the substitutions of that primitive and those matching any node
+  std::unordered_map<std::string, std::vector<size_t>> prim_index_;
+  // substitutions matching any node
+  std::vector<size_t> generic_;
 };
 }  // namespace opt
 }  // namespace mindspore
@@ -26,6 +26,8 @@
 #include <map>
 #include <utility>
 #include <initializer_list>
+#include <iomanip>
+#include <sstream>
 
 #include "debug/draw.h"
 #include "debug/anf_ir_dump.h"
@@ -145,6 +147,7 @@ class Optimizer : public std::enable_shared_from_this<Optimizer> {
     // Optimizer step counter;
     int64_t counter = 1;
     bool changes = true;
+    pass_time_.assign(passes_.size(), 0);
 
     while (changes) {
       changes = false;
@@ -180,7 +183,9 @@ class Optimizer : public std::enable_shared_from_this<Optimizer> {
               changes = true;
             }
           };
+          double start = GetTime();
           use_profile ? (WITH(MsProfile::GetProfile()->Step(pass_names_[i])) opt_func) : opt_func();
+          pass_time_[i] += GetTime() - start;
           static const auto enable_dump_pass_ir = (common::GetEnv("ENV_DUMP_PASS_IR") == "1");
           if (enable_dump_pass_ir && MsContext::GetInstance()->get_param<bool>(MS_CTX_SAVE_GRAPHS_FLAG)) {
             auto fg_name =
@@ -202,6 +207,7 @@ class Optimizer : public std::enable_shared_from_this<Optimizer> {
         break;
       }
     }
+    PrintPassTime(counter - 1);
     return func_graph;
   }
 
@@ -215,6 +221,9 @@ class Optimizer : public std::enable_shared_from_this<Optimizer> {
 
   const std::string name() const { return name_; }
 
+  // time spent in each pass during the last step, in seconds
+  const std::vector<double> &pass_time() const { return pass_time_; }
+
   void set_is_untyped_generated() { is_untyped_generated_ = true; }
   void clear_is_untyped_generated() { is_untyped_generated_ = false; }
 
@@ -231,10 +240,28 @@ class Optimizer : public std::enable_shared_from_this<Optimizer> {
   bool is_on_debug_{false};
 
  private:
+  void PrintPassTime(int64_t rounds) const {
+    if (!IS_OUTPUT_ON(mindspore::INFO)) {
+      return;
+    }
+    std::vector<size_t> order(pass_time_.size());
+    for (size_t i = 0; i < order.size(); i++) {
+      order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) { return pass_time_[a] > pass_time_[b]; });
+    std::ostringstream oss;
+    oss << "Optimizer " << name_ << " ran " << rounds << " rounds, time per pass:";
+    for (size_t i : order) {
+      oss << " " << pass_names_[i] << " " << std::fixed << std::setprecision(6) << pass_time_[i] << "s";
+    }
+    MS_LOG(INFO) << oss.str();
+  }
+
   const std::string name_;
   pipeline::ResourceBasePtr resource_;
   std::vector<OptPass> passes_;
   std::vector<std::string> pass_names_;
+  std::vector<double> pass_time_;
   bool run_only_once_;
   bool is_watch_renormalize_;
   bool is_enable_;
@@ -41,6 +41,12 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_num_parallel_workers", &ConfigManager::num_parallel_workers)
                     .def("get_numa_enable", &ConfigManager::numa_enable)
                     .def("set_numa_enable", &ConfigManager::set_numa_enable)
+                    .def("get_numa_placement", &ConfigManager::numa_placement)
+                    .def("get_numa_tenants_per_node", &ConfigManager::numa_tenants_per_node)
+                    .def("set_numa_placement",
+                         [](ConfigManager &c, NumaPlacementMode mode, int32_t tenants_per_node) {
+                           THROW_IF_ERROR(c.set_numa_placement(mode, tenants_per_node));
+                         })
                     .def("get_op_connector_size", &ConfigManager::op_connector_size)
                     .def("get_rows_per_buffer", &ConfigManager::rows_per_buffer)
                     .def("get_seed", &ConfigManager::seed)
@@ -83,7 +89,15 @@ PYBIND_REGISTER(Tensor, 0, ([](const py::module *m) {
                       py::buffer_info info;
                       THROW_IF_ERROR(Tensor::GetBufferInfo(&tensor, &info));
                       return py::array(pybind11::dtype(info), info.shape, info.strides, info.ptr, t);
-                    });
+                    })
+                    .def("__dlpack__",
+                         [](const std::shared_ptr<Tensor> &t, py::object stream) {
+                           py::object capsule;
+                           THROW_IF_ERROR(Tensor::GetDLPack(t, &capsule));
+                           return capsule;
+                         },
+                         py::arg("stream") = py::none())
+                    .def("__dlpack_device__", [](const std::shared_ptr<Tensor> &t) { return py::make_tuple(1, 0); });
                 }));
 
 PYBIND_REGISTER(TensorShape, 0, ([](const py::module *m) {
@@ -127,5 +141,13 @@ PYBIND_REGISTER(ImageBatchFormat, 0, ([](const py::module *m) {
                     .export_values();
                 }));
 
+PYBIND_REGISTER(NumaPlacementMode, 0, ([](const py::module *m) {
+                  (void)py::enum_<NumaPlacementMode>(*m, "NumaPlacementMode", py::arithmetic())
+                    .value("DE_NUMA_PLACEMENT_NONE", NumaPlacementMode::kNone)
+                    .value("DE_NUMA_PLACEMENT_LOCAL", NumaPlacementMode::kLocal)
+                    .value("DE_NUMA_PLACEMENT_SPREAD", NumaPlacementMode::kSpread)
+                    .export_values();
+                }));
+
 }  // namespace dataset
 }  // namespace mindspore
@@ -483,8 +483,10 @@ PYBIND_REGISTER(RepeatNode, 2, ([](const py::module *m) {
 PYBIND_REGISTER(ShuffleNode, 2, ([](const py::module *m) {
                   (void)py::class_<ShuffleNode, DatasetNode, std::shared_ptr<ShuffleNode>>(*m, "ShuffleNode",
                                                                                            "to create a ShuffleNode")
-                    .def(py::init([](std::shared_ptr<DatasetNode> self, int32_t shuffle_size, bool reset_every_epoch) {
-                      auto shuffle = std::make_shared<ShuffleNode>(self, shuffle_size, reset_every_epoch);
+                    .def(py::init([](std::shared_ptr<DatasetNode> self, int32_t shuffle_size, bool reset_every_epoch,
+                                     int32_t block_size, int32_t row_pool_size) {
+                      auto shuffle =
+                        std::make_shared<ShuffleNode>(self, shuffle_size, reset_every_epoch, block_size, row_pool_size);
                       THROW_IF_ERROR(shuffle->ValidateParams());
                       return shuffle;
                     }));
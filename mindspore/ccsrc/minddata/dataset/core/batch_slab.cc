@@ -0,0 +1,167 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/core/batch_slab.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "minddata/dataset/util/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// slabs are turned off after that many outputs in a row missed their slot
+constexpr int32_t kBatchSlabMaxMisses = 64;
+
+// Memory pool over a range of slots of a slab. Allocates the range once and never frees it, the slab is freed when
+// the last region goes away.
+class SlabRegion : public MemoryPool {
+ public:
+  SlabRegion(std::shared_ptr<BatchSlab> slab, unsigned char *data, size_t size)
+      : slab_(std::move(slab)), data_(data), size_(size), allocated_(false) {}
+
+  ~SlabRegion() override = default;
+
+  Status Allocate(size_t n, void **p) override {
+    CHECK_FAIL_RETURN_UNEXPECTED(!allocated_ && n <= size_, "Batch slab region is already allocated or too small.");
+    allocated_ = true;
+    *p = data_;
+    return Status::OK();
+  }
+
+  Status Reallocate(void **p, size_t old_sz, size_t new_sz) override {
+    CHECK_FAIL_RETURN_UNEXPECTED(*p == data_ && new_sz <= size_, "Batch slab region is too small.");
+    return Status::OK();
+  }
+
+  void Deallocate(void *p) override {}
+
+  uint64_t get_max_size() const override { return size_; }
+
+  int PercentFree() const override { return allocated_ ? 0 : 100; }
+
+ private:
+  std::shared_ptr<BatchSlab> slab_;
+  unsigned char *data_;
+  size_t size_;
+  bool allocated_;
+};
+}  // namespace
+
+BatchSlab::BatchSlab(std::shared_ptr<BatchSlabPool> pool, unsigned char *data, size_t slot_size, int32_t num_slots)
+    : pool_(std::move(pool)), data_(data), slot_size_(slot_size), num_slots_(num_slots) {}
+
+BatchSlab::~BatchSlab() { pool_->Recycle(data_, slot_size_ * num_slots_); }
+
+std::shared_ptr<MemoryPool> BatchSlab::Region(int32_t first, int32_t count) {
+  return std::make_shared<SlabRegion>(shared_from_this(), data_ + first * slot_size_, count * slot_size_);
+}
+
+BatchSlabPool::BatchSlabPool(int32_t batch_size, int32_t max_free)
+    : batch_size_(batch_size), max_free_(max_free), enabled_(true), misses_(0) {}
+
+BatchSlabPool::~BatchSlabPool() {
+  for (auto &buffer : free_) {
+    free(buffer.first);
+  }
+}
+
+std::shared_ptr<BatchSlab> BatchSlabPool::GetSlab(int64_t epoch, int64_t batch, size_t slot_size) {
+  // declared before the lock, if this is the last reference the slab is freed after the lock is released
+  std::shared_ptr<BatchSlab> slab;
+  std::lock_guard<std::mutex> lock(mux_);
+  std::weak_ptr<BatchSlab> &entry = slabs_[{epoch, batch}];
+  slab = entry.lock();
+  if (slab != nullptr) {
+    return slab->slot_size() == slot_size ? slab : nullptr;
+  }
+
+  size_t size = slot_size * batch_size_;
+  unsigned char *data = nullptr;
+  auto it = std::find_if(free_.begin(), free_.end(), [size](const auto &buffer) { return buffer.second == size; });
+  if (it != free_.end()) {
+    data = it->first;
+    free_.erase(it);
+  } else {
+    data = static_cast<unsigned char *>(malloc(size));
+    if (data == nullptr) {
+      return nullptr;
+    }
+  }
+  slab = std::make_shared<BatchSlab>(shared_from_this(), data, slot_size, batch_size_);
+  entry = slab;
+
+  // drop the slabs of batches which were never taken, e.g. the remainder when drop_remainder is set
+  if (slabs_.size() > static_cast<size_t>(max_free_) * 2) {
+    for (auto iter = slabs_.begin(); iter != slabs_.end();) {
+      iter = iter->second.expired() ? slabs_.erase(iter) : std::next(iter);
+    }
+  }
+  return slab;
+}
+
+std::shared_ptr<BatchSlab> BatchSlabPool::TakeSlab(int64_t epoch, int64_t batch) {
+  std::lock_guard<std::mutex> lock(mux_);
+  auto it = slabs_.find({epoch, batch});
+  if (it == slabs_.end()) {
+    return nullptr;
+  }
+  std::shared_ptr<BatchSlab> slab = it->second.lock();
+  slabs_.erase(it);
+  return slab;
+}
+
+void BatchSlabPool::RecordHit(bool hit) {
+  if (hit) {
+    misses_ = 0;
+  } else if (++misses_ == kBatchSlabMaxMisses) {
+    MS_LOG(INFO) << "Outputs of map keep missing their batch slots, writing into batches in place is turned off.";
+    enabled_ = false;
+  }
+}
+
+void BatchSlabPool::Recycle(unsigned char *data, size_t size) {
+  std::lock_guard<std::mutex> lock(mux_);
+  if (free_.size() < static_cast<size_t>(max_free_)) {
+    free_.emplace_back(data, size);
+  } else {
+    free(data);
+  }
+}
+
+TensorSlot::TensorSlot(std::shared_ptr<BatchSlabPool> pool, int64_t epoch, int64_t row)
+    : pool_(pool != nullptr && pool->enabled() ? std::move(pool) : nullptr), epoch_(epoch), row_(row) {}
+
+bool TensorSlot::Holds(const unsigned char *buffer) const {
+  return slab_ != nullptr && buffer == slab_->slot(static_cast<int32_t>(row_ % pool_->batch_size()));
+}
+
+std::shared_ptr<MemoryPool> TensorSlot::Claim(size_t size) {
+  if (pool_ == nullptr || region_ != nullptr || size == 0) {
+    return nullptr;
+  }
+  int64_t batch_size = pool_->batch_size();
+  std::shared_ptr<BatchSlab> slab = pool_->GetSlab(epoch_, row_ / batch_size, size);
+  if (slab == nullptr) {
+    // the output of this row has another size than the first row of the batch
+    return nullptr;
+  }
+  slab_ = slab;
+  region_ = slab->Region(static_cast<int32_t>(row_ % batch_size), 1);
+  return region_;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,150 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_CORE_BATCH_SLAB_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_CORE_BATCH_SLAB_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/util/memory_pool.h"
+
+namespace mindspore {
+namespace dataset {
+class BatchSlabPool;
+
+/// \class BatchSlab batch_slab.h
+/// \brief One contiguous buffer holding a column of one batch, slot i being row i.
+///     The last TensorOp of a map writes its output straight into a slot (see TensorSlot), and the batch op then uses
+///     the whole buffer as the batch tensor instead of copying every row into a new one.
+class BatchSlab : public std::enable_shared_from_this<BatchSlab> {
+ public:
+  /// \brief Constructor, the slab takes ownership of data and gives it back to the pool when destroyed
+  BatchSlab(std::shared_ptr<BatchSlabPool> pool, unsigned char *data, size_t slot_size, int32_t num_slots);
+
+  ~BatchSlab();
+
+  size_t slot_size() const { return slot_size_; }
+
+  int32_t num_slots() const { return num_slots_; }
+
+  /// \brief Address of a slot
+  const unsigned char *slot(int32_t index) const { return data_ + index * slot_size_; }
+
+  /// \brief A memory pool handing out slots [first, first + count) as a single allocation. The pool keeps the slab
+  ///     alive for as long as a tensor uses it, freeing the tensor does not free the slots.
+  /// \param[in] first first slot
+  /// \param[in] count number of slots
+  /// \return the memory pool
+  std::shared_ptr<MemoryPool> Region(int32_t first, int32_t count);
+
+ private:
+  std::shared_ptr<BatchSlabPool> pool_;
+  unsigned char *data_;
+  size_t slot_size_;
+  int32_t num_slots_;
+};
+
+/// \class BatchSlabPool batch_slab.h
+/// \brief Shared by a map op and the batch op right above it. Keeps the slab of every batch being built, keyed by
+///     epoch and batch number, and recycles the buffers of the slabs which are freed.
+class BatchSlabPool : public std::enable_shared_from_this<BatchSlabPool> {
+ public:
+  /// \brief Constructor
+  /// \param[in] batch_size number of rows in a batch, every slab has that many slots
+  /// \param[in] max_free number of freed buffers kept for reuse
+  BatchSlabPool(int32_t batch_size, int32_t max_free);
+
+  ~BatchSlabPool();
+
+  int32_t batch_size() const { return batch_size_; }
+
+  /// \brief Whether map workers should still write into slabs. Turned off when the outputs of the last TensorOp
+  ///     keep missing their slots, which happens when the shapes are not fixed.
+  bool enabled() const { return enabled_; }
+
+  /// \brief Get the slab of a batch, creating it with the given slot size on first use
+  /// \param[in] epoch epoch number, counted by end of epoch buffers
+  /// \param[in] batch batch number in the epoch
+  /// \param[in] slot_size bytes of a row
+  /// \return the slab, nullptr if the slab of this batch has another slot size or out of memory
+  std::shared_ptr<BatchSlab> GetSlab(int64_t epoch, int64_t batch, size_t slot_size);
+
+  /// \brief Remove the slab of a batch from the pool, called by the batch op when it builds the batch
+  /// \param[in] epoch epoch number, counted by end of epoch buffers
+  /// \param[in] batch batch number in the epoch
+  /// \return the slab, nullptr if no row of the batch is in a slab
+  std::shared_ptr<BatchSlab> TakeSlab(int64_t epoch, int64_t batch);
+
+  /// \brief Record whether the output of the last TensorOp landed in its slot
+  void RecordHit(bool hit);
+
+ private:
+  friend class BatchSlab;
+
+  // Keep the buffer of a freed slab for reuse
+  void Recycle(unsigned char *data, size_t size);
+
+  const int32_t batch_size_;
+  const int32_t max_free_;
+  std::atomic<bool> enabled_;
+  std::atomic<int32_t> misses_;  // consecutive misses
+  std::mutex mux_;
+  std::map<std::pair<int64_t, int64_t>, std::weak_ptr<BatchSlab>> slabs_;
+  std::vector<std::pair<unsigned char *, size_t>> free_;
+};
+
+/// \class TensorSlot batch_slab.h
+/// \brief The slot of one row in the slab of its batch. The map job claims it with the size of the output of its last
+///     TensorOp and hands the returned memory pool to TensorOp::ComputeInto, so only the output tensor lands in it.
+class TensorSlot {
+ public:
+  /// \brief Constructor
+  /// \param[in] pool slab pool, nullptr makes the TensorSlot inactive
+  /// \param[in] epoch epoch number, counted by end of epoch buffers
+  /// \param[in] row row number in the epoch
+  TensorSlot(std::shared_ptr<BatchSlabPool> pool, int64_t epoch, int64_t row);
+
+  ~TensorSlot() = default;
+
+  TensorSlot(const TensorSlot &) = delete;
+  TensorSlot &operator=(const TensorSlot &) = delete;
+
+  bool active() const { return pool_ != nullptr; }
+
+  /// \brief Whether a buffer is the slot of this row
+  bool Holds(const unsigned char *buffer) const;
+
+  /// \brief Claim the slot for an output of the given size
+  /// \param[in] size bytes of the output
+  /// \return the memory pool holding the slot, nullptr if the slot is inactive, already claimed or the slab of the
+  ///     batch has another slot size
+  std::shared_ptr<MemoryPool> Claim(size_t size);
+
+ private:
+  std::shared_ptr<BatchSlabPool> pool_;
+  int64_t epoch_;
+  int64_t row_;
+  std::shared_ptr<BatchSlab> slab_;
+  std::shared_ptr<MemoryPool> region_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_CORE_BATCH_SLAB_H_
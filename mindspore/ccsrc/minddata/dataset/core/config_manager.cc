@@ -38,6 +38,8 @@ ConfigManager::ConfigManager()
       rank_id_(kCfgDefaultRankId),
       seed_(kCfgDefaultSeed),
       numa_enable_(false),
+      numa_placement_(NumaPlacementMode::kNone),
+      numa_tenants_per_node_(kCfgNumaTenantsPerNode),
       monitor_sampling_interval_(kCfgMonitorSamplingInterval),
       callback_timout_(kCfgCallbackTimeout),
       cache_host_(kCfgDefaultCacheHost),
@@ -134,6 +136,14 @@ void ConfigManager::set_rank_id(int32_t rank_id) { rank_id_ = rank_id; }
 
 void ConfigManager::set_numa_enable(bool numa_enable) { numa_enable_ = numa_enable; }
 
+Status ConfigManager::set_numa_placement(NumaPlacementMode mode, int32_t tenants_per_node) {
+  CHECK_FAIL_RETURN_UNEXPECTED(tenants_per_node > 0,
+                               "tenants_per_node should be positive, got: " + std::to_string(tenants_per_node));
+  numa_placement_ = mode;
+  numa_tenants_per_node_ = tenants_per_node;
+  return Status::OK();
+}
+
 void ConfigManager::set_seed(uint32_t seed) { seed_ = seed; }
 
 void ConfigManager::set_monitor_sampling_interval(uint32_t interval) { monitor_sampling_interval_ = interval; }
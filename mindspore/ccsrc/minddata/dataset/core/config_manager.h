@@ -153,6 +153,19 @@ class ConfigManager {
   /// @return Get the current numa switch state.
   bool numa_enable() const { return numa_enable_; }
 
+  // setter function
+  // @param mode - Where the threads of the pipeline run, see NumaPlacement
+  // @param tenants_per_node - How many processes share a numa node, each one gets its own cpus
+  Status set_numa_placement(NumaPlacementMode mode, int32_t tenants_per_node);
+
+  // getter function
+  // @return The numa placement of the threads of the pipeline
+  NumaPlacementMode numa_placement() const { return numa_placement_; }
+
+  // getter function
+  // @return How many processes share a numa node
+  int32_t numa_tenants_per_node() const { return numa_tenants_per_node_; }
+
   // getter function
   // This rank_id is for numa and device_queue, one process work with only one rank_id
   // for standalone scenario, this rank_id may come from env 'CUDA_VISIBLE_DEVICES',
@@ -228,6 +241,8 @@ class ConfigManager {
   int32_t cache_port_;
   int32_t num_connections_;
   bool numa_enable_;
+  NumaPlacementMode numa_placement_;
+  int32_t numa_tenants_per_node_;
   int32_t prefetch_size_;
   bool auto_num_workers_;
   const int32_t num_cpu_threads_;
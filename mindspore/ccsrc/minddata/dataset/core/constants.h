@@ -38,6 +38,9 @@ enum class TensorImpl { kNone, kFlexible, kCv, kNP };
 // Possible values for shuffle
 enum class ShuffleMode { kFalse = 0, kFiles = 1, kGlobal = 2 };
 
+// Possible values for the numa placement of the pipeline threads
+enum class NumaPlacementMode { kNone = 0, kLocal = 1, kSpread = 2 };
+
 // Possible values for Border types
 enum class BorderType { kConstant = 0, kEdge = 1, kReflect = 2, kSymmetric = 3 };
 
@@ -88,6 +91,7 @@ constexpr uint32_t kCfgParallelWorkers = 4;
 constexpr uint32_t kCfgWorkerConnectorSize = 16;
 constexpr uint32_t kCfgOpConnectorSize = 16;
 constexpr int32_t kCfgDefaultRankId = -1;
+constexpr int32_t kCfgNumaTenantsPerNode = 1;
 constexpr uint32_t kCfgDefaultSeed = std::mt19937::default_seed;
 constexpr uint32_t kCfgMonitorSamplingInterval = 10;
 constexpr uint32_t kCfgCallbackTimeout = 60;  // timeout value for callback in seconds
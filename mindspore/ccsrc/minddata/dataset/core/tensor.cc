@@ -35,6 +35,8 @@
 
 #ifdef ENABLE_PYTHON
 #include "minddata/dataset/core/pybind_support.h"
+#include "minddata/dataset/include/type_id.h"
+#include "utils/dlpack.h"
 namespace py = pybind11;
 #endif
 #include "minddata/dataset/core/tensor_shape.h"
@@ -104,6 +106,21 @@ Status Tensor::CreateEmpty(const TensorShape &shape, const DataType &type, Tenso
   }
   return Status::OK();
 }
+
+Status Tensor::CreateEmpty(const TensorShape &shape, const DataType &type, const std::shared_ptr<MemoryPool> &pool,
+                           TensorPtr *out) {
+  CHECK_FAIL_RETURN_UNEXPECTED(shape.known(), "Invalid shape.");
+  CHECK_FAIL_RETURN_UNEXPECTED(type.IsNumeric(), "The type should be numeric.");
+  RETURN_UNEXPECTED_IF_NULL(pool);
+  const TensorAlloc *alloc = GlobalContext::Instance()->tensor_allocator();
+  *out = std::allocate_shared<Tensor>(*alloc, shape, type);
+  (*out)->data_allocator_ = std::make_unique<Allocator<unsigned char>>(pool);
+  int64_t byte_size = (*out)->SizeInBytes();
+  if (byte_size != 0) {
+    RETURN_IF_NOT_OK((*out)->AllocateBuffer(byte_size));
+  }
+  return Status::OK();
+}
 Status Tensor::CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src, TensorPtr *out) {
   RETURN_IF_NOT_OK(CreateEmpty(shape, type, out));
   if (src != nullptr) {
@@ -617,6 +634,49 @@ Status Tensor::GetBufferInfo(Tensor *t, py::buffer_info *out) {
                          t->Strides());
   return Status::OK();
 }
+
+namespace {
+// The DLPack tensor handed to a consumer, it keeps the dataset tensor alive
+struct DLPackContext {
+  std::shared_ptr<Tensor> tensor;
+  std::vector<int64_t> shape;
+  DLManagedTensor managed;
+};
+
+void DeleteDLPackContext(DLManagedTensor *managed) { delete static_cast<DLPackContext *>(managed->manager_ctx); }
+
+void DestructDLPackCapsule(PyObject *capsule) {
+  if (PyCapsule_IsValid(capsule, kDLPackCapsuleName)) {
+    auto managed = static_cast<DLManagedTensor *>(PyCapsule_GetPointer(capsule, kDLPackCapsuleName));
+    managed->deleter(managed);
+  }
+}
+}  // namespace
+
+Status Tensor::GetDLPack(const std::shared_ptr<Tensor> &t, py::object *out) {
+  RETURN_UNEXPECTED_IF_NULL(t);
+  RETURN_UNEXPECTED_IF_NULL(out);
+  auto context = std::make_unique<DLPackContext>();
+  auto &dl_tensor = context->managed.dl_tensor;
+  CHECK_FAIL_RETURN_UNEXPECTED(t->type().IsNumeric() && TypeIdToDLDataType(DETypeToMSType(t->type()), &dl_tensor.dtype),
+                               "Cannot export tensor of type " + t->type().ToString() + " as DLPack.");
+  context->tensor = t;
+  auto shape = t->shape().AsVector();
+  context->shape.assign(shape.begin(), shape.end());
+  dl_tensor.data = t->GetMutableBuffer();
+  dl_tensor.device = {kDLCPU, 0};
+  dl_tensor.ndim = static_cast<int>(context->shape.size());
+  dl_tensor.shape = context->shape.data();
+  dl_tensor.strides = nullptr;
+  dl_tensor.byte_offset = 0;
+  context->managed.manager_ctx = context.get();
+  context->managed.deleter = DeleteDLPackContext;
+  auto capsule = PyCapsule_New(&context->managed, kDLPackCapsuleName, DestructDLPackCapsule);
+  CHECK_FAIL_RETURN_UNEXPECTED(capsule != nullptr, "Failed to create the DLPack capsule.");
+  (void)context.release();
+  *out = py::reinterpret_steal<py::object>(capsule);
+  return Status::OK();
+}
 #endif
 
 template <typename T>
@@ -62,6 +62,7 @@ namespace dataset {
 class Tensor;
 template <typename T>
 class Allocator;
+class MemoryPool;
 
 using CharAllocPtr = std::unique_ptr<Allocator<unsigned char>>;
 using TensorAllocPtr = std::shared_ptr<Allocator<Tensor>>;  // An allocator shared_ptr for Tensors
@@ -96,6 +97,16 @@ class Tensor {
   /// \return Status code
   static Status CreateEmpty(const TensorShape &shape, const DataType &type, TensorPtr *out);
 
+  /// Create a numeric tensor with type and shape, its data allocated from the given memory pool instead of the global
+  /// one. Items of the tensor would be uninitialized.
+  /// \param[in] shape shape of the output tensor
+  /// \param[in] type type of the output tensor
+  /// \param[in] pool memory pool to allocate the data from
+  /// \param[out] out Generated tensor
+  /// \return Status code
+  static Status CreateEmpty(const TensorShape &shape, const DataType &type, const std::shared_ptr<MemoryPool> &pool,
+                            TensorPtr *out);
+
   /// Create a numeric tensor from a pointer in memory. Length of the source data is determined from the shape and type.
   /// Data will be copied into the new created tensor.
   /// \param[in] shape shape of the output tensor
@@ -420,6 +431,12 @@ class Tensor {
   Status GetDataAsNumpyStrings(py::array *data);
 
   static Status GetBufferInfo(Tensor *t, py::buffer_info *out);
+
+  /// Export a numeric tensor as a DLPack capsule without copy, the capsule keeps the tensor alive
+  /// \param[in] t the tensor to export
+  /// \param[out] out the capsule, which other frameworks consume once
+  /// \return Status code
+  static Status GetDLPack(const std::shared_ptr<Tensor> &t, py::object *out);
 #endif
 
   /// TensorIterator is a linear iterator that can be used to iterate over the elements of the Tensor
@@ -166,8 +166,26 @@ void BatchOp::Print(std::ostream &out, bool show_all) const {
   }
 }
 
+namespace {
+// Whether column col of every row is in its slot of the slab, with the same shape, so the slab is the batched column
+bool InSlab(const TensorQTable &rows, size_t col, dsize_t batch_size, const std::shared_ptr<BatchSlab> &slab) {
+  if (slab == nullptr || slab->num_slots() != batch_size) {
+    return false;
+  }
+  const TensorShape &first_shape = rows.front().at(col)->shape();
+  for (dsize_t j = 0; j < batch_size; j++) {
+    const std::shared_ptr<Tensor> &tensor = rows[j].at(col);
+    if (tensor->GetBuffer() != slab->slot(static_cast<int32_t>(j)) || tensor->shape() != first_shape ||
+        static_cast<size_t>(tensor->SizeInBytes()) != slab->slot_size()) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
 Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, const std::unique_ptr<TensorQTable> *dest,
-                          dsize_t batch_size) {
+                          dsize_t batch_size, const std::shared_ptr<BatchSlab> &slab) {
   if ((*src)->size() != batch_size) {
     RETURN_STATUS_UNEXPECTED("[Internal Batch ERROR] Source table size does not match the batch_size");
   }
@@ -191,7 +209,10 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, const std::u
     TensorShape new_shape = first_shape.PrependDim(static_cast<int64_t>(batch_size));
 
     std::shared_ptr<Tensor> new_tensor;
-    if (first_type.IsNumeric()) {  // numeric tensor
+    if (first_type.IsNumeric() && InSlab(**src, i, batch_size, slab)) {
+      // the map below already wrote every row of this column into its slot, the slab is the batch
+      RETURN_IF_NOT_OK(Tensor::CreateEmpty(new_shape, first_type, slab->Region(0, batch_size), &new_tensor));
+    } else if (first_type.IsNumeric()) {  // numeric tensor
       RETURN_IF_NOT_OK(Tensor::CreateEmpty(new_shape, first_type, &new_tensor));
       dsize_t j = 0;
       for (auto row : **src) {
@@ -253,7 +274,11 @@ Status BatchOp::MakeBatchedBuffer(std::pair<std::unique_ptr<TensorQTable>, CBatc
   if (pad_) RETURN_IF_NOT_OK(PadColumns(&table_pair.first, pad_info_, column_name_id_map_));  // do padding if needed
   (*db) = std::make_unique<DataBuffer>(table_pair.second.batch_num_, DataBuffer::kDeBFlagNone);
   std::unique_ptr<TensorQTable> dest_table = std::make_unique<TensorQTable>();
-  RETURN_IF_NOT_OK(BatchRows(&table_pair.first, &dest_table, table_pair.first->size()));
+  std::shared_ptr<BatchSlab> slab;
+  if (batch_slab_pool_ != nullptr) {
+    slab = batch_slab_pool_->TakeSlab(table_pair.second.epoch_num_, table_pair.second.batch_num_);
+  }
+  RETURN_IF_NOT_OK(BatchRows(&table_pair.first, &dest_table, table_pair.first->size(), slab));
   (*db)->set_tensor_table(std::move(dest_table));
   return Status::OK();
 }
@@ -263,8 +288,9 @@ Status BatchOp::LaunchThreadsAndInitOp() {
     return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "Pipeline init failed, Execution tree not set.");
   }
   RETURN_IF_NOT_OK(worker_queues_.Register(tree_->AllTasks()));
-  RETURN_IF_NOT_OK(
-    tree_->LaunchWorkers(num_workers_, std::bind(&BatchOp::WorkerEntry, this, std::placeholders::_1), Name()));
+  // The batches are handed to the device, so they are built on the numa node of the consumer
+  RETURN_IF_NOT_OK(tree_->LaunchWorkers(num_workers_, std::bind(&BatchOp::WorkerEntry, this, std::placeholders::_1),
+                                        Name(), true));
   return Status::OK();
 }
 
@@ -564,6 +590,15 @@ Status BatchOp::ComputeColMap() {
   return Status::OK();
 }
 
+bool BatchOp::StacksRows() const {
+#ifdef ENABLE_PYTHON
+  if (batch_size_func_) {
+    return false;
+  }
+#endif
+  return !pad_ && in_col_names_.empty();
+}
+
 int64_t BatchOp::GetTreeBatchSize() {
 #ifdef ENABLE_PYTHON
   if (batch_size_func_) {
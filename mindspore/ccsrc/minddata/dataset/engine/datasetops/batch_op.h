@@ -26,6 +26,7 @@
 #include <utility>
 #include <vector>
 
+#include "minddata/dataset/core/batch_slab.h"
 #include "minddata/dataset/core/config_manager.h"
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
@@ -213,10 +214,11 @@ class BatchOp : public ParallelOp {
   // @param const std::unique_ptr<TensorQTable> *src - table that has the rows for batching
   // @param const std::unique_ptr<TensorQTable> *dest - dest_table to hold batched rows
   // @param int32_t size - batch_size
-  // @param const std::unordered_map<std::string, int32_t>& column_name_id_map - column names to index mapping
+  // @param const std::shared_ptr<BatchSlab> &slab - slab the rows of a column may already be in, that column is
+  //     then batched without copying
   // @return Status The status code returned
   static Status BatchRows(const std::unique_ptr<TensorQTable> *src, const std::unique_ptr<TensorQTable> *dest,
-                          dsize_t batch_size);
+                          dsize_t batch_size, const std::shared_ptr<BatchSlab> &slab = nullptr);
 
   // @param table
   // @param const PadInfo &pad_info pad info
@@ -227,6 +229,18 @@ class BatchOp : public ParallelOp {
 
   int64_t GetTreeBatchSize() override;
 
+  // Whether every batch is made by stacking its rows as they are, so the rows can be written into batch slabs
+  // @return - true if there is no padding, per batch map or batch size function
+  bool StacksRows() const;
+
+  // Batch size getter
+  // @return - the batch size the op starts with
+  int32_t start_batch_size() const { return start_batch_size_; }
+
+  // Setter for the slab pool shared with the map op below, see BatchSlabPass
+  // @param pool - the slab pool
+  void SetBatchSlabPool(std::shared_ptr<BatchSlabPool> pool) { batch_slab_pool_ = std::move(pool); }
+
  protected:
   Status ComputeColMap() override;
 
@@ -290,6 +304,7 @@ class BatchOp : public ParallelOp {
   std::unique_ptr<ChildIterator> child_iterator_;       // child iterator for fetching TensorRows 1 by 1
   std::unordered_map<std::string, int32_t> child_map_;  // col_name_id_map of the child node
   QueueList<std::pair<std::unique_ptr<TensorQTable>, CBatchInfo>> worker_queues_;  // internal queue for syncing worker
+  std::shared_ptr<BatchSlabPool> batch_slab_pool_;  // slabs the map op below writes the rows into, may be null
 #ifdef ENABLE_PYTHON
   py::function batch_size_func_;  // Function pointer of batch size function
   py::function batch_map_func_;   // Function pointer of per batch map function
@@ -30,6 +30,7 @@
 #include "minddata/dataset/engine/data_buffer.h"
 #include "minddata/dataset/engine/db_connector.h"
 #include "minddata/dataset/engine/opt/pass.h"
+#include "minddata/dataset/engine/perf/event_ring.h"
 #ifndef ENABLE_ANDROID
 #include "utils/system/crc32c.h"
 #include "utils/log_adapter.h"
@@ -256,8 +257,14 @@ void DatasetOp::Print(std::ostream &out, bool show_all) const {
 
 // Gets the next buffer from the given child
 Status DatasetOp::GetNextBuffer(std::unique_ptr<DataBuffer> *p_buffer, int32_t worker_id, bool retry_if_eoe) {
-  // pop is a blocked call and will throw an interruption if the whole group shuts down.
+  if (static_cast<size_t>(worker_id) >= event_rings_.size()) {
+    // pop is a blocked call and will throw an interruption if the whole group shuts down.
+    RETURN_IF_NOT_OK(out_connector_->PopWithRetry(static_cast<int>(worker_id), p_buffer, retry_if_eoe));
+    return Status::OK();
+  }
+  int64_t wait_start = OpEventRing::NowUs();
   RETURN_IF_NOT_OK(out_connector_->PopWithRetry(static_cast<int>(worker_id), p_buffer, retry_if_eoe));
+  event_rings_[worker_id]->Record(wait_start, OpEventRing::NowUs(), (*p_buffer)->NumRows(), out_connector_->size());
   return Status::OK();
 }
 
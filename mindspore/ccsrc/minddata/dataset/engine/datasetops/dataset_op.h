@@ -65,6 +65,8 @@ class NodePass;
 
 class SamplerRT;
 
+class OpEventRing;
+
 /// \brief The base class DatasetOp is the main tree node.  It is an abstract class, so
 /// the actual implementation of the operators will be derived from here.
 class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
@@ -297,6 +299,10 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
     return out_connector_ == nullptr ? int64_t(-1) : static_cast<int64_t>(out_connector_->out_buffers_count());
   }
 
+  /// \brief Attach the rings that GetNextBuffer records connector events into, indexed by consumer worker id
+  /// \param[in] rings - the rings, an empty vector turns recording off
+  void SetEventRings(std::vector<std::shared_ptr<OpEventRing>> rings) { event_rings_ = std::move(rings); }
+
   /// \brief Getter function
   /// \return connector size of current op
   int32_t ConnectorCapacity() const {
@@ -432,6 +438,7 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   CallbackManager callback_manager_;                             // Manages callbacks associated with a DatasetOp
   int64_t dataset_size_;                                         // Size of the dataset
   int64_t num_classes_;                                          // Number of classes
+  std::vector<std::shared_ptr<OpEventRing>> event_rings_;        // Connector events, empty unless tracing is on
 
  private:
   /// Sets the operator id.
@@ -64,9 +64,24 @@ DeviceQueueOp::DeviceQueueOp(std::string channel_name, DeviceType device_type, i
 #ifdef ENABLE_TDTQUE
   ascend_keep_waiting_ = true;
 #endif
+#ifdef ENABLE_CPUQUE
+  // Created here rather than on the sending thread, so the graph which runs after the send never takes from the
+  // closed queue of the last send
+  if (device_type_ == DeviceType::CPU) {
+    cpu_queue_ = device::cpu::CPUDataQueueMgr::GetInstance().Create(channel_name_, device::cpu::kDataQueueCapacity);
+  }
+#endif
 }
 
-DeviceQueueOp::~DeviceQueueOp() {}
+DeviceQueueOp::~DeviceQueueOp() {
+#ifdef ENABLE_CPUQUE
+  // Drop the batches the graph did not take, unless a newer send of the channel owns the queue
+  auto &queue_mgr = device::cpu::CPUDataQueueMgr::GetInstance();
+  if (cpu_queue_ != nullptr && queue_mgr.Get(channel_name_) == cpu_queue_) {
+    queue_mgr.Destroy(channel_name_);
+  }
+#endif
+}
 
 #ifdef ENABLE_GPUQUE
 void DeviceQueueOp::ReleaseData(void *addr, int32_t worker_id) {
@@ -465,27 +480,70 @@ Status DeviceQueueOp::MallocForGPUData(std::vector<device::DataItemGpu> *items,
 }
 #endif
 
+#ifdef ENABLE_CPUQUE
+Status DeviceQueueOp::PushDataToCPU(const std::shared_ptr<device::cpu::CPUDataQueue> &queue, TensorRow &&row,
+                                    bool *pushed) {
+  RETURN_UNEXPECTED_IF_NULL(pushed);
+  *pushed = false;
+  device::cpu::DataBatch batch;
+  for (const auto &tensor : row) {
+    CHECK_FAIL_RETURN_UNEXPECTED(tensor->type().IsNumeric(), "Invalid data, cannot send string tensor to device.");
+    CHECK_FAIL_RETURN_UNEXPECTED(tensor->HasData(), "Invalid data, cannot send tensor with no data to device.");
+    // The kernels only read the batch
+    auto data_ptr = const_cast<unsigned char *>(tensor->GetBuffer());
+    batch.items_.push_back({data_ptr, static_cast<size_t>(tensor->SizeInBytes())});
+  }
+  // The batch holds the tensors until the GetNext takes the next one
+  batch.holder_ = std::make_shared<TensorRow>(std::move(row));
+
+  while (!queue->IsClosed() && !TaskManager::FindMe()->Interrupted()) {
+    auto ret = queue->Push(std::move(batch), WAIT_TIME);
+    if (ret == device::cpu::DataQueueStatus::kSuccess) {
+      *pushed = true;
+      break;
+    }
+    if (ret != device::cpu::DataQueueStatus::kTimeout || stop_send_) {
+      break;
+    }
+    MS_LOG(DEBUG) << "Retry pushing data...";
+  }
+  return Status::OK();
+}
+#endif
+
 Status DeviceQueueOp::SendDataToCPU() {
   MS_LOG(INFO) << "Device queue, sending data to CPU.";
   int64_t total_batch = 0;
 
+  Status rc;
   std::unique_ptr<ChildIterator> child_iterator = std::make_unique<ChildIterator>(this, 0, 0);
   while (!(child_iterator->eof_handled())) {
     TensorRow curr_row;
-    RETURN_IF_NOT_OK(child_iterator->FetchNextTensorRow(&curr_row));
+    rc = child_iterator->FetchNextTensorRow(&curr_row);
+    if (rc.IsError()) break;
 
     if (!curr_row.empty()) {
       for (auto &tensor : curr_row) {
         MS_LOG(DEBUG) << "Feature size is " << tensor->SizeInBytes() << ".";
       }
+#ifdef ENABLE_CPUQUE
+      bool pushed = false;
+      rc = PushDataToCPU(cpu_queue_, std::move(curr_row), &pushed);
+      if (rc.IsError() || !pushed) break;
+#endif
       total_batch++;
       if (stop_send_) break;
+      if (total_batch_ > 0 && total_batch >= total_batch_) break;
     }
   }
 
   MS_LOG(INFO) << "Device queue total batch is " << total_batch << ".";
+#ifdef ENABLE_CPUQUE
+  // No more batches come, the GetNext fails once it took the ones left instead of waiting out its timeout
+  cpu_queue_->Close();
+#endif
 
-  return Status::OK();
+  return rc;
 }
 
 void DeviceQueueOp::Print(std::ostream &out, bool show_all) const {
@@ -39,6 +39,10 @@ using mindspore::device::BlockQueueStatus_T;
 using mindspore::device::GpuBufferMgr;
 #endif
 
+#ifdef ENABLE_CPUQUE
+#include "runtime/device/cpu/cpu_data_queue.h"
+#endif
+
 namespace mindspore {
 namespace dataset {
 using DATA_INFO = std::vector<std::pair<DataType, TensorShape>>;
@@ -208,6 +212,11 @@ class DeviceQueueOp : public PipelineOp {
 #endif
 
   Status SendDataToCPU();
+#ifdef ENABLE_CPUQUE
+  // Push a row to the CPU data queue, pushed is false if the queue is closed or the op is stopped
+  Status PushDataToCPU(const std::shared_ptr<device::cpu::CPUDataQueue> &queue, TensorRow &&row, bool *pushed);
+  std::shared_ptr<device::cpu::CPUDataQueue> cpu_queue_;
+#endif
   std::string channel_name_;
   DeviceType device_type_;
   const int32_t device_id_;
@@ -38,8 +38,16 @@ Status CpuMapJob::Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) {
     TensorRow input_row = in[row];
     TensorRow result_row;
     for (size_t i = 0; i < ops_.size(); i++) {
+      // The output of the last TensorOp goes to the slot of the row in its batch slab, if the map feeds a batch
+      bool done = false;
+      Status rc;
+      if (i + 1 == ops_.size() && batch_slab_pool_ != nullptr) {
+        rc = ComputeIntoSlot(ops_[i], input_row, batch_slab_first_row_ + row, &result_row, &done);
+      }
       // Call compute function for cpu
-      Status rc = ops_[i]->Compute(input_row, &result_row);
+      if (rc.IsOk() && !done) {
+        rc = ops_[i]->Compute(input_row, &result_row);
+      }
       if (rc.IsError()) {
         if (input_row.getId() >= 0) {
           MS_LOG(ERROR) << "The TensorRow with id=" + std::to_string(input_row.getId()) + " failed on " +
@@ -58,5 +66,34 @@ Status CpuMapJob::Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) {
   return Status::OK();
 }
 
+Status CpuMapJob::ComputeIntoSlot(const std::shared_ptr<TensorOp> &op, const TensorRow &input, int64_t row,
+                                  TensorRow *output, bool *done) {
+  *done = false;
+  TensorSlot slot(batch_slab_pool_, batch_slab_epoch_, row);
+  if (!slot.active() || !op->CanComputeInto() || input.size() != 1 || input[0] == nullptr) {
+    return Status::OK();
+  }
+  // The slot is claimed with the size of the output, an input the op rejects is left to Compute to report
+  std::vector<TensorShape> shapes;
+  std::vector<DataType> types;
+  std::shared_ptr<MemoryPool> region;
+  if (op->OutputShape({input[0]->shape()}, shapes).IsOk() && op->OutputType({input[0]->type()}, types).IsOk() &&
+      shapes.size() == 1 && types.size() == 1 && shapes[0].known() && types[0].IsNumeric()) {
+    region = slot.Claim(shapes[0].NumOfElements() * types[0].SizeInBytes());
+  }
+  if (region == nullptr) {
+    batch_slab_pool_->RecordHit(false);
+    return Status::OK();
+  }
+  std::shared_ptr<Tensor> result;
+  RETURN_IF_NOT_OK(op->ComputeInto(input[0], region, &result));
+  RETURN_UNEXPECTED_IF_NULL(result);
+  batch_slab_pool_->RecordHit(slot.Holds(result->GetBuffer()));
+  output->clear();
+  output->push_back(std::move(result));
+  *done = true;
+  return Status::OK();
+}
+
 }  // namespace dataset
 }  // namespace mindspore
@@ -35,6 +35,17 @@ class CpuMapJob : public MapJob {
 
   // A pure virtual run function to execute a cpu map job
   Status Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) override;
+
+ private:
+  // Run the last TensorOp with its output written into the slot of the row in the batch slab
+  // @param op - the last TensorOp of the job
+  // @param input - the input row of the op
+  // @param row - row number in the epoch
+  // @param output - the output row
+  // @param done - whether the op was run, it is not when the output can not go to the slot
+  // @return Status
+  Status ComputeIntoSlot(const std::shared_ptr<TensorOp> &op, const TensorRow &input, int64_t row, TensorRow *output,
+                         bool *done);
 };
 
 }  // namespace dataset
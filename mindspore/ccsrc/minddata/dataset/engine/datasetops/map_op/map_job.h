@@ -17,8 +17,10 @@
 #define DATASET_ENGINE_DATASETOPS_MAP_OP_MAP_JOB_H_
 
 #include <memory>
+#include <utility>
 #include <vector>
 
+#include "minddata/dataset/core/batch_slab.h"
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/core/tensor_row.h"
 #include "minddata/dataset/kernels/tensor_op.h"
@@ -42,11 +44,24 @@ class MapJob {
     return Status::OK();
   }
 
+  // Let the last operation write its output straight into the batch slabs of the batch op above the map
+  // @param pool - the slab pool shared with the batch op
+  // @param epoch - epoch number of the rows, counted by end of epoch buffers
+  // @param first_row - row number in the epoch of the first row of the job
+  void SetBatchSlab(std::shared_ptr<BatchSlabPool> pool, int64_t epoch, int64_t first_row) {
+    batch_slab_pool_ = std::move(pool);
+    batch_slab_epoch_ = epoch;
+    batch_slab_first_row_ = first_row;
+  }
+
   // A pure virtual run function to execute a particular map job
   virtual Status Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) = 0;
 
  protected:
   std::vector<std::shared_ptr<TensorOp>> ops_;
+  std::shared_ptr<BatchSlabPool> batch_slab_pool_;
+  int64_t batch_slab_epoch_ = 0;
+  int64_t batch_slab_first_row_ = 0;
 };
 
 }  // namespace dataset
@@ -162,6 +162,8 @@ Status MapOp::operator()() {
   RETURN_IF_NOT_OK(rc);
   // num_buffers received, including eoe, num_epoch, num_step of current epoch
   int64_t num_buf = 0, ep_step = 0, total_step = 0;
+  // epoch and row number of the next row, as the batch op above counts them, for the batch slabs
+  int64_t slab_epoch = 0, slab_row = 0;
 
   RETURN_IF_NOT_OK(callback_manager_.Begin(CallbackParam(0, ep_step, total_step)));
 
@@ -183,6 +185,10 @@ Status MapOp::operator()() {
 
       // Populate map worker job for a worker to execute
       RETURN_IF_NOT_OK(GenerateWorkerJob(&worker_job));
+      if (batch_slab_pool_ != nullptr && !worker_job->jobs.empty()) {
+        worker_job->jobs.back()->SetBatchSlab(batch_slab_pool_, slab_epoch, slab_row);
+        slab_row += worker_job->databuffer->NumRows();
+      }
 
       // Push map worker job to the corresponding worker's queue
       RETURN_IF_NOT_OK(local_queues_[num_buf++ % num_workers_]->Add(std::move(worker_job)));
@@ -198,6 +204,8 @@ Status MapOp::operator()() {
 
       ep_step = 0;
     }
+    slab_epoch++;
+    slab_row = 0;
     // Propagate the eoe buffer to worker
     std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(buff));
     RETURN_IF_NOT_OK(local_queues_[num_buf++ % num_workers_]->Add(std::move(worker_job)));
@@ -200,6 +200,10 @@ class MapOp : public ParallelOp {
 
   const auto &TFuncs() const { return tfuncs_; }
 
+  // Setter for the slab pool shared with the batch op above, see BatchSlabPass
+  // @param pool - the slab pool
+  void SetBatchSlabPool(std::shared_ptr<BatchSlabPool> pool) { batch_slab_pool_ = std::move(pool); }
+
  private:
   // A unit of job for map worker thread.
   // MapWorkerJob holds a list of MapJob where each MapJob can be a CpuMapJob, GpuMapJob or DvppMapJob.
@@ -225,6 +229,9 @@ class MapOp : public ParallelOp {
   // Variable to store the column name that the tensorOps are consuming
   std::vector<std::string> in_columns_;
 
+  // Slabs of the batch op above the map, the last TensorOp writes its output into them. May be null
+  std::shared_ptr<BatchSlabPool> batch_slab_pool_;
+
   // Variable to store the column name that the tensorOps are producing
   std::vector<std::string> out_columns_;
 
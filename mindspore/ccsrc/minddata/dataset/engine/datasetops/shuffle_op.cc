@@ -40,9 +40,11 @@ namespace dataset {
 constexpr int32_t ShuffleOp::kShuffleStateInit;
 constexpr int32_t ShuffleOp::kShuffleStateActive;
 constexpr int32_t ShuffleOp::kShuffleStateDrain;
+constexpr ShuffleRowStore::Handle ShuffleOp::kNoRow;
 
 // Builder constructor. Creates the builder object.
-ShuffleOp::Builder::Builder() : build_shuffle_size_(0), build_reshuffle_each_epoch_(true) {
+ShuffleOp::Builder::Builder()
+    : build_shuffle_size_(0), build_reshuffle_each_epoch_(true), build_shuffle_block_size_(1), build_row_pool_size_(0) {
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
   build_op_connector_size_ = cfg->op_connector_size();
   build_rows_per_buffer_ = cfg->rows_per_buffer();
@@ -53,6 +55,12 @@ Status ShuffleOp::Builder::SanityCheck() const {
   if (build_shuffle_size_ < 2) {
     RETURN_STATUS_UNEXPECTED("Invalid parameter, shuffle buffer size must be greater than 1.");
   }
+  if (build_shuffle_block_size_ < 1) {
+    RETURN_STATUS_UNEXPECTED("Invalid parameter, shuffle block size must be greater than 0.");
+  }
+  if (build_row_pool_size_ < 0) {
+    RETURN_STATUS_UNEXPECTED("Invalid parameter, row pool size must not be negative.");
+  }
   return Status::OK();
 }
 
@@ -60,13 +68,14 @@ Status ShuffleOp::Builder::SanityCheck() const {
 Status ShuffleOp::Builder::Build(std::shared_ptr<ShuffleOp> *ptr) {
   RETURN_IF_NOT_OK(SanityCheck());
   *ptr = std::make_shared<ShuffleOp>(build_shuffle_size_, build_shuffle_seed_, build_op_connector_size_,
-                                     build_reshuffle_each_epoch_, build_rows_per_buffer_);
+                                     build_reshuffle_each_epoch_, build_rows_per_buffer_, build_shuffle_block_size_,
+                                     build_row_pool_size_);
   return Status::OK();
 }
 
 // Constructor of the ShuffleOp
 ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch,
-                     int32_t rows_per_buffer)
+                     int32_t rows_per_buffer, int32_t shuffle_block_size, int32_t row_pool_size)
     : PipelineOp(op_connector_size),
       shuffle_size_(shuffle_size),
       shuffle_seed_(shuffle_seed),
@@ -74,7 +83,9 @@ ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_con
       rng_(shuffle_seed),
       buffer_counter_(0),
       rows_per_buffer_(rows_per_buffer),
-      shuffle_buffer_(std::make_unique<TensorTable>()),
+      shuffle_block_size_(shuffle_block_size),
+      row_pool_size_(row_pool_size),
+      row_store_(std::make_unique<ShuffleRowStore>()),
       shuffle_last_row_idx_(0),
       shuffle_buffer_state_(kShuffleStateInit) {}
 
@@ -90,7 +101,9 @@ Status ShuffleOp::SelfReset() {
     rng_ = std::mt19937_64(shuffle_seed_);
   }
 
-  shuffle_buffer_ = std::make_unique<TensorTable>();
+  row_store_->Clear();
+  shuffle_buffer_.clear();
+  shuffle_blocks_.clear();
   buffer_counter_ = 0;
   shuffle_last_row_idx_ = 0;
   shuffle_buffer_state_ = kShuffleStateInit;
@@ -103,13 +116,18 @@ void ShuffleOp::Print(std::ostream &out, bool show_all) const {
     // Call the super class for displaying any common 1-liner info
     PipelineOp::Print(out, show_all);
     // Then show any custom derived-internal 1-liner info for this op
-    out << " [shuffle size: " << shuffle_size_ << "]\n";
+    out << " [shuffle size: " << shuffle_size_ << "]";
+    if (shuffle_block_size_ > 1) {
+      out << " [block size: " << shuffle_block_size_ << "]";
+    }
+    out << "\n";
   } else {
     // Call the super class for displaying any common detailed info
     PipelineOp::Print(out, show_all);
     // Then show any custom derived-internal stuff
     out << "\nShuffle size: " << shuffle_size_ << "\nRows per buffer: " << rows_per_buffer_
-        << "\nShuffle buffer state: " << shuffle_buffer_state_ << "\nShuffle seed: " << shuffle_seed_ << "\n\n";
+        << "\nShuffle buffer state: " << shuffle_buffer_state_ << "\nShuffle seed: " << shuffle_seed_
+        << "\nShuffle block size: " << shuffle_block_size_ << "\nRow pool size (MB): " << row_pool_size_ << "\n\n";
   }
 }
 
@@ -122,14 +140,16 @@ Status ShuffleOp::AddRowToShuffleBuffer(TensorRow new_shuffle_row) {
   // slot better be empty because it should already have been swapped out during the random row
   // selection that was done previously!)
   if (shuffle_last_row_idx_ < (shuffle_size_ - 1)) {
-    shuffle_buffer_->push_back(std::move(new_shuffle_row));
-    shuffle_last_row_idx_ = (shuffle_buffer_->size()) - 1;
+    ShuffleRowStore::Handle handle;
+    RETURN_IF_NOT_OK(row_store_->Put(std::move(new_shuffle_row), &handle));
+    shuffle_buffer_.push_back(handle);
+    shuffle_last_row_idx_ = (shuffle_buffer_.size()) - 1;
   } else {
-    if (!(*shuffle_buffer_)[shuffle_last_row_idx_].empty()) {
+    if (shuffle_buffer_[shuffle_last_row_idx_] != kNoRow) {
       return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
                     "Last row of shuffle buffer should not be occupied!");
     }
-    (*shuffle_buffer_)[shuffle_last_row_idx_] = std::move(new_shuffle_row);
+    RETURN_IF_NOT_OK(row_store_->Put(std::move(new_shuffle_row), &shuffle_buffer_[shuffle_last_row_idx_]));
   }
   return Status::OK();
 }
@@ -148,6 +168,7 @@ Status ShuffleOp::operator()() {
   int32_t worker_id = 0;
   int32_t child_idx = 0;
   child_iterator_ = std::make_unique<ChildIterator>(this, worker_id, child_idx);
+  RETURN_IF_NOT_OK(row_store_->Init(row_pool_size_));
 
   // Main operator loop
   while (true) {
@@ -159,6 +180,12 @@ Status ShuffleOp::operator()() {
       break;
     }
 
+    // The block shuffle has its own loop, it leaves the buffer fully drained
+    if (shuffle_block_size_ > 1) {
+      RETURN_IF_NOT_OK(DrainBlocks());
+      shuffle_last_row_idx_ = -1;
+    }
+
     // Next, enter into the main execution loop of the shuffle op.
     // When the tail index position of our shuffle buffer goes negative it means that we've
     // fully drained the data from the shuffle buffer and we're done.
@@ -171,10 +198,13 @@ Status ShuffleOp::operator()() {
 
       // Step 2)
       // Randomly select a slot from our shuffle buffer and copy that row into the output
-      // tensor table. We remove the data from the shuffle buffer, leaving that slot
-      // in the table as an empty vector
+      // tensor table. We remove the row from the shuffle buffer, leaving that slot
+      // in the table empty
       int64_t random_slot = rng_() % (shuffle_last_row_idx_ + 1);
-      new_buffer_table->push_back(std::move((*shuffle_buffer_)[random_slot]));
+      TensorRow row;
+      RETURN_IF_NOT_OK(row_store_->Take(shuffle_buffer_[random_slot], &row));
+      shuffle_buffer_[random_slot] = kNoRow;
+      new_buffer_table->push_back(std::move(row));
 
       // Step 3)
       // If the output tensor table is at the requested size, then create a buffer for it
@@ -193,7 +223,8 @@ Status ShuffleOp::operator()() {
       // just vacated.  This makes the shuffle buffer contiguous, with an empty slot at the
       // tail of the shuffle buffer.
       if (random_slot != shuffle_last_row_idx_) {
-        (*shuffle_buffer_)[random_slot] = std::move((*shuffle_buffer_)[shuffle_last_row_idx_]);
+        shuffle_buffer_[random_slot] = shuffle_buffer_[shuffle_last_row_idx_];
+        shuffle_buffer_[shuffle_last_row_idx_] = kNoRow;
       }
 
       // Step 5)
@@ -263,9 +294,29 @@ Status ShuffleOp::InitShuffleBuffer() {
     RETURN_STATUS_UNEXPECTED("Unable to fetch a single row for shuffle buffer.");
   }
 
+  if (shuffle_block_size_ > 1) {
+    // Fill the buffer with whole blocks, keeping at least one
+    size_t num_blocks = std::max(1, shuffle_size_ / shuffle_block_size_);
+    std::vector<ShuffleRowStore::Handle> block(1);
+    RETURN_IF_NOT_OK(row_store_->Put(std::move(new_row), &block[0]));
+    shuffle_buffer_state_ = kShuffleStateActive;
+    RETURN_IF_NOT_OK(FetchBlock(&block));
+    shuffle_blocks_.push_back(std::move(block));
+    while (shuffle_buffer_state_ == kShuffleStateActive && shuffle_blocks_.size() < num_blocks) {
+      block.clear();
+      RETURN_IF_NOT_OK(FetchBlock(&block));
+      if (!block.empty()) {
+        shuffle_blocks_.push_back(std::move(block));
+      }
+    }
+    MS_LOG(DEBUG) << "Shuffle operator finished initializing the shuffle buffer with " << shuffle_blocks_.size()
+                  << " blocks.";
+    return Status::OK();
+  }
+
   // Now fill the rest of the shuffle buffer until we are unable to get the next row or we reached
   // the desired shuffle buffer size.
-  while (!new_row.empty() && shuffle_buffer_->size() < static_cast<size_t>(shuffle_size_ - 1)) {
+  while (!new_row.empty() && shuffle_buffer_.size() < static_cast<size_t>(shuffle_size_ - 1)) {
     // Add the previously fetched row
     RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(new_row)));
 
@@ -287,6 +338,69 @@ Status ShuffleOp::InitShuffleBuffer() {
   return Status::OK();
 }
 
+Status ShuffleOp::FetchBlock(std::vector<ShuffleRowStore::Handle> *block) {
+  while (block->size() < static_cast<size_t>(shuffle_block_size_) && shuffle_buffer_state_ == kShuffleStateActive) {
+    TensorRow new_row;
+    RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+    if (new_row.empty()) {
+      shuffle_buffer_state_ = kShuffleStateDrain;
+    } else {
+      ShuffleRowStore::Handle handle;
+      RETURN_IF_NOT_OK(row_store_->Put(std::move(new_row), &handle));
+      block->push_back(handle);
+    }
+  }
+  return Status::OK();
+}
+
+Status ShuffleOp::DrainBlocks() {
+  auto new_buffer_table = std::make_unique<TensorQTable>();
+  while (!shuffle_blocks_.empty()) {
+    // Take a random block out of the shuffle buffer, moving the last block into its slot
+    size_t random_slot = rng_() % shuffle_blocks_.size();
+    std::vector<ShuffleRowStore::Handle> block = std::move(shuffle_blocks_[random_slot]);
+    if (random_slot != shuffle_blocks_.size() - 1) {
+      shuffle_blocks_[random_slot] = std::move(shuffle_blocks_.back());
+    }
+    shuffle_blocks_.pop_back();
+
+    // Replace it with the next block of the input
+    if (shuffle_buffer_state_ == kShuffleStateActive) {
+      std::vector<ShuffleRowStore::Handle> next_block;
+      RETURN_IF_NOT_OK(FetchBlock(&next_block));
+      if (!next_block.empty()) {
+        shuffle_blocks_.push_back(std::move(next_block));
+      }
+    }
+
+    // Send the rows of the block in a random order
+    for (size_t i = block.size(); i > 1; --i) {
+      std::swap(block[i - 1], block[rng_() % i]);
+    }
+    for (auto handle : block) {
+      TensorRow row;
+      RETURN_IF_NOT_OK(row_store_->Take(handle, &row));
+      new_buffer_table->push_back(std::move(row));
+      if (new_buffer_table->size() == rows_per_buffer_) {
+        RETURN_IF_NOT_OK(SendBuffer(&new_buffer_table));
+      }
+    }
+  }
+  if (!new_buffer_table->empty()) {
+    RETURN_IF_NOT_OK(SendBuffer(&new_buffer_table));
+  }
+  return Status::OK();
+}
+
+Status ShuffleOp::SendBuffer(std::unique_ptr<TensorQTable> *table) {
+  auto new_buffer = std::make_unique<DataBuffer>(buffer_counter_, DataBuffer::kDeBFlagNone);
+  new_buffer->set_tensor_table(std::move(*table));
+  buffer_counter_++;
+  *table = std::make_unique<TensorQTable>();
+  MS_LOG(DEBUG) << "Shuffle operator sending a buffer to output.";
+  return out_connector_->Add(0, std::move(new_buffer));
+}
+
 Status ShuffleOp::EoeReceived(int32_t worker_id) {
   state_ = OpState::kDeOpIdle;
   return Status::OK();
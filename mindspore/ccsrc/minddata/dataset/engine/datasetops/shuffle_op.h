@@ -28,6 +28,7 @@
 #include "minddata/dataset/core/tensor_shape.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
 #include "minddata/dataset/engine/datasetops/pipeline_op.h"
+#include "minddata/dataset/engine/datasetops/shuffle_row_store.h"
 #include "minddata/dataset/util/status.h"
 
 namespace mindspore {
@@ -51,6 +52,9 @@ class ShuffleOp : public PipelineOp {
   // Shuffle buffer is in a state of being drained
   static constexpr int32_t kShuffleStateDrain = 2;
 
+  // Handle of an empty slot of the shuffle buffer
+  static constexpr ShuffleRowStore::Handle kNoRow = -1;
+
  public:
   // The nested builder class inside of the ShuffleOp is used to help manage all of the arguments
   // for constructing it.  The shuffle op is fairly simple though, but the builder provides a
@@ -100,6 +104,20 @@ class ShuffleOp : public PipelineOp {
       return *this;
     }
 
+    // Setter method.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetShuffleBlockSize(int32_t shuffle_block_size) {
+      build_shuffle_block_size_ = shuffle_block_size;
+      return *this;
+    }
+
+    // Setter method.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetRowPoolSize(int32_t row_pool_size) {
+      build_row_pool_size_ = row_pool_size;
+      return *this;
+    }
+
     // The builder "build" method creates the final object.
     // @return shared_ptr to the new ShuffleOp object
     Status Build(std::shared_ptr<ShuffleOp> *);
@@ -112,6 +130,8 @@ class ShuffleOp : public PipelineOp {
     int32_t build_rows_per_buffer_;
     bool build_reshuffle_each_epoch_;
     int32_t build_op_connector_size_;
+    int32_t build_shuffle_block_size_;
+    int32_t build_row_pool_size_;
 
     Status SanityCheck() const;
   };
@@ -122,8 +142,10 @@ class ShuffleOp : public PipelineOp {
   // @param shuffle_seed - The seed to use for random number generation
   // @param op_connector_size - The output connector queue size
   // @param rows_per_buffer - The requested number of rows per buffer
+  // @param shuffle_block_size - Number of consecutive input rows shuffled as a block, 1 to shuffle single rows
+  // @param row_pool_size - Size in MB of the pool the rows of the shuffle buffer are packed into, 0 for no pool
   ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch,
-            int32_t rows_per_buffer);
+            int32_t rows_per_buffer, int32_t shuffle_block_size = 1, int32_t row_pool_size = 0);
 
   // Destructor
   ~ShuffleOp() = default;
@@ -175,6 +197,21 @@ class ShuffleOp : public PipelineOp {
   // @return Status The status code returned
   Status InitShuffleBuffer();
 
+  // Private function to fetch the next block of rows from the child, in the order they come in.
+  // Switches to the draining state at the end of the epoch.
+  // @param block - The handles of the rows of the block
+  // @return Status The status code returned
+  Status FetchBlock(std::vector<ShuffleRowStore::Handle> *block);
+
+  // Private function for the main loop of the block shuffle. A random block of the shuffle buffer is replaced by the
+  // next block of the input and its rows are sent in a random order.
+  // @return Status The status code returned
+  Status DrainBlocks();
+
+  // Private function to send a table of rows as a buffer to the output connector.
+  // @return Status The status code returned
+  Status SendBuffer(std::unique_ptr<TensorQTable> *table);
+
   // Private function to re-init the shuffle op for another epoch.  Shuffle op calls this by
   // itself rather than waiting for the reset driven from operators above it in the pipeline.
   // @return Status The status code returned
@@ -191,8 +228,14 @@ class ShuffleOp : public PipelineOp {
   std::mt19937_64 rng_;
   int32_t buffer_counter_;   // For creating new buffer id's
   int32_t rows_per_buffer_;  // Number of rows to pack into output buffer
-  // A single (potentially large) buffer of tensor rows for performing shuffling.
-  std::unique_ptr<TensorTable> shuffle_buffer_;
+  int32_t shuffle_block_size_;  // Number of consecutive input rows shuffled as a block
+  int32_t row_pool_size_;       // Size in MB of the pool the rows are packed into
+  // The rows of the shuffle buffer, which itself only holds their handles.
+  std::unique_ptr<ShuffleRowStore> row_store_;
+  // A single (potentially large) buffer of row handles for performing shuffling, kNoRow for an empty slot.
+  std::vector<ShuffleRowStore::Handle> shuffle_buffer_;
+  // The blocks of row handles of the block shuffle.
+  std::vector<std::vector<ShuffleRowStore::Handle>> shuffle_blocks_;
   int32_t shuffle_last_row_idx_;  // Internal tracking of the last slot of our shuffle buffer
   int32_t shuffle_buffer_state_;  // State tracking for the shuffle buffer phases of work
 
@@ -0,0 +1,167 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/shuffle_row_store.h"
+#include <securec.h>
+#include <utility>
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/util/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Every field of a packed row is an int64, the bytes of a tensor are padded to keep them aligned:
+// id, number of tensors, then for each tensor: type, rank, dims, number of bytes, bytes
+constexpr size_t kFieldSize = sizeof(int64_t);
+
+size_t AlignUp(size_t size) { return (size + kFieldSize - 1) / kFieldSize * kFieldSize; }
+}  // namespace
+
+Status ShuffleRowStore::Init(int32_t pool_size_mb) {
+  CHECK_FAIL_RETURN_UNEXPECTED(pool_size_mb >= 0, "Invalid pool size: " + std::to_string(pool_size_mb));
+  Clear();
+  pool_ = nullptr;
+  if (pool_size_mb > 0) {
+    RETURN_IF_NOT_OK(Arena::CreateArena(&pool_, pool_size_mb));
+  }
+  return Status::OK();
+}
+
+size_t ShuffleRowStore::PackedSize(const TensorRow &row) {
+  size_t size = 2 * kFieldSize;
+  for (const auto &tensor : row) {
+    if (tensor == nullptr || !tensor->shape().known()) {
+      return 0;
+    }
+    if (tensor->GetBuffer() == nullptr && tensor->SizeInBytes() > 0) {
+      return 0;
+    }
+    size += (3 + tensor->shape().Rank()) * kFieldSize + AlignUp(tensor->SizeInBytes());
+  }
+  return size;
+}
+
+Status ShuffleRowStore::Pack(const TensorRow &row, unsigned char *dest, size_t size) {
+  auto fields = reinterpret_cast<int64_t *>(dest);
+  *fields++ = row.getId();
+  *fields++ = static_cast<int64_t>(row.size());
+  for (const auto &tensor : row) {
+    *fields++ = static_cast<int64_t>(tensor->type().value());
+    *fields++ = tensor->shape().Rank();
+    for (auto dim : tensor->shape().AsVector()) {
+      *fields++ = dim;
+    }
+    int64_t bytes = tensor->SizeInBytes();
+    *fields++ = bytes;
+    auto data = reinterpret_cast<unsigned char *>(fields);
+    if (bytes > 0) {
+      size_t remaining = size - (data - dest);
+      CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(data, remaining, tensor->GetBuffer(), bytes) == EOK,
+                                   "Failed to pack a row of the shuffle buffer.");
+    }
+    fields = reinterpret_cast<int64_t *>(data + AlignUp(bytes));
+  }
+  return Status::OK();
+}
+
+Status ShuffleRowStore::Unpack(const unsigned char *src, size_t size, TensorRow *row) {
+  auto fields = reinterpret_cast<const int64_t *>(src);
+  row_id_type id = *fields++;
+  int64_t num_tensors = *fields++;
+  TensorRow out;
+  out.setId(id);
+  out.reserve(num_tensors);
+  for (int64_t i = 0; i < num_tensors; ++i) {
+    DataType type(static_cast<DataType::Type>(*fields++));
+    int64_t rank = *fields++;
+    std::vector<dsize_t> dims(fields, fields + rank);
+    fields += rank;
+    int64_t bytes = *fields++;
+    auto data = reinterpret_cast<const unsigned char *>(fields);
+    CHECK_FAIL_RETURN_UNEXPECTED(data + bytes <= src + size, "Invalid packed row in the shuffle buffer.");
+    std::shared_ptr<Tensor> tensor;
+    if (bytes > 0) {
+      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(TensorShape(dims), type, data, bytes, &tensor));
+    } else {
+      RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape(dims), type, &tensor));
+    }
+    out.push_back(std::move(tensor));
+    fields = reinterpret_cast<const int64_t *>(data + AlignUp(bytes));
+  }
+  *row = std::move(out);
+  return Status::OK();
+}
+
+Status ShuffleRowStore::Put(TensorRow &&row, Handle *handle) {
+  RETURN_UNEXPECTED_IF_NULL(handle);
+  if (free_.empty()) {
+    free_.push_back(static_cast<Handle>(slots_.size()));
+    slots_.emplace_back();
+  }
+  Slot &slot = slots_[free_.back()];
+  size_t size = pool_ == nullptr ? 0 : PackedSize(row);
+  void *packed = nullptr;
+  if (size > 0 && pool_->Allocate(size, &packed).IsOk()) {
+    Status rc = Pack(row, reinterpret_cast<unsigned char *>(packed), size);
+    if (rc.IsError()) {
+      pool_->Deallocate(packed);
+      return rc;
+    }
+    slot.packed = reinterpret_cast<unsigned char *>(packed);
+    slot.packed_size = size;
+    ++num_packed_;
+    // Free the tensors now, the caller may hold on to the moved row
+    row.clear();
+  } else {
+    // No pool, or the pool is full, keep the row as it is
+    slot.row = std::move(row);
+  }
+  *handle = free_.back();
+  free_.pop_back();
+  return Status::OK();
+}
+
+Status ShuffleRowStore::Take(Handle handle, TensorRow *row) {
+  RETURN_UNEXPECTED_IF_NULL(row);
+  CHECK_FAIL_RETURN_UNEXPECTED(handle >= 0 && handle < static_cast<Handle>(slots_.size()),
+                               "Invalid handle of the shuffle buffer: " + std::to_string(handle));
+  Slot &slot = slots_[handle];
+  if (slot.packed != nullptr) {
+    Status rc = Unpack(slot.packed, slot.packed_size, row);
+    pool_->Deallocate(slot.packed);
+    slot.packed = nullptr;
+    slot.packed_size = 0;
+    --num_packed_;
+    RETURN_IF_NOT_OK(rc);
+  } else {
+    *row = std::move(slot.row);
+    slot.row = TensorRow();
+  }
+  free_.push_back(handle);
+  return Status::OK();
+}
+
+void ShuffleRowStore::Clear() {
+  for (auto &slot : slots_) {
+    if (slot.packed != nullptr) {
+      pool_->Deallocate(slot.packed);
+    }
+  }
+  slots_.clear();
+  free_.clear();
+  num_packed_ = 0;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,90 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SHUFFLE_ROW_STORE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SHUFFLE_ROW_STORE_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/util/arena.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \class ShuffleRowStore shuffle_row_store.h
+/// \brief Holds the rows of a shuffle buffer behind integer handles, so the shuffle only moves handles around.
+///     With a pool, every row is packed into a single allocation of the pool, its shape, type and bytes back to back,
+///     and its tensors are freed right away. The resident size of a row is then its bytes instead of the tensor
+///     objects, shapes and allocations of each column, which is most of it for the small encoded records shuffled
+///     before decoding. Rows which do not fit in the pool any more are kept as they are.
+class ShuffleRowStore {
+ public:
+  using Handle = int32_t;
+
+  ShuffleRowStore() = default;
+  ~ShuffleRowStore() = default;
+
+  /// \brief Create the pool, rows are kept as they are without one
+  /// \param[in] pool_size_mb size of the pool in MB, 0 for no pool
+  /// \return Status object
+  Status Init(int32_t pool_size_mb);
+
+  /// \brief Store a row
+  /// \param[in] row the row, moved into the store
+  /// \param[out] handle handle of the row
+  /// \return Status object
+  Status Put(TensorRow &&row, Handle *handle);
+
+  /// \brief Give back a row and release its handle
+  /// \param[in] handle handle returned by Put
+  /// \param[out] row the row
+  /// \return Status object
+  Status Take(Handle handle, TensorRow *row);
+
+  /// \brief Drop all the rows
+  void Clear();
+
+  /// \brief Number of rows in the store
+  int32_t size() const { return static_cast<int32_t>(slots_.size() - free_.size()); }
+
+  /// \brief Number of rows packed into the pool
+  int32_t num_packed() const { return num_packed_; }
+
+ private:
+  struct Slot {
+    TensorRow row;                    // The row when it is not packed
+    unsigned char *packed = nullptr;  // The row packed into the pool
+    size_t packed_size = 0;
+  };
+
+  // Bytes needed to pack a row, 0 if it can not be packed
+  static size_t PackedSize(const TensorRow &row);
+
+  static Status Pack(const TensorRow &row, unsigned char *dest, size_t size);
+
+  static Status Unpack(const unsigned char *src, size_t size, TensorRow *row);
+
+  std::shared_ptr<Arena> pool_;
+  std::vector<Slot> slots_;
+  std::vector<Handle> free_;
+  int32_t num_packed_ = 0;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SHUFFLE_ROW_STORE_H_
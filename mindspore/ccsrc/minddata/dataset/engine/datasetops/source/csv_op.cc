@@ -16,9 +16,17 @@
 #include "minddata/dataset/engine/datasetops/source/csv_op.h"
 
 #include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <stdexcept>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 #include "minddata/dataset/core/config_manager.h"
 #include "minddata/dataset/engine/jagged_connector.h"
@@ -28,6 +36,76 @@
 
 namespace mindspore {
 namespace dataset {
+namespace {
+// Find the first char in [begin, end) which is one of a, b, c and d, 16 chars at a time when possible.
+// @return const char * - the char found, or end if there is none.
+const char *FindAnyOf(const char *begin, const char *end, char a, char b, char c, char d) {
+#if defined(__SSE2__)
+  const __m128i va = _mm_set1_epi8(a);
+  const __m128i vb = _mm_set1_epi8(b);
+  const __m128i vc = _mm_set1_epi8(c);
+  const __m128i vd = _mm_set1_epi8(d);
+  for (; end - begin >= 16; begin += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+    __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb)),
+                               _mm_or_si128(_mm_cmpeq_epi8(v, vc), _mm_cmpeq_epi8(v, vd)));
+    int mask = _mm_movemask_epi8(hit);
+    if (mask != 0) {
+      return begin + __builtin_ctz(mask);
+    }
+  }
+#elif defined(__aarch64__)
+  const uint8x16_t va = vdupq_n_u8(static_cast<uint8_t>(a));
+  const uint8x16_t vb = vdupq_n_u8(static_cast<uint8_t>(b));
+  const uint8x16_t vc = vdupq_n_u8(static_cast<uint8_t>(c));
+  const uint8x16_t vd = vdupq_n_u8(static_cast<uint8_t>(d));
+  for (; end - begin >= 16; begin += 16) {
+    uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t *>(begin));
+    uint8x16_t hit = vorrq_u8(vorrq_u8(vceqq_u8(v, va), vceqq_u8(v, vb)), vorrq_u8(vceqq_u8(v, vc), vceqq_u8(v, vd)));
+    // narrow every compare result byte to a nibble, char i is then bits [4i, 4i + 4) of the mask
+    uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hit), 4)), 0);
+    if (mask != 0) {
+      return begin + (__builtin_ctzll(mask) >> 2);
+    }
+  }
+#endif
+  for (; begin < end; ++begin) {
+    if (*begin == a || *begin == b || *begin == c || *begin == d) {
+      return begin;
+    }
+  }
+  return end;
+}
+
+// Same as std::stoi, but reads a nul terminated buffer instead of a std::string.
+int StrToInt(const char *str) {
+  char *end = nullptr;
+  errno = 0;
+  long value = std::strtol(str, &end, 10);
+  if (end == str) {
+    throw std::invalid_argument("stoi");
+  }
+  if (errno == ERANGE || value < INT_MIN || value > INT_MAX) {
+    throw std::out_of_range("stoi");
+  }
+  return static_cast<int>(value);
+}
+
+// Same as std::stof, but reads a nul terminated buffer instead of a std::string.
+float StrToFloat(const char *str) {
+  char *end = nullptr;
+  errno = 0;
+  float value = std::strtof(str, &end);
+  if (end == str) {
+    throw std::invalid_argument("stof");
+  }
+  if (errno == ERANGE) {
+    throw std::out_of_range("stof");
+  }
+  return value;
+}
+}  // namespace
+
 CsvOp::Builder::Builder()
     : builder_device_id_(0),
       builder_num_devices_(1),
@@ -151,15 +229,42 @@ CsvOp::CsvParser::Message CsvOp::CsvParser::GetMessage(int c) {
 
 int CsvOp::CsvParser::ProcessMessage(int c) {
   Message m = GetMessage(c);
-  StateDiagram::iterator it = sd.find({cur_state_, m});
-  if (it == sd.end()) {
+  const StateActionPair *transition = sd.Find(cur_state_, m);
+  if (transition == nullptr) {
     return -1;
   }
-  int ret = it->second.second(*this, c);
-  cur_state_ = it->second.first;
+  int ret = transition->second(*this, c);
+  cur_state_ = transition->first;
   return ret;
 }
 
+int CsvOp::CsvParser::ProcessBlock(const char *begin, const char *end) {
+  const char *p = begin;
+  while (p < end) {
+    // inside a field, only these chars change the state, copy everything in front of them at once
+    if (cur_state_ == State::UNQUOTE) {
+      const char *stop = FindAnyOf(p, end, csv_field_delim_, '"', '\r', '\n');
+      PutChars(p, stop);
+      p = stop;
+    } else if (cur_state_ == State::QUOTE) {
+      const char *stop = FindAnyOf(p, end, '"', '"', '"', '"');
+      PutChars(p, stop);
+      p = stop;
+    }
+    if (p == end) {
+      break;
+    }
+    if (ProcessMessage(static_cast<unsigned char>(*p)) != 0) {
+      return -1;
+    }
+    ++p;
+    if (ReachEndOffset()) {
+      break;
+    }
+  }
+  return 0;
+}
+
 int CsvOp::CsvParser::PutChar(int c) {
   if (pos_ >= str_buf_.size()) {
     str_buf_.resize(str_buf_.size() * 2);
@@ -169,22 +274,43 @@ int CsvOp::CsvParser::PutChar(int c) {
   return 0;
 }
 
+void CsvOp::CsvParser::PutChars(const char *begin, const char *end) {
+  size_t size = str_buf_.size();
+  while (pos_ + (end - begin) > size) {
+    size *= 2;
+  }
+  if (size != str_buf_.size()) {
+    str_buf_.resize(size);
+  }
+  std::copy(begin, end, str_buf_.begin() + pos_);
+  pos_ += end - begin;
+}
+
 int CsvOp::CsvParser::PutRecord(int c) {
-  std::string s = std::string(str_buf_.begin(), str_buf_.begin() + pos_);
+  if (total_rows_ < start_offset_) {
+    // the row belongs to another shard, no need to convert it
+    pos_ = 0;
+    cur_col_++;
+    return 0;
+  }
   std::shared_ptr<Tensor> t;
   if (cur_col_ >= column_default_.size()) {
     err_message_ = "Number of file columns does not match the default records";
     return -1;
   }
+  if (pos_ >= str_buf_.size()) {
+    str_buf_.resize(str_buf_.size() * 2);
+  }
+  str_buf_[pos_] = '\0';
   switch (column_default_[cur_col_]->type) {
     case CsvOp::INT:
-      Tensor::CreateScalar(std::stoi(s), &t);
+      Tensor::CreateScalar(StrToInt(str_buf_.data()), &t);
       break;
     case CsvOp::FLOAT:
-      Tensor::CreateScalar(std::stof(s), &t);
+      Tensor::CreateScalar(StrToFloat(str_buf_.data()), &t);
       break;
     default:
-      Tensor::CreateScalar(s, &t);
+      Tensor::CreateScalar(std::string(str_buf_.data(), pos_), &t);
       break;
   }
   if (cur_col_ >= (*tensor_table_)[cur_row_].size()) {
@@ -274,12 +400,37 @@ int CsvOp::CsvParser::CountRows(int c) {
   } else {
     m = Message::MS_NORMAL;
   }
-  StateDiagram::iterator it = sdl.find({cur_state_, m});
-  if (it == sdl.end()) {
+  const StateActionPair *transition = sdl.Find(cur_state_, m);
+  if (transition == nullptr) {
     return -1;
   }
-  cur_state_ = it->second.first;
-  return it->second.second(*this, c);
+  cur_state_ = transition->first;
+  return transition->second(*this, c);
+}
+
+int CsvOp::CsvParser::CountBlock(const char *begin, const char *end, int64_t offset,
+                                 std::vector<int64_t> *row_offsets) {
+  const char *p = begin;
+  while (p < end) {
+    if (cur_state_ == State::UNQUOTE) {
+      p = FindAnyOf(p, end, '"', '\r', '\n', '\n');
+    } else if (cur_state_ == State::QUOTE) {
+      p = FindAnyOf(p, end, '"', '"', '"', '"');
+    }
+    if (p == end) {
+      break;
+    }
+    bool between_rows = cur_state_ == State::START_OF_FILE || cur_state_ == State::END_OF_LINE;
+    if (CountRows(static_cast<unsigned char>(*p)) != 0) {
+      return -1;
+    }
+    if (between_rows && cur_state_ != State::END_OF_LINE && cur_state_ != State::START_OF_FILE &&
+        row_offsets != nullptr && total_rows_ % CSV_ROW_INDEX_INTERVAL == 0) {
+      row_offsets->push_back(offset + (p - begin));
+    }
+    ++p;
+  }
+  return 0;
 }
 
 Status CsvOp::CsvParser::InitCsvParser() {
@@ -478,6 +629,7 @@ Status CsvOp::CsvParser::InitCsvParser() {
             if (this->total_rows_ > this->start_offset_ && this->total_rows_ <= this->end_offset_) {
               this->tensor_table_->push_back(TensorRow(column_default_.size(), nullptr));
             }
+            this->pos_ = 0;
             return 0;
           }}},
         {{State::END_OF_LINE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::NullFunc}},
@@ -501,7 +653,7 @@ Status CsvOp::LoadFile(const std::string &file, const int64_t start_offset, cons
   csv_parser.SetStartOffset(start_offset);
   csv_parser.SetEndOffset(end_offset);
   std::ifstream ifs;
-  ifs.open(file, std::ifstream::in);
+  ifs.open(file, std::ifstream::in | std::ifstream::binary);
   if (!ifs.is_open()) {
     RETURN_STATUS_UNEXPECTED("Error opening file: " + file);
   }
@@ -510,17 +662,34 @@ Status CsvOp::LoadFile(const std::string &file, const int64_t start_offset, cons
     getline(ifs, tmp);
   }
   csv_parser.Reset();
+
+  // start from the closest indexed row in front of the shard
+  auto row_offsets = filename_row_offsets_.find(file);
+  if (row_offsets != filename_row_offsets_.end() && !row_offsets->second.empty()) {
+    size_t index =
+      std::min(static_cast<size_t>(start_offset / CSV_ROW_INDEX_INTERVAL), row_offsets->second.size() - 1);
+    if (index > 0) {
+      ifs.seekg(row_offsets->second[index]);
+      csv_parser.SetTotalRows(static_cast<int64_t>(index) * CSV_ROW_INDEX_INTERVAL);
+    }
+  }
+
+  std::vector<char> block(CSV_READ_BLOCK_SIZE);
   try {
-    while (ifs.good()) {
-      // when ifstream reachs the end of file, the function get() return std::char_traits<char>::eof()
-      // which is a 32-bit -1, it's not equal to the 8-bit -1 on Euler OS. So instead of char, we use
-      // int to receive its return value.
-      int chr = ifs.get();
-      if (csv_parser.ProcessMessage(chr) != 0) {
-        RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse file: " + file + ":" +
-                                 std::to_string(csv_parser.GetTotalRows() + 1) +
-                                 ". Error message: " + csv_parser.GetErrorMessage());
-      }
+    int ret = 0;
+    while (ret == 0 && ifs.good() && !csv_parser.ReachEndOffset()) {
+      ifs.read(block.data(), block.size());
+      ret = csv_parser.ProcessBlock(block.data(), block.data() + ifs.gcount());
+    }
+    if (ret == 0) {
+      // std::char_traits<char>::eof() is a 32-bit -1, it's not equal to the 8-bit -1 on Euler OS.
+      // So instead of char, the parser uses int to receive it.
+      ret = csv_parser.ProcessMessage(std::char_traits<char>::eof());
+    }
+    if (ret != 0) {
+      RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse file: " + file + ":" +
+                               std::to_string(csv_parser.GetTotalRows() + 1) +
+                               ". Error message: " + csv_parser.GetErrorMessage());
     }
   } catch (std::invalid_argument &ia) {
     std::string err_row = std::to_string(csv_parser.GetTotalRows() + 1);
@@ -784,7 +953,7 @@ Status CsvOp::PostEndOfEpoch(int32_t queue_index) {
 
 Status CsvOp::CalculateNumRowsPerShard() {
   for (auto it = filename_index_->begin(); it != filename_index_->end(); ++it) {
-    int64_t count = CountTotalRows(it.value());
+    int64_t count = CountTotalRows(it.value(), &filename_row_offsets_[it.value()]);
     filename_numrows_[it.value()] = count;
     all_num_rows_ += count;
   }
@@ -798,10 +967,10 @@ Status CsvOp::CalculateNumRowsPerShard() {
   return Status::OK();
 }
 
-int64_t CsvOp::CountTotalRows(const std::string &file) {
+int64_t CsvOp::CountTotalRows(const std::string &file, std::vector<int64_t> *row_offsets) {
   CsvParser csv_parser(0, jagged_buffer_connector_, rows_per_buffer_, field_delim_, column_default_list_);
   std::ifstream ifs;
-  ifs.open(file, std::ifstream::in);
+  ifs.open(file, std::ifstream::in | std::ifstream::binary);
   if (!ifs.is_open()) {
     return 0;
   }
@@ -810,12 +979,19 @@ int64_t CsvOp::CountTotalRows(const std::string &file) {
     getline(ifs, tmp);
   }
   csv_parser.Reset();
+  if (row_offsets != nullptr) {
+    row_offsets->clear();
+  }
+  std::vector<char> block(CSV_READ_BLOCK_SIZE);
+  int64_t offset = ifs.good() ? static_cast<int64_t>(ifs.tellg()) : 0;
   while (ifs.good()) {
-    int chr = ifs.get();
-    if (csv_parser.CountRows(chr) != 0) {
+    ifs.read(block.data(), block.size());
+    if (csv_parser.CountBlock(block.data(), block.data() + ifs.gcount(), offset, row_offsets) != 0) {
       break;
     }
+    offset += ifs.gcount();
   }
+  csv_parser.CountRows(std::char_traits<char>::eof());
 
   return csv_parser.GetTotalRows();
 }
@@ -16,6 +16,9 @@
 #ifndef DATASET_ENGINE_DATASETOPS_SOURCE_CSV_OP_H_
 #define DATASET_ENGINE_DATASETOPS_SOURCE_CSV_OP_H_
 
+#include <array>
+#include <functional>
+#include <initializer_list>
 #include <string>
 #include <vector>
 #include <memory>
@@ -31,6 +34,11 @@ namespace mindspore {
 namespace dataset {
 
 const size_t CSV_BUFFER_SIZE = 4096;
+// Size of the blocks read from a csv file
+const size_t CSV_READ_BLOCK_SIZE = 4 * 1024 * 1024;
+// Every CSV_ROW_INDEX_INTERVAL rows, the byte offset of the row is recorded while counting rows, so a shard seeks to
+// its first row instead of parsing all the rows in front of it
+const int64_t CSV_ROW_INDEX_INTERVAL = 4096;
 using StringIndex = AutoIndexObj<std::string>;
 class JaggedConnector;
 
@@ -59,6 +67,9 @@ class CsvOp : public ParallelOp {
   // We design a state machine to implement CSV syntactic analysis. It contains two state diagram,'sd' and 'sdl'.
   // The 'sd' is used for parsing CSV syntactic, it's complete and complicate.
   // The 'sdl' is used for counting the record rows, it's concise and it runs fast.
+  // Files are fed to the parser block by block. Inside a field, the characters which cannot change the state are
+  // skipped with a vectorized scan and copied in one go, so the state diagrams only see delimiters, quotes and
+  // line breaks.
   struct CsvParser {
    public:
     CsvParser() = delete;
@@ -74,10 +85,29 @@ class CsvOp : public ParallelOp {
 
     void SetEndOffset(int64_t end_offset) { end_offset_ = end_offset; }
 
+    void SetTotalRows(int64_t total_rows) { total_rows_ = total_rows; }
+
     int ProcessMessage(int c);
 
+    // Parse a block of the file, the state is kept across blocks so fields may span them.
+    // @param begin - the first char of the block.
+    // @param end - one past the last char of the block.
+    // @return int - 0 if succeed, -1 otherwise.
+    int ProcessBlock(const char *begin, const char *end);
+
+    // @return bool - whether all the rows before the end offset have been put, the rest of the file is not needed.
+    bool ReachEndOffset() const { return cur_state_ == State::END_OF_LINE && total_rows_ >= end_offset_; }
+
     int CountRows(int c);
 
+    // Count the rows in a block of the file, the state is kept across blocks.
+    // @param begin - the first char of the block.
+    // @param end - one past the last char of the block.
+    // @param offset - the offset of the block in the file.
+    // @param row_offsets - if not null, the offset of every CSV_ROW_INDEX_INTERVAL-th row is appended.
+    // @return int - 0 if succeed, -1 otherwise.
+    int CountBlock(const char *begin, const char *end, int64_t offset, std::vector<int64_t> *row_offsets);
+
     Status InitCsvParser();
 
     int64_t GetTotalRows() { return total_rows_; }
@@ -106,7 +136,26 @@ class CsvOp : public ParallelOp {
 
     typedef std::pair<State, Message> StateMessagePair;
     typedef std::pair<State, std::function<int(CsvParser &, int)>> StateActionPair;
-    typedef std::map<StateMessagePair, StateActionPair> StateDiagram;
+
+    // Transition table indexed by state and message, an action without target marks a missing transition.
+    class StateDiagram {
+     public:
+      StateDiagram() = default;
+
+      StateDiagram(std::initializer_list<std::pair<StateMessagePair, StateActionPair>> transitions) {
+        for (auto &transition : transitions) {
+          table_[transition.first.first][transition.first.second] = transition.second;
+        }
+      }
+
+      const StateActionPair *Find(State state, Message message) const {
+        const StateActionPair &transition = table_[state][message];
+        return transition.second ? &transition : nullptr;
+      }
+
+     private:
+      std::array<std::array<StateActionPair, Message::MS_END_OF_FILE + 1>, State::EXCEPTION + 1> table_;
+    };
 
     Message GetMessage(int c);
 
@@ -114,6 +163,9 @@ class CsvOp : public ParallelOp {
 
     int PutChar(int c);
 
+    // Append chars which do not change the state to the current field
+    void PutChars(const char *begin, const char *end);
+
     int PutRecord(int c);
 
     int PutRow(int c);
@@ -384,8 +436,9 @@ class CsvOp : public ParallelOp {
 
   // Count number of rows in each file.
   // @param filename - csv file name.
+  // @param row_offsets - if not null, returns the offset of every CSV_ROW_INDEX_INTERVAL-th row.
   // @return int64_t - the total number of rows in file.
-  int64_t CountTotalRows(const std::string &file);
+  int64_t CountTotalRows(const std::string &file, std::vector<int64_t> *row_offsets = nullptr);
 
   // Pushes a control indicator onto the IOBlockQueue for each worker to consume.
   // When the worker pops this control indicator, it will shut itself down gracefully.
@@ -412,6 +465,7 @@ class CsvOp : public ParallelOp {
   int64_t all_num_rows_;
   int64_t num_samples_;
   std::map<std::string, int64_t> filename_numrows_;
+  std::map<std::string, std::vector<int64_t>> filename_row_offsets_;
   std::unique_ptr<StringIndex> filename_index_;
   std::vector<std::string> csv_files_list_;
   WaitPost io_block_queue_wait_post_;
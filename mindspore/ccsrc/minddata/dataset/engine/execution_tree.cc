@@ -18,6 +18,8 @@
 #include <string>
 #include <utility>
 #include <limits>
+#include <memory>
+#include <vector>
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/engine/datasetops/shuffle_op.h"
 #include "minddata/dataset/engine/datasetops/device_queue_op.h"
@@ -25,6 +27,7 @@
 #include "minddata/dataset/engine/opt/pre/removal_pass.h"
 #ifndef ENABLE_ANDROID
 #include "minddata/dataset/engine/opt/pre/cache_transform_pass.h"
+#include "minddata/dataset/engine/opt/post/batch_slab_pass.h"
 #include "minddata/dataset/engine/opt/post/repeat_pass.h"
 #include "minddata/dataset/engine/opt/pre/cache_error_pass.h"
 #include "mindspore/ccsrc/minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
@@ -35,6 +38,7 @@
 #if defined(ENABLE_GPUQUE) || defined(ENABLE_TDTQUE)
 #include "minddata/dataset/util/numa_interface.h"
 #endif
+#include "minddata/dataset/util/numa_placement.h"
 #include "minddata/dataset/util/task_manager.h"
 
 namespace mindspore {
@@ -150,6 +154,19 @@ void ExecutionTree::PrintNode(std::ostream &out, const std::shared_ptr<DatasetOp
 Status ExecutionTree::Launch() {
   // opencv limit too many threads
 #if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__) && !defined(ENABLE_ANDROID)
+  // The numa placement pins every thread of the tree, it replaces the process level numa bind below.
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  if (cfg->numa_placement() != NumaPlacementMode::kNone && numa_placement_ == nullptr) {
+    std::vector<std::vector<int32_t>> node_cpus;
+    Status rc = NumaPlacement::ReadNodeCpus(&node_cpus);
+    if (rc.IsOk()) {
+      numa_placement_ = std::make_unique<NumaPlacement>();
+      RETURN_IF_NOT_OK(numa_placement_->Init(node_cpus, cfg->rank_id(), cfg->numa_tenants_per_node(),
+                                             cfg->numa_placement() == NumaPlacementMode::kSpread));
+    } else {
+      MS_LOG(WARNING) << "Numa topology is not available, the threads of the tree are not pinned. " << rc;
+    }
+  }
 #if defined(ENABLE_GPUQUE) || defined(ENABLE_TDTQUE)
   // Here we do numa bind for performance optimization, as our test result,
   // if we do numa bind when get_dataset_size launch a tree, we'll get a
@@ -160,7 +177,7 @@ Status ExecutionTree::Launch() {
   // Now we only support GPU scenario and the single process scenario of Ascend,
   // now we remove the target_link of numa with _c_dataengine, and user can use
   // a config api to control whether to open numa feature.
-  if (numa_enable_ && rank_id_ >= 0) {
+  if (numa_enable_ && rank_id_ >= 0 && numa_placement_ == nullptr) {
     if (handle_ == nullptr) {
       handle_ = GetNumaAdapterHandle();
       if (handle_ == nullptr) {
@@ -208,7 +225,15 @@ Status ExecutionTree::Launch() {
     // the launching tree/user thread.  Do not exec any thread for an inlined op.
     itr->state_ = DatasetOp::OpState::kDeOpRunning;
     if (!itr->inlined()) {
-      RETURN_IF_NOT_OK(tg_->CreateAsyncTask(itr->NameWithID(), std::ref(*itr)));
+      if (numa_placement_ != nullptr) {
+        DatasetOp &op = *itr;
+        RETURN_IF_NOT_OK(tg_->CreateAsyncTask(itr->NameWithID(), [this, &op]() {
+          RETURN_IF_NOT_OK(numa_placement_->PinHome());
+          return op();
+        }));
+      } else {
+        RETURN_IF_NOT_OK(tg_->CreateAsyncTask(itr->NameWithID(), std::ref(*itr)));
+      }
       // Set the state of the Operator as running. This only matters in Leaf ops, CacheOp and TakeOp
     }
   }
@@ -237,7 +262,8 @@ ExecutionTree::Iterator::Iterator(const std::shared_ptr<DatasetOp> &root) : ind_
 
 // Given the number of workers, launches the worker entry function for each. Essentially a
 // wrapper for the TaskGroup handling that is stored inside the execution tree.
-Status ExecutionTree::LaunchWorkers(int32_t num_workers, std::function<Status(uint32_t)> func, std::string name) {
+Status ExecutionTree::LaunchWorkers(int32_t num_workers, std::function<Status(uint32_t)> func, std::string name,
+                                    bool near_consumer) {
   int32_t num_cpu_threads = GlobalContext::Instance()->config_manager()->num_cpu_threads();
   // this performs check that num_workers is positive and not unreasonably large which could happen
   // for example, un-initialized variable. uint16 max is 65536 which is large enough to cover everything
@@ -248,8 +274,18 @@ Status ExecutionTree::LaunchWorkers(int32_t num_workers, std::function<Status(ui
     MS_LOG(WARNING) << name + " is launched with " << std::to_string(num_workers) << " worker threads which exceeds "
                     << std::to_string(num_cpu_threads) << ", the maximum number of threads on this CPU.";
   }
+  // The workers of every op get their own cpus, rather than worker 0 of every op sharing the first one
+  int32_t first_slot = numa_placement_ != nullptr ? numa_placement_->ReserveWorkers(num_workers) : 0;
   for (int32_t i = 0; i < num_workers; ++i) {
-    RETURN_IF_NOT_OK(tg_->CreateAsyncTask(name, std::bind(func, i)));
+    if (numa_placement_ != nullptr) {
+      // Pinned before the worker allocates anything, so its rows are first touched on the node of its cpu
+      RETURN_IF_NOT_OK(tg_->CreateAsyncTask(name, [this, func, i, first_slot, near_consumer]() {
+        RETURN_IF_NOT_OK(numa_placement_->PinWorker(first_slot + i, near_consumer));
+        return func(i);
+      }));
+    } else {
+      RETURN_IF_NOT_OK(tg_->CreateAsyncTask(name, std::bind(func, i)));
+    }
   }
   return Status::OK();
 }
@@ -322,6 +358,7 @@ Status ExecutionTree::PostAction() {
   post_actions.push_back(std::make_unique<CacheErrorPass>());
   post_actions.push_back(std::make_unique<CacheTransformPass>());
   post_actions.push_back(std::make_unique<RepeatPass>());
+  post_actions.push_back(std::make_unique<BatchSlabPass>());
 #endif
 
   // Apply post action passes
@@ -35,6 +35,7 @@ namespace dataset {
 // Forward declares
 class TaskGroup;
 class DatasetOp;
+class NumaPlacement;
 class Pass;
 using OptPass = std::vector<std::unique_ptr<Pass>>;
 class ExecutionTree {
@@ -155,8 +156,11 @@ class ExecutionTree {
   // wrapper for the TaskGroup handling that is stored inside the execution tree.
   // @param num_workers - The number of workers to launch
   // @param func - The function entry point that workers will execute
+  // @param name - The name of the worker tasks
+  // @param near_consumer - Whether the numa placement keeps the workers on the node of the consumer of the pipeline
   // @return Status The status code returned
-  Status LaunchWorkers(int32_t num_workers, std::function<Status(uint32_t)> func, std::string name = "");
+  Status LaunchWorkers(int32_t num_workers, std::function<Status(uint32_t)> func, std::string name = "",
+                       bool near_consumer = false);
 
   // Getter method
   // @return shared_ptr to the root operator
@@ -257,6 +261,7 @@ class ExecutionTree {
   int32_t num_epochs_;                                   // Total number of epochs to run for this tree
   std::unique_ptr<ProfilingManager> profiling_manager_;  // Profiling manager
   bool partially_prepare_;                               // Temp: during migration to IR, if true, run remaining passes.
+  std::unique_ptr<NumaPlacement> numa_placement_;        // Pins the threads of the ops, nullptr if placement is off
 #if defined(ENABLE_GPUQUE) || defined(ENABLE_TDTQUE)
   // This rank_id is for numa and device_queue, one process work with only one rank_id,
   // for standalone scenario, this rank_id may come from env 'CUDA_VISIBLE_DEVICES',
@@ -0,0 +1,144 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/gnn/graph_csr.h"
+
+#include <algorithm>
+#include <string>
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+
+Status GraphCsr::Build(std::vector<std::pair<NodeIdType, NodeType>> nodes,
+                       const std::vector<std::pair<NodeIdType, NodeIdType>> &edges) {
+  std::sort(nodes.begin(), nodes.end());
+  const size_t node_num = nodes.size();
+  node_ids_.resize(node_num);
+  std::vector<NodeType> node_types(node_num);
+  for (size_t i = 0; i < node_num; ++i) {
+    CHECK_FAIL_RETURN_UNEXPECTED(i == 0 || nodes[i].first != nodes[i - 1].first,
+                                 "Duplicate node id:" + std::to_string(nodes[i].first));
+    node_ids_[i] = nodes[i].first;
+    node_types[i] = nodes[i].second;
+  }
+  nodes.clear();
+  nodes.shrink_to_fit();
+
+  id_table_.clear();
+  if (node_num > 0) {
+    min_node_id_ = node_ids_.front();
+    int64_t id_range = static_cast<int64_t>(node_ids_.back()) - min_node_id_ + 1;
+    // only worth a direct table if it is at most twice as large as the node list itself
+    if (id_range <= 2 * static_cast<int64_t>(node_num)) {
+      id_table_.assign(id_range, kNoDenseId);
+      for (size_t i = 0; i < node_num; ++i) {
+        id_table_[node_ids_[i] - min_node_id_] = static_cast<DenseIdType>(i);
+      }
+    }
+  }
+
+  // first pass counts the out degree per neighbor type, second pass scatters the neighbors
+  std::vector<std::pair<DenseIdType, DenseIdType>> dense_edges(edges.size());
+  adjacency_.clear();
+  for (size_t i = 0; i < edges.size(); ++i) {
+    DenseIdType src, dst;
+    RETURN_IF_NOT_OK(GetDenseId(edges[i].first, &src));
+    RETURN_IF_NOT_OK(GetDenseId(edges[i].second, &dst));
+    dense_edges[i] = {src, dst};
+    Adjacency &adj = adjacency_[node_types[dst]];
+    if (adj.offsets.empty()) {
+      adj.offsets.assign(node_num + 1, 0);
+    }
+    adj.offsets[src + 1]++;
+  }
+  std::unordered_map<NodeType, std::vector<EdgeOffsetType>> cursors;
+  for (auto &itr : adjacency_) {
+    std::vector<EdgeOffsetType> &offsets = itr.second.offsets;
+    for (size_t i = 0; i < node_num; ++i) {
+      offsets[i + 1] += offsets[i];
+    }
+    itr.second.neighbors.resize(offsets[node_num]);
+    cursors[itr.first].assign(offsets.begin(), offsets.end() - 1);
+  }
+  // the scatter is stable, the neighbors of a node keep the order their edges were added in
+  for (const auto &edge : dense_edges) {
+    NodeType type = node_types[edge.second];
+    adjacency_[type].neighbors[cursors[type][edge.first]++] = edge.second;
+  }
+  return Status::OK();
+}
+
+Status GraphCsr::GetDenseId(NodeIdType id, DenseIdType *dense_id) const {
+  if (!id_table_.empty()) {
+    int64_t index = static_cast<int64_t>(id) - min_node_id_;
+    *dense_id = (index < 0 || index >= static_cast<int64_t>(id_table_.size())) ? kNoDenseId : id_table_[index];
+  } else {
+    auto itr = std::lower_bound(node_ids_.begin(), node_ids_.end(), id);
+    *dense_id = (itr == node_ids_.end() || *itr != id) ? kNoDenseId : static_cast<DenseIdType>(itr - node_ids_.begin());
+  }
+  if (*dense_id == kNoDenseId) {
+    std::string err_msg = "Invalid node id:" + std::to_string(id);
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  return Status::OK();
+}
+
+std::pair<const DenseIdType *, const DenseIdType *> GraphCsr::GetNeighbors(DenseIdType dense_id,
+                                                                         NodeType neighbor_type) const {
+  auto itr = adjacency_.find(neighbor_type);
+  if (itr == adjacency_.end()) {
+    return {nullptr, nullptr};
+  }
+  const DenseIdType *base = itr->second.neighbors.data();
+  return {base + itr->second.offsets[dense_id], base + itr->second.offsets[dense_id + 1]};
+}
+
+void GraphCsr::GetAllNeighbors(DenseIdType dense_id, NodeType neighbor_type, bool exclude_itself,
+                               std::vector<NodeIdType> *out_neighbors) const {
+  auto range = GetNeighbors(dense_id, neighbor_type);
+  out_neighbors->clear();
+  out_neighbors->reserve((range.second - range.first) + (exclude_itself ? 0 : 1));
+  if (!exclude_itself) {
+    out_neighbors->push_back(node_ids_[dense_id]);
+  }
+  for (const DenseIdType *itr = range.first; itr != range.second; ++itr) {
+    out_neighbors->push_back(node_ids_[*itr]);
+  }
+}
+
+void GraphCsr::SampleNeighbors(DenseIdType dense_id, NodeType neighbor_type, int32_t samples_num, std::mt19937 *rnd,
+                               std::vector<DenseIdType> *scratch, DenseIdType *out_neighbors) const {
+  auto range = GetNeighbors(dense_id, neighbor_type);
+  const int64_t degree = range.second - range.first;
+  if (degree == 0) {
+    std::fill(out_neighbors, out_neighbors + samples_num, kNoDenseId);
+    return;
+  }
+  scratch->assign(range.first, range.second);
+  int32_t filled = 0;
+  while (filled < samples_num) {
+    // partial Fisher-Yates shuffle, only the first num positions are drawn
+    int64_t num = std::min<int64_t>(samples_num - filled, degree);
+    for (int64_t i = 0; i < num; ++i) {
+      std::uniform_int_distribution<int64_t> distribution(i, degree - 1);
+      std::swap((*scratch)[i], (*scratch)[distribution(*rnd)]);
+      out_neighbors[filled++] = (*scratch)[i];
+    }
+  }
+}
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,106 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_H_
+
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/engine/gnn/node.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+
+using DenseIdType = int32_t;
+using EdgeOffsetType = int64_t;
+
+constexpr DenseIdType kNoDenseId = -1;
+
+// Compressed sparse row adjacency of the graph.
+// Node ids are remapped to dense ids 0..N-1 in ascending order of node id, and the out neighbors of every node are
+// stored contiguously per neighbor node type, in the order their edges were added. Looking up the neighbors of a node
+// is two array reads instead of a hash lookup plus a walk over shared_ptr<Node>.
+class GraphCsr {
+ public:
+  GraphCsr() = default;
+
+  ~GraphCsr() = default;
+
+  // Build the adjacency from all nodes and edges of the graph
+  // @param std::vector<std::pair<NodeIdType, NodeType>> nodes - id and type of every node
+  // @param std::vector<std::pair<NodeIdType, NodeIdType>> edges - src and dst node id of every edge
+  // @return Status The status code returned
+  Status Build(std::vector<std::pair<NodeIdType, NodeType>> nodes,
+               const std::vector<std::pair<NodeIdType, NodeIdType>> &edges);
+
+  // @return size_t - Number of nodes
+  size_t NodeCount() const { return node_ids_.size(); }
+
+  // Map a node id to its dense id
+  // @param NodeIdType id - node id
+  // @param DenseIdType *dense_id - Returned dense id
+  // @return Status The status code returned, error if the node id does not exist
+  Status GetDenseId(NodeIdType id, DenseIdType *dense_id) const;
+
+  // @param DenseIdType dense_id - a valid dense id
+  // @return NodeIdType - Returned node id
+  NodeIdType GetNodeId(DenseIdType dense_id) const { return node_ids_[dense_id]; }
+
+  // Get the out neighbors of a node with the given node type
+  // @param DenseIdType dense_id - a valid dense id
+  // @param NodeType neighbor_type - type of neighbor
+  // @return std::pair<const DenseIdType *, const DenseIdType *> - begin and end of the neighbors, in edge order
+  std::pair<const DenseIdType *, const DenseIdType *> GetNeighbors(DenseIdType dense_id, NodeType neighbor_type) const;
+
+  // Get the all neighbors of a node as node ids
+  // @param DenseIdType dense_id - a valid dense id
+  // @param NodeType neighbor_type - type of neighbor
+  // @param bool exclude_itself - if false, the node itself is put in front of its neighbors
+  // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id
+  void GetAllNeighbors(DenseIdType dense_id, NodeType neighbor_type, bool exclude_itself,
+                       std::vector<NodeIdType> *out_neighbors) const;
+
+  // Sample neighbors of a node without replacement, restarting from the whole neighbor list every time it runs out.
+  // If the node has no such neighbors, the output is filled with kNoDenseId
+  // @param DenseIdType dense_id - a valid dense id
+  // @param NodeType neighbor_type - type of neighbor
+  // @param int32_t samples_num - Number of neighbors to be acquired
+  // @param std::mt19937 *rnd - random generator owned by the calling thread
+  // @param std::vector<DenseIdType> *scratch - buffer reused across calls by the calling thread
+  // @param DenseIdType *out_neighbors - Returned neighbors dense id, must hold samples_num elements
+  void SampleNeighbors(DenseIdType dense_id, NodeType neighbor_type, int32_t samples_num, std::mt19937 *rnd,
+                       std::vector<DenseIdType> *scratch, DenseIdType *out_neighbors) const;
+
+ private:
+  struct Adjacency {
+    std::vector<EdgeOffsetType> offsets;  // neighbors of dense id i are [offsets[i], offsets[i + 1])
+    std::vector<DenseIdType> neighbors;
+  };
+
+  std::vector<NodeIdType> node_ids_;  // sorted, indexed by dense id
+  // when node ids are compact, id - min_node_id_ indexes this table directly, otherwise node_ids_ is binary searched
+  std::vector<DenseIdType> id_table_;
+  NodeIdType min_node_id_ = 0;
+  std::unordered_map<NodeType, Adjacency> adjacency_;
+};
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_H_
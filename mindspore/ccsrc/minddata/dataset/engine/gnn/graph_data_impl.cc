@@ -24,6 +24,7 @@
 #include "minddata/dataset/core/tensor_shape.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
 #include "minddata/dataset/util/random.h"
+#include "minddata/dataset/util/task_manager.h"
 namespace mindspore {
 namespace dataset {
 namespace gnn {
@@ -137,9 +138,9 @@ Status GraphDataImpl::GetAllNeighbors(const std::vector<NodeIdType> &node_list,
   size_t max_neighbor_num = 0;
   neighbors.resize(node_list.size());
   for (size_t i = 0; i < node_list.size(); ++i) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[i], &node));
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i]));
+    DenseIdType dense_id;
+    RETURN_IF_NOT_OK(graph_csr_.GetDenseId(node_list[i], &dense_id));
+    graph_csr_.GetAllNeighbors(dense_id, neighbor_type, false, &neighbors[i]);
     max_neighbor_num = max_neighbor_num > neighbors[i].size() ? max_neighbor_num : neighbors[i].size();
   }
 
@@ -181,34 +182,72 @@ Status GraphDataImpl::GetSampledNeighbors(const std::vector<NodeIdType> &node_li
   for (const auto &type : neighbor_types) {
     RETURN_IF_NOT_OK(CheckNeighborType(type));
   }
-  std::vector<std::vector<NodeIdType>> neighbors_vec(node_list.size());
-  for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> input_node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &input_node));
-    neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
-    std::vector<NodeIdType> input_list = {node_list[node_idx]};
+  std::vector<DenseIdType> dense_list(node_list.size());
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    RETURN_IF_NOT_OK(graph_csr_.GetDenseId(node_list[i], &dense_list[i]));
+  }
+  // each row holds the node itself, then neighbor_nums[0] ids, then neighbor_nums[0] * neighbor_nums[1] ids, ...
+  size_t row_size = 1;
+  size_t hop_size = 1;
+  for (const auto &num : neighbor_nums) {
+    hop_size *= num;
+    row_size += hop_size;
+  }
+  std::vector<NodeIdType> rows(node_list.size() * row_size);
+  size_t num_workers = std::min(static_cast<size_t>(std::max(num_workers_, 1)), node_list.size() / kMinNodesPerWorker);
+  if (num_workers <= 1) {
+    SampleNeighborRows(dense_list, 0, node_list.size(), neighbor_nums, neighbor_types, rnd_(), row_size, &rows);
+  } else {
+    size_t chunk = (node_list.size() + num_workers - 1) / num_workers;
+    TaskGroup vg;
+    for (size_t begin = 0; begin < node_list.size(); begin += chunk) {
+      size_t end = std::min(begin + chunk, node_list.size());
+      uint32_t seed = rnd_();
+      RETURN_IF_NOT_OK(vg.CreateAsyncTask("SampleNeighbors", [&, begin, end, seed]() -> Status {
+        SampleNeighborRows(dense_list, begin, end, neighbor_nums, neighbor_types, seed, row_size, &rows);
+        return Status::OK();
+      }));
+    }
+    vg.join_all(Task::WaitFlag::kBlocking);
+    RETURN_IF_NOT_OK(vg.GetTaskErrorIfAny());
+  }
+  std::shared_ptr<Tensor> tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateFromVector(
+    rows, TensorShape({static_cast<dsize_t>(node_list.size()), static_cast<dsize_t>(row_size)}), &tensor));
+  tensor->Squeeze();
+  *out = std::move(tensor);
+  return Status::OK();
+}
+
+void GraphDataImpl::SampleNeighborRows(const std::vector<DenseIdType> &dense_list, size_t begin, size_t end,
+                                       const std::vector<NodeIdType> &neighbor_nums,
+                                       const std::vector<NodeType> &neighbor_types, uint32_t seed, size_t row_size,
+                                       std::vector<NodeIdType> *out) const {
+  std::mt19937 rnd(seed);
+  std::vector<DenseIdType> scratch;
+  std::vector<DenseIdType> row(row_size);
+  for (size_t row_idx = begin; row_idx < end; ++row_idx) {
+    row[0] = dense_list[row_idx];
+    // the nodes of the previous hop are row[input_begin, input_end)
+    size_t input_begin = 0;
+    size_t input_end = 1;
     for (size_t i = 0; i < neighbor_nums.size(); ++i) {
-      std::vector<NodeIdType> neighbors;
-      neighbors.reserve(input_list.size() * neighbor_nums[i]);
-      for (const auto &node_id : input_list) {
-        if (node_id == kDefaultNodeId) {
-          for (int32_t j = 0; j < neighbor_nums[i]; ++j) {
-            neighbors.emplace_back(kDefaultNodeId);
-          }
+      size_t output = input_end;
+      for (size_t j = input_begin; j < input_end; ++j, output += neighbor_nums[i]) {
+        if (row[j] == kNoDenseId) {
+          std::fill_n(row.begin() + output, neighbor_nums[i], kNoDenseId);
         } else {
-          std::shared_ptr<Node> node;
-          RETURN_IF_NOT_OK(GetNodeByNodeId(node_id, &node));
-          std::vector<NodeIdType> out;
-          RETURN_IF_NOT_OK(node->GetSampledNeighbors(neighbor_types[i], neighbor_nums[i], &out));
-          neighbors.insert(neighbors.end(), out.begin(), out.end());
+          graph_csr_.SampleNeighbors(row[j], neighbor_types[i], neighbor_nums[i], &rnd, &scratch, &row[output]);
         }
       }
-      neighbors_vec[node_idx].insert(neighbors_vec[node_idx].end(), neighbors.begin(), neighbors.end());
-      input_list = std::move(neighbors);
+      input_begin = input_end;
+      input_end = output;
+    }
+    NodeIdType *out_row = out->data() + row_idx * row_size;
+    for (size_t k = 0; k < row_size; ++k) {
+      out_row[k] = row[k] == kNoDenseId ? kDefaultNodeId : graph_csr_.GetNodeId(row[k]);
     }
   }
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neighbors_vec, DataType(DataType::DE_INT32), out));
-  return Status::OK();
 }
 
 Status GraphDataImpl::NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> shuffled_ids,
@@ -246,15 +285,15 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
   std::vector<std::vector<NodeIdType>> neg_neighbors_vec;
   neg_neighbors_vec.resize(node_list.size());
   for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &node));
+    DenseIdType dense_id;
+    RETURN_IF_NOT_OK(graph_csr_.GetDenseId(node_list[node_idx], &dense_id));
     std::vector<NodeIdType> neighbors;
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neg_neighbor_type, &neighbors));
+    graph_csr_.GetAllNeighbors(dense_id, neg_neighbor_type, false, &neighbors);
     std::unordered_set<NodeIdType> exclude_nodes;
     std::transform(neighbors.begin(), neighbors.end(),
                    std::insert_iterator<std::unordered_set<NodeIdType>>(exclude_nodes, exclude_nodes.begin()),
                    [](const NodeIdType node) { return node; });
-    neg_neighbors_vec[node_idx].emplace_back(node->id());
+    neg_neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
     if (all_nodes.size() > exclude_nodes.size()) {
       while (neg_neighbors_vec[node_idx].size() < samples_num + 1) {
         RETURN_IF_NOT_OK(NegativeSample(all_nodes, shuffled_id, &start_index, exclude_nodes, samples_num + 1,
@@ -265,7 +304,7 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
         }
       }
     } else {
-      MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node->id()
+      MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node_list[node_idx]
                     << " neg_neighbor_type:" << neg_neighbor_type;
       // If there are no negative neighbors, they are filled with kDefaultNodeId
       for (int32_t i = 0; i < samples_num; ++i) {
@@ -285,7 +324,8 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
 Status GraphDataImpl::RandomWalk(const std::vector<NodeIdType> &node_list, const std::vector<NodeType> &meta_path,
                                  float step_home_param, float step_away_param, NodeIdType default_node,
                                  std::shared_ptr<Tensor> *out) {
-  RETURN_IF_NOT_OK(random_walk_.Build(node_list, meta_path, step_home_param, step_away_param, default_node));
+  RETURN_IF_NOT_OK(
+    random_walk_.Build(node_list, meta_path, step_home_param, step_away_param, default_node, 1, num_workers_));
   std::vector<std::vector<NodeIdType>> walks;
   RETURN_IF_NOT_OK(random_walk_.SimulateWalk(&walks));
   RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>({walks}, DataType(DataType::DE_INT32), out));
@@ -611,94 +651,104 @@ Status GraphDataImpl::RandomWalkBase::Build(const std::vector<NodeIdType> &node_
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path) {
+Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, std::mt19937 *rnd,
+                                                   std::vector<NodeIdType> *walk_path) {
+  const GraphCsr &csr = graph_->graph_csr_;
   // Simulate a random walk starting from start node.
-  auto walk = std::vector<NodeIdType>(1, start_node);  // walk is an vector
+  DenseIdType start_dense_id;
+  RETURN_IF_NOT_OK(csr.GetDenseId(start_node, &start_dense_id));
+  auto walk = std::vector<DenseIdType>(1, start_dense_id);  // walk is an vector
   // walk simulate
   while (walk.size() - 1 < meta_path_.size()) {
-    // current nodE
+    // current node
     auto cur_node_id = walk.back();
-    std::shared_ptr<Node> cur_node;
-    RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(cur_node_id, &cur_node));
 
-    // current neighbors
-    std::vector<NodeIdType> cur_neighbors;
-    RETURN_IF_NOT_OK(cur_node->GetAllNeighbors(meta_path_[walk.size() - 1], &cur_neighbors, true));
-    std::sort(cur_neighbors.begin(), cur_neighbors.end());
+    // current neighbors, in edge order
+    auto cur_neighbors = csr.GetNeighbors(cur_node_id, meta_path_[walk.size() - 1]);
 
     // break if no neighbors
-    if (cur_neighbors.empty()) {
+    if (cur_neighbors.first == cur_neighbors.second) {
       break;
     }
 
     // walk by the fist node, then by the previous 2 nodes
     std::shared_ptr<StochasticIndex> stochastic_index;
     if (walk.size() == 1) {
-      RETURN_IF_NOT_OK(GetNodeProbability(cur_node_id, meta_path_[0], &stochastic_index));
+      RETURN_IF_NOT_OK(GetNodeProbability(cur_node_id, meta_path_[0], rnd, &stochastic_index));
     } else {
-      NodeIdType prev_node_id = walk[walk.size() - 2];
-      RETURN_IF_NOT_OK(GetEdgeProbability(prev_node_id, cur_node_id, walk.size() - 2, &stochastic_index));
+      DenseIdType prev_node_id = walk[walk.size() - 2];
+      RETURN_IF_NOT_OK(GetEdgeProbability(prev_node_id, cur_node_id, walk.size() - 2, rnd, &stochastic_index));
     }
-    NodeIdType next_node_id = cur_neighbors[WalkToNextNode(*stochastic_index)];
+    DenseIdType next_node_id = cur_neighbors.first[WalkToNextNode(*stochastic_index, rnd)];
     walk.push_back(next_node_id);
   }
 
-  while (walk.size() - 1 < meta_path_.size()) {
-    walk.push_back(default_node_);
+  walk_path->clear();
+  walk_path->reserve(meta_path_.size() + 1);
+  std::transform(walk.begin(), walk.end(), std::back_inserter(*walk_path),
+                 [&csr](DenseIdType dense_id) { return csr.GetNodeId(dense_id); });
+  while (walk_path->size() - 1 < meta_path_.size()) {
+    walk_path->push_back(default_node_);
   }
-
-  *walk_path = std::move(walk);
   return Status::OK();
 }
 
 Status GraphDataImpl::RandomWalkBase::SimulateWalk(std::vector<std::vector<NodeIdType>> *walks) {
-  for (int32_t i = 0; i < num_walks_; ++i) {
-    for (const auto &node : node_list_) {
-      std::vector<NodeIdType> walk;
-      RETURN_IF_NOT_OK(Node2vecWalk(node, &walk));
-      walks->push_back(walk);
+  size_t node_num = node_list_.size();
+  size_t total_walks = node_num * num_walks_;
+  walks->resize(total_walks);
+  // walk i starts from node_list_[i % node_num], ranges of walks are handed to workers with their own generator
+  auto walk_range = [this, node_num, walks](size_t begin, size_t end, uint32_t seed) -> Status {
+    std::mt19937 rnd(seed);
+    for (size_t i = begin; i < end; ++i) {
+      RETURN_IF_NOT_OK(Node2vecWalk(node_list_[i % node_num], &rnd, &(*walks)[i]));
     }
+    return Status::OK();
+  };
+  size_t num_workers = std::min(static_cast<size_t>(num_workers_), total_walks / kMinNodesPerWorker);
+  if (num_workers <= 1) {
+    return walk_range(0, total_walks, graph_->rnd_());
   }
-  return Status::OK();
+  size_t chunk = (total_walks + num_workers - 1) / num_workers;
+  TaskGroup vg;
+  for (size_t begin = 0; begin < total_walks; begin += chunk) {
+    RETURN_IF_NOT_OK(vg.CreateAsyncTask("RandomWalk", std::bind(walk_range, begin, std::min(begin + chunk, total_walks),
+                                                                static_cast<uint32_t>(graph_->rnd_()))));
+  }
+  vg.join_all(Task::WaitFlag::kBlocking);
+  return vg.GetTaskErrorIfAny();
 }
 
-Status GraphDataImpl::RandomWalkBase::GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
+Status GraphDataImpl::RandomWalkBase::GetNodeProbability(const DenseIdType &node_id, const NodeType &node_type,
+                                                         std::mt19937 *rnd,
                                                          std::shared_ptr<StochasticIndex> *node_probability) {
   // Generate alias nodes
-  std::shared_ptr<Node> node;
-  graph_->GetNodeByNodeId(node_id, &node);
-  std::vector<NodeIdType> neighbors;
-  RETURN_IF_NOT_OK(node->GetAllNeighbors(node_type, &neighbors, true));
-  std::sort(neighbors.begin(), neighbors.end());
-  auto non_normalized_probability = std::vector<float>(neighbors.size(), 1.0);
+  auto neighbors = graph_->graph_csr_.GetNeighbors(node_id, node_type);
+  auto non_normalized_probability = std::vector<float>(neighbors.second - neighbors.first, 1.0);
   *node_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
+    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability), rnd));
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst,
-                                                         uint32_t meta_path_index,
+Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const DenseIdType &src, const DenseIdType &dst,
+                                                         uint32_t meta_path_index, std::mt19937 *rnd,
                                                          std::shared_ptr<StochasticIndex> *edge_probability) {
   // Get the alias edge setup lists for a given edge.
-  std::shared_ptr<Node> src_node;
-  graph_->GetNodeByNodeId(src, &src_node);
-  std::vector<NodeIdType> src_neighbors;
-  RETURN_IF_NOT_OK(src_node->GetAllNeighbors(meta_path_[meta_path_index], &src_neighbors, true));
-
-  std::shared_ptr<Node> dst_node;
-  graph_->GetNodeByNodeId(dst, &dst_node);
-  std::vector<NodeIdType> dst_neighbors;
-  RETURN_IF_NOT_OK(dst_node->GetAllNeighbors(meta_path_[meta_path_index + 1], &dst_neighbors, true));
+  const GraphCsr &csr = graph_->graph_csr_;
+  auto src_neighbors = csr.GetNeighbors(src, meta_path_[meta_path_index]);
+  auto dst_neighbors = csr.GetNeighbors(dst, meta_path_[meta_path_index + 1]);
+  // the csr keeps neighbors in insertion order, a sorted copy makes the lookups below logarithmic
+  std::vector<DenseIdType> sorted_src_neighbors(src_neighbors.first, src_neighbors.second);
+  std::sort(sorted_src_neighbors.begin(), sorted_src_neighbors.end());
 
-  std::sort(dst_neighbors.begin(), dst_neighbors.end());
   std::vector<float> non_normalized_probability;
-  for (const auto &dst_nbr : dst_neighbors) {
-    if (dst_nbr == src) {
+  non_normalized_probability.reserve(dst_neighbors.second - dst_neighbors.first);
+  for (const DenseIdType *dst_nbr = dst_neighbors.first; dst_nbr != dst_neighbors.second; ++dst_nbr) {
+    if (*dst_nbr == src) {
       non_normalized_probability.push_back(1.0 / step_home_param_);  // replace 1.0 with G[dst][dst_nbr]['weight']
       continue;
     }
-    auto it = std::find(src_neighbors.begin(), src_neighbors.end(), dst_nbr);
-    if (it != src_neighbors.end()) {
+    if (std::binary_search(sorted_src_neighbors.begin(), sorted_src_neighbors.end(), *dst_nbr)) {
       // stay close, this node connect both src and dst
       non_normalized_probability.push_back(1.0);  // replace 1.0 with G[dst][dst_nbr]['weight']
     } else {
@@ -708,21 +758,21 @@ Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src,
   }
 
   *edge_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
+    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability), rnd));
   return Status::OK();
 }
 
-StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::vector<float> &probability) {
+StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::vector<float> &probability,
+                                                                   std::mt19937 *rnd) {
   uint32_t K = probability.size();
   std::vector<int32_t> switch_to_large_index(K, 0);
   std::vector<float> weight(K, .0);
   std::vector<int32_t> smaller;
   std::vector<int32_t> larger;
-  auto random_device = GetRandomDevice();
   std::uniform_real_distribution<> distribution(-kGnnEpsilon, kGnnEpsilon);
   float accumulate_threshold = 0.0;
   for (uint32_t i = 0; i < K; i++) {
-    float threshold_one = distribution(random_device);
+    float threshold_one = distribution(*rnd);
     accumulate_threshold += threshold_one;
     weight[i] = i < K - 1 ? probability[i] * K + threshold_one : probability[i] * K - accumulate_threshold;
     weight[i] < 1.0 ? smaller.push_back(i) : larger.push_back(i);
@@ -740,18 +790,17 @@ StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::ve
   return StochasticIndex(switch_to_large_index, weight);
 }
 
-uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index) {
-  auto switch_to_large_index = stochastic_index.first;
-  auto weight = stochastic_index.second;
+uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index, std::mt19937 *rnd) {
+  const auto &switch_to_large_index = stochastic_index.first;
+  const auto &weight = stochastic_index.second;
   const uint32_t size_of_index = switch_to_large_index.size();
 
-  auto random_device = GetRandomDevice();
   std::uniform_real_distribution<> distribution(0.0, 1.0);
 
   // Generate random integer between [0, K)
-  uint32_t random_idx = std::floor(distribution(random_device) * size_of_index);
+  uint32_t random_idx = std::floor(distribution(*rnd) * size_of_index);
 
-  if (distribution(random_device) < weight[random_idx]) {
+  if (distribution(*rnd) < weight[random_idx]) {
     return random_idx;
   }
   return switch_to_large_index[random_idx];
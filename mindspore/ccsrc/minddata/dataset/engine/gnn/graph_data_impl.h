@@ -25,6 +25,7 @@
 #include <vector>
 #include <utility>
 
+#include "minddata/dataset/engine/gnn/graph_csr.h"
 #include "minddata/dataset/engine/gnn/graph_data.h"
 #if !defined(_WIN32) && !defined(_WIN64)
 #include "minddata/dataset/engine/gnn/graph_shared_memory.h"
@@ -37,6 +38,8 @@ namespace gnn {
 
 const float kGnnEpsilon = 0.0001;
 const uint32_t kMaxNumWalks = 80;
+// Requests over fewer nodes than this per worker are not worth spreading over threads
+const size_t kMinNodesPerWorker = 256;
 using StochasticIndex = std::pair<std::vector<int32_t>, std::vector<float>>;
 
 class GraphDataImpl : public GraphData {
@@ -175,17 +178,17 @@ class GraphDataImpl : public GraphData {
     Status SimulateWalk(std::vector<std::vector<NodeIdType>> *walks);
 
    private:
-    Status Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path);
+    Status Node2vecWalk(const NodeIdType &start_node, std::mt19937 *rnd, std::vector<NodeIdType> *walk_path);
 
-    Status GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
+    Status GetNodeProbability(const DenseIdType &node_id, const NodeType &node_type, std::mt19937 *rnd,
                               std::shared_ptr<StochasticIndex> *node_probability);
 
-    Status GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst, uint32_t meta_path_index,
-                              std::shared_ptr<StochasticIndex> *edge_probability);
+    Status GetEdgeProbability(const DenseIdType &src, const DenseIdType &dst, uint32_t meta_path_index,
+                              std::mt19937 *rnd, std::shared_ptr<StochasticIndex> *edge_probability);
 
-    static StochasticIndex GenerateProbability(const std::vector<float> &probability);
+    static StochasticIndex GenerateProbability(const std::vector<float> &probability, std::mt19937 *rnd);
 
-    static uint32_t WalkToNextNode(const StochasticIndex &stochastic_index);
+    static uint32_t WalkToNextNode(const StochasticIndex &stochastic_index, std::mt19937 *rnd);
 
     template <typename T>
     std::vector<float> Normalize(const std::vector<T> &non_normalized_probability);
@@ -259,6 +262,18 @@ class GraphDataImpl : public GraphData {
 
   Status CheckNeighborType(NodeType neighbor_type);
 
+  // Sample the neighbors of nodes hop by hop, one row per input node
+  // @param std::vector<DenseIdType> &dense_list - Input nodes
+  // @param size_t begin, end - Range of input nodes handled by this call
+  // @param std::vector<NodeIdType> neighbor_nums - Number of neighbors sampled per hop
+  // @param std::vector<NodeType> neighbor_types - Neighbor type sampled per hop
+  // @param uint32_t seed - seed of the random generator of this call
+  // @param size_t row_size - Number of ids per row
+  // @param std::vector<NodeIdType> *out - Returned rows, the rows in [begin, end) are filled
+  void SampleNeighborRows(const std::vector<DenseIdType> &dense_list, size_t begin, size_t end,
+                          const std::vector<NodeIdType> &neighbor_nums, const std::vector<NodeType> &neighbor_types,
+                          uint32_t seed, size_t row_size, std::vector<NodeIdType> *out) const;
+
   std::string dataset_file_;
   int32_t num_workers_;  // The number of worker threads
   std::mt19937 rnd_;
@@ -270,6 +285,7 @@ class GraphDataImpl : public GraphData {
 #endif
   std::unordered_map<NodeType, std::vector<NodeIdType>> node_type_map_;
   std::unordered_map<NodeIdType, std::shared_ptr<Node>> node_id_map_;
+  GraphCsr graph_csr_;
 
   std::unordered_map<EdgeType, std::vector<EdgeIdType>> edge_type_map_;
   std::unordered_map<EdgeIdType, std::shared_ptr<Edge>> edge_id_map_;
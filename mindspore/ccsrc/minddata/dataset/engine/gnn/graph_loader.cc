@@ -44,11 +44,14 @@ GraphLoader::GraphLoader(GraphDataImpl *graph_impl, std::string mr_filepath, int
 Status GraphLoader::GetNodesAndEdges() {
   NodeIdMap *n_id_map = &graph_impl_->node_id_map_;
   EdgeIdMap *e_id_map = &graph_impl_->edge_id_map_;
+  std::vector<std::pair<NodeIdType, NodeType>> csr_nodes;
+  std::vector<std::pair<NodeIdType, NodeIdType>> csr_edges;
   for (std::deque<std::shared_ptr<Node>> &dq : n_deques_) {
     while (dq.empty() == false) {
       std::shared_ptr<Node> node_ptr = dq.front();
       n_id_map->insert({node_ptr->id(), node_ptr});
       graph_impl_->node_type_map_[node_ptr->type()].push_back(node_ptr->id());
+      csr_nodes.emplace_back(node_ptr->id(), node_ptr->type());
       dq.pop_front();
     }
   }
@@ -62,7 +65,7 @@ Status GraphLoader::GetNodesAndEdges() {
       CHECK_FAIL_RETURN_UNEXPECTED(src_itr != n_id_map->end(), "invalid src_id:" + std::to_string(src_itr->first));
       CHECK_FAIL_RETURN_UNEXPECTED(dst_itr != n_id_map->end(), "invalid src_id:" + std::to_string(dst_itr->first));
       RETURN_IF_NOT_OK(edge_ptr->SetNode({src_itr->second, dst_itr->second}));
-      RETURN_IF_NOT_OK(src_itr->second->AddNeighbor(dst_itr->second));
+      csr_edges.emplace_back(src_itr->first, dst_itr->first);
       e_id_map->insert({edge_ptr->id(), edge_ptr});  // add edge to edge_id_map_
       graph_impl_->edge_type_map_[edge_ptr->type()].push_back(edge_ptr->id());
       dq.pop_front();
@@ -71,6 +74,7 @@ Status GraphLoader::GetNodesAndEdges() {
 
   for (auto &itr : graph_impl_->node_type_map_) itr.second.shrink_to_fit();
   for (auto &itr : graph_impl_->edge_type_map_) itr.second.shrink_to_fit();
+  RETURN_IF_NOT_OK(graph_impl_->graph_csr_.Build(std::move(csr_nodes), csr_edges));
 
   MergeFeatureMaps();
   return Status::OK();
@@ -66,6 +66,7 @@ class GraphLoader {
   // this function will query mindrecord and construct all nodes and edges
   // nodes and edges are added to map without any connection. That's because there nodes and edges are read in
   // random order. src_node and dst_node in Edge are node_id only with -1 as type.
+  // once all nodes are known, the edges are connected and the adjacency of the graph is built into its GraphCsr
   // features attached to each node and edge are expected to be filled correctly
   Status GetNodesAndEdges();
 
@@ -43,38 +43,13 @@ class LocalNode : public Node {
   // @return Status The status code returned
   Status GetFeatures(FeatureType feature_type, std::shared_ptr<Feature> *out_feature) override;
 
-  // Get the all neighbors of a node
-  // @param NodeType neighbor_type - type of neighbor
-  // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id
-  // @return Status The status code returned
-  Status GetAllNeighbors(NodeType neighbor_type, std::vector<NodeIdType> *out_neighbors,
-                         bool exclude_itself = false) override;
-
-  // Get the sampled neighbors of a node
-  // @param NodeType neighbor_type - type of neighbor
-  // @param int32_t samples_num - Number of neighbors to be acquired
-  // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id
-  // @return Status The status code returned
-  Status GetSampledNeighbors(NodeType neighbor_type, int32_t samples_num,
-                             std::vector<NodeIdType> *out_neighbors) override;
-
-  // Add neighbor of node
-  // @param std::shared_ptr<Node> node -
-  // @return Status The status code returned
-  Status AddNeighbor(const std::shared_ptr<Node> &node) override;
-
   // Update feature of node
   // @param std::shared_ptr<Feature> feature -
   // @return Status The status code returned
   Status UpdateFeature(const std::shared_ptr<Feature> &feature) override;
 
  private:
-  Status GetSampledNeighbors(const std::vector<std::shared_ptr<Node>> &neighbors, int32_t samples_num,
-                             std::vector<NodeIdType> *out);
-
-  std::mt19937 rnd_;
   std::unordered_map<FeatureType, std::shared_ptr<Feature>> features_;
-  std::unordered_map<NodeType, std::vector<std::shared_ptr<Node>>> neighbor_nodes_;
 };
 }  // namespace gnn
 }  // namespace dataset
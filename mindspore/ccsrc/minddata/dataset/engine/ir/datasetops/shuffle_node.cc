@@ -27,25 +27,31 @@ namespace mindspore {
 namespace dataset {
 
 // Constructor for ShuffleNode
-ShuffleNode::ShuffleNode(std::shared_ptr<DatasetNode> child, int32_t shuffle_size, bool reset_every_epoch)
-    : shuffle_size_(shuffle_size), shuffle_seed_(GetSeed()), reset_every_epoch_(reset_every_epoch) {
+ShuffleNode::ShuffleNode(std::shared_ptr<DatasetNode> child, int32_t shuffle_size, bool reset_every_epoch,
+                         int32_t block_size, int32_t row_pool_size)
+    : shuffle_size_(shuffle_size),
+      shuffle_seed_(GetSeed()),
+      reset_every_epoch_(reset_every_epoch),
+      block_size_(block_size),
+      row_pool_size_(row_pool_size) {
   this->AddChild(child);
 }
 
 std::shared_ptr<DatasetNode> ShuffleNode::Copy() {
-  auto node = std::make_shared<ShuffleNode>(nullptr, shuffle_size_, reset_every_epoch_);
+  auto node = std::make_shared<ShuffleNode>(nullptr, shuffle_size_, reset_every_epoch_, block_size_, row_pool_size_);
   return node;
 }
 
 void ShuffleNode::Print(std::ostream &out) const {
   out << Name() + "(shuffle_size:" + std::to_string(shuffle_size_) +
-           ",reset_every_epoch:" + (reset_every_epoch_ ? "true" : "false") + ")";
+           ",reset_every_epoch:" + (reset_every_epoch_ ? "true" : "false") +
+           ",block_size:" + std::to_string(block_size_) + ",row_pool_size:" + std::to_string(row_pool_size_) + ")";
 }
 
 // Function to build the ShuffleOp
 Status ShuffleNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_ops) {
   node_ops->push_back(std::make_shared<ShuffleOp>(shuffle_size_, shuffle_seed_, connector_que_size_, reset_every_epoch_,
-                                                  rows_per_buffer_));
+                                                  rows_per_buffer_, block_size_, row_pool_size_));
   return Status::OK();
 }
 
@@ -57,6 +63,16 @@ Status ShuffleNode::ValidateParams() {
     MS_LOG(ERROR) << err_msg;
     RETURN_STATUS_SYNTAX_ERROR(err_msg);
   }
+  if (block_size_ <= 0) {
+    std::string err_msg = "ShuffleNode: Invalid input, block_size: " + std::to_string(block_size_);
+    MS_LOG(ERROR) << err_msg;
+    RETURN_STATUS_SYNTAX_ERROR(err_msg);
+  }
+  if (row_pool_size_ < 0) {
+    std::string err_msg = "ShuffleNode: Invalid input, row_pool_size: " + std::to_string(row_pool_size_);
+    MS_LOG(ERROR) << err_msg;
+    RETURN_STATUS_SYNTAX_ERROR(err_msg);
+  }
 
   return Status::OK();
 }
@@ -65,6 +81,8 @@ Status ShuffleNode::to_json(nlohmann::json *out_json) {
   nlohmann::json args;
   args["buffer_size"] = shuffle_size_;
   args["reshuffle_each_epoch"] = reset_every_epoch_;
+  args["block_size"] = block_size_;
+  args["row_pool_size"] = row_pool_size_;
   *out_json = args;
   return Status::OK();
 }
@@ -30,7 +30,8 @@ namespace dataset {
 
 class ShuffleNode : public DatasetNode {
  public:
-  ShuffleNode(std::shared_ptr<DatasetNode> child, int32_t shuffle_size, bool reset_every_epoch);
+  ShuffleNode(std::shared_ptr<DatasetNode> child, int32_t shuffle_size, bool reset_every_epoch,
+              int32_t block_size = 1, int32_t row_pool_size = 0);
 
   ~ShuffleNode() = default;
 
@@ -57,6 +58,8 @@ class ShuffleNode : public DatasetNode {
   int32_t ShuffleSize() const { return shuffle_size_; }
   uint32_t ShuffleSeed() const { return shuffle_seed_; }
   bool ResetEveryEpoch() const { return reset_every_epoch_; }
+  int32_t BlockSize() const { return block_size_; }
+  int32_t RowPoolSize() const { return row_pool_size_; }
 
   /// \brief Get the arguments of node
   /// \param[out] out_json JSON string of all attributes
@@ -67,6 +70,8 @@ class ShuffleNode : public DatasetNode {
   int32_t shuffle_size_;
   uint32_t shuffle_seed_;
   bool reset_every_epoch_;
+  int32_t block_size_;
+  int32_t row_pool_size_;
 };
 
 }  // namespace dataset
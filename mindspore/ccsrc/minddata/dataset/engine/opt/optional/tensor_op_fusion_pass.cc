@@ -23,15 +23,78 @@
 #include "minddata/dataset/include/transforms.h"
 #include "minddata/dataset/include/vision.h"
 #include "minddata/dataset/include/vision_lite.h"
+#include "minddata/dataset/kernels/data/type_cast_op.h"
+#include "minddata/dataset/kernels/image/normalize_hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "minddata/dataset/kernels/image/rescale_op.h"
 
 namespace mindspore {
 namespace dataset {
+namespace {
+// Whether op is the pre-built TensorOp or the TensorOperation of the given names
+bool IsOp(const std::shared_ptr<TensorOperation> &op, const std::string &op_name, const std::string &operation_name) {
+  return op->Name() == op_name || op->Name() == operation_name;
+}
+
+// Fuse [Rescale] Normalize HwcToChw [TypeCast to float32 or float16] into one NormalizeHwcToChwOp. The ops are
+// deterministic and cheap, dispatching them one by one through OpenCV costs more than the math.
+Status FuseNormalizeHwcToChw(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *const modified) {
+  for (size_t i = 0; i + 1 < ops->size(); i++) {
+    if (!IsOp((*ops)[i], kNormalizeOp, vision::kNormalizeOperation) ||
+        !IsOp((*ops)[i + 1], kHwcToChwOp, vision::kHwcToChwOperation)) {
+      continue;
+    }
+    auto normalize = std::dynamic_pointer_cast<NormalizeOp>((*ops)[i]->Build());
+    if (normalize == nullptr || normalize->mean()->Size() != 3 || normalize->std()->Size() != 3) {
+      continue;
+    }
+    std::vector<float> mean(3), std(3);
+    for (dsize_t c = 0; c < 3; c++) {
+      RETURN_IF_NOT_OK(normalize->mean()->GetItemAt<float>(&mean[c], {c}));
+      RETURN_IF_NOT_OK(normalize->std()->GetItemAt<float>(&std[c], {c}));
+    }
+
+    size_t first = i, last = i + 2;
+    float rescale = 1.0, shift = 0.0;
+    if (i > 0 && IsOp((*ops)[i - 1], kRescaleOp, vision::kRescaleOperation)) {
+      auto op = std::dynamic_pointer_cast<RescaleOp>((*ops)[i - 1]->Build());
+      if (op != nullptr) {
+        rescale = op->rescale();
+        shift = op->shift();
+        first = i - 1;
+      }
+    }
+    DataType output_type(DataType::DE_FLOAT32);
+    if (last < ops->size() && IsOp((*ops)[last], kTypeCastOp, kTypeCastOperation)) {
+      auto op = std::dynamic_pointer_cast<TypeCastOp>((*ops)[last]->Build());
+      if (op != nullptr && (op->type() == DataType::DE_FLOAT32 || op->type() == DataType::DE_FLOAT16)) {
+        output_type = op->type();
+        last++;
+      }
+    }
+    MS_LOG(INFO) << "Fusing " << (last - first) << " ops starting at " << (*ops)[first]->Name()
+                 << " into one NormalizeHwcToChw.";
+    (*ops)[first] = std::make_shared<transforms::PreBuiltOperation>(
+      std::make_shared<NormalizeHwcToChwOp>(mean, std, rescale, shift, output_type));
+    ops->erase(ops->begin() + first + 1, ops->begin() + last);
+    *modified = true;
+  }
+  return Status::OK();
+}
+}  // namespace
 
 Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
   std::vector<std::shared_ptr<TensorOperation>> ops = node->operations();
 
+  bool fused = false;
+  RETURN_IF_NOT_OK(FuseNormalizeHwcToChw(&ops, &fused));
+  if (fused) {
+    node->setOperations(ops);
+    *modified = true;
+  }
+
   // start temporary code, to deal with pre-built TensorOperation
   std::vector<std::string> pattern = {kDecodeOp, kRandomCropAndResizeOp};
   auto itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
@@ -0,0 +1,45 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/opt/post/batch_slab_pass.h"
+#include <memory>
+#include "minddata/dataset/core/batch_slab.h"
+#include "minddata/dataset/engine/datasetops/batch_op.h"
+#include "minddata/dataset/engine/datasetops/map_op/map_op.h"
+
+namespace mindspore {
+namespace dataset {
+
+Status BatchSlabPass::RunOnNode(std::shared_ptr<BatchOp> node, bool *const modified) {
+  *modified = false;
+  if (!node->StacksRows() || node->start_batch_size() <= 1 || node->child(0) == nullptr) {
+    return Status::OK();
+  }
+  std::shared_ptr<MapOp> map = std::dynamic_pointer_cast<MapOp>(node->child(0));
+  // the last TensorOp of the map has to be able to write its output into a given buffer
+  if (map == nullptr || map->TFuncs().empty() || !map->TFuncs().back()->CanComputeInto()) {
+    return Status::OK();
+  }
+  // a slab lives until its batch is consumed, keep enough freed buffers for the batches in flight
+  int32_t max_free = node->num_workers() + node->ConnectorCapacity();
+  auto pool = std::make_shared<BatchSlabPool>(node->start_batch_size(), max_free);
+  map->SetBatchSlabPool(pool);
+  node->SetBatchSlabPool(pool);
+  MS_LOG(INFO) << "Batch slab pass: " << map->NameWithID() << " writes into the batches of " << node->NameWithID();
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,49 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_POST_BATCH_SLAB_PASS_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_POST_BATCH_SLAB_PASS_H_
+
+#include <memory>
+#include "minddata/dataset/engine/opt/pass.h"
+
+namespace mindspore {
+namespace dataset {
+
+/// \class BatchSlabPass batch_slab_pass.h
+/// \brief This is a NodePass that lets a MapOp write its output rows straight into the batches of the BatchOp right
+///     above it. Both ops get the same BatchSlabPool: the last TensorOp of the map writes its output into the slot
+///     of the row in the slab of its batch through TensorOp::ComputeInto, and the batch op uses the slab as the
+///     batched tensor instead of copying the rows. Rows which missed their slot are copied as before.
+class BatchSlabPass : public NodePass {
+ public:
+  /// \brief Constructor
+  BatchSlabPass() = default;
+
+  /// \brief Destructor
+  ~BatchSlabPass() = default;
+
+  /// \brief Share a slab pool between the batch and the map below it, if the batch stacks the rows as they are and
+  ///     the last TensorOp of the map implements ComputeInto
+  /// \param[in] node The node being visited
+  /// \param[inout] modified Indicator if the node was changed at all
+  /// \return Status The status code returned
+  Status RunOnNode(std::shared_ptr<BatchOp> node, bool *const modified) override;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_POST_BATCH_SLAB_PASS_H_
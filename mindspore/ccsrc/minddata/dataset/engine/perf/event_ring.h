@@ -0,0 +1,121 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_EVENT_RING_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_EVENT_RING_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mindspore {
+namespace dataset {
+
+/// \brief One buffer handed from an op's output connector to a consumer worker.
+struct OpEvent {
+  int64_t timestamp_us;  // when the consumer got the buffer
+  int32_t wait_us;       // time the consumer worker was blocked waiting for the buffer
+  int32_t busy_us;       // time the consumer worker spent since it got its previous buffer
+  int32_t rows;          // rows in the buffer
+  int32_t queue_depth;   // buffers left in the connector after the pop
+};
+
+/// \class OpEventRing event_ring.h
+/// \brief Fixed size single producer / single consumer ring of OpEvent.
+///        The producer is the consumer worker of one connector, the consumer is the monitor thread.
+///        Recording never blocks and never allocates; when the ring is full the event is counted as dropped.
+class OpEventRing {
+ public:
+  /// \brief Constructor
+  /// \param[in] op_id id of the op whose output connector is traced
+  /// \param[in] consumer_id id of the op consuming that connector, -1 for the iterator
+  /// \param[in] worker_id id of the consumer worker owning this ring
+  /// \param[in] capacity number of events, rounded up to a power of two
+  OpEventRing(int32_t op_id, int32_t consumer_id, int32_t worker_id, uint32_t capacity)
+      : op_id_(op_id), consumer_id_(consumer_id), worker_id_(worker_id), last_end_us_(0) {
+    uint32_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    buf_.resize(size);
+    mask_ = size - 1;
+  }
+
+  ~OpEventRing() = default;
+
+  /// \brief Steady clock in microseconds, the time base of all events
+  static int64_t NowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+  }
+
+  /// \brief Record one pop. Only called by the worker owning this ring.
+  /// \param[in] wait_start_us time the worker started waiting
+  /// \param[in] wait_end_us time the worker got the buffer
+  /// \param[in] rows rows in the buffer
+  /// \param[in] queue_depth buffers left in the connector
+  void Record(int64_t wait_start_us, int64_t wait_end_us, int32_t rows, int32_t queue_depth) {
+    int64_t busy_us = last_end_us_ == 0 ? 0 : wait_start_us - last_end_us_;
+    last_end_us_ = wait_end_us;
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) > mask_) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    buf_[head & mask_] = {wait_end_us, static_cast<int32_t>(wait_end_us - wait_start_us),
+                          static_cast<int32_t>(busy_us), rows, queue_depth};
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  /// \brief Move all recorded events to out. Only called by the monitor thread.
+  /// \param[out] out events are appended here
+  /// \return number of events drained
+  size_t Drain(std::vector<OpEvent> *out) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    for (uint64_t i = tail; i < head; i++) {
+      out->push_back(buf_[i & mask_]);
+    }
+    tail_.store(head, std::memory_order_release);
+    return static_cast<size_t>(head - tail);
+  }
+
+  /// \brief Number of events dropped because the ring was full, reset on read
+  uint64_t TakeDropped() { return dropped_.exchange(0, std::memory_order_relaxed); }
+
+  int32_t op_id() const { return op_id_; }
+
+  int32_t consumer_id() const { return consumer_id_; }
+
+  int32_t worker_id() const { return worker_id_; }
+
+ private:
+  const int32_t op_id_;
+  const int32_t consumer_id_;
+  const int32_t worker_id_;
+  std::vector<OpEvent> buf_;
+  uint64_t mask_;
+  int64_t last_end_us_;  // touched by the producer only
+  // head_ and tail_ are on their own cache lines so the worker and the monitor do not share one
+  alignas(64) std::atomic<uint64_t> head_{0};
+  alignas(64) std::atomic<uint64_t> tail_{0};
+  std::atomic<uint64_t> dropped_{0};
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_EVENT_RING_H_
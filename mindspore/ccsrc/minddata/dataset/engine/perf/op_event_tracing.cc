@@ -0,0 +1,160 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/op_event_tracing.h"
+#include <sys/stat.h>
+#include <algorithm>
+#include "minddata/dataset/engine/execution_tree.h"
+#include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/path.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+template <typename T, typename F>
+void WriteColumn(std::ofstream *file, const std::vector<OpEvent> &events, std::vector<T> *column, F get) {
+  column->resize(events.size());
+  std::transform(events.begin(), events.end(), column->begin(), get);
+  file->write(reinterpret_cast<const char *>(column->data()), column->size() * sizeof(T));
+}
+
+int32_t HistogramBucket(int64_t ns) {
+  int32_t bucket = 0;
+  while (ns > 0 && bucket < kOpEventHistogramBuckets - 1) {
+    ns >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+}  // namespace
+
+Status OpEventTracing::Init(const std::string &dir_path, const std::string &device_id) {
+  file_path_ = (Path(dir_path) / Path("op_event_profiling_" + device_id + ".bin")).toString();
+  for (auto &node : *tree_) {
+    if (node.inlined()) {
+      continue;
+    }
+    DatasetOp *parent = nullptr;
+    node.Parent(&parent, 0);
+    int32_t consumer_id = parent == nullptr ? -1 : parent->id();
+    std::vector<std::shared_ptr<OpEventRing>> op_rings;
+    for (int32_t worker_id = 0; worker_id < node.num_consumers(); worker_id++) {
+      op_rings.push_back(std::make_shared<OpEventRing>(node.id(), consumer_id, worker_id, kOpEventRingSize));
+    }
+    rings_.insert(rings_.end(), op_rings.begin(), op_rings.end());
+    node.SetEventRings(std::move(op_rings));
+  }
+
+  file_.open(file_path_, std::ios::binary | std::ios::trunc);
+  if (!file_.is_open()) {
+    RETURN_STATUS_UNEXPECTED("Profiling file can not be opened: " + file_path_);
+  }
+  file_.write(reinterpret_cast<const char *>(&kOpEventFileMagic), sizeof(kOpEventFileMagic));
+  file_.write(reinterpret_cast<const char *>(&kOpEventFileVersion), sizeof(kOpEventFileVersion));
+  return Status::OK();
+}
+
+void OpEventTracing::WriteBlockHeader(uint32_t kind, uint32_t count) {
+  file_.write(reinterpret_cast<const char *>(&kind), sizeof(kind));
+  file_.write(reinterpret_cast<const char *>(&count), sizeof(count));
+}
+
+Status OpEventTracing::WriteEvents() {
+  events_.clear();
+  std::vector<int32_t> op_ids;
+  std::vector<int32_t> consumer_ids;
+  std::vector<int32_t> worker_ids;
+  uint64_t dropped = 0;
+  for (auto &ring : rings_) {
+    size_t drained = ring->Drain(&events_);
+    op_ids.insert(op_ids.end(), drained, ring->op_id());
+    consumer_ids.insert(consumer_ids.end(), drained, ring->consumer_id());
+    worker_ids.insert(worker_ids.end(), drained, ring->worker_id());
+    dropped += ring->TakeDropped();
+  }
+  if (dropped > 0) {
+    MS_LOG(WARNING) << "Profiling dropped " << dropped << " op events, sampling interval is too long.";
+    WriteBlockHeader(kOpEventBlockDropped, static_cast<uint32_t>(std::min<uint64_t>(dropped, UINT32_MAX)));
+  }
+  if (events_.empty()) {
+    return Status::OK();
+  }
+
+  for (size_t i = 0; i < events_.size(); i++) {
+    const OpEvent &event = events_[i];
+    if (event.rows > 0 && event.busy_us > 0) {
+      int64_t ns_per_row = static_cast<int64_t>(event.busy_us) * 1000 / event.rows;
+      histograms_[consumer_ids[i]][HistogramBucket(ns_per_row)] += event.rows;
+    }
+  }
+
+  WriteBlockHeader(kOpEventBlockEvents, static_cast<uint32_t>(events_.size()));
+  std::vector<int64_t> timestamps;
+  WriteColumn(&file_, events_, &timestamps, [](const OpEvent &e) { return e.timestamp_us; });
+  for (auto ids : {&op_ids, &consumer_ids, &worker_ids}) {
+    file_.write(reinterpret_cast<const char *>(ids->data()), ids->size() * sizeof(int32_t));
+  }
+  std::vector<int32_t> column;
+  WriteColumn(&file_, events_, &column, [](const OpEvent &e) { return e.wait_us; });
+  WriteColumn(&file_, events_, &column, [](const OpEvent &e) { return e.busy_us; });
+  WriteColumn(&file_, events_, &column, [](const OpEvent &e) { return e.rows; });
+  WriteColumn(&file_, events_, &column, [](const OpEvent &e) { return e.queue_depth; });
+  if (!file_.good()) {
+    RETURN_STATUS_UNEXPECTED("Failed to write profiling file: " + file_path_);
+  }
+  return Status::OK();
+}
+
+Status OpEventTracing::Sample() {
+  std::lock_guard<std::mutex> lock(mux_);
+  if (!file_.is_open()) {
+    return Status::OK();
+  }
+  return WriteEvents();
+}
+
+Status OpEventTracing::SaveToFile() {
+  std::lock_guard<std::mutex> lock(mux_);
+  if (!file_.is_open()) {
+    return Status::OK();
+  }
+  RETURN_IF_NOT_OK(WriteEvents());
+  // histograms are cumulative, readers keep the last block
+  WriteBlockHeader(kOpEventBlockHistogram, static_cast<uint32_t>(histograms_.size()));
+  for (const auto &histogram : histograms_) {
+    file_.write(reinterpret_cast<const char *>(&histogram.first), sizeof(histogram.first));
+    file_.write(reinterpret_cast<const char *>(&kOpEventHistogramBuckets), sizeof(kOpEventHistogramBuckets));
+    file_.write(reinterpret_cast<const char *>(histogram.second.data()), sizeof(Histogram));
+  }
+  file_.flush();
+  if (!file_.good()) {
+    RETURN_STATUS_UNEXPECTED("Failed to write profiling file: " + file_path_);
+  }
+  return Status::OK();
+}
+
+Status OpEventTracing::ChangeFileMode() {
+  if (file_path_.empty()) {
+    return Status::OK();
+  }
+  if (chmod(common::SafeCStr(file_path_), S_IRUSR | S_IWUSR) == -1) {
+    std::string err_str = "Change file mode failed," + file_path_;
+    return Status(StatusCode::kUnexpectedError, err_str);
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
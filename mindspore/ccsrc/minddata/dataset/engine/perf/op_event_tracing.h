@@ -0,0 +1,101 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_OP_EVENT_TRACING_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_OP_EVENT_TRACING_H_
+
+#include <array>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "minddata/dataset/engine/perf/event_ring.h"
+#include "minddata/dataset/engine/perf/profiling.h"
+
+namespace mindspore {
+namespace dataset {
+class ExecutionTree;
+
+constexpr uint32_t kOpEventFileMagic = 0x5645444D;  // "MDEV"
+constexpr uint32_t kOpEventFileVersion = 1;
+constexpr uint32_t kOpEventRingSize = 4096;
+constexpr int32_t kOpEventHistogramBuckets = 32;
+
+// Block kinds of the op event file
+enum OpEventBlock : uint32_t {
+  kOpEventBlockEvents = 1,     // count events, stored column by column
+  kOpEventBlockHistogram = 2,  // count ops, each one op id, bucket number and per bucket row counts
+  kOpEventBlockDropped = 3,    // count events dropped since the previous block of this kind
+};
+
+// OpEventTracing records every buffer popped from an op's output connector: how long the consumer worker waited for
+// it, how long the worker was busy since its previous buffer, the number of rows and the connector depth.
+// Workers write into their own lock free ring, so recording is two clock reads and a store. The monitor thread drains
+// the rings at every sampling interval and appends them to a binary file as column blocks, so memory is bounded no
+// matter how long the pipeline runs. Per op histograms of busy time per row are kept in memory and written when the
+// profiling data is saved. Use mindspore.profiler.parser.minddata_event_parser to read the file.
+//
+// File layout, all fields little endian:
+//   uint32 magic, uint32 version
+//   blocks of: uint32 kind, uint32 count, payload
+//   events payload: int64 timestamp_us[count], then int32 op_id, consumer_id, worker_id, wait_us, busy_us, rows,
+//   queue_depth, each [count]
+//   histogram payload per op: int32 op_id, int32 buckets, uint64 rows[buckets]; bucket i counts rows whose busy time
+//   per row in ns is in [2^(i-1), 2^i)
+//   dropped payload: none
+class OpEventTracing : public Sampling {
+ public:
+  explicit OpEventTracing(ExecutionTree *tree) : tree_(tree) {}
+
+  ~OpEventTracing() override = default;
+
+  // Create the rings of all ops in the tree and open the output file.
+  // Must be called before the ops are launched.
+  Status Init(const std::string &dir_path, const std::string &device_id) override;
+
+  // Drain the rings and append the events to the file
+  // @return Status The status code returned
+  Status Sample() override;
+
+  // Drain the rings, write the histograms and flush the file
+  // @return Status The status code returned
+  Status SaveToFile() override;
+
+  std::string Name() const override { return kOpEventTracingName; }
+
+  Status ChangeFileMode() override;
+
+ private:
+  using Histogram = std::array<uint64_t, kOpEventHistogramBuckets>;
+
+  // Drain all rings into a block. Caller holds mux_.
+  Status WriteEvents();
+
+  // Append a block header
+  void WriteBlockHeader(uint32_t kind, uint32_t count);
+
+  ExecutionTree *tree_;
+  std::vector<std::shared_ptr<OpEventRing>> rings_;
+  std::map<int32_t, Histogram> histograms_;  // keyed by consumer op id
+  std::vector<OpEvent> events_;              // drain buffer, reused
+  std::ofstream file_;
+  std::mutex mux_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_OP_EVENT_TRACING_H_
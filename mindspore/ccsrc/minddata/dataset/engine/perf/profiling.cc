@@ -25,6 +25,7 @@
 #include "minddata/dataset/engine/perf/connector_size.h"
 #include "minddata/dataset/engine/perf/connector_throughput.h"
 #include "minddata/dataset/engine/perf/dataset_iterator_tracing.h"
+#include "minddata/dataset/engine/perf/op_event_tracing.h"
 #include "minddata/dataset/util/log_adapter.h"
 
 namespace mindspore {
@@ -79,6 +80,10 @@ Status ProfilingManager::Initialize() {
   std::shared_ptr<Sampling> connector_thr_sampling = std::make_shared<ConnectorThroughput>(tree_);
   RETURN_IF_NOT_OK(RegisterSamplingNode(connector_thr_sampling));
 
+  // op_event node is drained by the monitor at every sampling interval
+  std::shared_ptr<Sampling> op_event_tracing = std::make_shared<OpEventTracing>(tree_);
+  RETURN_IF_NOT_OK(RegisterSamplingNode(op_event_tracing));
+
   return Status::OK();
 }
 
@@ -0,0 +1,194 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/normalize_hwc_to_chw_op.h"
+
+#include <cstdint>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int64_t kNumChannels = 3;
+constexpr int32_t kLutSize = 256;
+
+// Map one uint8 HWC image to CHW through the per channel lookup tables
+template <typename Out>
+void LookupToChw(const uint8_t *in, int64_t plane, const Out *lut, Out *out) {
+  const Out *lut_r = lut;
+  const Out *lut_g = lut + kLutSize;
+  const Out *lut_b = lut + 2 * kLutSize;
+  Out *out_r = out;
+  Out *out_g = out + plane;
+  Out *out_b = out + 2 * plane;
+  for (int64_t i = 0; i < plane; i++) {
+    out_r[i] = lut_r[in[kNumChannels * i]];
+    out_g[i] = lut_g[in[kNumChannels * i + 1]];
+    out_b[i] = lut_b[in[kNumChannels * i + 2]];
+  }
+}
+
+// Scale one HWC image to CHW, the loop has no branches so the compiler vectorizes it
+template <typename In, typename Out>
+void ScaleToChw(const In *in, int64_t plane, const float *scale, const float *shift, Out *out) {
+  Out *out_r = out;
+  Out *out_g = out + plane;
+  Out *out_b = out + 2 * plane;
+  for (int64_t i = 0; i < plane; i++) {
+    out_r[i] = static_cast<Out>(static_cast<float>(in[kNumChannels * i]) * scale[0] + shift[0]);
+    out_g[i] = static_cast<Out>(static_cast<float>(in[kNumChannels * i + 1]) * scale[1] + shift[1]);
+    out_b[i] = static_cast<Out>(static_cast<float>(in[kNumChannels * i + 2]) * scale[2] + shift[2]);
+  }
+}
+
+template <typename In, typename Out>
+void ScaleImagesToChw(const std::shared_ptr<Tensor> &input, int64_t num_images, int64_t plane, const float *scale,
+                      const float *shift, Out *out) {
+  const In *in = reinterpret_cast<const In *>(input->GetBuffer());
+  for (int64_t n = 0; n < num_images; n++) {
+    ScaleToChw(in + n * plane * kNumChannels, plane, scale, shift, out + n * plane * kNumChannels);
+  }
+}
+}  // namespace
+
+NormalizeHwcToChwOp::NormalizeHwcToChwOp(const std::vector<float> &mean, const std::vector<float> &std,
+                                         float rescale, float shift, const DataType &output_type)
+    : output_type_(output_type) {
+  // (in * rescale + shift - mean) / std
+  for (size_t c = 0; c < mean.size() && c < std.size(); c++) {
+    scale_.push_back(rescale / std[c]);
+    shift_.push_back((shift - mean[c]) / std[c]);
+  }
+  if (scale_.size() != kNumChannels) {
+    return;
+  }
+  for (int64_t c = 0; c < kNumChannels; c++) {
+    for (int32_t v = 0; v < kLutSize; v++) {
+      lut_.push_back(static_cast<float>(v) * scale_[c] + shift_[c]);
+    }
+  }
+  if (output_type_ == DataType::DE_FLOAT16) {
+    for (float v : lut_) {
+      lut_fp16_.push_back(static_cast<float16>(v));
+    }
+  }
+}
+
+template <typename Out>
+Status NormalizeHwcToChwOp::Run(const std::shared_ptr<Tensor> &input, const std::vector<Out> &lut,
+                                const std::shared_ptr<MemoryPool> &output_pool, std::shared_ptr<Tensor> *output) {
+  const TensorShape &shape = input->shape();
+  int64_t num_images = shape.Rank() == 4 ? shape[0] : 1;
+  int64_t plane = shape[-3] * shape[-2];
+  TensorShape out_shape({kNumChannels, shape[-3], shape[-2]});
+  if (shape.Rank() == 4) {
+    out_shape = out_shape.PrependDim(num_images);
+  }
+  if (output_pool != nullptr) {
+    RETURN_IF_NOT_OK(Tensor::CreateEmpty(out_shape, output_type_, output_pool, output));
+  } else {
+    RETURN_IF_NOT_OK(Tensor::CreateEmpty(out_shape, output_type_, output));
+  }
+  if (plane == 0 || num_images == 0) {
+    return Status::OK();
+  }
+  Out *out = &(*(*output)->begin<Out>());
+  switch (input->type().value()) {
+    case DataType::DE_UINT8: {
+      const uint8_t *in = input->GetBuffer();
+      for (int64_t n = 0; n < num_images; n++) {
+        LookupToChw(in + n * plane * kNumChannels, plane, lut.data(), out + n * plane * kNumChannels);
+      }
+      break;
+    }
+    case DataType::DE_INT8:
+      ScaleImagesToChw<int8_t>(input, num_images, plane, scale_.data(), shift_.data(), out);
+      break;
+    case DataType::DE_UINT16:
+      ScaleImagesToChw<uint16_t>(input, num_images, plane, scale_.data(), shift_.data(), out);
+      break;
+    case DataType::DE_INT16:
+      ScaleImagesToChw<int16_t>(input, num_images, plane, scale_.data(), shift_.data(), out);
+      break;
+    case DataType::DE_INT32:
+      ScaleImagesToChw<int32_t>(input, num_images, plane, scale_.data(), shift_.data(), out);
+      break;
+    case DataType::DE_FLOAT32:
+      ScaleImagesToChw<float>(input, num_images, plane, scale_.data(), shift_.data(), out);
+      break;
+    case DataType::DE_FLOAT64:
+      ScaleImagesToChw<double>(input, num_images, plane, scale_.data(), shift_.data(), out);
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("NormalizeHwcToChw: unsupported input type " + input->type().ToString());
+  }
+  return Status::OK();
+}
+
+Status NormalizeHwcToChwOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  return ComputeInto(input, nullptr, output);
+}
+
+Status NormalizeHwcToChwOp::ComputeInto(const std::shared_ptr<Tensor> &input,
+                                        const std::shared_ptr<MemoryPool> &output_pool,
+                                        std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  CHECK_FAIL_RETURN_UNEXPECTED(scale_.size() == kNumChannels, "NormalizeHwcToChw: mean and std should be of size 3.");
+  const TensorShape &shape = input->shape();
+  if ((shape.Rank() != 3 && shape.Rank() != 4) || shape[-1] != kNumChannels) {
+    RETURN_STATUS_UNEXPECTED("NormalizeHwcToChw: input should be <H,W,C> or <N,H,W,C> with 3 channels, got " +
+                             shape.ToString());
+  }
+  if (output_type_ == DataType::DE_FLOAT16) {
+    return Run(input, lut_fp16_, output_pool, output);
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(output_type_ == DataType::DE_FLOAT32,
+                               "NormalizeHwcToChw: output type should be float32 or float16.");
+  return Run(input, lut_, output_pool, output);
+}
+
+Status NormalizeHwcToChwOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  outputs.clear();
+  TensorShape in = inputs[0];
+  if (in.Rank() == 3) {
+    outputs.emplace_back(TensorShape{in[2], in[0], in[1]});
+  } else if (in.Rank() == 4) {
+    outputs.emplace_back(TensorShape{in[0], in[3], in[1], in[2]});
+  }
+  if (!outputs.empty()) return Status::OK();
+  return Status(StatusCode::kUnexpectedError, "Input has a wrong shape");
+}
+
+Status NormalizeHwcToChwOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = output_type_;
+  return Status::OK();
+}
+
+void NormalizeHwcToChwOp::Print(std::ostream &out) const {
+  out << Name() << ", output type: " << output_type_ << ", scale:";
+  for (float s : scale_) {
+    out << " " << s;
+  }
+  out << ", shift:";
+  for (float s : shift_) {
+    out << " " << s;
+  }
+  out << std::endl;
+}
+}  // namespace dataset
+}  // namespace mindspore
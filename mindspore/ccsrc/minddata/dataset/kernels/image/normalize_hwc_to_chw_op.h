@@ -0,0 +1,74 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_NORMALIZE_HWC_TO_CHW_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_NORMALIZE_HWC_TO_CHW_OP_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Rescale, Normalize, HwcToChw and a TypeCast to float in one pass over the image, without OpenCV.
+// Works on an image <H,W,C> or on a whole batch <N,H,W,C> and writes <C,H,W> or <N,C,H,W> of float32 or float16.
+// uint8 images are mapped through a per channel lookup table. TensorOpFusionPass replaces the unfused ops with it.
+class NormalizeHwcToChwOp : public TensorOp {
+ public:
+  // @param mean - mean of every channel, after rescaling
+  // @param std - standard deviation of every channel, after rescaling
+  // @param rescale - rescale factor applied before normalizing
+  // @param shift - shift applied before normalizing
+  // @param output_type - DE_FLOAT32 or DE_FLOAT16
+  NormalizeHwcToChwOp(const std::vector<float> &mean, const std::vector<float> &std, float rescale = 1.0,
+                      float shift = 0.0, const DataType &output_type = DataType(DataType::DE_FLOAT32));
+
+  ~NormalizeHwcToChwOp() override = default;
+
+  void Print(std::ostream &out) const override;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  bool CanComputeInto() const override { return true; }
+
+  Status ComputeInto(const std::shared_ptr<Tensor> &input, const std::shared_ptr<MemoryPool> &output_pool,
+                     std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  std::string Name() const override { return kNormalizeHwcToChwOp; }
+
+ private:
+  // The output is allocated from output_pool, or from the global pool if it is nullptr
+  template <typename Out>
+  Status Run(const std::shared_ptr<Tensor> &input, const std::vector<Out> &lut,
+             const std::shared_ptr<MemoryPool> &output_pool, std::shared_ptr<Tensor> *output);
+
+  std::vector<float> scale_;  // out = in * scale_[c] + shift_[c]
+  std::vector<float> shift_;
+  DataType output_type_;
+  std::vector<float> lut_;         // 256 entries per channel, for uint8 input
+  std::vector<float16> lut_fp16_;  // same in float16
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_NORMALIZE_HWC_TO_CHW_OP_H_
@@ -37,6 +37,10 @@ class NormalizeOp : public TensorOp {
 
   std::string Name() const override { return kNormalizeOp; }
 
+  std::shared_ptr<Tensor> mean() const { return mean_; }
+
+  std::shared_ptr<Tensor> std() const { return std_; }
+
  private:
   std::shared_ptr<Tensor> mean_;
   std::shared_ptr<Tensor> std_;
@@ -34,6 +34,11 @@ Status TensorOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
   }
 }
 
+Status TensorOp::ComputeInto(const std::shared_ptr<Tensor> &input, const std::shared_ptr<MemoryPool> &output_pool,
+                             std::shared_ptr<Tensor> *output) {
+  return Status(StatusCode::kUnexpectedError, Name() + " can not write its output into a given buffer.");
+}
+
 // Name: Compute()
 // Description: This Compute() take multiple Tensors from different columns and produce multiple Tensors too.
 //              The derived class should override this function otherwise error.
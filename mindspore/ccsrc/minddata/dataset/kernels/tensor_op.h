@@ -23,6 +23,7 @@
 
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/util/memory_pool.h"
 #include "minddata/dataset/util/status.h"
 
 #define IO_CHECK(input, output)                             \
@@ -64,6 +65,7 @@ constexpr char kHwcToChwOp[] = "HwcToChwOp";
 constexpr char kInvertOp[] = "InvertOp";
 constexpr char kMixUpBatchOp[] = "MixUpBatchOp";
 constexpr char kNormalizeOp[] = "NormalizeOp";
+constexpr char kNormalizeHwcToChwOp[] = "NormalizeHwcToChwOp";
 constexpr char kNormalizePadOp[] = "NormalizePadOp";
 constexpr char kPadOp[] = "PadOp";
 constexpr char kRandomColorAdjustOp[] = "RandomColorAdjustOp";
@@ -168,6 +170,19 @@ class TensorOp {
   // @return Status
   virtual Status Compute(const TensorRow &input, TensorRow *output);
 
+  // Whether the 1-1 TensorOp implements ComputeInto
+  // @return true/false
+  virtual bool CanComputeInto() const { return false; }
+
+  // Perform a 1-1 operation writing the output into memory given by the caller, e.g. the slot of the row in a batch.
+  // The output gets the shape and type given by OutputShape and OutputType.
+  // @param input the input tensor
+  // @param output_pool memory pool the buffer of the output is allocated from, only the output tensor uses it
+  // @param output the address to a shared_ptr where the result will be placed
+  // @return Status
+  virtual Status ComputeInto(const std::shared_ptr<Tensor> &input, const std::shared_ptr<MemoryPool> &output_pool,
+                             std::shared_ptr<Tensor> *output);
+
   // Returns true oif the TensorOp takes one input and returns one output.
   // @return true/false
   bool OneToOne() { return NumInput() == 1 && NumOutput() == 1; }
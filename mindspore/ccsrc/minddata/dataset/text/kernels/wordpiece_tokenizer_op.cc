@@ -16,6 +16,7 @@
 
 #include "minddata/dataset/text/kernels/wordpiece_tokenizer_op.h"
 #include <algorithm>
+#include <iterator>
 #include <utility>
 
 namespace mindspore {
@@ -35,26 +36,27 @@ WordpieceTokenizerOp::WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab,
       unknown_token_(unknown_token),
       with_offsets_(with_offsets) {}
 
-Status WordpieceTokenizerOp::LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start,
+Status WordpieceTokenizerOp::LookupWord(const VocabTrie &trie, const std::string_view &input_token, const int start,
                                         bool *out_found, int *out_end) const {
   CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && start < input_token.size(), "Out of range");
   *out_found = false;
-  for (int i = runes.size() - 1; i >= 0; i--) {
-    *out_end = runes[i].offset + runes[i].len;
-    int len = *out_end - start;
-    std::string word = input_token.substr(start, len);
-    if (start > 0) {
-      word = suffix_indicator_ + word;
-    }
-    if (vocab_->Lookup(word) != Vocab::kNoTokenExists) {
+  VocabTrie::TrieNodeIdType node = VocabTrie::kRootNode;
+  if (start > 0) {
+    node = trie.Walk(node, suffix_indicator_);
+  }
+  for (int i = start; i < input_token.size() && node != VocabTrie::kNoNode;) {
+    node = trie.Child(node, static_cast<uint8_t>(input_token[i++]));
+    // a byte of the form 10xxxxxx continues the current utf8 character
+    bool at_boundary = i == input_token.size() || (static_cast<uint8_t>(input_token[i]) & 0xC0) != 0x80;
+    if (node != VocabTrie::kNoNode && at_boundary && trie.Value(node) != Vocab::kNoTokenExists) {
       *out_found = true;
-      break;
+      *out_end = i;
     }
   }
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::FoundNoToken(const std::string &input_token, const uint32_t &basic_start,
+Status WordpieceTokenizerOp::FoundNoToken(const std::string_view &input_token, const uint32_t &basic_start,
                                           std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
                                           std::vector<uint32_t> *offsets_limit) const {
   out_tokens->clear();
@@ -69,19 +71,22 @@ Status WordpieceTokenizerOp::FoundNoToken(const std::string &input_token, const
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::AddSubword(const std::string &input_token, const int &start, const int &end,
+Status WordpieceTokenizerOp::AddSubword(const std::string_view &input_token, const int &start, const int &end,
                                         std::vector<std::string> *out_tokens) const {
   CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && end > start && end <= input_token.size(), "Out of range");
-  std::string subword = input_token.substr(start, end - start);
+  std::string subword;
   if (start > 0) {
-    subword = suffix_indicator_ + subword;
+    subword.reserve(suffix_indicator_.size() + end - start);
+    subword.append(suffix_indicator_);
   }
-  out_tokens->emplace_back(subword);
+  subword.append(input_token.substr(start, end - start));
+  out_tokens->emplace_back(std::move(subword));
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uint32_t &basic_start,
-                                       std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
+Status WordpieceTokenizerOp::GetTokens(const VocabTrie &trie, const std::string_view &input_token,
+                                       const uint32_t &basic_start, std::vector<std::string> *out_tokens,
+                                       std::vector<uint32_t> *offsets_start,
                                        std::vector<uint32_t> *offsets_limit) const {
   if (input_token.size() > max_bytes_per_token_) {
     offsets_start->push_back(basic_start);
@@ -94,14 +99,18 @@ Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uin
     }
     return Status::OK();
   }
-  RuneStrArray runes;
-  if (!DecodeRunesInString(input_token.data(), input_token.size(), runes)) {
-    RETURN_STATUS_UNEXPECTED("Decode utf8 string failed.");
+  // the trie walks bytes, so check the token decodes as utf8 without building its runes
+  for (size_t i = 0; i < input_token.size();) {
+    auto rune = DecodeRuneInString(input_token.data() + i, input_token.size() - i);
+    if (rune.len == 0) {
+      RETURN_STATUS_UNEXPECTED("Decode utf8 string failed.");
+    }
+    i += rune.len;
   }
   int end = 0;
   for (int start = 0; start < input_token.size();) {
     bool found = false;
-    RETURN_IF_NOT_OK(LookupWord(input_token, runes, start, &found, &end));
+    RETURN_IF_NOT_OK(LookupWord(trie, input_token, start, &found, &end));
     if (found) {
       RETURN_IF_NOT_OK(AddSubword(input_token, start, end, out_tokens));
       offsets_start->push_back(static_cast<uint32_t>(basic_start + start));
@@ -116,9 +125,11 @@ Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uin
 
 Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
   IO_CHECK_VECTOR(input, output);
+  RETURN_UNEXPECTED_IF_NULL(vocab_);
   if (input[0]->Rank() > 1 || input[0]->type() != DataType::DE_STRING) {
     RETURN_STATUS_UNEXPECTED("The input tensor should be scalar or 1-D string tensor.");
   }
+  std::shared_ptr<const VocabTrie> trie = vocab_->GetTrie();
   dsize_t count = 0;
   std::vector<std::string> out_tokens;
   std::vector<uint32_t> offsets_start, offsets_limit;
@@ -129,8 +140,9 @@ Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output)
     if (with_offsets_ && input.size() == 3) {
       RETURN_IF_NOT_OK(input[1]->GetItemAt<uint32_t>(&basic_start, {count, 0}));
     }
-    RETURN_IF_NOT_OK(GetTokens(std::string(*iter), basic_start, &temp_tokens, &offsets_start, &offsets_limit));
-    out_tokens.insert(out_tokens.end(), temp_tokens.begin(), temp_tokens.end());
+    RETURN_IF_NOT_OK(GetTokens(*trie, *iter, basic_start, &temp_tokens, &offsets_start, &offsets_limit));
+    out_tokens.insert(out_tokens.end(), std::make_move_iterator(temp_tokens.begin()),
+                      std::make_move_iterator(temp_tokens.end()));
     count++;
   }
   if (out_tokens.empty()) {
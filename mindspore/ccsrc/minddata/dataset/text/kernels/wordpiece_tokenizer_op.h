@@ -27,8 +27,7 @@
 #include "minddata/dataset/text/vocab.h"
 #include "minddata/dataset/util/status.h"
 
-using cppjieba::DecodeRunesInString;
-using cppjieba::RuneStrArray;
+using cppjieba::DecodeRuneInString;
 namespace mindspore {
 namespace dataset {
 
@@ -47,14 +46,18 @@ class WordpieceTokenizerOp : public TensorOp {
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
  protected:
-  Status AddSubword(const std::string &input_token, const int &start, const int &end,
+  Status AddSubword(const std::string_view &input_token, const int &start, const int &end,
                     std::vector<std::string> *out_token) const;
-  Status FoundNoToken(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
-                      std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
-  Status LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start, bool *out_found,
+  Status FoundNoToken(const std::string_view &input_token, const uint32_t &basic_start,
+                      std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
+                      std::vector<uint32_t> *offsets_limit) const;
+  // Greedy longest match of a (suffix) subword starting at start, walking the vocab trie over the input bytes once.
+  // Only matches ending on a utf8 character boundary are accepted.
+  Status LookupWord(const VocabTrie &trie, const std::string_view &input_token, const int start, bool *out_found,
                     int *out_end) const;
-  Status GetTokens(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
-                   std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
+  Status GetTokens(const VocabTrie &trie, const std::string_view &input_token, const uint32_t &basic_start,
+                   std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
+                   std::vector<uint32_t> *offsets_limit) const;
 
   std::string Name() const override { return kWordpieceTokenizerOp; }
 
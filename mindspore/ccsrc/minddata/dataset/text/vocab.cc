@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include <fstream>
+#include <queue>
+#include <tuple>
 #include <unordered_set>
 #include <unordered_map>
 #include <utility>
@@ -28,6 +30,68 @@
 
 namespace mindspore {
 namespace dataset {
+const VocabTrie::TrieNodeIdType VocabTrie::kRootNode = 0;
+const VocabTrie::TrieNodeIdType VocabTrie::kNoNode = -1;
+
+VocabTrie::VocabTrie(const std::unordered_map<WordType, WordIdType> &word2id) {
+  std::vector<std::pair<std::string_view, WordIdType>> words;
+  words.reserve(word2id.size());
+  for (const auto &p : word2id) {
+    words.emplace_back(p.first, p.second);
+  }
+  // std::string_view compares bytes as unsigned char, so words sharing a prefix end up adjacent and their next bytes
+  // are in ascending order, which is the order edges are stored in
+  std::sort(words.begin(), words.end());
+
+  // nodes are numbered in BFS order so that the edges of node i always follow the edges of node i - 1
+  // each entry is (first word, last word + 1, depth) of the words sharing the prefix of this node
+  std::queue<std::tuple<size_t, size_t, size_t>> pending;
+  pending.emplace(0, words.size(), 0);
+  edge_offsets_.push_back(0);
+  while (!pending.empty()) {
+    size_t lo, hi, depth;
+    std::tie(lo, hi, depth) = pending.front();
+    pending.pop();
+    WordIdType value = Vocab::kNoTokenExists;
+    if (lo < hi && words[lo].first.size() == depth) {
+      value = words[lo].second;
+      lo++;
+    }
+    values_.push_back(value);
+    while (lo < hi) {
+      uint8_t label = static_cast<uint8_t>(words[lo].first[depth]);
+      size_t end = lo + 1;
+      while (end < hi && static_cast<uint8_t>(words[end].first[depth]) == label) {
+        end++;
+      }
+      edge_labels_.push_back(label);
+      edge_targets_.push_back(static_cast<TrieNodeIdType>(values_.size() + pending.size()));
+      pending.emplace(lo, end, depth + 1);
+      lo = end;
+    }
+    edge_offsets_.push_back(static_cast<uint32_t>(edge_labels_.size()));
+  }
+}
+
+VocabTrie::TrieNodeIdType VocabTrie::Child(TrieNodeIdType node, uint8_t label) const {
+  auto begin = edge_labels_.begin() + edge_offsets_[node];
+  auto end = edge_labels_.begin() + edge_offsets_[node + 1];
+  auto itr = std::lower_bound(begin, end, label);
+  return (itr == end || *itr != label) ? kNoNode : edge_targets_[itr - edge_labels_.begin()];
+}
+
+VocabTrie::TrieNodeIdType VocabTrie::Walk(TrieNodeIdType node, const std::string_view &str) const {
+  for (size_t i = 0; i < str.size() && node != kNoNode; i++) {
+    node = Child(node, static_cast<uint8_t>(str[i]));
+  }
+  return node;
+}
+
+WordIdType VocabTrie::Lookup(const std::string_view &word) const {
+  TrieNodeIdType node = Walk(kRootNode, word);
+  return node == kNoNode ? Vocab::kNoTokenExists : values_[node];
+}
+
 Vocab::Vocab(std::unordered_map<WordType, WordIdType> word2id) { word2id_ = std::move(word2id); }
 
 WordIdType Vocab::Lookup(const WordType &word) const {
@@ -35,6 +99,14 @@ WordIdType Vocab::Lookup(const WordType &word) const {
   return itr == word2id_.end() ? kNoTokenExists : itr->second;
 }
 
+std::shared_ptr<const VocabTrie> Vocab::GetTrie() const {
+  std::lock_guard<std::mutex> lock(trie_mutex_);
+  if (trie_ == nullptr) {
+    trie_ = std::make_shared<const VocabTrie>(word2id_);
+  }
+  return trie_;
+}
+
 #ifdef ENABLE_PYTHON
 Status Vocab::BuildFromPyList(const py::list &words, const py::list &special_tokens, bool prepend_special,
                               std::shared_ptr<Vocab> *vocab) {
@@ -71,6 +143,8 @@ Status Vocab::BuildFromPyDict(const py::dict &words, std::shared_ptr<Vocab> *voc
 void Vocab::append_word(const std::string &word) {
   if (word2id_.find(word) == word2id_.end()) {
     word2id_[word] = word2id_.size();
+    std::lock_guard<std::mutex> lock(trie_mutex_);
+    trie_ = nullptr;
   }
 }
 
@@ -18,7 +18,9 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VOCAB_H_
 
 #include <string>
+#include <string_view>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -37,6 +39,53 @@ namespace py = pybind11;
 using WordIdType = int32_t;
 using WordType = std::string;
 
+// A read-only byte-level trie over the words of a Vocab. Children of each node are stored contiguously and sorted by
+// label (CSR layout), so matching walks the input once without building any intermediate std::string.
+class VocabTrie {
+ public:
+  using TrieNodeIdType = int32_t;
+
+  static const TrieNodeIdType kRootNode;
+  static const TrieNodeIdType kNoNode;
+
+  /// \brief Build a trie from a word2id map.
+  /// \param[in] word2id Map of word and word id pair.
+  explicit VocabTrie(const std::unordered_map<WordType, WordIdType> &word2id);
+
+  ~VocabTrie() = default;
+
+  /// \brief Follow the edge labeled with one byte.
+  /// \param[in] node Node to start from.
+  /// \param[in] label Byte on the edge.
+  /// \return The child node, or kNoNode if there is no such edge.
+  TrieNodeIdType Child(TrieNodeIdType node, uint8_t label) const;
+
+  /// \brief Follow the edges labeled with every byte of a string.
+  /// \param[in] node Node to start from.
+  /// \param[in] str Bytes to follow.
+  /// \return The node reached, or kNoNode if the path leaves the trie.
+  TrieNodeIdType Walk(TrieNodeIdType node, const std::string_view &str) const;
+
+  /// \brief Get the id of the word ending at a node.
+  /// \param[in] node A valid node of this trie.
+  /// \return The word id, or Vocab::kNoTokenExists if no word ends at this node.
+  WordIdType Value(TrieNodeIdType node) const { return values_[node]; }
+
+  /// \brief Lookup the id of a word without copying it.
+  /// \param[in] word Word to look up.
+  /// \return The word id, or Vocab::kNoTokenExists if the word is not in the trie.
+  WordIdType Lookup(const std::string_view &word) const;
+
+  /// \return Number of nodes in the trie.
+  size_t NodeCount() const { return values_.size(); }
+
+ private:
+  std::vector<WordIdType> values_;        // word id ending at each node
+  std::vector<uint32_t> edge_offsets_;    // edges of node i are [edge_offsets_[i], edge_offsets_[i + 1])
+  std::vector<uint8_t> edge_labels_;      // sorted per node
+  std::vector<TrieNodeIdType> edge_targets_;
+};
+
 class Vocab {
  public:
 #ifdef ENABLE_PYTHON
@@ -97,6 +146,10 @@ class Vocab {
   // @return WordIdType, word_id
   WordIdType Lookup(const WordType &word) const;
 
+  /// \brief Get the trie view of this vocab, it is built on first use and shared by all ops holding this vocab.
+  /// \return A read-only trie, which stays valid even if the vocab is appended to afterwards.
+  std::shared_ptr<const VocabTrie> GetTrie() const;
+
   // constructor, shouldn't be called directly, can't be private due to std::make_unique()
   // @param std::unordered_map<WordType, WordIdType> map - sanitized word2id map
   explicit Vocab(std::unordered_map<WordType, WordIdType> map);
@@ -117,6 +170,8 @@ class Vocab {
 
  private:
   std::unordered_map<WordType, WordIdType> word2id_;
+  mutable std::mutex trie_mutex_;
+  mutable std::shared_ptr<const VocabTrie> trie_;
 };
 
 }  // namespace dataset
@@ -0,0 +1,174 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/util/numa_placement.h"
+#if defined(__linux__) && !defined(ENABLE_ANDROID)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include "minddata/dataset/util/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr char kSysNodePath[] = "/sys/devices/system/node";
+
+Status ReadLine(const std::string &file, std::string *line) {
+  std::ifstream fs(file);
+  CHECK_FAIL_RETURN_UNEXPECTED(!fs.fail(), "Fail to open file: " + file);
+  (void)std::getline(fs, *line);
+  CHECK_FAIL_RETURN_UNEXPECTED(!fs.bad(), "Fail to read file: " + file);
+  return Status::OK();
+}
+}  // namespace
+
+Status NumaPlacement::ParseCpuList(const std::string &cpu_list, std::vector<int32_t> *cpus) {
+  RETURN_UNEXPECTED_IF_NULL(cpus);
+  cpus->clear();
+  std::stringstream ss(cpu_list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    if (range.empty() || range == "\n") {
+      continue;
+    }
+    char *end = nullptr;
+    int64_t first = strtol(range.c_str(), &end, 10);
+    int64_t last = first;
+    if (*end == '-') {
+      last = strtol(end + 1, &end, 10);
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED((*end == '\0' || *end == '\n') && end != range.c_str() && first >= 0 && first <= last,
+                                 "Invalid cpu list: " + cpu_list);
+    for (int64_t cpu = first; cpu <= last; ++cpu) {
+      cpus->push_back(static_cast<int32_t>(cpu));
+    }
+  }
+  std::sort(cpus->begin(), cpus->end());
+  cpus->erase(std::unique(cpus->begin(), cpus->end()), cpus->end());
+  return Status::OK();
+}
+
+Status NumaPlacement::ReadNodeCpus(std::vector<std::vector<int32_t>> *node_cpus) {
+  RETURN_UNEXPECTED_IF_NULL(node_cpus);
+  std::string line;
+  RETURN_IF_NOT_OK(ReadLine(std::string(kSysNodePath) + "/online", &line));
+  std::vector<int32_t> nodes;
+  RETURN_IF_NOT_OK(ParseCpuList(line, &nodes));
+  CHECK_FAIL_RETURN_UNEXPECTED(!nodes.empty(), "No online numa node found.");
+  node_cpus->assign(nodes.back() + 1, {});
+  for (auto node : nodes) {
+    RETURN_IF_NOT_OK(ReadLine(std::string(kSysNodePath) + "/node" + std::to_string(node) + "/cpulist", &line));
+    RETURN_IF_NOT_OK(ParseCpuList(line, &(*node_cpus)[node]));
+  }
+#if defined(__linux__) && !defined(ENABLE_ANDROID)
+  // Only keep the cpus the process may run on, e.g. when it is started by taskset or in a cpuset cgroup
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+    for (auto &cpus : *node_cpus) {
+      (void)cpus.erase(std::remove_if(cpus.begin(), cpus.end(), [&allowed](int32_t cpu) {
+                         return cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &allowed);
+                       }),
+                       cpus.end());
+    }
+  }
+#endif
+  return Status::OK();
+}
+
+Status NumaPlacement::Init(const std::vector<std::vector<int32_t>> &node_cpus, int32_t rank_id,
+                           int32_t tenants_per_node, bool spread) {
+  CHECK_FAIL_RETURN_UNEXPECTED(tenants_per_node > 0,
+                               "tenants_per_node should be positive, got: " + std::to_string(tenants_per_node));
+  nodes_.clear();
+  slices_.clear();
+  next_worker_ = 0;
+  for (size_t node = 0; node < node_cpus.size(); ++node) {
+    if (!node_cpus[node].empty()) {
+      nodes_.push_back(static_cast<int32_t>(node));
+    }
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(!nodes_.empty(), "No numa node with a cpu found.");
+  int32_t num_nodes = static_cast<int32_t>(nodes_.size());
+  int32_t rank = std::max(rank_id, 0);
+  home_index_ = rank % num_nodes;
+  home_node_ = nodes_[home_index_];
+  spread_ = spread;
+
+  // Ranks rank % num_nodes, rank % num_nodes + num_nodes, ... share a home node, each one takes its own chunk
+  int32_t tenant = (rank / num_nodes) % tenants_per_node;
+  for (auto node : nodes_) {
+    const std::vector<int32_t> &cpus = node_cpus[node];
+    int32_t num_cpus = static_cast<int32_t>(cpus.size());
+    if (tenants_per_node > num_cpus) {
+      // More tenants than cores, they have to share them
+      slices_.push_back({cpus[tenant % num_cpus]});
+      continue;
+    }
+    int32_t chunk = num_cpus / tenants_per_node;
+    int32_t begin = tenant * chunk;
+    // The last tenant also gets the remainder
+    int32_t end = tenant == tenants_per_node - 1 ? num_cpus : begin + chunk;
+    slices_.emplace_back(cpus.begin() + begin, cpus.begin() + end);
+  }
+  MS_LOG(INFO) << "Numa placement of rank " << rank_id << ": home node " << home_node_ << ", " << num_nodes
+               << " node(s), " << slices_[home_index_].size() << " cpu(s) on the home node, spread: " << std::boolalpha
+               << spread_;
+  return Status::OK();
+}
+
+int32_t NumaPlacement::CpuOfWorker(int32_t worker_id, bool near_consumer) const {
+  int32_t num_nodes = static_cast<int32_t>(slices_.size());
+  if (spread_ && !near_consumer) {
+    // Round robin over the nodes starting at home, then over the cpus of each node
+    const std::vector<int32_t> &slice = slices_[(home_index_ + worker_id) % num_nodes];
+    return slice[(worker_id / num_nodes) % slice.size()];
+  }
+  const std::vector<int32_t> &slice = slices_[home_index_];
+  return slice[worker_id % slice.size()];
+}
+
+Status NumaPlacement::PinWorker(int32_t worker_id, bool near_consumer) const {
+  CHECK_FAIL_RETURN_UNEXPECTED(!slices_.empty(), "Numa placement is not initialized.");
+  return SetAffinity({CpuOfWorker(worker_id, near_consumer)});
+}
+
+Status NumaPlacement::PinHome() const {
+  CHECK_FAIL_RETURN_UNEXPECTED(!slices_.empty(), "Numa placement is not initialized.");
+  return SetAffinity(slices_[home_index_]);
+}
+
+Status NumaPlacement::SetAffinity(const std::vector<int32_t> &cpus) {
+#if defined(__linux__) && !defined(ENABLE_ANDROID)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (auto cpu : cpus) {
+    CPU_SET(cpu, &cpu_set);
+  }
+  auto err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (err != 0) {
+    RETURN_STATUS_UNEXPECTED("Unable to set affinity. Errno = " + std::to_string(err));
+  }
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED("Numa placement is only supported on Linux.");
+#endif
+}
+}  // namespace dataset
+}  // namespace mindspore
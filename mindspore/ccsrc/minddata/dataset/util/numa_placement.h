@@ -0,0 +1,95 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_NUMA_PLACEMENT_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_NUMA_PLACEMENT_H_
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Places the threads of a pipeline on the cpus of the numa nodes. Unlike NumaBind, which binds the whole process to
+// one node, every thread is pinned to one cpu, so the tensors a thread allocates are first touched, and hence placed,
+// on the node of that cpu. The placement only depends on the topology and the rank, so it is the same on every run.
+//
+// The home node of a process is rank_id % num_nodes. Ranks which share a home node are tenants of that node and
+// each tenant gets a disjoint slice of the cpus of every node, so co-located pipelines never compete for a core.
+// The workers of all the ops of a tree are numbered in one sequence, see ReserveWorkers, so they fill the slice
+// instead of every op starting on the same cpus.
+class NumaPlacement {
+ public:
+  NumaPlacement() = default;
+  ~NumaPlacement() = default;
+
+  /// \brief Read the cpus of every online numa node from sysfs.
+  /// \param[out] node_cpus The cpus of each node, indexed by node id. Offline nodes get an empty list.
+  /// \return Status object
+  static Status ReadNodeCpus(std::vector<std::vector<int32_t>> *node_cpus);
+
+  /// \brief Parse a cpu list of the kernel such as "0-3,8,10-11".
+  /// \param[in] cpu_list The list to parse
+  /// \param[out] cpus The cpus of the list in ascending order
+  /// \return Status object
+  static Status ParseCpuList(const std::string &cpu_list, std::vector<int32_t> *cpus);
+
+  /// \brief Compute the slice of cpus of this process.
+  /// \param[in] node_cpus The cpus of each node
+  /// \param[in] rank_id The rank of this process, a negative rank is treated as rank 0
+  /// \param[in] tenants_per_node How many processes share a node
+  /// \param[in] spread Whether the workers are spread over all the nodes or stay on the home node
+  /// \return Status object
+  Status Init(const std::vector<std::vector<int32_t>> &node_cpus, int32_t rank_id, int32_t tenants_per_node,
+              bool spread);
+
+  /// \brief Reserve the placement ids of the workers of one op, the ids of all the ops of a tree do not overlap.
+  /// \param[in] num_workers Number of workers of the op
+  /// \return The placement id of the first worker, the others follow it
+  int32_t ReserveWorkers(int32_t num_workers) { return next_worker_.fetch_add(num_workers); }
+
+  /// \brief The cpu of a worker thread.
+  /// \param[in] worker_id The placement id of the worker
+  /// \param[in] near_consumer Keep the worker on the home node, which is the node of the consumer of the pipeline.
+  ///     Ops whose output is handed to the device, such as batch, produce their rows there.
+  /// \return The cpu id
+  int32_t CpuOfWorker(int32_t worker_id, bool near_consumer) const;
+
+  /// \brief Pin the calling thread to the cpu of a worker, worker_id is its placement id.
+  Status PinWorker(int32_t worker_id, bool near_consumer) const;
+
+  /// \brief Pin the calling thread to all the cpus of the slice on the home node, used by the op master threads.
+  Status PinHome() const;
+
+  int32_t home_node() const { return home_node_; }
+
+ private:
+  static Status SetAffinity(const std::vector<int32_t> &cpus);
+
+  // The nodes with at least one cpu, the slices_ are indexed the same way
+  std::vector<int32_t> nodes_;
+  // The cpus of this process on each node
+  std::vector<std::vector<int32_t>> slices_;
+  int32_t home_node_ = 0;
+  int32_t home_index_ = 0;
+  bool spread_ = false;
+  // Placement id of the next worker launched
+  std::atomic<int32_t> next_worker_{0};
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_NUMA_PLACEMENT_H_
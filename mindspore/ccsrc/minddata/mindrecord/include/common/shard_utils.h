@@ -117,6 +117,12 @@ const int kMaxFieldCount = 100;
 // Minimum free disk size
 const int kMinFreeDiskSize = 10;  // 10M
 
+// index db: columns before the index fields, parameters of an insert statement (SQLITE_MAX_VARIABLE_NUMBER of old
+// sqlite builds) and page cache of a writer connection
+const int kIndexFixedColumns = 8;
+const int kMaxSqlParameters = 999;
+const int kIndexDbCacheSize = -32768;  // 32M, negative is in KB
+
 // dummy json
 const json kDummyId = R"({"id": 0})"_json;
 
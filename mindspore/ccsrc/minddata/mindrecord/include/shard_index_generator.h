@@ -70,7 +70,15 @@ class __attribute__((visibility("default"))) ShardIndexGenerator {
 
   std::pair<MSRStatus, std::vector<json>> GetSchemaDetails(const std::vector<uint64_t> &schema_lens, std::fstream &in);
 
-  static std::pair<MSRStatus, std::string> GenerateRawSQL(const std::vector<std::pair<uint64_t, std::string>> &fields);
+  /// \brief create the unique index on ROW_ID and INC_*, after the rows are inserted
+  MSRStatus CreateKeyIndex(sqlite3 *db);
+
+  /// \brief generate an insert statement with positional parameters
+  /// \param[in] fields index fields
+  /// \param[in] num_rows number of rows the statement inserts
+  /// \return the statement
+  static std::pair<MSRStatus, std::string> GenerateRawSQL(const std::vector<std::pair<uint64_t, std::string>> &fields,
+                                                          int num_rows);
 
   std::pair<MSRStatus, sqlite3 *> CheckDatabase(const std::string &shard_address);
 
@@ -82,14 +90,15 @@ class __attribute__((visibility("default"))) ShardIndexGenerator {
   /// \return field name, db type, field value
   ROW_DATA GenerateRowData(int shard_no, const std::map<int, int> &blob_id_to_page_id, int raw_page_id,
                            std::fstream &in);
-  ///
-  /// \param db
-  /// \param sql
-  /// \param data
+  /// \brief bind rows to an insert statement and execute it
+  /// \param[in] stmt statement from GenerateRawSQL
+  /// \param[in] data rows of a page
+  /// \param[in] begin first row to insert
+  /// \param[in] num_rows number of rows the statement inserts
   /// \return
   MSRStatus BindParameterExecuteSQL(
-    sqlite3 *db, const std::string &sql,
-    const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data);
+    sqlite3_stmt *stmt, const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data,
+    size_t begin, int num_rows);
 
   INDEX_FIELDS GenerateIndexFields(const std::vector<json> &schema_detail);
 
@@ -26,6 +26,7 @@
 #include <exception>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -85,7 +86,7 @@ class __attribute__((visibility("default"))) ShardWriter {
 
   /// \brief write raw data by group size
   /// \param[in] raw_data the vector of raw json data, vector format
-  /// \param[in] blob_data the vector of image data
+  /// \param[in,out] blob_data the vector of image data, it is consumed and left empty on success
   /// \param[in] sign validate data or not
   /// \return MSRStatus the status of MSRStatus to judge if write successfully
   MSRStatus WriteRawData(std::map<uint64_t, std::vector<json>> &raw_data, vector<vector<uint8_t>> &blob_data,
@@ -93,7 +94,7 @@ class __attribute__((visibility("default"))) ShardWriter {
 
   /// \brief write raw data by group size for call from python
   /// \param[in] raw_data the vector of raw json data, python-handle format
-  /// \param[in] blob_data the vector of image data
+  /// \param[in,out] blob_data the vector of image data, it is consumed and left empty on success
   /// \param[in] sign validate data or not
   /// \return MSRStatus the status of MSRStatus to judge if write successfully
   MSRStatus WriteRawData(std::map<uint64_t, std::vector<py::handle>> &raw_data, vector<vector<uint8_t>> &blob_data,
@@ -141,8 +142,16 @@ class __attribute__((visibility("default"))) ShardWriter {
   MSRStatus SerializeRawData(std::map<uint64_t, std::vector<json>> &raw_data,
                              std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count);
 
+  /// \brief run func(start, end) on ranges of [0, count) in hardware_concurrency threads
+  void ParallelFor(int count, const std::function<void(int, int)> &func);
+
+  /// \brief wait for the write stage of the previous WriteRawData call
+  /// \return MSRStatus the status of that write
+  MSRStatus WaitPendingWrite();
+
   /// \brief write all data parallel
-  MSRStatus ParallelWriteData(const std::vector<std::vector<uint8_t>> &blob_data,
+  MSRStatus ParallelWriteData(const std::vector<std::pair<int, int>> &shards,
+                              const std::vector<std::vector<uint8_t>> &blob_data,
                               const std::vector<std::vector<uint8_t>> &bin_raw_data);
 
   /// \brief write data shard by shard
@@ -258,6 +267,7 @@ class __attribute__((visibility("default"))) ShardWriter {
   std::mutex check_mutex_;  // mutex for data check
   std::atomic<bool> flag_{false};
   std::atomic<int64_t> compression_size_;
+  std::future<MSRStatus> pending_write_;  // write stage of the last WriteRawData call
 };
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <thread>
 
 #include "minddata/mindrecord/include/shard_index_generator.h"
@@ -230,7 +231,14 @@ std::pair<MSRStatus, sqlite3 *> ShardIndexGenerator::CreateDatabase(int shard_no
     return {FAILED, nullptr};
   }
   sqlite3 *db = ret1.second;
-  std::string sql = "DROP TABLE IF EXISTS INDEXES;";
+  // the db is written once by a single connection and rebuilt from the mindrecord file if anything goes wrong, so
+  // skip the rollback journal and the syncs
+  std::string sql = "PRAGMA journal_mode=OFF; PRAGMA synchronous=OFF; PRAGMA locking_mode=EXCLUSIVE;"
+                    "PRAGMA temp_store=MEMORY; PRAGMA cache_size=" + std::to_string(kIndexDbCacheSize) + ";";
+  if (ExecuteSQL(sql, db, "set pragmas successfully.") != SUCCESS) {
+    return {FAILED, nullptr};
+  }
+  sql = "DROP TABLE IF EXISTS INDEXES;";
   if (ExecuteSQL(sql, db, "drop table successfully.") != SUCCESS) {
     return {FAILED, nullptr};
   }
@@ -256,11 +264,8 @@ std::pair<MSRStatus, sqlite3 *> ShardIndexGenerator::CreateDatabase(int shard_no
     }
     sql += ",INC_" + std::to_string(field_no++) + " INT, " + ret.second + " " + type;
   }
-  sql += ", PRIMARY KEY(ROW_ID";
-  for (uint64_t i = 0; i < fields_.size(); ++i) {
-    sql += ",INC_" + std::to_string(i);
-  }
-  sql += "));";
+  // the key index is created after the rows are loaded, see CreateKeyIndex
+  sql += ");";
   if (ExecuteSQL(sql, db, "create table successfully.") != SUCCESS) {
     return {FAILED, nullptr};
   }
@@ -271,6 +276,16 @@ std::pair<MSRStatus, sqlite3 *> ShardIndexGenerator::CreateDatabase(int shard_no
   return {SUCCESS, db};
 }
 
+MSRStatus ShardIndexGenerator::CreateKeyIndex(sqlite3 *db) {
+  // same lookups as a PRIMARY KEY(ROW_ID, INC_0, ...), but sorted once instead of updated on every insert
+  std::string sql = "CREATE UNIQUE INDEX INDEXES_KEY ON INDEXES(ROW_ID";
+  for (uint64_t i = 0; i < fields_.size(); ++i) {
+    sql += ",INC_" + std::to_string(i);
+  }
+  sql += ");";
+  return ExecuteSQL(sql, db, "create index successfully.");
+}
+
 std::pair<MSRStatus, std::vector<json>> ShardIndexGenerator::GetSchemaDetails(const std::vector<uint64_t> &schema_lens,
                                                                               std::fstream &in) {
   std::vector<json> schema_details;
@@ -293,7 +308,7 @@ std::pair<MSRStatus, std::vector<json>> ShardIndexGenerator::GetSchemaDetails(co
 }
 
 std::pair<MSRStatus, std::string> ShardIndexGenerator::GenerateRawSQL(
-  const std::vector<std::pair<uint64_t, std::string>> &fields) {
+  const std::vector<std::pair<uint64_t, std::string>> &fields, int num_rows) {
   std::string sql =
     "INSERT INTO INDEXES (ROW_ID,ROW_GROUP_ID,PAGE_ID_RAW,PAGE_OFFSET_RAW,PAGE_OFFSET_RAW_END,"
     "PAGE_ID_BLOB,PAGE_OFFSET_BLOB,PAGE_OFFSET_BLOB_END";
@@ -306,36 +321,31 @@ std::pair<MSRStatus, std::string> ShardIndexGenerator::GenerateRawSQL(
     }
     sql += ",INC_" + std::to_string(field_no++) + "," + ret.second;
   }
-  sql +=
-    ") VALUES( :ROW_ID,:ROW_GROUP_ID,:PAGE_ID_RAW,:PAGE_OFFSET_RAW,:PAGE_OFFSET_RAW_END,:PAGE_ID_BLOB,"
-    ":PAGE_OFFSET_BLOB,:PAGE_OFFSET_BLOB_END";
-  field_no = 0;
-  for (const auto &field : fields) {
-    auto ret = GenerateFieldName(field);
-    if (ret.first != SUCCESS) {
-      return {FAILED, ""};
-    }
-    sql += ",:INC_" + std::to_string(field_no++) + ",:" + ret.second;
+
+  // positional parameters, a row binds them in the order GenerateRowData fills it
+  std::string values = "(?,?,?,?,?,?,?,?";
+  for (size_t i = 0; i < fields.size(); ++i) {
+    values += ",?,?";
+  }
+  values += ")";
+  sql += ") VALUES " + values;
+  for (int i = 1; i < num_rows; ++i) {
+    sql += "," + values;
   }
-  sql += " )";
   return {SUCCESS, sql};
 }
 
 MSRStatus ShardIndexGenerator::BindParameterExecuteSQL(
-  sqlite3 *db, const std::string &sql,
-  const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data) {
-  sqlite3_stmt *stmt = nullptr;
-  if (sqlite3_prepare_v2(db, common::SafeCStr(sql), -1, &stmt, 0) != SQLITE_OK) {
-    MS_LOG(ERROR) << "SQL error: could not prepare statement, sql: " << sql;
-    return FAILED;
-  }
-  for (auto &row : data) {
+  sqlite3_stmt *stmt, const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data,
+  size_t begin, int num_rows) {
+  int num_columns = sqlite3_bind_parameter_count(stmt) / num_rows;
+  for (int r = 0; r < num_rows; ++r) {
+    const auto &row = data[begin + r];
+    int index = r * num_columns + 1;
     for (auto &field : row) {
-      const auto &place_holder = std::get<0>(field);
       const auto &field_type = std::get<1>(field);
       const auto &field_value = std::get<2>(field);
 
-      int index = sqlite3_bind_parameter_index(stmt, common::SafeCStr(place_holder));
       if (field_type == "INTEGER") {
         if (sqlite3_bind_int64(stmt, index, std::stoll(field_value)) != SQLITE_OK) {
           MS_LOG(ERROR) << "SQL error: could not bind parameter, index: " << index
@@ -359,14 +369,19 @@ MSRStatus ShardIndexGenerator::BindParameterExecuteSQL(
           return FAILED;
         }
       }
+      ++index;
     }
-    if (sqlite3_step(stmt) != SQLITE_DONE) {
-      MS_LOG(ERROR) << "SQL error: Could not step (execute) stmt.";
-      return FAILED;
+    // a row without index fields, bindings are kept across executions so clear the rest
+    for (; index <= (r + 1) * num_columns; ++index) {
+      (void)sqlite3_bind_null(stmt, index);
     }
+  }
+  if (sqlite3_step(stmt) != SQLITE_DONE) {
+    MS_LOG(ERROR) << "SQL error: Could not step (execute) stmt.";
     (void)sqlite3_reset(stmt);
+    return FAILED;
   }
-  (void)sqlite3_finalize(stmt);
+  (void)sqlite3_reset(stmt);
   return SUCCESS;
 }
 
@@ -526,30 +541,65 @@ MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, std::pair
     return FAILED;
   }
 
+  // one statement inserting as many rows as the parameter limit allows, and one for the rest of a page
+  const int num_columns = kIndexFixedColumns + 2 * static_cast<int>(fields_.size());
+  const int batch_rows = std::max(1, kMaxSqlParameters / num_columns);
+  auto batch_sql = GenerateRawSQL(fields_, batch_rows);
+  auto single_sql = GenerateRawSQL(fields_, 1);
+  if (batch_sql.first != SUCCESS || single_sql.first != SUCCESS) {
+    MS_LOG(ERROR) << "Generate raw SQL failed";
+    return FAILED;
+  }
+  sqlite3_stmt *batch_stmt = nullptr;
+  sqlite3_stmt *single_stmt = nullptr;
+  if (sqlite3_prepare_v2(db.second, common::SafeCStr(batch_sql.second), -1, &batch_stmt, 0) != SQLITE_OK) {
+    MS_LOG(ERROR) << "SQL error: could not prepare statement, sql: " << batch_sql.second;
+    return FAILED;
+  }
+  if (sqlite3_prepare_v2(db.second, common::SafeCStr(single_sql.second), -1, &single_stmt, 0) != SQLITE_OK) {
+    MS_LOG(ERROR) << "SQL error: could not prepare statement, sql: " << single_sql.second;
+    (void)sqlite3_finalize(batch_stmt);
+    return FAILED;
+  }
+
   std::fstream in;
   in.open(common::SafeCStr(shard_address), std::ios::in | std::ios::binary);
   if (!in.good()) {
     MS_LOG(ERROR) << "Invalid file, failed to open file: " << shard_address;
+    (void)sqlite3_finalize(batch_stmt);
+    (void)sqlite3_finalize(single_stmt);
     return FAILED;
   }
   (void)sqlite3_exec(db.second, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
+  MSRStatus status = SUCCESS;
   for (int raw_page_id : raw_page_ids) {
-    auto sql = GenerateRawSQL(fields_);
-    if (sql.first != SUCCESS) {
-      MS_LOG(ERROR) << "Generate raw SQL failed";
-      return FAILED;
-    }
     auto data = GenerateRowData(shard_no, blob_id_to_page_id, raw_page_id, in);
     if (data.first != SUCCESS) {
       MS_LOG(ERROR) << "Generate raw data failed";
-      return FAILED;
+      status = FAILED;
+      break;
+    }
+    size_t row = 0;
+    for (; status == SUCCESS && row + batch_rows <= data.second.size(); row += batch_rows) {
+      status = BindParameterExecuteSQL(batch_stmt, data.second, row, batch_rows);
+    }
+    for (; status == SUCCESS && row < data.second.size(); ++row) {
+      status = BindParameterExecuteSQL(single_stmt, data.second, row, 1);
     }
-    if (BindParameterExecuteSQL(db.second, sql.second, data.second) == FAILED) {
+    if (status != SUCCESS) {
       MS_LOG(ERROR) << "Execute SQL failed";
-      return FAILED;
+      break;
     }
     MS_LOG(INFO) << "Insert " << data.second.size() << " rows to index db.";
   }
+  (void)sqlite3_finalize(batch_stmt);
+  (void)sqlite3_finalize(single_stmt);
+  if (status != SUCCESS) {
+    return FAILED;
+  }
+  if (CreateKeyIndex(db.second) != SUCCESS) {
+    return FAILED;
+  }
   (void)sqlite3_exec(db.second, "END TRANSACTION;", nullptr, nullptr, nullptr);
   in.close();
 
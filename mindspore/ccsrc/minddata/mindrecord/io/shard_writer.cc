@@ -33,6 +33,10 @@ ShardWriter::ShardWriter()
 }
 
 ShardWriter::~ShardWriter() {
+  // the write stage uses the file streams
+  if (pending_write_.valid()) {
+    pending_write_.wait();
+  }
   for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; i--) {
     file_streams_[i]->close();
   }
@@ -210,6 +214,10 @@ MSRStatus ShardWriter::OpenForAppend(const std::string &path) {
 }
 
 MSRStatus ShardWriter::Commit() {
+  if (WaitPendingWrite() == FAILED) {
+    return FAILED;
+  }
+
   // Read pages file
   std::ifstream page_file(pages_file_.c_str());
   if (page_file.good()) {
@@ -612,11 +620,15 @@ MSRStatus ShardWriter::WriteRawDataPreCheck(std::map<uint64_t, std::vector<json>
 
   // compress blob
   if (shard_column_->CheckCompressBlob()) {
-    for (auto &blob : blob_data) {
+    ParallelFor(static_cast<int>(blob_data.size()), [this, &blob_data](int start, int end) {
       int64_t compression_bytes = 0;
-      blob = shard_column_->CompressBlob(blob, &compression_bytes);
+      for (int i = start; i < end; ++i) {
+        int64_t blob_bytes = 0;
+        blob_data[i] = shard_column_->CompressBlob(blob_data[i], &blob_bytes);
+        compression_bytes += blob_bytes;
+      }
       compression_size_ += compression_bytes;
-    }
+    });
   }
 
   // Add 4-bytes dummy blob data if no any blob fields
@@ -629,6 +641,11 @@ MSRStatus ShardWriter::WriteRawDataPreCheck(std::map<uint64_t, std::vector<json>
     raw_data.insert(std::pair<uint64_t, std::vector<json>>(0, std::vector<json>(blob_data.size(), kDummyId)));
   }
 
+  // everything above overlaps the write stage of the previous call, the row and schema counts below are its input
+  if (WaitPendingWrite() == FAILED) {
+    return FAILED;
+  }
+
   auto v = ValidateRawData(raw_data, blob_data, sign);
   if (std::get<0>(v) == FAILED) {
     MS_LOG(ERROR) << "Validate raw data failed";
@@ -677,6 +694,11 @@ MSRStatus ShardWriter::MergeBlobData(const std::vector<string> &blob_fields,
 
 MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_data,
                                     std::vector<std::vector<uint8_t>> &blob_data, bool sign, bool parallel_writer) {
+  // Files are reopened under the lock, nothing may be written in the background
+  if (parallel_writer && WaitPendingWrite() == FAILED) {
+    return FAILED;
+  }
+
   // Lock Writer if loading data parallel
   int fd = LockWriter(parallel_writer);
   if (fd < 0) {
@@ -719,12 +741,31 @@ MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_d
     return FAILED;
   }
 
+  auto shards = BreakIntoShards();
+  if (!parallel_writer) {
+    // Write data to disk in the background, the next call serializes its rows meanwhile. The blobs are swapped into
+    // the pending write and blob_data is left empty, errors are returned by the next call or by Commit
+    std::vector<std::vector<uint8_t>> blobs;
+    blobs.swap(blob_data);
+    auto write = [this, shards, blobs = std::move(blobs), bin_raw_data = std::move(bin_raw_data)]() {
+      if (ParallelWriteData(shards, blobs, bin_raw_data) == FAILED) {
+        MS_LOG(ERROR) << "Parallel write data failed";
+        return FAILED;
+      }
+      MS_LOG(INFO) << "Write " << bin_raw_data.size() << " records successfully.";
+      return SUCCESS;
+    };
+    pending_write_ = std::async(std::launch::async, std::move(write));
+    return SUCCESS;
+  }
+
   // Write data to disk with multi threads
-  if (ParallelWriteData(blob_data, bin_raw_data) == FAILED) {
+  if (ParallelWriteData(shards, blob_data, bin_raw_data) == FAILED) {
     MS_LOG(ERROR) << "Parallel write data failed";
     return FAILED;
   }
   MS_LOG(INFO) << "Write " << bin_raw_data.size() << " records successfully.";
+  blob_data.clear();
 
   if (UnlockWriter(fd, parallel_writer) == FAILED) {
     MS_LOG(ERROR) << "Unlock writer failed";
@@ -787,9 +828,9 @@ MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<py::handle>>
   return WriteRawData(raw_data_json, blob_data, sign, parallel_writer);
 }
 
-MSRStatus ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>> &blob_data,
+MSRStatus ShardWriter::ParallelWriteData(const std::vector<std::pair<int, int>> &shards,
+                                         const std::vector<std::vector<uint8_t>> &blob_data,
                                          const std::vector<std::vector<uint8_t>> &bin_raw_data) {
-  auto shards = BreakIntoShards();
   // define the number of thread
   int thread_num = static_cast<int>(shard_count_);
   if (thread_num < 0) {
@@ -800,6 +841,7 @@ MSRStatus ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>>
   }
   int left_thread = shard_count_;
   int current_thread = 0;
+  std::atomic<bool> write_success(true);
   while (left_thread) {
     if (left_thread < thread_num) {
       thread_num = left_thread;
@@ -810,8 +852,12 @@ MSRStatus ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>>
       for (int x = 0; x < thread_num; ++x) {
         int start_row = shards[current_thread + x].first;
         int end_row = shards[current_thread + x].second;
-        thread_set[x] = std::thread(&ShardWriter::WriteByShard, this, current_thread + x, start_row, end_row,
-                                    std::ref(blob_data), std::ref(bin_raw_data));
+        int shard_id = current_thread + x;
+        thread_set[x] = std::thread([&, shard_id, start_row, end_row]() {
+          if (WriteByShard(shard_id, start_row, end_row, blob_data, bin_raw_data) != SUCCESS) {
+            write_success = false;
+          }
+        });
       }
       // Wait for threads done
       for (int x = 0; x < thread_num; ++x) {
@@ -821,7 +867,7 @@ MSRStatus ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>>
       current_thread += thread_num;
     }
   }
-  return SUCCESS;
+  return write_success ? SUCCESS : FAILED;
 }
 
 MSRStatus ShardWriter::WriteByShard(int shard_id, int start_row, int end_row,
@@ -918,7 +964,9 @@ MSRStatus ShardWriter::AppendBlobPage(const int &shard_id, const std::vector<std
     return FAILED;
   }
 
-  (void)FlushBlobChunk(file_streams_[shard_id], blob_data, blob_row);
+  if (FlushBlobChunk(file_streams_[shard_id], blob_data, blob_row) != SUCCESS) {
+    return FAILED;
+  }
 
   // Update last blob page
   bytes_page += std::accumulate(blob_data_size_.begin() + blob_row.first, blob_data_size_.begin() + blob_row.second, 0);
@@ -947,7 +995,9 @@ MSRStatus ShardWriter::NewBlobPage(const int &shard_id, const std::vector<std::v
       return FAILED;
     }
 
-    (void)FlushBlobChunk(file_streams_[shard_id], blob_data, blob_row);
+    if (FlushBlobChunk(file_streams_[shard_id], blob_data, blob_row) != SUCCESS) {
+      return FAILED;
+    }
     // Create new page info for header
     auto page_size =
       std::accumulate(blob_data_size_.begin() + blob_row.first, blob_data_size_.begin() + blob_row.second, 0);
@@ -1079,7 +1129,9 @@ MSRStatus ShardWriter::AppendRawPage(const int &shard_id, const std::vector<std:
   if (chunk_id > 0) row_group_ids.emplace_back(++last_row_group_id, n_bytes);
   n_bytes += std::accumulate(raw_data_size_.begin() + rows_in_group[chunk_id].first,
                              raw_data_size_.begin() + rows_in_group[chunk_id].second, 0);
-  (void)FlushRawChunk(file_streams_[shard_id], rows_in_group, chunk_id, bin_raw_data);
+  if (FlushRawChunk(file_streams_[shard_id], rows_in_group, chunk_id, bin_raw_data) != SUCCESS) {
+    return FAILED;
+  }
 
   // Update previous raw data page
   last_raw_page->SetPageSize(n_bytes);
@@ -1098,24 +1150,23 @@ MSRStatus ShardWriter::FlushBlobChunk(const std::shared_ptr<std::fstream> &out,
   if (blob_row.second > static_cast<int>(blob_data.size()) || blob_row.first < 0) {
     return FAILED;
   }
+  // Pack the chunk, the size of each blob followed by its data, and write it at once
+  uint64_t chunk_size = 0;
+  for (int j = blob_row.first; j < blob_row.second; ++j) {
+    chunk_size += kInt64Len + blob_data[j].size();
+  }
+  std::vector<uint8_t> chunk(chunk_size);
+  uint8_t *dst = chunk.data();
   for (int j = blob_row.first; j < blob_row.second; ++j) {
-    // Write the size of blob
     uint64_t line_len = blob_data[j].size();
-    auto &io_handle = out->write(reinterpret_cast<char *>(&line_len), kInt64Len);
-    if (!io_handle.good() || io_handle.fail() || io_handle.bad()) {
-      MS_LOG(ERROR) << "File write failed";
-      out->close();
-      return FAILED;
-    }
-
-    // Write the data of blob
-    auto line = blob_data[j];
-    auto &io_handle_data = out->write(reinterpret_cast<char *>(&line[0]), line_len);
-    if (!io_handle_data.good() || io_handle_data.fail() || io_handle_data.bad()) {
-      MS_LOG(ERROR) << "File write failed";
-      out->close();
-      return FAILED;
-    }
+    dst = std::copy_n(reinterpret_cast<uint8_t *>(&line_len), kInt64Len, dst);
+    dst = std::copy(blob_data[j].begin(), blob_data[j].end(), dst);
+  }
+  auto &io_handle = out->write(reinterpret_cast<char *>(chunk.data()), chunk.size());
+  if (!io_handle.good() || io_handle.fail() || io_handle.bad()) {
+    MS_LOG(ERROR) << "File write failed";
+    out->close();
+    return FAILED;
   }
   return SUCCESS;
 }
@@ -1123,28 +1174,29 @@ MSRStatus ShardWriter::FlushBlobChunk(const std::shared_ptr<std::fstream> &out,
 MSRStatus ShardWriter::FlushRawChunk(const std::shared_ptr<std::fstream> &out,
                                      const std::vector<std::pair<int, int>> &rows_in_group, const int &chunk_id,
                                      const std::vector<std::vector<uint8_t>> &bin_raw_data) {
+  // Pack the chunk, for each row the sizes of multi schemas followed by their data, and write it at once
+  uint64_t chunk_size = 0;
+  for (int i = rows_in_group[chunk_id].first; i < rows_in_group[chunk_id].second; i++) {
+    chunk_size += raw_data_size_[i];
+  }
+  std::vector<uint8_t> chunk(chunk_size);
+  uint8_t *dst = chunk.data();
   for (int i = rows_in_group[chunk_id].first; i < rows_in_group[chunk_id].second; i++) {
-    // Write the size of multi schemas
     for (uint32_t j = 0; j < schema_count_; ++j) {
       uint64_t line_len = bin_raw_data[i * schema_count_ + j].size();
-      auto &io_handle = out->write(reinterpret_cast<char *>(&line_len), kInt64Len);
-      if (!io_handle.good() || io_handle.fail() || io_handle.bad()) {
-        MS_LOG(ERROR) << "File write failed";
-        out->close();
-        return FAILED;
-      }
+      dst = std::copy_n(reinterpret_cast<uint8_t *>(&line_len), kInt64Len, dst);
     }
-    // Write the data of multi schemas
     for (uint32_t j = 0; j < schema_count_; ++j) {
-      auto line = bin_raw_data[i * schema_count_ + j];
-      auto &io_handle = out->write(reinterpret_cast<char *>(&line[0]), line.size());
-      if (!io_handle.good() || io_handle.fail() || io_handle.bad()) {
-        MS_LOG(ERROR) << "File write failed";
-        out->close();
-        return FAILED;
-      }
+      const auto &line = bin_raw_data[i * schema_count_ + j];
+      dst = std::copy(line.begin(), line.end(), dst);
     }
   }
+  auto &io_handle = out->write(reinterpret_cast<char *>(chunk.data()), chunk.size());
+  if (!io_handle.good() || io_handle.fail() || io_handle.bad()) {
+    MS_LOG(ERROR) << "File write failed";
+    out->close();
+    return FAILED;
+  }
   return SUCCESS;
 }
 
@@ -1225,29 +1277,40 @@ MSRStatus ShardWriter::WriteShardHeader() {
 
 MSRStatus ShardWriter::SerializeRawData(std::map<uint64_t, std::vector<json>> &raw_data,
                                         std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count) {
+  ParallelFor(static_cast<int>(row_count),
+              [this, &raw_data, &bin_data](int start, int end) { FillArray(start, end, raw_data, bin_data); });
+  return flag_ == true ? FAILED : SUCCESS;
+}
+
+void ShardWriter::ParallelFor(int count, const std::function<void(int, int)> &func) {
   // define the number of thread
   uint32_t thread_num = std::thread::hardware_concurrency();
   if (thread_num == 0) thread_num = kThreadNumber;
-  // Set the number of samples processed by each thread
-  int group_num = ceil(row_count * 1.0 / thread_num);
-  std::vector<std::thread> thread_set(thread_num);
-  int work_thread_num = 0;
+  // Set the number of items processed by each thread
+  int group_num = ceil(count * 1.0 / thread_num);
+  std::vector<std::thread> thread_set;
   for (uint32_t x = 0; x < thread_num; ++x) {
     int start_num = x * group_num;
-    int end_num = ((x + 1) * group_num > row_count) ? row_count : (x + 1) * group_num;
+    int end_num = std::min(static_cast<int>(x + 1) * group_num, count);
     if (start_num >= end_num) {
-      continue;
+      break;
     }
-    // Define the run boundary and start the child thread
-    thread_set[x] =
-      std::thread(&ShardWriter::FillArray, this, start_num, end_num, std::ref(raw_data), std::ref(bin_data));
-    work_thread_num++;
+    thread_set.emplace_back(func, start_num, end_num);
   }
-  for (uint32_t x = 0; x < work_thread_num; ++x) {
-    // Set obstacles to prevent the main thread from running
-    thread_set[x].join();
+  for (auto &thread : thread_set) {
+    thread.join();
   }
-  return flag_ == true ? FAILED : SUCCESS;
+}
+
+MSRStatus ShardWriter::WaitPendingWrite() {
+  if (!pending_write_.valid()) {
+    return SUCCESS;
+  }
+  if (pending_write_.get() == FAILED) {
+    MS_LOG(ERROR) << "Write data of the previous call failed";
+    return FAILED;
+  }
+  return SUCCESS;
 }
 
 MSRStatus ShardWriter::SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data) {
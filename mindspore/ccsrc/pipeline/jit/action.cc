@@ -29,6 +29,7 @@
 #include "frontend/parallel/costmodel_context.h"
 #include "frontend/parallel/context.h"
 #include "pipeline/jit/pass.h"
+#include "pipeline/jit/compile_cache.h"
 #include "pipeline/jit/parse/parse_base.h"
 #include "pipeline/jit/parse/data_converter.h"
 #include "abstract/abstract_value.h"
@@ -590,6 +591,14 @@ std::vector<ActionItem> GePipeline() {
 std::vector<ActionItem> VmPipeline() {
   auto actions = CommonPipeline();
 
+  // The cache key is the resolved graph, on a hit the pipeline goes from here to the actions after validate
+  bool use_compile_cache = !CompileCache::Dir().empty();
+  if (use_compile_cache) {
+    auto iter = std::find_if(actions.begin(), actions.end(),
+                             [](const ActionItem &item) { return item.first == "inference_opt_prepare"; });
+    (void)actions.insert(iter, std::make_pair(kCompileCacheLoad, CompileCacheLoadAction));
+  }
+
   // optimize
   actions.emplace_back(std::make_pair("optimize", VmOptimizeAction));
 
@@ -597,6 +606,9 @@ std::vector<ActionItem> VmPipeline() {
   actions.emplace_back(std::make_pair("py_opt", OptActionVmPyStub));
 
   actions.emplace_back(std::make_pair("validate", ValidateAction));
+  if (use_compile_cache) {
+    actions.emplace_back(std::make_pair(kCompileCacheSave, CompileCacheSaveAction));
+  }
 #if (ENABLE_CPU && (ENABLE_D || ENABLE_GPU))
   if (ps::Util::IsRoleOfWorker()) {
     actions.emplace_back(std::make_pair("worker", StartPSWorkerAction));
@@ -0,0 +1,463 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/jit/compile_cache.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <dlfcn.h>
+#endif
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+#include "debug/common.h"
+#include "debug/dump_proto.h"
+#include "frontend/optimizer/py_pass_manager.h"
+#include "frontend/parallel/context.h"
+#include "ir/graph_utils.h"
+#include "ir/tensor.h"
+#include "load_mindir/load_model.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_context.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace pipeline {
+namespace {
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+// bump when the layout of an entry changes
+constexpr int kCompileCacheFormat = 1;
+
+uint64_t Fnv1a(const void *data, size_t size) {
+  uint64_t hash = kFnvOffsetBasis;
+  auto bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * kFnvPrime;
+  }
+  return hash;
+}
+
+// Identifies the build of the library, so entries written by another build are never used
+std::string LibraryVersion() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  Dl_info info;
+  if (dladdr(reinterpret_cast<void *>(&LibraryVersion), &info) != 0 && info.dli_fname != nullptr) {
+    struct stat st;
+    if (stat(info.dli_fname, &st) == 0) {
+      return std::string(info.dli_fname) + " " + std::to_string(st.st_size) + " " + std::to_string(st.st_mtime);
+    }
+  }
+#endif
+  return std::string(__DATE__) + " " + __TIME__;
+}
+
+// Attributes sorted by name, the text must not depend on the order of the hash map
+template <typename T>
+std::map<std::string, ValuePtr> Sorted(const T &attrs) {
+  return std::map<std::string, ValuePtr>(attrs.begin(), attrs.end());
+}
+
+// Text of the graphs used by a root graph. Graphs and nodes are numbered in the order they are reached instead of
+// using their ids, which depend on what was compiled before in the process.
+class KeyBuilder {
+ public:
+  std::string Build(const FuncGraphPtr &root) {
+    (void)GraphIndex(root);
+    // graphs_ grows while the graphs are visited
+    for (size_t i = 0; i < graphs_.size(); i++) {
+      AddGraph(graphs_[i], i);
+    }
+    return buffer_.str();
+  }
+
+  std::string ValueText(const ValuePtr &value) {
+    MS_EXCEPTION_IF_NULL(value);
+    if (value->isa<FuncGraph>()) {
+      return "@" + std::to_string(GraphIndex(value->cast<FuncGraphPtr>()));
+    }
+    if (value->isa<Primitive>()) {
+      auto prim = value->cast<PrimitivePtr>();
+      std::ostringstream buffer;
+      buffer << prim->name() << "{";
+      for (auto &attr : Sorted(prim->attrs())) {
+        buffer << attr.first << "=" << ValueText(attr.second) << ",";
+      }
+      buffer << "}";
+      return buffer.str();
+    }
+    if (value->isa<tensor::Tensor>()) {
+      // the text of a tensor is truncated, hash its data instead
+      auto tensor = value->cast<tensor::TensorPtr>();
+      std::ostringstream buffer;
+      buffer << "Tensor(" << TypeIdLabel(tensor->data_type()) << ", " << ShapeText(tensor->shape()) << ", "
+             << std::hex << Fnv1a(tensor->data_c(), tensor->Size()) << ")";
+      return buffer.str();
+    }
+    if (value->isa<ValueSequeue>()) {
+      std::string text = value->isa<ValueTuple>() ? "(" : "[";
+      for (auto &item : value->cast<ValueSequeuePtr>()->value()) {
+        text += ValueText(item) + ",";
+      }
+      return text + (value->isa<ValueTuple>() ? ")" : "]");
+    }
+    return value->ToString();
+  }
+
+ private:
+  static std::string ShapeText(const std::vector<int64_t> &shape) {
+    std::string text = "[";
+    for (auto dim : shape) {
+      text += std::to_string(dim) + ",";
+    }
+    return text + "]";
+  }
+
+  size_t GraphIndex(const FuncGraphPtr &func_graph) {
+    auto iter = graph_index_.find(func_graph);
+    if (iter != graph_index_.end()) {
+      return iter->second;
+    }
+    graph_index_[func_graph] = graphs_.size();
+    graphs_.push_back(func_graph);
+    return graphs_.size() - 1;
+  }
+
+  size_t NodeIndex(const AnfNodePtr &node) {
+    auto iter = node_index_.find(node);
+    if (iter != node_index_.end()) {
+      return iter->second;
+    }
+    size_t index = node_index_.size();
+    node_index_[node] = index;
+    return index;
+  }
+
+  void AddGraph(const FuncGraphPtr &func_graph, size_t index) {
+    buffer_ << "graph " << index << "{";
+    for (auto &attr : Sorted(func_graph->attrs())) {
+      buffer_ << attr.first << "=" << ValueText(attr.second) << ",";
+    }
+    buffer_ << "}(";
+    for (auto &param : func_graph->parameters()) {
+      auto parameter = param->cast<ParameterPtr>();
+      MS_EXCEPTION_IF_NULL(parameter);
+      buffer_ << "%" << NodeIndex(param) << " " << parameter->name();
+      if (parameter->has_default()) {
+        auto tensor = parameter->default_param()->cast<tensor::TensorPtr>();
+        if (tensor != nullptr) {
+          buffer_ << ":" << TypeIdLabel(tensor->data_type()) << ShapeText(tensor->shape());
+        }
+      }
+      buffer_ << ",";
+    }
+    buffer_ << ")\n";
+    for (auto &node : TopoSort(func_graph->get_return())) {
+      if (node->isa<CNode>()) {
+        buffer_ << "%" << NodeIndex(node) << "=(";
+        for (auto &input : node->cast<CNodePtr>()->inputs()) {
+          buffer_ << "%" << NodeIndex(input) << ",";
+        }
+        buffer_ << ")\n";
+      } else if (node->isa<ValueNode>()) {
+        buffer_ << "%" << NodeIndex(node) << "=" << ValueText(GetValueNode(node)) << "\n";
+      } else if (node->func_graph() != func_graph) {
+        // free variable, a parameter of an enclosing graph
+        buffer_ << "%" << NodeIndex(node) << "=free " << node->cast<ParameterPtr>()->name() << "\n";
+      }
+    }
+  }
+
+  std::ostringstream buffer_;
+  std::vector<FuncGraphPtr> graphs_;
+  std::unordered_map<FuncGraphPtr, size_t> graph_index_;
+  std::unordered_map<AnfNodePtr, size_t> node_index_;
+};
+
+std::string AbstractText(KeyBuilder *builder, const AbstractBasePtr &abs) {
+  MS_EXCEPTION_IF_NULL(abs);
+  if (abs->isa<abstract::AbstractSequeue>()) {
+    std::string text = abs->isa<abstract::AbstractTuple>() ? "(" : "[";
+    for (auto &element : abs->cast<abstract::AbstractSequeuePtr>()->elements()) {
+      text += AbstractText(builder, element) + ",";
+    }
+    return text + (abs->isa<abstract::AbstractTuple>() ? ")" : "]");
+  }
+  std::string text = abs->BuildType()->ToString() + abs->BuildShape()->ToString();
+  // graphs are specialized on the values of scalars, not on the values of tensors
+  if (abs->isa<abstract::AbstractScalar>()) {
+    text += "=" + builder->ValueText(abs->BuildValue());
+  }
+  return text;
+}
+
+bool WriteFile(const std::string &path, const std::string &data) {
+  // write then rename, processes sharing the cache directory never see a partial entry
+  std::string tmp_path = path + ".tmp" + std::to_string(getpid());
+  std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+  if (!ofs.is_open()) {
+    return false;
+  }
+  ofs.write(data.data(), data.size());
+  ofs.close();
+  if (!ofs.good() || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    (void)std::remove(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+// Parse a meta file: the parameter number, one line per parameter, "w name" for a weight and "i" for an input,
+// then the key. Returns false if the file is truncated or broken.
+bool ReadMeta(std::istream *meta, std::vector<std::string> *params, std::string *key) {
+  constexpr size_t kMaxParamNum = 1 << 20;
+  std::string line;
+  if (!std::getline(*meta, line) || line.empty() ||
+      !std::all_of(line.begin(), line.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); })) {
+    return false;
+  }
+  size_t param_num = 0;
+  try {
+    param_num = std::stoul(line);
+  } catch (const std::exception &) {
+    return false;
+  }
+  if (param_num > kMaxParamNum) {
+    return false;
+  }
+  params->resize(param_num);
+  for (auto &param : *params) {
+    if (!std::getline(*meta, param)) {
+      return false;
+    }
+    bool is_input = param == "i";
+    bool is_weight = param.size() > 2 && param[0] == 'w' && param[1] == ' ';
+    if (!is_input && !is_weight) {
+      return false;
+    }
+  }
+  key->assign(std::istreambuf_iterator<char>(*meta), std::istreambuf_iterator<char>());
+  return !meta->bad();
+}
+}  // namespace
+
+std::string CompileCache::Dir() {
+  std::string dir = common::GetEnv("MS_COMPILER_CACHE_PATH");
+  if (dir.empty()) {
+    return dir;
+  }
+  std::string parallel_mode = parallel::ParallelContext::GetInstance()->parallel_mode();
+  if (parallel_mode == parallel::AUTO_PARALLEL || parallel_mode == parallel::SEMI_AUTO_PARALLEL) {
+    MS_LOG(INFO) << "Compile cache is not used in " << parallel_mode << " mode.";
+    return "";
+  }
+  // python passes are not part of the key
+  auto py_pass_manager = opt::python_pass::PyPassManager::GetInstance();
+  if (py_pass_manager->GetPassGroup(opt::python_pass::Phase::PREAD)->size() != 0 ||
+      py_pass_manager->GetPassGroup(opt::python_pass::Phase::OPT)->size() != 0) {
+    MS_LOG(INFO) << "Compile cache is not used with python passes.";
+    return "";
+  }
+  return dir;
+}
+
+std::string CompileCache::Key(const FuncGraphPtr &func_graph, const abstract::AbstractBasePtrList &args_spec) {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  auto parallel_context = parallel::ParallelContext::GetInstance();
+  std::ostringstream buffer;
+  buffer << "format " << kCompileCacheFormat << "\n";
+  buffer << "library " << LibraryVersion() << "\n";
+  buffer << "context " << context->get_param<std::string>(MS_CTX_DEVICE_TARGET) << " "
+         << context->get_param<int>(MS_CTX_EXECUTION_MODE) << " "
+         << context->get_param<bool>(MS_CTX_ENABLE_GRAPH_KERNEL) << " "
+         << context->get_param<bool>(MS_CTX_ENABLE_AUTO_MIXED_PRECISION) << " "
+         << context->get_param<bool>(MS_CTX_ENABLE_SPARSE) << " "
+         << context->get_param<bool>(MS_CTX_ENABLE_REDUCE_PRECISION) << " "
+         << context->get_param<bool>(MS_CTX_ENABLE_PARALLEL_SPLIT) << " " << parallel_context->parallel_mode() << " "
+         << parallel_context->device_num() << " " << parallel_context->global_rank() << " "
+         << parallel_context->gradients_mean() << "\n";
+  KeyBuilder builder;
+  buffer << "args";
+  for (auto &arg : args_spec) {
+    buffer << " " << AbstractText(&builder, arg);
+  }
+  buffer << "\n" << builder.Build(func_graph);
+  return buffer.str();
+}
+
+std::string CompileCache::EntryPath(const std::string &key) const {
+  std::ostringstream buffer;
+  buffer << std::hex << std::setw(16) << std::setfill('0') << Fnv1a(key.data(), key.size());
+  return dir_ + "/" + buffer.str();
+}
+
+FuncGraphPtr CompileCache::Load(const std::string &key, const std::vector<ParameterPtr> &weights) const {
+  std::string path = EntryPath(key);
+  std::ifstream meta(path + ".meta", std::ios::binary);
+  if (!meta.is_open()) {
+    MS_LOG(INFO) << "Compile cache miss: " << path;
+    return nullptr;
+  }
+  std::vector<std::string> params;
+  std::string stored_key;
+  if (!ReadMeta(&meta, &params, &stored_key)) {
+    MS_LOG(WARNING) << "Compile cache entry is broken: " << path;
+    return nullptr;
+  }
+  if (stored_key != key) {
+    MS_LOG(INFO) << "Compile cache collision: " << path;
+    return nullptr;
+  }
+
+  FuncGraphPtr func_graph = nullptr;
+  try {
+    func_graph = LoadMindIR(path + ".mindir");
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Load compile cache entry " << path << " failed: " << e.what();
+    return nullptr;
+  }
+  if (func_graph == nullptr || func_graph->parameters().size() != params.size()) {
+    MS_LOG(WARNING) << "Compile cache entry is broken: " << path;
+    return nullptr;
+  }
+  // MindIR puts the weights before the inputs, restore the order of the compiled graph
+  std::unordered_map<std::string, ParameterPtr> weight_map;
+  for (auto &weight : weights) {
+    weight_map[weight->name()] = weight;
+  }
+  size_t weight_num =
+    std::count_if(params.begin(), params.end(), [](const std::string &param) { return param[0] == 'w'; });
+  const auto &loaded = func_graph->parameters();
+  std::vector<AnfNodePtr> ordered;
+  size_t next_weight = 0;
+  size_t next_input = weight_num;
+  for (auto &param : params) {
+    if (param[0] != 'w') {
+      ordered.push_back(loaded[next_input++]);
+      continue;
+    }
+    std::string name = param.substr(2);
+    auto iter = weight_map.find(name);
+    if (iter == weight_map.end()) {
+      MS_LOG(WARNING) << "Compile cache entry " << path << " uses weight " << name << " which is not in the network.";
+      return nullptr;
+    }
+    auto parameter = loaded[next_weight++]->cast<ParameterPtr>();
+    if (parameter == nullptr) {
+      MS_LOG(WARNING) << "Compile cache entry is broken: " << path;
+      return nullptr;
+    }
+    parameter->set_name(name);
+    parameter->set_default_param(iter->second->default_param());
+    ordered.push_back(parameter);
+  }
+  func_graph->set_parameters(ordered);
+  MS_LOG(INFO) << "Compile cache hit: " << path;
+  return func_graph;
+}
+
+void CompileCache::Save(const std::string &key, const FuncGraphPtr &func_graph) const {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  if (!func_graph->func_graphs_used_total().empty()) {
+    MS_LOG(INFO) << "Graph " << func_graph->ToString() << " calls other graphs, it is not stored in compile cache.";
+    return;
+  }
+  std::string proto;
+  try {
+    proto = GetBinaryProtoString(func_graph);
+  } catch (const std::exception &e) {
+    MS_LOG(INFO) << "Graph " << func_graph->ToString() << " can not be exported to MindIR: " << e.what();
+    return;
+  }
+  if (proto.empty()) {
+    return;
+  }
+  std::ostringstream meta;
+  meta << func_graph->parameters().size() << "\n";
+  for (auto &param : func_graph->parameters()) {
+    auto parameter = param->cast<ParameterPtr>();
+    MS_EXCEPTION_IF_NULL(parameter);
+    meta << (parameter->has_default() ? "w " + parameter->name() : "i") << "\n";
+  }
+  meta << key;
+
+  // creates the cache directory if needed
+  auto real_path = Common::GetRealPath(EntryPath(key));
+  if (!real_path.has_value()) {
+    MS_LOG(WARNING) << "Create compile cache directory " << dir_ << " failed.";
+    return;
+  }
+  // the graph goes first, an entry is only visible once its meta file exists
+  std::string path = real_path.value();
+  if (!WriteFile(path + ".mindir", proto) || !WriteFile(path + ".meta", meta.str())) {
+    MS_LOG(WARNING) << "Write compile cache entry " << path << " failed.";
+    return;
+  }
+  MS_LOG(INFO) << "Compile cache saved: " << path;
+}
+
+bool CompileCacheLoadAction(const ResourcePtr &res) {
+  MS_EXCEPTION_IF_NULL(res);
+  std::string dir = CompileCache::Dir();
+  if (dir.empty()) {
+    return true;
+  }
+  FuncGraphPtr func_graph = res->func_graph();
+  MS_EXCEPTION_IF_NULL(func_graph);
+  std::string key = CompileCache::Key(func_graph, res->args_spec());
+  res->results()[kCompileCacheKey] = key;
+
+  std::vector<ParameterPtr> weights;
+  for (auto &param : func_graph->parameters()) {
+    auto parameter = param->cast<ParameterPtr>();
+    if (parameter != nullptr && parameter->has_default()) {
+      weights.push_back(parameter);
+    }
+  }
+  FuncGraphPtr cached = CompileCache(dir).Load(key, weights);
+  if (cached == nullptr) {
+    return true;
+  }
+  auto manager = res->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  manager->AddFuncGraph(cached, true);
+  manager->KeepRoots({cached});
+  res->set_func_graph(cached);
+  res->results()[kCompileCacheHit] = true;
+  return true;
+}
+
+bool CompileCacheSaveAction(const ResourcePtr &res) {
+  MS_EXCEPTION_IF_NULL(res);
+  std::string dir = CompileCache::Dir();
+  if (dir.empty() || res->results().count(kCompileCacheKey) == 0 || res->results().count(kCompileCacheHit) != 0) {
+    return true;
+  }
+  CompileCache(dir).Save(res->results()[kCompileCacheKey].cast<std::string>(), res->func_graph());
+  return true;
+}
+}  // namespace pipeline
+}  // namespace mindspore
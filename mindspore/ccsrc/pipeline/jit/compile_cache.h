@@ -0,0 +1,73 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
+#define MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ir/func_graph.h"
+#include "pipeline/jit/resource.h"
+
+namespace mindspore {
+namespace pipeline {
+// Names of the cache actions, on a hit the pipeline skips every action in between
+const char kCompileCacheLoad[] = "compile_cache_load";
+const char kCompileCacheSave[] = "compile_cache_save";
+
+// Persistent cache of optimized graphs, turned on by setting MS_COMPILER_CACHE_PATH to a directory.
+// The key is the text of the resolved graph (structure, primitives with their attributes, constants and weight
+// shapes), the argument abstracts, the context flags that change the optimization and the build of the library.
+// An entry holds the optimized graph in MindIR and the order and names of its parameters; on load the weights are
+// bound to the parameters of the current network so the stored values are never used.
+// Only flat graphs are stored, since MindIR keeps a single graph. Kernels are still selected and built by the
+// backend, which has its own kernel caches.
+class CompileCache {
+ public:
+  explicit CompileCache(const std::string &dir) : dir_(dir) {}
+
+  ~CompileCache() = default;
+
+  // Cache directory, empty if the cache is off or the current context can not use it
+  static std::string Dir();
+
+  // Key text of a resolved graph
+  static std::string Key(const FuncGraphPtr &func_graph, const abstract::AbstractBasePtrList &args_spec);
+
+  // Load the optimized graph of a key.
+  // @param key key text
+  // @param weights parameters with default values of the resolved graph, the loaded graph uses their values
+  // @return the graph, nullptr on a miss
+  FuncGraphPtr Load(const std::string &key, const std::vector<ParameterPtr> &weights) const;
+
+  // Store the optimized graph of a key, does nothing if the graph can not be stored
+  void Save(const std::string &key, const FuncGraphPtr &func_graph) const;
+
+ private:
+  // Path of the files of a key without extension
+  std::string EntryPath(const std::string &key) const;
+
+  std::string dir_;
+};
+
+bool CompileCacheLoadAction(const ResourcePtr &res);
+bool CompileCacheSaveAction(const ResourcePtr &res);
+}  // namespace pipeline
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
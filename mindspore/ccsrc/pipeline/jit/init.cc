@@ -280,10 +280,12 @@ PYBIND11_MODULE(_c_expression, m) {
 
   (void)py::class_<EventWriter, std::shared_ptr<EventWriter>>(m, "EventWriter_")
     .def(py::init<const std::string &>())
+    .def(py::init<const std::string &, size_t, bool>())
     .def("GetFileName", &EventWriter::GetFileName, "Get the file name.")
     .def("Open", &EventWriter::Open, "Open the write file.")
     .def("Write", &EventWriter::Write, "Write the serialize event.")
     .def("EventCount", &EventWriter::GetWriteEventCount, "Write event count.")
+    .def("DroppedEventCount", &EventWriter::GetDroppedEventCount, "Dropped event count.")
     .def("Flush", &EventWriter::Flush, "Flush the event.")
     .def("Close", &EventWriter::Close, "Close the write.")
     .def("Shut", &EventWriter::Shut, "Final close the write.");
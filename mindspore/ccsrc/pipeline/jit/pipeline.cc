@@ -27,6 +27,7 @@
 
 #include "ir/param_info.h"
 #include "pipeline/jit/pass.h"
+#include "pipeline/jit/compile_cache.h"
 #include "pipeline/jit/parse/data_converter.h"
 #include "frontend/optimizer/ad/dfunctor.h"
 #include "debug/anf_ir_dump.h"
@@ -651,7 +652,14 @@ void Pipeline::Run() {
 
   WITH(MsProfile::GetProfile())[&user_graph, this]() {
     size_t i = 0;
+    bool skip = false;
     for (auto &action : actions_) {
+      // the compile cache had the optimized graph, skip the actions which build it
+      if (skip) {
+        skip = action.first != kCompileCacheSave;
+        i++;
+        continue;
+      }
 #ifdef ENABLE_TIMELINE
       DumpTime &dump_time = DumpTime::GetInstance();
       dump_time.Record(action.first, GetTime(), true);
@@ -684,6 +692,9 @@ void Pipeline::Run() {
       if (!result) {
         MS_LOG(EXCEPTION) << "Pipeline running to end, failed in step:" << action.first;
       }
+      if (action.first == kCompileCacheLoad && resource_->results().count(kCompileCacheHit) != 0) {
+        skip = true;
+      }
       if (MsContext::GetInstance()->get_param<bool>(MS_CTX_SAVE_GRAPHS_FLAG) && resource_->func_graph() != nullptr) {
         auto graph = resource_->func_graph();
         if (graph != nullptr) {
@@ -851,8 +862,9 @@ py::object ExecutorPy::Run(const py::tuple &args, const py::object &phase) {
   bool is_loopsink = info_[phase_s]->resource->gpu_loopsink_flag();
   int64_t sinksize = info_[phase_s]->resource->gpu_loopsink_size();
   ConfigManager::GetInstance().set_gpu_loopsink_size(is_loopsink ? sinksize : 1);
-  // If target is not gpu or is loopsink, keep vmloop 1.
-  bool g = (MsContext::GetInstance()->get_param<std::string>(MS_CTX_DEVICE_TARGET) == kGPUDevice);
+  // If target is not gpu or cpu, or is loopsink, keep vmloop 1.
+  auto target = MsContext::GetInstance()->get_param<std::string>(MS_CTX_DEVICE_TARGET);
+  bool g = (target == kGPUDevice || target == kCPUDevice);
   int64_t vm_loop = (!g || is_loopsink) ? 1 : sinksize;
   MS_LOG(INFO) << "VM loop size " << vm_loop << ", loopsink size " << (is_loopsink ? sinksize : 1);
   py::object ret;
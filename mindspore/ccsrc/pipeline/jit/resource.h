@@ -44,6 +44,8 @@ const char kBackend[] = "backend";
 const char kStepParallelGraph[] = "step_parallel";
 const char kOutput[] = "output";
 const char kPynativeGraphId[] = "graph_id";
+const char kCompileCacheKey[] = "compile_cache_key";
+const char kCompileCacheHit[] = "compile_cache_hit";
 
 class InferenceResource;
 
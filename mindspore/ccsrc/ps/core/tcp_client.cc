@@ -175,6 +175,11 @@ void TcpClient::ReadCallback(struct bufferevent *bev, void *ctx) {
   struct evbuffer *input = bufferevent_get_input(const_cast<struct bufferevent *>(bev));
   MS_EXCEPTION_IF_NULL(input);
 
+  if (!tcp_client->read_callback_) {
+    tcp_client->message_handler_.ReceiveMessage(input);
+    return;
+  }
+
   char read_buffer[4096];
 
   while (EVBUFFER_LENGTH(input) > 0) {
@@ -264,18 +269,15 @@ void TcpClient::SetMessageCallback(const OnMessage &cb) { message_callback_ = cb
 bool TcpClient::SendMessage(const CommMessage &message) const {
   MS_EXCEPTION_IF_NULL(buffer_event_);
   bufferevent_lock(buffer_event_);
-  bool res = true;
-  size_t buf_size = message.ByteSizeLong();
-  std::vector<unsigned char> serialized(buf_size);
-  message.SerializeToArray(serialized.data(), SizeToInt(buf_size));
-  if (bufferevent_write(buffer_event_, &buf_size, sizeof(buf_size)) == -1) {
-    MS_LOG(ERROR) << "Event buffer add header failed!";
-    res = false;
-  }
-  if (bufferevent_write(buffer_event_, serialized.data(), buf_size) == -1) {
-    MS_LOG(ERROR) << "Event buffer add protobuf data failed!";
-    res = false;
-  }
+  bool res = TcpMessageHandler::WriteMessage(bufferevent_get_output(buffer_event_), message);
+  bufferevent_unlock(buffer_event_);
+  return res;
+}
+
+bool TcpClient::SendMessage(std::shared_ptr<CommMessage> message) const {
+  MS_EXCEPTION_IF_NULL(buffer_event_);
+  bufferevent_lock(buffer_event_);
+  bool res = TcpMessageHandler::WriteMessage(bufferevent_get_output(buffer_event_), message);
   bufferevent_unlock(buffer_event_);
   return res;
 }
@@ -61,6 +61,8 @@ class TcpClient {
   void StartWithNoBlock();
   void SetMessageCallback(const OnMessage &cb);
   bool SendMessage(const CommMessage &message) const;
+  // Send without copying the data, the message must not be modified afterwards
+  bool SendMessage(std::shared_ptr<CommMessage> message) const;
   void StartTimer(const uint32_t &time);
   void set_timer_callback(const OnTimer &timer);
   const event_base &eventbase();
@@ -17,58 +17,145 @@
 #include "ps/core/tcp_message_handler.h"
 
 #include <arpa/inet.h>
+#include <algorithm>
 #include <iostream>
 #include <utility>
 
+#include "utils/convert_utils_base.h"
+
 namespace mindspore {
 namespace ps {
 namespace core {
+namespace {
+bool WriteMessageHeader(struct evbuffer *output, const CommMessage &message) {
+  CommMessage pb_message;
+  *pb_message.mutable_pb_meta() = message.pb_meta();
+  pb_message.set_user_cmd(message.user_cmd());
+  std::string serialized = pb_message.SerializeAsString();
+  MessageHeader header;
+  header.message_length_ = serialized.size();
+  header.data_length_ = message.data().size();
+  if (evbuffer_add(output, &header, kHeaderLen) == -1) {
+    MS_LOG(ERROR) << "Event buffer add header failed!";
+    return false;
+  }
+  if (evbuffer_add(output, serialized.data(), serialized.size()) == -1) {
+    MS_LOG(ERROR) << "Event buffer add protobuf data failed!";
+    return false;
+  }
+  return true;
+}
+
+void ReleaseMessage(const void *, size_t, void *message) {
+  delete static_cast<std::shared_ptr<CommMessage> *>(message);
+}
+}  // namespace
+
 void TcpMessageHandler::SetCallback(const messageReceive &message_receive) { message_callback_ = message_receive; }
 
+unsigned char *TcpMessageHandler::NextBuffer(size_t *len) {
+  MS_EXCEPTION_IF_NULL(len);
+  if (header_index_ < kHeaderLen) {
+    *len = kHeaderLen - header_index_;
+    return reinterpret_cast<unsigned char *>(&header_) + header_index_;
+  }
+  if (message_index_ < header_.message_length_) {
+    *len = header_.message_length_ - message_index_;
+    return message_buffer_.get() + message_index_;
+  }
+  *len = header_.data_length_ - data_index_;
+  return reinterpret_cast<unsigned char *>(&data_[0]) + data_index_;
+}
+
+void TcpMessageHandler::Consume(size_t len) {
+  if (header_index_ < kHeaderLen) {
+    header_index_ += len;
+    if (header_index_ == kHeaderLen) {
+      message_buffer_.reset(new unsigned char[header_.message_length_]);
+      data_.resize(header_.data_length_);
+    }
+  } else if (message_index_ < header_.message_length_) {
+    message_index_ += len;
+  } else {
+    data_index_ += len;
+  }
+  if (header_index_ < kHeaderLen || message_index_ < header_.message_length_ || data_index_ < header_.data_length_) {
+    return;
+  }
+
+  std::shared_ptr<CommMessage> pb_message = std::make_shared<CommMessage>();
+  pb_message->ParseFromArray(message_buffer_.get(), header_.message_length_);
+  pb_message->set_data(std::move(data_));
+  message_buffer_.reset();
+  data_ = std::string();
+  header_index_ = 0;
+  message_index_ = 0;
+  data_index_ = 0;
+  if (message_callback_) {
+    message_callback_(pb_message);
+  }
+}
+
 void TcpMessageHandler::ReceiveMessage(const void *buffer, size_t num) {
   MS_EXCEPTION_IF_NULL(buffer);
   auto buffer_data = reinterpret_cast<const unsigned char *>(buffer);
 
   while (num > 0) {
-    if (remaining_length_ == 0) {
-      for (int i = 0; i < kHeaderLen && num > 0; ++i) {
-        header_[++header_index_] = *(buffer_data + i);
-        --num;
-        if (header_index_ == kHeaderLen - 1) {
-          message_length_ = *reinterpret_cast<const size_t *>(header_);
-          remaining_length_ = message_length_;
-          message_buffer_.reset(new unsigned char[remaining_length_]);
-          buffer_data += (i + 1);
-          break;
-        }
-      }
+    size_t len = 0;
+    unsigned char *dest = NextBuffer(&len);
+    size_t copy_len = std::min(len, num);
+    int ret = memcpy_s(dest, copy_len, buffer_data, copy_len);
+    if (ret != 0) {
+      MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
     }
+    buffer_data += copy_len;
+    num -= copy_len;
+    Consume(copy_len);
+  }
+}
 
-    if (remaining_length_ > 0 && num > 0) {
-      size_t copy_len = remaining_length_ <= num ? remaining_length_ : num;
-      remaining_length_ -= copy_len;
-      num -= copy_len;
+void TcpMessageHandler::ReceiveMessage(struct evbuffer *input) {
+  MS_EXCEPTION_IF_NULL(input);
+  while (evbuffer_get_length(input) > 0) {
+    size_t len = 0;
+    unsigned char *dest = NextBuffer(&len);
+    int read = evbuffer_remove(input, dest, std::min(len, evbuffer_get_length(input)));
+    if (read == -1) {
+      MS_LOG(EXCEPTION) << "Can not drain data from the event buffer!";
+    }
+    Consume(IntToSize(read));
+  }
+}
 
-      int ret = memcpy_s(message_buffer_.get() + last_copy_len_, copy_len, buffer_data, copy_len);
-      last_copy_len_ += copy_len;
-      buffer_data += copy_len;
-      if (ret != 0) {
-        MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-      }
+bool TcpMessageHandler::WriteMessage(struct evbuffer *output, const CommMessage &message) {
+  MS_EXCEPTION_IF_NULL(output);
+  if (!WriteMessageHeader(output, message)) {
+    return false;
+  }
+  if (evbuffer_add(output, message.data().data(), message.data().size()) == -1) {
+    MS_LOG(ERROR) << "Event buffer add data failed!";
+    return false;
+  }
+  return true;
+}
 
-      if (remaining_length_ == 0) {
-        std::shared_ptr<CommMessage> pb_message = std::make_shared<CommMessage>();
-        pb_message->ParseFromArray(message_buffer_.get(), message_length_);
-        if (message_callback_) {
-          message_callback_(pb_message);
-        }
-        message_buffer_.reset();
-        message_buffer_ = nullptr;
-        header_index_ = -1;
-        last_copy_len_ = 0;
-      }
-    }
+bool TcpMessageHandler::WriteMessage(struct evbuffer *output, const std::shared_ptr<CommMessage> &message) {
+  MS_EXCEPTION_IF_NULL(output);
+  MS_EXCEPTION_IF_NULL(message);
+  if (!WriteMessageHeader(output, *message)) {
+    return false;
+  }
+  if (message->data().empty()) {
+    return true;
+  }
+  // the buffer keeps the message alive until the data is written to the socket
+  auto holder = new std::shared_ptr<CommMessage>(message);
+  if (evbuffer_add_reference(output, message->data().data(), message->data().size(), ReleaseMessage, holder) == -1) {
+    MS_LOG(ERROR) << "Event buffer add data failed!";
+    delete holder;
+    return false;
   }
+  return true;
 }
 }  // namespace core
 }  // namespace ps
@@ -17,6 +17,8 @@
 #ifndef MINDSPORE_CCSRC_PS_CORE_TCP_MESSAGE_HANDLER_H_
 #define MINDSPORE_CCSRC_PS_CORE_TCP_MESSAGE_HANDLER_H_
 
+#include <event2/buffer.h>
+
 #include <functional>
 #include <iostream>
 #include <string>
@@ -31,31 +33,45 @@ namespace mindspore {
 namespace ps {
 namespace core {
 using messageReceive = std::function<void(std::shared_ptr<CommMessage>)>;
-constexpr int kHeaderLen = 8;
+
+// A message is framed as this header, the CommMessage without its data serialized by protobuf, and the data as raw
+// bytes, so tensors are never serialized and can be sent from and received into their own buffers.
+struct MessageHeader {
+  size_t message_length_ = 0;
+  size_t data_length_ = 0;
+};
+constexpr size_t kHeaderLen = sizeof(MessageHeader);
 
 class TcpMessageHandler {
  public:
   TcpMessageHandler()
-      : is_parsed_(false),
-        message_buffer_(nullptr),
-        message_length_(0),
-        remaining_length_(0),
-        header_index_(-1),
-        last_copy_len_(0) {}
+      : message_buffer_(nullptr), header_{}, header_index_(0), message_index_(0), data_index_(0) {}
   virtual ~TcpMessageHandler() = default;
 
   void SetCallback(const messageReceive &cb);
   void ReceiveMessage(const void *buffer, size_t num);
+  // Drain the input buffer of a connection, reading straight into the buffers of the messages
+  void ReceiveMessage(struct evbuffer *input);
+
+  // Add a message to the output buffer of a connection, copying the data
+  static bool WriteMessage(struct evbuffer *output, const CommMessage &message);
+  // Add a message to the output buffer of a connection, the buffer references the data until it is sent, so the
+  // message must not be modified after this call
+  static bool WriteMessage(struct evbuffer *output, const std::shared_ptr<CommMessage> &message);
 
  private:
+  // Where the next bytes of the stream go and how many of them are expected there
+  unsigned char *NextBuffer(size_t *len);
+  // Account for len bytes written to the next buffer
+  void Consume(size_t len);
+
   messageReceive message_callback_;
-  bool is_parsed_;
-  std::unique_ptr<unsigned char> message_buffer_;
-  size_t message_length_;
-  size_t remaining_length_;
-  char header_[8];
-  int header_index_;
-  size_t last_copy_len_;
+  std::unique_ptr<unsigned char[]> message_buffer_;
+  std::string data_;
+  MessageHeader header_;
+  size_t header_index_;
+  size_t message_index_;
+  size_t data_index_;
 };
 }  // namespace core
 }  // namespace ps
@@ -36,6 +36,8 @@ void TcpConnection::InitConnection(const messageReceive &callback) { tcp_message
 
 void TcpConnection::OnReadHandler(const void *buffer, size_t num) { tcp_message_handler_.ReceiveMessage(buffer, num); }
 
+void TcpConnection::OnReadHandler(struct evbuffer *input) { tcp_message_handler_.ReceiveMessage(input); }
+
 void TcpConnection::SendMessage(const void *buffer, size_t num) const {
   if (bufferevent_write(buffer_event_, buffer, num) == -1) {
     MS_LOG(ERROR) << "Write message to buffer event failed!";
@@ -52,18 +54,7 @@ bool TcpConnection::SendMessage(std::shared_ptr<CommMessage> message) const {
   MS_EXCEPTION_IF_NULL(buffer_event_);
   MS_EXCEPTION_IF_NULL(message);
   bufferevent_lock(buffer_event_);
-  bool res = true;
-  size_t buf_size = message->ByteSizeLong();
-  std::vector<unsigned char> serialized(buf_size);
-  message->SerializeToArray(serialized.data(), SizeToInt(buf_size));
-  if (bufferevent_write(buffer_event_, &buf_size, sizeof(buf_size)) == -1) {
-    MS_LOG(ERROR) << "Event buffer add header failed!";
-    res = false;
-  }
-  if (bufferevent_write(buffer_event_, serialized.data(), buf_size) == -1) {
-    MS_LOG(ERROR) << "Event buffer add protobuf data failed!";
-    res = false;
-  }
+  bool res = TcpMessageHandler::WriteMessage(bufferevent_get_output(buffer_event_), message);
   bufferevent_unlock(buffer_event_);
   return res;
 }
@@ -303,14 +294,7 @@ void TcpServer::ReadCallback(struct bufferevent *bev, void *connection) {
 
   auto conn = static_cast<class TcpConnection *>(connection);
   struct evbuffer *buf = bufferevent_get_input(bev);
-  char read_buffer[4096];
-  while (EVBUFFER_LENGTH(buf) > 0) {
-    int read = evbuffer_remove(buf, &read_buffer, sizeof(read_buffer));
-    if (read == -1) {
-      MS_LOG(EXCEPTION) << "Can not drain data from the event buffer!";
-    }
-    conn->OnReadHandler(read_buffer, IntToSize(read));
-  }
+  conn->OnReadHandler(buf);
 }
 
 void TcpServer::EventCallback(struct bufferevent *bev, std::int16_t events, void *data) {
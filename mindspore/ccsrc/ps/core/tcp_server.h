@@ -56,6 +56,8 @@ class TcpConnection {
   virtual void SendMessage(const void *buffer, size_t num) const;
   bool SendMessage(std::shared_ptr<CommMessage> message) const;
   virtual void OnReadHandler(const void *buffer, size_t numBytes);
+  // Read the messages of the input buffer straight into their own buffers
+  virtual void OnReadHandler(struct evbuffer *input);
   TcpServer *GetServer() const;
   const evutil_socket_t &GetFd() const;
   void set_callback(const Callback &callback);
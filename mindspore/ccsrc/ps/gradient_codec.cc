@@ -0,0 +1,271 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/gradient_codec.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "base/float16.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+constexpr float kInt8Max = 127;
+constexpr size_t kValuesPerFloat16 = 2;
+constexpr size_t kValuesPerFloat8 = 4;
+constexpr size_t kShapeEntrySize = 3;
+
+uint16_t FloatToHalfBits(float value) {
+  float16 half(value);
+  uint16_t bits;
+  (void)memcpy(&bits, &half, sizeof(bits));
+  return bits;
+}
+
+float HalfBitsToFloat(uint16_t bits) {
+  float16 half;
+  (void)memcpy(&half, &bits, sizeof(bits));
+  return half_to_float(half);
+}
+
+// Round to nearest even, bf16 being the upper half of a float
+uint16_t FloatToBf16Bits(float value) {
+  if (std::isnan(value)) {
+    return 0x7FC0;
+  }
+  uint32_t bits;
+  (void)memcpy(&bits, &value, sizeof(bits));
+  bits += 0x7FFF + ((bits >> 16) & 1);
+  return static_cast<uint16_t>(bits >> 16);
+}
+
+float Bf16BitsToFloat(uint16_t bits) {
+  uint32_t value_bits = static_cast<uint32_t>(bits) << 16;
+  float value;
+  (void)memcpy(&value, &value_bits, sizeof(value));
+  return value;
+}
+
+template <typename ToBits, typename FromBits>
+void Encode16(const float *values, size_t n, float *residual, float *out, ToBits to_bits, FromBits from_bits) {
+  uint16_t *dst = reinterpret_cast<uint16_t *>(out);
+  for (size_t i = 0; i < n; i++) {
+    dst[i] = to_bits(values[i]);
+    if (residual != nullptr) {
+      residual[i] -= from_bits(dst[i]);
+    }
+  }
+}
+
+template <typename FromBits>
+void DecodeAccumulate16(const float *payload, float *accum, size_t n, FromBits from_bits) {
+  const uint16_t *src = reinterpret_cast<const uint16_t *>(payload);
+  for (size_t i = 0; i < n; i++) {
+    accum[i] += from_bits(src[i]);
+  }
+}
+}  // namespace
+
+GradientCodec GradientCodec::FromEnv() {
+  std::string env = common::GetEnv(kEnvGradCompression);
+  if (env.empty()) {
+    return GradientCodec();
+  }
+  if (env == "fp16") {
+    return GradientCodec(GradCodecType::kFp16, kDefaultTopKRatio);
+  }
+  if (env == "bf16") {
+    return GradientCodec(GradCodecType::kBf16, kDefaultTopKRatio);
+  }
+  if (env == "int8") {
+    return GradientCodec(GradCodecType::kInt8, kDefaultTopKRatio);
+  }
+  if (env.compare(0, 4, "topk") == 0) {
+    float ratio = kDefaultTopKRatio;
+    if (env.size() > 4) {
+      ratio = env[4] == ':' ? std::strtof(env.c_str() + 5, nullptr) : 0;
+    }
+    if (ratio > 0 && ratio <= 1) {
+      return GradientCodec(GradCodecType::kTopK, ratio);
+    }
+  }
+  MS_LOG(WARNING) << "Invalid " << kEnvGradCompression << ": " << env << ", gradients are pushed uncompressed.";
+  return GradientCodec();
+}
+
+size_t GradientCodec::TopK(size_t n) const {
+  size_t k = static_cast<size_t>(std::ceil(n * topk_ratio_));
+  return std::min(std::max(k, static_cast<size_t>(1)), n);
+}
+
+size_t GradientCodec::EncodedSize(size_t n) const {
+  switch (type_) {
+    case GradCodecType::kFp16:
+    case GradCodecType::kBf16:
+      return (n + kValuesPerFloat16 - 1) / kValuesPerFloat16;
+    case GradCodecType::kInt8:
+      return 1 + (n + kValuesPerFloat8 - 1) / kValuesPerFloat8;
+    case GradCodecType::kTopK:
+      return 2 * TopK(n);
+    default:
+      return n;
+  }
+}
+
+void GradientCodec::Encode(const float *grad, size_t n, float *residual, float *out) const {
+  if (n == 0) {
+    return;
+  }
+  const float *values = grad;
+  if (residual != nullptr) {
+    for (size_t i = 0; i < n; i++) {
+      residual[i] += grad[i];
+    }
+    values = residual;
+  }
+  size_t size = EncodedSize(n);
+  // clear the padding of the last float
+  out[size - 1] = 0;
+
+  switch (type_) {
+    case GradCodecType::kFp16:
+      Encode16(values, n, residual, out, FloatToHalfBits, HalfBitsToFloat);
+      break;
+    case GradCodecType::kBf16:
+      Encode16(values, n, residual, out, FloatToBf16Bits, Bf16BitsToFloat);
+      break;
+    case GradCodecType::kInt8: {
+      float max_abs = 0;
+      for (size_t i = 0; i < n; i++) {
+        max_abs = std::max(max_abs, std::fabs(values[i]));
+      }
+      float scale = max_abs / kInt8Max;
+      float inv_scale = scale > 0 ? 1 / scale : 0;
+      out[0] = scale;
+      int8_t *dst = reinterpret_cast<int8_t *>(out + 1);
+      for (size_t i = 0; i < n; i++) {
+        float q = std::round(values[i] * inv_scale);
+        dst[i] = static_cast<int8_t>(std::min(std::max(q, -kInt8Max), kInt8Max));
+        if (residual != nullptr) {
+          residual[i] -= dst[i] * scale;
+        }
+      }
+      break;
+    }
+    case GradCodecType::kTopK: {
+      size_t k = TopK(n);
+      std::vector<uint32_t> indices(n);
+      for (size_t i = 0; i < n; i++) {
+        indices[i] = static_cast<uint32_t>(i);
+      }
+      (void)std::nth_element(indices.begin(), indices.begin() + (k - 1), indices.end(),
+                             [values](uint32_t a, uint32_t b) { return std::fabs(values[a]) > std::fabs(values[b]); });
+      for (size_t j = 0; j < k; j++) {
+        uint32_t index = indices[j];
+        (void)memcpy(&out[2 * j], &index, sizeof(index));
+        out[2 * j + 1] = values[index];
+        if (residual != nullptr) {
+          residual[index] = 0;
+        }
+      }
+      break;
+    }
+    default:
+      (void)memcpy(out, values, n * sizeof(float));
+      if (residual != nullptr) {
+        (void)memset(residual, 0, n * sizeof(float));
+      }
+      break;
+  }
+}
+
+bool GradientCodec::DecodeAccumulate(const float *payload, size_t size, float *accum, size_t n) const {
+  if (size != EncodedSize(n)) {
+    MS_LOG(ERROR) << "The " << ToString() << " payload of " << n << " values has " << size << " floats, expect "
+                  << EncodedSize(n);
+    return false;
+  }
+  switch (type_) {
+    case GradCodecType::kFp16:
+      DecodeAccumulate16(payload, accum, n, HalfBitsToFloat);
+      break;
+    case GradCodecType::kBf16:
+      DecodeAccumulate16(payload, accum, n, Bf16BitsToFloat);
+      break;
+    case GradCodecType::kInt8: {
+      float scale = payload[0];
+      const int8_t *src = reinterpret_cast<const int8_t *>(payload + 1);
+      for (size_t i = 0; i < n; i++) {
+        accum[i] += src[i] * scale;
+      }
+      break;
+    }
+    case GradCodecType::kTopK:
+      for (size_t j = 0; j < size / 2; j++) {
+        uint32_t index;
+        (void)memcpy(&index, &payload[2 * j], sizeof(index));
+        if (index >= n) {
+          MS_LOG(ERROR) << "The index " << index << " of the top-k payload is out of range " << n;
+          return false;
+        }
+        accum[index] += payload[2 * j + 1];
+      }
+      break;
+    default:
+      for (size_t i = 0; i < n; i++) {
+        accum[i] += payload[i];
+      }
+      break;
+  }
+  return true;
+}
+
+std::vector<float> GradientCodec::ToShapeEntry() const {
+  return {kGradCodecTag, static_cast<float>(type_), topk_ratio_};
+}
+
+bool GradientCodec::FromShapeEntry(const float *entry, size_t size, GradientCodec *codec) {
+  MS_EXCEPTION_IF_NULL(codec);
+  if (size != kShapeEntrySize || entry[0] != kGradCodecTag) {
+    return false;
+  }
+  int type = static_cast<int>(entry[1]);
+  if (type < static_cast<int>(GradCodecType::kNone) || type > static_cast<int>(GradCodecType::kTopK)) {
+    MS_LOG(EXCEPTION) << "Unknown gradient codec " << type;
+  }
+  *codec = GradientCodec(static_cast<GradCodecType>(type), entry[2]);
+  return true;
+}
+
+std::string GradientCodec::ToString() const {
+  switch (type_) {
+    case GradCodecType::kFp16:
+      return "fp16";
+    case GradCodecType::kBf16:
+      return "bf16";
+    case GradCodecType::kInt8:
+      return "int8";
+    case GradCodecType::kTopK:
+      return "topk:" + std::to_string(topk_ratio_);
+    default:
+      return "none";
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
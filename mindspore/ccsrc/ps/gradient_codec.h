@@ -0,0 +1,87 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_GRADIENT_CODEC_H_
+#define MINDSPORE_CCSRC_PS_GRADIENT_CODEC_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace mindspore {
+namespace ps {
+// fp16, bf16, int8, topk or topk:<ratio of the values sent>, unset to push full fp32 gradients
+constexpr char kEnvGradCompression[] = "MS_PS_GRAD_COMPRESSION";
+// Marks the codec entry the worker appends after the optimizer input shapes, shapes are never negative
+constexpr float kGradCodecTag = -1;
+// Gradients with fewer values are always pushed in fp32
+constexpr size_t kGradCodecMinSize = 1024;
+constexpr float kDefaultTopKRatio = 0.01;
+
+enum class GradCodecType : int { kNone = 0, kFp16 = 1, kBf16 = 2, kInt8 = 3, kTopK = 4 };
+
+// Encoding of the dense gradients pushed to the parameter servers. A payload is an array of floats so that it fits
+// in the KVPairs of a push:
+//   fp16/bf16: two 16-bit values in each float
+//   int8: the scale, then four values in each float
+//   topk: the index (as int bits) and the value of the k largest values in magnitude
+// The worker picks the codec of a key and sends it with the optimizer input shapes, the server then decodes the
+// pushed gradients while accumulating them.
+class GradientCodec {
+ public:
+  GradientCodec() : type_(GradCodecType::kNone), topk_ratio_(kDefaultTopKRatio) {}
+  GradientCodec(GradCodecType type, float topk_ratio) : type_(type), topk_ratio_(topk_ratio) {}
+  ~GradientCodec() = default;
+
+  // Codec set by MS_PS_GRAD_COMPRESSION
+  static GradientCodec FromEnv();
+
+  GradCodecType type() const { return type_; }
+  float topk_ratio() const { return topk_ratio_; }
+  bool enabled() const { return type_ != GradCodecType::kNone; }
+
+  // Whether the error of the encoding is kept by the worker and added to the next gradient of the key
+  bool error_feedback() const { return type_ == GradCodecType::kInt8 || type_ == GradCodecType::kTopK; }
+
+  // Number of floats of the payload of n values
+  size_t EncodedSize(size_t n) const;
+
+  // Encode n values into EncodedSize(n) floats of out.
+  // @param residual n floats of error feedback or nullptr, added to grad and set to the part which was not sent
+  void Encode(const float *grad, size_t n, float *residual, float *out) const;
+
+  // Decode a payload of n values and add them to accum
+  // @return false if the payload does not match n
+  bool DecodeAccumulate(const float *payload, size_t size, float *accum, size_t n) const;
+
+  // Entry appended to the optimizer input shapes
+  std::vector<float> ToShapeEntry() const;
+
+  // Parse an entry of the optimizer input shapes
+  // @return false if the entry is a shape
+  static bool FromShapeEntry(const float *entry, size_t size, GradientCodec *codec);
+
+  std::string ToString() const;
+
+ private:
+  size_t TopK(size_t n) const;
+
+  GradCodecType type_;
+  float topk_ratio_;
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_GRADIENT_CODEC_H_
@@ -85,6 +85,12 @@ void DenseOptimInfo::Accumulate(const Values &values, const Lengths &lengths) {
     grad_offset += lengths[i];
   }
   float *grad_data = values.data() + grad_offset;
+  if (grad_codec_.enabled()) {
+    if (!grad_codec_.DecodeAccumulate(grad_data, lengths[grad_index], accum_grad_data, size)) {
+      MS_LOG(EXCEPTION) << "Decoding the pushed gradient failed.";
+    }
+    return;
+  }
   CHECK_EQ(size, static_cast<size_t>(lengths[grad_index]));
 
   for (size_t i = 0; i < size; i++) {
@@ -21,6 +21,7 @@
 #include <string>
 #include "backend/kernel_compiler/kernel.h"
 #include "ps/common.h"
+#include "ps/gradient_codec.h"
 
 namespace mindspore {
 namespace ps {
@@ -36,6 +37,8 @@ class OptimizerInfo {
                            size_t rank_id) {}
   virtual void Reset() {}
   void AddWorkspace(const AddressPtr &workspace);
+  // Codec of the pushed gradients, decoded by Accumulate
+  void set_grad_codec(const GradientCodec &grad_codec) { grad_codec_ = grad_codec; }
 
   virtual const AddressPtr &gradient() = 0;
   virtual const AddressPtr &indices() = 0;
@@ -55,6 +58,7 @@ class OptimizerInfo {
   std::vector<AddressPtr> inputs_;
   std::vector<AddressPtr> workspaces_;
   std::vector<AddressPtr> outputs_;
+  GradientCodec grad_codec_;
 };
 
 class DenseOptimInfo : public OptimizerInfo {
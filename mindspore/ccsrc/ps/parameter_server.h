@@ -37,6 +37,7 @@
 #include "backend/session/anf_runtime_algorithm.h"
 #include "backend/session/session_factory.h"
 #include "ps/common.h"
+#include "ps/gradient_codec.h"
 #include "ps/optimizer_info.h"
 #include "ps/optimizer_info_builder.h"
 #include "ps/util.h"
@@ -127,6 +128,7 @@ class ParameterServer {
   void Finalize();
   void UpdateWeights();
   void AccumGrad(const Keys &key, const Values &values, const Lengths &lengths);
+  void DecodeGrad(const Key &key, const Values &values, const Lengths &lengths, Values *grads, Lengths *grad_lengths);
   WeightPtr weight(const Key &key);
   void DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, ::ps::KVPairs<T> *res);
   void UpdateEmbeddings(const Key &key, const LookupIds &lookup_ids, const Values &vals);
@@ -152,6 +154,7 @@ class ParameterServer {
   std::unordered_map<Key, std::shared_ptr<PServerKernel>> optimizers_;
   std::unordered_map<Key, InputsShapePtr> optim_inputs_shape_;
   std::unordered_map<Key, InputsShapePtr> original_optim_inputs_shape_;
+  std::unordered_map<Key, GradientCodec> grad_codecs_;
   std::unordered_map<Key, std::shared_ptr<OptimizerInfo>> optim_infos_;
   std::unordered_map<std::string, std::shared_ptr<OptimizerInfoBuilder>> optim_info_builders_;
   std::unordered_map<Key, std::string> weight_key_to_optims_;
@@ -425,7 +428,20 @@ void ParameterServer<T>::InitOptimInputsShape(const Keys &keys, const Values &va
     original_optim_inputs_shape_[key] = original_inputs_shape;
     optim_inputs_shape_[key] = inputs_shape;
   }
-  for (size_t i = 0; i < keys.size(); i++) {
+  // The worker appends the codec of the gradients it pushes for the key after the shapes
+  size_t shape_num = keys.size();
+  GradientCodec grad_codec;
+  if (shape_num > 0 && GradientCodec::FromShapeEntry(values.data() + values.size() - lengths[shape_num - 1],
+                                                     lengths[shape_num - 1], &grad_codec)) {
+    shape_num--;
+    if (grad_codec.enabled() && weight_key_to_optims_[key] != kApplyMomentum) {
+      MS_LOG(EXCEPTION) << "Gradient compression is only supported by " << kApplyMomentum << ", key " << key
+                        << " uses " << weight_key_to_optims_[key];
+    }
+    MS_LOG(INFO) << "Gradients of key " << key << " are pushed in " << grad_codec.ToString();
+    grad_codecs_[key] = grad_codec;
+  }
+  for (size_t i = 0; i < shape_num; i++) {
     auto shape = std::make_shared<std::vector<size_t>>();
     MS_EXCEPTION_IF_NULL(shape);
     auto original_shape = std::make_shared<std::vector<size_t>>();
@@ -618,9 +634,21 @@ void ParameterServer<T>::AccumGrad(const Keys &keys, const Values &values, const
         MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << weight_key_to_optims_[key];
       }
       MS_EXCEPTION_IF_NULL(pserver_kernel);
-      OptimizerInfo *optim = builder->Build(pserver_kernel, weights_[key], keys, values, lengths,
-                                            optim_inputs_shape_[key], worker_num_, is_embedding_[key]);
+      const GradientCodec &grad_codec = grad_codecs_[key];
+      OptimizerInfo *optim = nullptr;
+      if (grad_codec.enabled()) {
+        // The optimizer info copies the first gradient, later ones are decoded while accumulating
+        Values grads;
+        Lengths grad_lengths;
+        DecodeGrad(key, values, lengths, &grads, &grad_lengths);
+        optim = builder->Build(pserver_kernel, weights_[key], keys, grads, grad_lengths, optim_inputs_shape_[key],
+                               worker_num_, is_embedding_[key]);
+      } else {
+        optim = builder->Build(pserver_kernel, weights_[key], keys, values, lengths, optim_inputs_shape_[key],
+                               worker_num_, is_embedding_[key]);
+      }
       optim_info.reset(optim);
+      optim_info->set_grad_codec(grad_codec);
       optim_infos_[key] = optim_info;
     } else {
       optim_info->Update(values, lengths);
@@ -637,6 +665,32 @@ void ParameterServer<T>::AccumGrad(const Keys &keys, const Values &values, const
   }
 }
 
+template <typename T>
+void ParameterServer<T>::DecodeGrad(const Key &key, const Values &values, const Lengths &lengths, Values *grads,
+                                    Lengths *grad_lengths) {
+  MS_EXCEPTION_IF_NULL(grads);
+  MS_EXCEPTION_IF_NULL(grad_lengths);
+  size_t grad_index = kMomentumPSSendIdx.at("grad");
+  EXC_IF_VEC_IDX_OOB(lengths, grad_index);
+  size_t grad_size = weights_[key]->size();
+  size_t offset = 0;
+  for (size_t i = 0; i < lengths.size(); i++) {
+    size_t length = IntToSize(lengths[i]);
+    if (i != grad_index) {
+      grads->append(Values(values.data() + offset, length));
+      grad_lengths->push_back(lengths[i]);
+    } else {
+      Values grad(grad_size, 0);
+      if (!grad_codecs_[key].DecodeAccumulate(values.data() + offset, length, grad.data(), grad_size)) {
+        MS_LOG(EXCEPTION) << "Decoding the gradient of key " << key << " failed.";
+      }
+      grads->append(grad);
+      grad_lengths->push_back(SizeToInt(grad_size));
+    }
+    offset += length;
+  }
+}
+
 template <typename T>
 WeightPtr ParameterServer<T>::weight(const Key &key) {
   std::unique_lock<std::mutex> lock(mutex_);
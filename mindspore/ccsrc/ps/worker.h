@@ -30,6 +30,7 @@
 #include "ir/tensor.h"
 #include "ps/util.h"
 #include "ps/common.h"
+#include "ps/gradient_codec.h"
 #include "ps/worker_proxy.h"
 #include "utils/shape_utils.h"
 #include "ps/ps_cache/ps_data/ps_data_prefetch.h"
@@ -83,6 +84,9 @@ class Worker {
   std::map<size_t, bool> init_keys_;
   std::map<size_t, int64_t> key_to_optimId_;
   std::map<size_t, std::vector<ShapeVector>> key_to_optim_shapes_;
+  std::map<size_t, GradientCodec> key_to_grad_codec_;
+  // error feedback of the keys whose codec keeps it
+  std::map<size_t, std::vector<float>> key_to_grad_residual_;
   std::map<std::string, bool> param_to_init_in_server_;
 };
 
@@ -130,7 +134,16 @@ void Worker<T>::Push(const std::vector<size_t> &keys, std::vector<uintptr_t> add
     indice_index = 1;
   }
 
-  size_t total_size = std::accumulate(sizes.begin(), sizes.end(), 0, std::plus<int64_t>());
+  // The dense gradient is encoded by the codec of the key, the other inputs are sent as they are
+  const GradientCodec &grad_codec = key_to_grad_codec_[key];
+  size_t dense_grad_index = is_sparse || !grad_codec.enabled() ? sizes.size() : kMomentumPSSendIdx.at("grad");
+  std::vector<int> sizes_int;
+  for (size_t i = 0; i < sizes.size(); i++) {
+    size_t size = i == dense_grad_index ? grad_codec.EncodedSize(LongToSize(sizes[i])) : LongToSize(sizes[i]);
+    sizes_int.push_back(SizeToInt(size));
+  }
+
+  size_t total_size = std::accumulate(sizes_int.begin(), sizes_int.end(), 0, std::plus<int64_t>());
   ::ps::SArray<T> total_buffer(total_size, 0);
   size_t offset = 0;
   size_t dst_size = 0;
@@ -140,6 +153,16 @@ void Worker<T>::Push(const std::vector<size_t> &keys, std::vector<uintptr_t> add
     void *src_data = reinterpret_cast<void *>(addrs[i]);
     MS_EXCEPTION_IF_NULL(dst_data);
     MS_EXCEPTION_IF_NULL(src_data);
+    if (i == dense_grad_index) {
+      std::vector<float> &residual = key_to_grad_residual_[key];
+      if (grad_codec.error_feedback() && residual.empty()) {
+        residual.resize(LongToSize(sizes[i]), 0);
+      }
+      grad_codec.Encode(reinterpret_cast<const float *>(src_data), LongToSize(sizes[i]),
+                        residual.empty() ? nullptr : residual.data(), reinterpret_cast<float *>(dst_data));
+      offset += sizes_int[i] * sizeof(T);
+      continue;
+    }
     dst_size = sizes[i] * sizeof(T);
     src_size = sizes[i] * sizeof(T);
     auto ret = memcpy_s(dst_data, dst_size, src_data, src_size);
@@ -153,9 +176,6 @@ void Worker<T>::Push(const std::vector<size_t> &keys, std::vector<uintptr_t> add
   while (!kv_worker_->IsReadyForPush(keys[0])) {
     continue;
   }
-  std::vector<int> sizes_int;
-  (void)std::transform(sizes.begin(), sizes.end(), std::back_inserter(sizes_int),
-                       [](const int64_t &value) { return static_cast<int>(value); });
   if (!is_sparse) {
     kv_worker_->PushData(::ps::SArray<::ps::Key>(keys), total_buffer, ::ps::SArray<int>(sizes_int));
   } else {
@@ -246,6 +266,24 @@ void Worker<T>::InitPSOptimInputShapes(const size_t key) {
       }
     }
   }
+
+  // Dense gradients which are large enough are compressed, the codec is sent after the shapes
+  GradientCodec grad_codec = GradientCodec::FromEnv();
+  size_t grad_origin_index = kMomentumOriginIdx.at("grad");
+  if (grad_codec.enabled() && key_to_optimId_[key] == Util::optimizer_id(kApplyMomentum) &&
+      shapes.size() > grad_origin_index) {
+    const ShapeVector &grad_shape = shapes[grad_origin_index];
+    size_t grad_size = std::accumulate(grad_shape.begin(), grad_shape.end(), 1, std::multiplies<int64_t>());
+    if (grad_size >= kGradCodecMinSize) {
+      key_to_grad_codec_[key] = grad_codec;
+      keys.push_back(key);
+      std::vector<float> entry = grad_codec.ToShapeEntry();
+      shape_len.push_back(SizeToInt(entry.size()));
+      for (auto value : entry) {
+        all_shape.push_back(static_cast<T>(value));
+      }
+    }
+  }
   MS_LOG(INFO) << "keys:" << keys;
   MS_LOG(INFO) << "shape_len:" << shape_len;
   MS_LOG(INFO) << "all_shape:" << all_shape;
@@ -16,6 +16,9 @@
 
 #include "pybind_api/ir/tensor_py.h"
 
+#include <functional>
+#include <memory>
+#include <numeric>
 #include <vector>
 #include <sstream>
 #include <string>
@@ -24,6 +27,7 @@
 #include "pybind_api/api_register.h"
 #include "abstract/abstract_value.h"
 #include "utils/shape_utils.h"
+#include "utils/dlpack.h"
 
 namespace mindspore {
 namespace tensor {
@@ -171,6 +175,75 @@ class TensorDataNumpy : public TensorData {
   py::buffer_info buffer_;
 };
 
+// TensorDataDLPack implements TensorData on the memory of a DLPack tensor, which is given back by its deleter.
+class TensorDataDLPack : public TensorData {
+ public:
+  explicit TensorDataDLPack(DLManagedTensor *managed) : managed_(managed) {
+    auto &dl_tensor = managed_->dl_tensor;
+    size_ = std::accumulate(dl_tensor.shape, dl_tensor.shape + dl_tensor.ndim, ssize_t(1), std::multiplies<ssize_t>());
+    data_ = static_cast<char *>(dl_tensor.data) + dl_tensor.byte_offset;
+  }
+
+  ~TensorDataDLPack() override {
+    if (managed_->deleter == nullptr) {
+      return;
+    }
+    // the producer may be a python object
+    if (Py_IsInitialized()) {
+      py::gil_scoped_acquire acquire;
+      managed_->deleter(managed_);
+    } else {
+      managed_->deleter(managed_);
+    }
+  }
+
+  ssize_t size() const override { return size_; }
+
+  ssize_t itemsize() const override { return managed_->dl_tensor.dtype.bits / 8; }
+
+  ssize_t nbytes() const override { return size() * itemsize(); }
+
+  ssize_t ndim() const override { return managed_->dl_tensor.ndim; }
+
+  void *data() override { return data_; }
+
+  const void *const_data() const override { return data_; }
+
+  std::string ToString(const TypeId type, const ShapeVector &shape, bool use_comma) const override {
+    std::vector<ssize_t> array_shape(shape.begin(), shape.end());
+    py::str dummyOwner;
+    py::array array(py::dtype(GetPyTypeFormat(type)), array_shape, data_, dummyOwner);
+    if (use_comma) {
+      py::dict kwargs;
+      kwargs["separator"] = ", ";
+      return py::str(py::module::import("numpy").attr("array2string")(array, **kwargs));
+    }
+    return py::str(array);
+  }
+
+ private:
+  DLManagedTensor *managed_;
+  ssize_t size_;
+  void *data_;
+};
+
+// The DLPack tensor handed to a consumer, it shares the data of the tensor
+struct DLPackContext {
+  TensorDataPtr data;
+  std::vector<int64_t> shape;
+  DLManagedTensor managed;
+};
+
+static void DeleteDLPackContext(DLManagedTensor *managed) { delete static_cast<DLPackContext *>(managed->manager_ctx); }
+
+// Only a capsule nobody consumed still owns its tensor
+static void DestructDLPackCapsule(PyObject *capsule) {
+  if (PyCapsule_IsValid(capsule, kDLPackCapsuleName)) {
+    auto managed = static_cast<DLManagedTensor *>(PyCapsule_GetPointer(capsule, kDLPackCapsuleName));
+    managed->deleter(managed);
+  }
+}
+
 TensorPtr TensorPy::MakeTensor(const py::array &input, const TypePtr &type_ptr) {
   // Get input buffer info.
   py::buffer_info buf = input.request();
@@ -228,6 +301,44 @@ TensorPtr TensorPy::MakeTensorNoCopy(const py::array &input) {
   return std::make_shared<Tensor>(dtype, shape, tensor_data);
 }
 
+TensorPtr TensorPy::MakeTensorFromDLPack(const py::object &input) {
+  py::object capsule = input;
+  if (!PyCapsule_CheckExact(input.ptr())) {
+    if (!py::hasattr(input, "__dlpack__")) {
+      MS_LOG(EXCEPTION) << "The input should be a DLPack capsule or support __dlpack__.";
+    }
+    capsule = input.attr("__dlpack__")();
+  }
+  auto managed = static_cast<DLManagedTensor *>(PyCapsule_GetPointer(capsule.ptr(), kDLPackCapsuleName));
+  if (managed == nullptr) {
+    PyErr_Clear();
+    MS_LOG(EXCEPTION) << "The DLPack capsule is consumed already.";
+  }
+  // Checks go first, the producer keeps the tensor when one fails.
+  auto &dl_tensor = managed->dl_tensor;
+  if (dl_tensor.device.device_type != kDLCPU && dl_tensor.device.device_type != kDLCUDAHost) {
+    MS_LOG(EXCEPTION) << "Only a DLPack tensor in host memory is supported, but got device type "
+                      << dl_tensor.device.device_type;
+  }
+  auto dtype = DLDataTypeToTypeId(dl_tensor.dtype);
+  if (dtype == TypeId::kTypeUnknown) {
+    MS_LOG(EXCEPTION) << "Unsupported DLPack data type, code " << static_cast<int>(dl_tensor.dtype.code) << " bits "
+                      << static_cast<int>(dl_tensor.dtype.bits) << " lanes " << dl_tensor.dtype.lanes;
+  }
+  ShapeVector shape(dl_tensor.shape, dl_tensor.shape + dl_tensor.ndim);
+  if (dl_tensor.strides != nullptr) {
+    int64_t stride = 1;
+    for (int i = dl_tensor.ndim - 1; i >= 0; --i) {
+      if (shape[i] != 1 && dl_tensor.strides[i] != stride) {
+        MS_LOG(EXCEPTION) << "The DLPack tensor should be C contiguous.";
+      }
+      stride *= shape[i];
+    }
+  }
+  (void)PyCapsule_SetName(capsule.ptr(), kDLPackUsedCapsuleName);
+  return std::make_shared<Tensor>(dtype, shape, std::make_shared<TensorDataDLPack>(managed));
+}
+
 static std::vector<ssize_t> GetStrides(const std::vector<ssize_t> &shape, ssize_t item_size) {
   std::vector<ssize_t> strides;
   strides.reserve(shape.size());
@@ -272,17 +383,49 @@ py::int_ TensorPy::GetPyItemSize(const Tensor &tensor) { return tensor.data().it
 
 py::int_ TensorPy::GetPyNBytes(const Tensor &tensor) { return tensor.data().nbytes(); }
 
-py::array TensorPy::SyncAsNumpy(const Tensor &tensor) {
-  {
-    py::gil_scoped_release gil_release;
-    if (tensor.NeedWait()) {
-      tensor.Wait();
-    }
-    tensor.data_sync();
+static void SyncData(const Tensor &tensor) {
+  py::gil_scoped_release gil_release;
+  if (tensor.NeedWait()) {
+    tensor.Wait();
   }
+  tensor.data_sync();
+}
+
+py::array TensorPy::SyncAsNumpy(const Tensor &tensor) {
+  SyncData(tensor);
   return AsNumpy(tensor);
 }
 
+py::buffer_info TensorPy::GetBufferInfo(const Tensor &tensor) {
+  SyncData(tensor);
+  return GetPyBufferInfo(tensor);
+}
+
+py::object TensorPy::ToDLPack(const Tensor &tensor) {
+  SyncData(tensor);
+  auto context = std::make_unique<DLPackContext>();
+  if (!TypeIdToDLDataType(tensor.data_type(), &context->managed.dl_tensor.dtype)) {
+    MS_LOG(EXCEPTION) << "Unsupported data type " << tensor.data_type() << " for DLPack.";
+  }
+  context->data = tensor.data_ptr();
+  context->shape.assign(tensor.shape().begin(), tensor.shape().end());
+  auto &dl_tensor = context->managed.dl_tensor;
+  dl_tensor.data = tensor.data_c();
+  dl_tensor.device = {kDLCPU, 0};
+  dl_tensor.ndim = static_cast<int>(context->shape.size());
+  dl_tensor.shape = context->shape.data();
+  dl_tensor.strides = nullptr;
+  dl_tensor.byte_offset = 0;
+  context->managed.manager_ctx = context.get();
+  context->managed.deleter = DeleteDLPackContext;
+  auto capsule = PyCapsule_New(&context->managed, kDLPackCapsuleName, DestructDLPackCapsule);
+  if (capsule == nullptr) {
+    throw py::error_already_set();
+  }
+  (void)context.release();
+  return py::reinterpret_steal<py::object>(capsule);
+}
+
 py::array TensorPy::AsNumpy(const Tensor &tensor) {
   auto data_numpy = dynamic_cast<const TensorDataNumpy *>(&tensor.data());
   if (data_numpy != nullptr) {
@@ -327,7 +470,9 @@ REGISTER_PYBIND_DEFINE(Tensor, ([](const py::module *m) {
                              }));
                          // Define python Tensor class.
                          // dtype should define before Tensor, because Tensor init depend dtype
-                         (void)py::class_<Tensor, MetaTensor, std::shared_ptr<Tensor>>(*m, "Tensor")
+                         (void)py::class_<Tensor, MetaTensor, std::shared_ptr<Tensor>>(*m, "Tensor",
+                                                                                       py::buffer_protocol())
+                           .def_buffer(TensorPy::GetBufferInfo)
                            .def(py::init([](const Tensor &tensor) { return std::make_shared<Tensor>(tensor); }),
                                 py::arg("input"))
                            .def(py::init([](const Tensor &tensor, const TypePtr &type_ptr) {
@@ -444,6 +589,29 @@ REGISTER_PYBIND_DEFINE(Tensor, ([](const py::module *m) {
                                  >>> a = np.ones((2, 3))
                                  >>> t = mindspore.Tensor.from_numpy(a)
                              )mydelimiter")
+                           .def("from_dlpack", TensorPy::MakeTensorFromDLPack, R"mydelimiter(
+                             Creates a Tensor sharing the memory of a DLPack tensor without copy.
+
+                             Arg:
+                                 input (PyCapsule): A DLPack capsule or an object with __dlpack__.
+
+                             Returns:
+                                 Tensor, tensor with shared data to the DLPack tensor.
+
+                             Examples:
+                                 >>> data = mindspore.Tensor(np.ones((2, 3)))
+                                 >>> t = mindspore.Tensor.from_dlpack(data.to_dlpack())
+                             )mydelimiter")
+                           .def("to_dlpack", TensorPy::ToDLPack, R"mydelimiter(
+                             Export the tensor as a DLPack capsule without copy.
+
+                             Returns:
+                                 PyCapsule, which other frameworks consume once.
+
+                             Examples:
+                                 >>> data = mindspore.Tensor(np.ones((2, 3)))
+                                 >>> capsule = data.to_dlpack()
+                             )mydelimiter")
                            .def("asnumpy", TensorPy::SyncAsNumpy, R"mydelimiter(
                              Convert tensor to numpy.ndarray.
 
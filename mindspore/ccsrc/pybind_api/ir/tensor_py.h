@@ -104,6 +104,16 @@ class TensorPy {
   // param input [py::array] Data value of the tensor.
   static TensorPtr MakeTensorNoCopy(const py::array &input);
 
+  // brief Create Tensor sharing the memory of a DLPack capsule or of an object with __dlpack__.
+  //
+  // param input [py::object] The capsule or the object, a capsule can only be consumed once.
+  static TensorPtr MakeTensorFromDLPack(const py::object &input);
+
+  // brief Export the host data of a tensor as a DLPack capsule without copy, the capsule keeps the data alive.
+  static py::object ToDLPack(const Tensor &tensor);
+
+  static py::buffer_info GetBufferInfo(const Tensor &tensor);
+
   static py::array SyncAsNumpy(const Tensor &tensor);
 
   static py::array AsNumpy(const Tensor &tensor);
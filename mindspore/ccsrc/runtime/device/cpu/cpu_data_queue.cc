@@ -0,0 +1,114 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/device/cpu/cpu_data_queue.h"
+#include <chrono>
+#include <utility>
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+CPUDataQueue::CPUDataQueue(size_t capacity)
+    : buffer_(capacity), capacity_(capacity), head_(0), size_(0), closed_(false) {}
+
+DataQueueStatus CPUDataQueue::Push(DataBatch &&batch, unsigned int timeout_in_ms) {
+  std::unique_lock<std::mutex> locker(mutex_);
+  bool ready = not_full_cond_.wait_for(locker, std::chrono::milliseconds(timeout_in_ms),
+                                       [this] { return closed_ || size_ < capacity_; });
+  if (closed_) {
+    return DataQueueStatus::kClosed;
+  }
+  if (!ready) {
+    return DataQueueStatus::kTimeout;
+  }
+  buffer_[(head_ + size_) % capacity_] = std::move(batch);
+  ++size_;
+  not_empty_cond_.notify_one();
+  return DataQueueStatus::kSuccess;
+}
+
+DataQueueStatus CPUDataQueue::Pop(DataBatch *batch, unsigned int timeout_in_sec) {
+  std::unique_lock<std::mutex> locker(mutex_);
+  bool ready = not_empty_cond_.wait_for(locker, std::chrono::seconds(timeout_in_sec),
+                                        [this] { return closed_ || size_ > 0; });
+  if (size_ == 0) {
+    return closed_ ? DataQueueStatus::kClosed : DataQueueStatus::kTimeout;
+  }
+  if (!ready) {
+    return DataQueueStatus::kTimeout;
+  }
+  *batch = std::move(buffer_[head_]);
+  head_ = (head_ + 1) % capacity_;
+  --size_;
+  not_full_cond_.notify_one();
+  return DataQueueStatus::kSuccess;
+}
+
+void CPUDataQueue::Close() {
+  std::lock_guard<std::mutex> locker(mutex_);
+  closed_ = true;
+  not_full_cond_.notify_all();
+  not_empty_cond_.notify_all();
+}
+
+bool CPUDataQueue::IsClosed() {
+  std::lock_guard<std::mutex> locker(mutex_);
+  return closed_;
+}
+
+size_t CPUDataQueue::Size() {
+  std::lock_guard<std::mutex> locker(mutex_);
+  return size_;
+}
+
+CPUDataQueueMgr &CPUDataQueueMgr::GetInstance() {
+  static CPUDataQueueMgr instance;
+  return instance;
+}
+
+std::shared_ptr<CPUDataQueue> CPUDataQueueMgr::Create(const std::string &channel_name, size_t capacity) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  auto iter = queues_.find(channel_name);
+  if (iter != queues_.end() && !iter->second->IsClosed()) {
+    return iter->second;
+  }
+  auto queue = std::make_shared<CPUDataQueue>(capacity == 0 ? 1 : capacity);
+  queues_[channel_name] = queue;
+  return queue;
+}
+
+std::shared_ptr<CPUDataQueue> CPUDataQueueMgr::Get(const std::string &channel_name) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  auto iter = queues_.find(channel_name);
+  return iter == queues_.end() ? nullptr : iter->second;
+}
+
+void CPUDataQueueMgr::Destroy(const std::string &channel_name) {
+  std::shared_ptr<CPUDataQueue> queue;
+  {
+    std::lock_guard<std::mutex> locker(mutex_);
+    auto iter = queues_.find(channel_name);
+    if (iter == queues_.end()) {
+      return;
+    }
+    queue = iter->second;
+    queues_.erase(iter);
+  }
+  queue->Close();
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_DATA_QUEUE_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_DATA_QUEUE_H_
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// Batches the dataset may send ahead of the GetNext
+constexpr size_t kDataQueueCapacity = 2;
+
+enum class DataQueueStatus : int { kSuccess = 0, kQueueNotExist, kClosed, kTimeout };
+
+struct DataItemCpu {
+  void *data_ptr_;
+  size_t data_len_;
+};
+
+// One batch of the dataset. The items point into the tensors of the dataset, which the holder keeps alive until the
+// consumer drops the batch, so a batch is never copied on its way to the kernels.
+struct DataBatch {
+  std::vector<DataItemCpu> items_;
+  std::shared_ptr<void> holder_;
+};
+
+// Bounded ring of batches between the dataset pipeline and the GetNext kernel of the CPU
+class CPUDataQueue {
+ public:
+  explicit CPUDataQueue(size_t capacity);
+  ~CPUDataQueue() = default;
+
+  // Wait at most timeout_in_ms for a free slot
+  DataQueueStatus Push(DataBatch &&batch, unsigned int timeout_in_ms);
+
+  // Wait at most timeout_in_sec for a batch
+  DataQueueStatus Pop(DataBatch *batch, unsigned int timeout_in_sec);
+
+  // Wake up the producer and the consumer, Push fails from now on and Pop once the queue is drained
+  void Close();
+
+  bool IsClosed();
+  size_t Size();
+  size_t Capacity() const { return capacity_; }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable not_full_cond_;
+  std::condition_variable not_empty_cond_;
+  std::vector<DataBatch> buffer_;
+  size_t capacity_;
+  size_t head_;
+  size_t size_;
+  bool closed_;
+
+  CPUDataQueue(const CPUDataQueue &) = delete;
+  CPUDataQueue &operator=(const CPUDataQueue &) = delete;
+};
+
+// Queues by channel name, shared by the dataset engine and the kernels which live in different libraries
+class CPUDataQueueMgr {
+ public:
+  static CPUDataQueueMgr &GetInstance();
+
+  // Create the queue of a channel. An open queue which already exists is kept, a closed one is replaced by an empty
+  // queue so that a new send of the channel does not start with the batches the last one left.
+  std::shared_ptr<CPUDataQueue> Create(const std::string &channel_name, size_t capacity);
+
+  // The queue of a channel, nullptr if it is not created
+  std::shared_ptr<CPUDataQueue> Get(const std::string &channel_name);
+
+  // Close the queue of a channel and forget it
+  void Destroy(const std::string &channel_name);
+
+ private:
+  CPUDataQueueMgr() = default;
+  ~CPUDataQueueMgr() = default;
+  CPUDataQueueMgr(const CPUDataQueueMgr &) = delete;
+  CPUDataQueueMgr &operator=(const CPUDataQueueMgr &) = delete;
+
+  std::mutex mutex_;
+  std::map<std::string, std::shared_ptr<CPUDataQueue>> queues_;
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_DATA_QUEUE_H_
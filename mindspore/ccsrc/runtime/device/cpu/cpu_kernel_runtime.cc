@@ -23,6 +23,7 @@
 #include <functional>
 #include <exception>
 #include "backend/kernel_compiler/kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "runtime/device/cpu/cpu_memory_manager.h"
 #include "utils/ms_context.h"
@@ -371,9 +372,52 @@ void CPUKernelRuntime::DecreaseSummaryRefCount(const session::NamedSummaryOutput
   static_cast<CPUMemoryManager *>(mem_manager_.get())->DecreaseSummaryRefCount(summary_outputs);
 }
 
+void CPUKernelRuntime::UseKernelOutputBuffers(const session::KernelGraph *kernel_graph, const CNodePtr &kernel,
+                                              const std::vector<void *> &buffers) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto &kernel_mod_outputs = AnfAlgo::GetKernelMod(kernel)->GetOutputSizeList();
+  if (buffers.size() != kernel_mod_outputs.size()) {
+    MS_LOG(EXCEPTION) << "The kernel returns " << buffers.size() << " output buffers, expect "
+                      << kernel_mod_outputs.size() << ". Trace:" << trace::DumpSourceLines(kernel);
+  }
+  std::set<session::KernelWithIndex> graph_outputs;
+  for (const auto &node : AnfAlgo::GetAllOutput(kernel_graph->output(), {prim::kPrimTupleGetItem})) {
+    (void)graph_outputs.insert(AnfAlgo::VisitKernelWithReturnType(node, 0, true));
+  }
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    auto device_address = AnfAlgo::GetMutableOutputAddr(kernel, i).get();
+    MS_EXCEPTION_IF_NULL(device_address);
+    // The outputs of the graph are bound to the output tensors
+    if (graph_outputs.count(std::make_pair(kernel, i)) > 0) {
+      auto ret = memcpy_s(device_address->ptr_, device_address->size_, buffers[i], kernel_mod_outputs[i]);
+      if (ret != EOK) {
+        MS_LOG(EXCEPTION) << "Copy the output " << i << " of " << kernel->fullname_with_scope() << " failed, ret "
+                          << ret;
+      }
+      continue;
+    }
+    swapped_addresses_.emplace_back(device_address, device_address->ptr_);
+    device_address->ptr_ = buffers[i];
+  }
+}
+
+void CPUKernelRuntime::RestoreKernelOutputAddresses() {
+  for (auto &swapped : swapped_addresses_) {
+    // The dynamic memory released the address after its last use, but it held the kernel buffer instead of the
+    // memory allocated for the step, which is freed here
+    if (swapped.first->ptr_ == nullptr) {
+      static_cast<CPUMemoryManager *>(mem_manager_.get())->MemFree(swapped.second);
+      continue;
+    }
+    swapped.first->ptr_ = swapped.second;
+  }
+  swapped_addresses_.clear();
+}
+
 bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph, bool is_task_sink) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
   static_cast<CPUMemoryManager *>(mem_manager_.get())->IncreaseAddressRefCount(kernel_graph);
+  RestoreKernelOutputAddresses();
 
   auto kernels = kernel_graph->execution_order();
   for (const auto &kernel : kernels) {
@@ -414,12 +458,17 @@ bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph, bool is_task_sink
     if (!ret) {
       MS_LOG(EXCEPTION) << "Launch kernel failed. Trace:" << trace::DumpSourceLines(kernel);
     }
+    auto cpu_kernel = dynamic_cast<kernel::CPUKernel *>(kernel_mod);
+    if (cpu_kernel != nullptr && !cpu_kernel->OutputBuffers().empty()) {
+      UseKernelOutputBuffers(kernel_graph, kernel, cpu_kernel->OutputBuffers());
+    }
     static_cast<CPUMemoryManager *>(mem_manager_.get())->DecreaseAddressRefCount(kernel);
 #ifdef ENABLE_PROFILE
     double cost_time = GetTime() - start_time;
     MS_LOG(INFO) << "cpu kernel: " << kernel->fullname_with_scope() << "  costs " << cost_time * 1e6 << " us";
 #endif
   }
+  RestoreKernelOutputAddresses();
   return true;
 }
 }  // namespace cpu
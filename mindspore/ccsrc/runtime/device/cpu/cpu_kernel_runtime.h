@@ -21,6 +21,7 @@
 #include <string>
 #include <map>
 #include <set>
+#include <utility>
 #include "runtime/device/kernel_runtime.h"
 #include "backend/session/kernel_graph.h"
 #include "backend/session/session_basic.h"
@@ -62,7 +63,13 @@ class CPUKernelRuntime : public KernelRuntime {
   void AssignInputNodeAddress(const session::KernelGraph *kernel_graph);
   void AssignKernelOutputAddress(const session::KernelGraph *kernel_graph);
   void AddRuntimeAddress(DeviceAddress *address, std::vector<kernel::AddressPtr> *input_list);
+  // Point the outputs of a kernel at the buffers it returns for this launch, e.g. the batch of the GetNext
+  void UseKernelOutputBuffers(const session::KernelGraph *kernel_graph, const CNodePtr &kernel,
+                              const std::vector<void *> &buffers);
+  void RestoreKernelOutputAddresses();
   std::set<DeviceAddressPtr> bound_addresses_;
+  // The addresses pointed at kernel buffers and their planned memory
+  std::vector<std::pair<DeviceAddress *, void *>> swapped_addresses_;
   std::map<AnfNodePtr, tensor::TensorPtr> input_param_tensor_map_;
   bool initialized_{false};
 };
@@ -301,6 +301,11 @@ void SetKernelInfo(const CNodePtr &kernel_node) {
   }
   GetInputFormatsAndDtypes(kernel_node, &input_formats, &input_types, &input_not_cnode_indexes);
   GetOutputInferFormatsAndDtypes(kernel_node, &infer_output_formats, &infer_output_types);
+  if (kernel_attrs.size() == 1 && kernel_attrs[0].GetAnyType()) {
+    MS_LOG(INFO) << "Operator[" << AnfAlgo::GetCNodeName(kernel_node) << "] takes the inferred formats and dtypes";
+    SetKernelBuildInfo(input_formats, input_types, infer_output_formats, infer_output_types, kernel_node.get());
+    return;
+  }
   KernelAttr selected_kernel_attr;
   std::pair<bool, bool> matched = std::make_pair(false, false);
   if (!SelectKernel(kernel_node, &selected_kernel_attr, kernel_attrs, input_formats, input_types,
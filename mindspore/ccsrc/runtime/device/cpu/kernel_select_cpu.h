@@ -33,7 +33,7 @@ void SetKernelInfo(const CNodePtr &apply_kernel_ptr);
 class KernelAttr {
  public:
   using DataType = std::pair<TypeId, std::string>;
-  KernelAttr() : all_same_(0) {}
+  KernelAttr() : all_same_(0), any_type_(false) {}
   ~KernelAttr() = default;
 
   KernelAttr &AddInputAttr(const TypeId &ms_type, const std::string &format = kOpFormat_DEFAULT) {
@@ -51,9 +51,16 @@ class KernelAttr {
     return *this;
   }
 
+  // The kernel takes and produces whatever types are inferred, e.g. the GetNext of the dataset
+  KernelAttr &SetAnyTypeAttr(bool any_type) {
+    any_type_ = any_type;
+    return *this;
+  }
+
   const DataType &GetInputAttr(const size_t index) const { return input_type_[index]; }
   const DataType &GetOutputAttr(const size_t index) const { return output_type_[index]; }
   bool GetAllSame() const { return all_same_; }
+  bool GetAnyType() const { return any_type_; }
 
   size_t GetInputSize() const { return input_type_.size(); }
   size_t GetOutputSize() const { return output_type_.size(); }
@@ -62,6 +69,7 @@ class KernelAttr {
   std::vector<DataType> input_type_;
   std::vector<DataType> output_type_;
   bool all_same_;
+  bool any_type_;
 };
 }  // namespace cpu
 }  // namespace device
@@ -22,9 +22,18 @@
 
 namespace mindspore {
 namespace summary {
+namespace {
+constexpr size_t kDefaultMaxPendingBytes = 64 * 1024 * 1024;
+}  // namespace
 
 // implement the EventWriter
-EventWriter::EventWriter(const std::string &file_full_name) : filename_(file_full_name), events_write_count_(0) {
+EventWriter::EventWriter(const std::string &file_full_name)
+    : EventWriter(file_full_name, kDefaultMaxPendingBytes, false) {}
+
+EventWriter::EventWriter(const std::string &file_full_name, size_t max_pending_bytes, bool drop_when_full)
+    : filename_(file_full_name),
+      max_pending_bytes_(max_pending_bytes),
+      drop_when_full_(drop_when_full) {
   fs_ = system::Env::GetFileSystem();
   if (fs_ == nullptr) {
     MS_LOG(EXCEPTION) << "Get the file system failed.";
@@ -44,10 +53,14 @@ EventWriter::~EventWriter() {
       MS_LOG(ERROR) << "Close file(" << filename_ << ") failed.";
     }
   }
+  StopWriter();
 }
 
 // get the write event count
-int32_t EventWriter::GetWriteEventCount() const { return events_write_count_; }
+int32_t EventWriter::GetWriteEventCount() const { return events_write_count_.load(); }
+
+// get the dropped event count
+int32_t EventWriter::GetDroppedEventCount() const { return events_drop_count_.load(); }
 
 // Open the file
 bool EventWriter::Open() {
@@ -68,14 +81,97 @@ void EventWriter::Write(const std::string &event_str) {
     MS_LOG(ERROR) << "Write failed because file could not be opened.";
     return;
   }
+  if (max_pending_bytes_ == 0) {
+    events_write_count_++;
+    bool result = WriteRecord(event_str);
+    if (!result) {
+      MS_LOG(ERROR) << "Event write failed.";
+    }
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (stop_) {
+    MS_LOG(ERROR) << "Write failed because the event writer is closed.";
+    return;
+  }
+  // a record larger than the limit is still accepted once the pending buffer is empty
+  auto has_space = [this, &event_str]() {
+    return pending_bytes_ == 0 || pending_bytes_ + event_str.size() <= max_pending_bytes_;
+  };
+  if (!has_space()) {
+    if (drop_when_full_) {
+      events_drop_count_++;
+      MS_LOG(INFO) << "Drop the event because " << pending_bytes_ << " bytes are waiting to be written to file("
+                   << filename_ << ").";
+      return;
+    }
+    done_cond_.wait(lock, has_space);
+  }
+  if (!writer_thread_.joinable()) {
+    writer_thread_ = std::thread(&EventWriter::WriteLoop, this);
+  }
+  pending_.push_back(event_str);
+  pending_bytes_ += event_str.size();
   events_write_count_++;
-  bool result = WriteRecord(event_str);
-  if (!result) {
-    MS_LOG(ERROR) << "Event write failed.";
+  lock.unlock();
+  write_cond_.notify_one();
+}
+
+void EventWriter::WriteLoop() {
+  std::vector<std::string> records;
+  std::string buffer;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    write_cond_.wait(lock, [this]() { return stop_ || !pending_.empty(); });
+    if (pending_.empty()) {
+      break;
+    }
+    // take the whole pending buffer so the callers can fill the other one while this one is written
+    records.swap(pending_);
+    pending_bytes_ = 0;
+    writing_ = true;
+    lock.unlock();
+    done_cond_.notify_all();
+
+    buffer.clear();
+    for (auto &record : records) {
+      FrameRecord(record, &buffer);
+    }
+    records.clear();
+    bool result = event_file_->Write(buffer);
+
+    lock.lock();
+    writing_ = false;
+    if (!result) {
+      write_failed_ = true;
+      MS_LOG(ERROR) << "Write the Summary data to file(" << filename_ << ") failed.";
+    }
+    done_cond_.notify_all();
+  }
+}
+
+void EventWriter::StopWriter() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  write_cond_.notify_one();
+  if (writer_thread_.joinable()) {
+    writer_thread_.join();
   }
 }
 
 bool EventWriter::Flush() {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cond_.wait(lock, [this]() { return pending_.empty() && !writing_; });
+    if (write_failed_) {
+      write_failed_ = false;
+      MS_LOG(ERROR) << "Failed to flush to file(" << filename_ << ") because a previous write failed.";
+      return false;
+    }
+  }
   // Confirm the event file is exist?
   if (!fs_->FileExist(filename_)) {
     MS_LOG(ERROR) << "Failed to flush to file(" << filename_ << ") because the file not exist.";
@@ -87,10 +183,11 @@ bool EventWriter::Flush() {
   }
   // Sync the file
   if (!event_file_->Flush()) {
-    MS_LOG(ERROR) << "Failed to sync to file(" << filename_ << "), the event count(" << events_write_count_ << ").";
+    MS_LOG(ERROR) << "Failed to sync to file(" << filename_ << "), the event count(" << events_write_count_.load()
+                  << ").";
     return false;
   }
-  MS_LOG(DEBUG) << "Flush " << events_write_count_ << " events to disk file(" << filename_ << ").";
+  MS_LOG(DEBUG) << "Flush " << events_write_count_.load() << " events to disk file(" << filename_ << ").";
   return true;
 }
 
@@ -101,6 +198,7 @@ bool EventWriter::Close() noexcept {
     MS_LOG(INFO) << "The event writer is closed.";
     return result;
   }
+  StopWriter();
   if (event_file_ != nullptr) {
     result = event_file_->Close();
     if (!result) {
@@ -120,6 +218,7 @@ bool EventWriter::Shut() noexcept {
   if (!result) {
     MS_LOG(ERROR) << "Flush failed when close the file.";
   }
+  StopWriter();
   if (event_file_ != nullptr) {
     bool _close = event_file_->Close();
     if (!_close) {
@@ -142,46 +241,39 @@ bool EventWriter::WriteRecord(const std::string &data) {
     MS_LOG(ERROR) << "Writer not initialized or previously closed.";
     return false;
   }
-  // Write the data to event file
+  std::string buffer;
+  FrameRecord(data, &buffer);
+  bool result = event_file_->Write(buffer);
+  if (!result) {
+    MS_LOG(ERROR) << "Write the Summary data failed.";
+    return false;
+  }
+  return true;
+}
+
+void EventWriter::FrameRecord(const std::string &data, std::string *buffer) {
   const unsigned int kArrayLen = sizeof(uint64_t);
   char data_len_array[kArrayLen];
   char crc_array[sizeof(uint32_t)];
+  buffer->reserve(buffer->size() + kArrayLen + sizeof(crc_array) + data.size() + sizeof(crc_array));
 
-  // step 1: write the data length
+  // step 1: the data length
   system::EncodeFixed64(data_len_array, kArrayLen, static_cast<int64_t>(data.size()));
-  bool result = event_file_->Write(string(data_len_array, sizeof(data_len_array)));
-  if (!result) {
-    MS_LOG(ERROR) << "Write the Summary data length failed.";
-    return false;
-  }
+  buffer->append(data_len_array, sizeof(data_len_array));
 
-  // step 2: write the crc of data length
+  // step 2: the crc of data length
   system::EncodeFixed64(data_len_array, kArrayLen, SizeToInt(data.size()));
   uint32_t crc = system::Crc32c::GetMaskCrc32cValue(data_len_array, sizeof(data_len_array));
   system::EncodeFixed32(crc_array, crc);
-  result = event_file_->Write(string(crc_array, sizeof(crc_array)));
-  if (!result) {
-    MS_LOG(ERROR) << "Write the Summary data length crc failed.";
-    return false;
-  }
+  buffer->append(crc_array, sizeof(crc_array));
 
-  // step 3: write the data
-  result = event_file_->Write(data);
-  if (!result) {
-    MS_LOG(ERROR) << "Write the Summary data failed.";
-    return false;
-  }
+  // step 3: the data
+  buffer->append(data);
 
-  // step 4: write data crc
+  // step 4: the data crc
   crc = system::Crc32c::GetMaskCrc32cValue(data.data(), data.size());
   system::EncodeFixed32(crc_array, crc);
-  result = event_file_->Write(string(crc_array, sizeof(crc_array)));
-  if (!result) {
-    MS_LOG(ERROR) << "Write the Summary footer failed.";
-    return false;
-  }
-
-  return true;
+  buffer->append(crc_array, sizeof(crc_array));
 }
 
 }  // namespace summary
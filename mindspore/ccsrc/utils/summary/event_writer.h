@@ -17,8 +17,13 @@
 #ifndef SUMMARY_EVENT_WRITER_H_
 #define SUMMARY_EVENT_WRITER_H_
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "pybind11/pybind11.h"
 #include "securec/include/securec.h"
@@ -36,11 +41,18 @@ using WriteFile = system::WriteFile;
 using WriteFilePtr = std::shared_ptr<WriteFile>;
 using FileSystem = system::FileSystem;
 
+// Records are framed and written by a background thread so that the training thread only pays for a copy.
+// The caller thread appends to a pending buffer, the writer thread swaps it out, frames all records with their CRCs
+// into one contiguous buffer and writes it with a single call.
 class EventWriter {
  public:
   // The file name = path + file_name
   explicit EventWriter(const std::string &file_full_name);
 
+  // @param max_pending_bytes: bytes of records allowed to wait for the writer thread, 0 writes on the caller thread
+  // @param drop_when_full: when the pending bytes are exceeded, drop the record instead of blocking the caller
+  EventWriter(const std::string &file_full_name, size_t max_pending_bytes, bool drop_when_full);
+
   ~EventWriter();
 
   // return the file name
@@ -49,13 +61,16 @@ class EventWriter {
   // return the count of write event
   int32_t GetWriteEventCount() const;
 
+  // return the count of event dropped because the pending buffer was full
+  int32_t GetDroppedEventCount() const;
+
   // Open the file
   bool Open();
 
   // write the Serialized "event_str" to file
   void Write(const std::string &event_str);
 
-  // Flush the cache to disk
+  // Wait for the pending records to be written, then flush the cache to disk
   bool Flush();
 
   // close the file
@@ -72,12 +87,35 @@ class EventWriter {
   bool WriteRecord(const std::string &data);
 
  private:
+  // Append the framed record to buffer
+  static void FrameRecord(const std::string &data, std::string *buffer);
+
+  // Writer thread main loop
+  void WriteLoop();
+
+  // Wait for the pending records to be written and stop the writer thread
+  void StopWriter() noexcept;
+
   // True: valid / False: closed
   bool status_ = false;
   std::shared_ptr<FileSystem> fs_;
   std::string filename_;
   WriteFilePtr event_file_;
-  int32_t events_write_count_ = 0;
+  // read by the caller thread while the writer thread updates them
+  std::atomic<int32_t> events_write_count_{0};
+  std::atomic<int32_t> events_drop_count_{0};
+
+  size_t max_pending_bytes_;
+  bool drop_when_full_;
+  std::thread writer_thread_;
+  std::mutex mutex_;
+  std::condition_variable write_cond_;  // signals the writer thread
+  std::condition_variable done_cond_;   // signals callers waiting for space or for a flush
+  std::vector<std::string> pending_;
+  size_t pending_bytes_ = 0;
+  bool writing_ = false;  // the writer thread holds records that are not in the file yet
+  bool stop_ = false;
+  bool write_failed_ = false;
 };
 
 }  // namespace summary
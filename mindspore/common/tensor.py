@@ -304,6 +304,35 @@ class Tensor(Tensor_):
         """Convert numpy array to Tensor without copy data."""
         return Tensor(Tensor_.from_numpy(array))
 
+    @staticmethod
+    def from_dlpack(dlpack):
+        """
+        Convert a DLPack tensor to Tensor without copy data.
+
+        Args:
+            dlpack (Union[PyCapsule, object]): A DLPack capsule, or an object with `__dlpack__` like a tensor of
+                another framework. The tensor must be C contiguous and in host memory.
+
+        Returns:
+            Tensor, sharing the data of the DLPack tensor.
+
+        Examples:
+            >>> data = Tensor(np.ones((2, 3)))
+            >>> t = Tensor.from_dlpack(data.to_dlpack())
+        """
+        return Tensor(Tensor_.from_dlpack(dlpack))
+
+    def to_dlpack(self):
+        """Convert tensor to a DLPack capsule without copy data, the capsule can be consumed once."""
+        return Tensor_.to_dlpack(self)
+
+    def __dlpack__(self, stream=None):
+        return Tensor_.to_dlpack(self)
+
+    def __dlpack_device__(self):
+        # (kDLCPU, 0), the data is synced to host before export
+        return (1, 0)
+
     def asnumpy(self):
         """Convert tensor to numpy array."""
         return Tensor_.asnumpy(self)
@@ -332,6 +332,7 @@ void FuncGraphManager::ProcessEdge(AnfNodePtr node, int index, AnfNodePtr inp, E
     auto &users_node = node_users_[inp];
     users_node.add(make_pair(node, index));
     AddEdge(node, index, inp);
+    signals_->EdgeAdded(node);
   }
 }
 
@@ -89,6 +89,8 @@ FuncGraphManagerPtr MakeManager(const std::vector<FuncGraphPtr> &func_graphs = {
 
 struct Signals {
   Signal<void()> InvalidateComputer;
+  // a node got a new input, or a new node was added with its inputs
+  Signal<void(const AnfNodePtr &)> EdgeAdded;
 };
 
 enum EdgeProcessDirection { kDecEdge = -1, kIncEdge = 1 };
@@ -72,7 +72,8 @@ std::unique_ptr<T[]> NewData(const U *input, size_t size) {
   if (input == nullptr || size == 0) {
     return nullptr;
   }
-  auto data = std::make_unique<T[]>(size);
+  // Every element is written below, so skip the zero fill of make_unique.
+  std::unique_ptr<T[]> data(new T[size]);
   if constexpr (!std::is_same<T, U>::value && (std::is_same<T, float16>::value || std::is_same<U, float16>::value)) {
     // Because float16 do not support implicit cast from/to other types,
     // We can not use std::copy() on array of float16, use a loop here.
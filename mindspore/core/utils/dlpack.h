@@ -0,0 +1,140 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_UTILS_DLPACK_H_
+#define MINDSPORE_CORE_UTILS_DLPACK_H_
+
+#include <cstdint>
+#include "ir/dtype/type_id.h"
+
+// The structures of the DLPack ABI, which frameworks use to share tensors without copying them.
+extern "C" {
+typedef enum {
+  kDLCPU = 1,
+  kDLCUDA = 2,
+  kDLCUDAHost = 3,
+} DLDeviceType;
+
+typedef struct {
+  DLDeviceType device_type;
+  int device_id;
+} DLDevice;
+
+typedef enum {
+  kDLInt = 0U,
+  kDLUInt = 1U,
+  kDLFloat = 2U,
+  kDLBfloat = 4U,
+  kDLBool = 6U,
+} DLDataTypeCode;
+
+typedef struct {
+  uint8_t code;
+  uint8_t bits;
+  uint16_t lanes;
+} DLDataType;
+
+typedef struct {
+  void *data;
+  DLDevice device;
+  int ndim;
+  DLDataType dtype;
+  int64_t *shape;
+  // Strides in elements, nullptr for a C contiguous tensor
+  int64_t *strides;
+  uint64_t byte_offset;
+} DLTensor;
+
+typedef struct DLManagedTensor {
+  DLTensor dl_tensor;
+  void *manager_ctx;
+  // Called by the consumer once it does not use the tensor anymore
+  void (*deleter)(struct DLManagedTensor *self);
+} DLManagedTensor;
+}
+
+namespace mindspore {
+// Name of a DLPack capsule, renamed to kDLPackUsedCapsuleName once a consumer owns the tensor
+constexpr auto kDLPackCapsuleName = "dltensor";
+constexpr auto kDLPackUsedCapsuleName = "used_dltensor";
+
+inline bool TypeIdToDLDataType(TypeId type_id, DLDataType *dtype) {
+  switch (type_id) {
+    case kNumberTypeBool:
+      *dtype = {kDLBool, 8, 1};
+      return true;
+    case kNumberTypeInt8:
+      *dtype = {kDLInt, 8, 1};
+      return true;
+    case kNumberTypeInt16:
+      *dtype = {kDLInt, 16, 1};
+      return true;
+    case kNumberTypeInt32:
+      *dtype = {kDLInt, 32, 1};
+      return true;
+    case kNumberTypeInt64:
+      *dtype = {kDLInt, 64, 1};
+      return true;
+    case kNumberTypeUInt8:
+      *dtype = {kDLUInt, 8, 1};
+      return true;
+    case kNumberTypeUInt16:
+      *dtype = {kDLUInt, 16, 1};
+      return true;
+    case kNumberTypeUInt32:
+      *dtype = {kDLUInt, 32, 1};
+      return true;
+    case kNumberTypeUInt64:
+      *dtype = {kDLUInt, 64, 1};
+      return true;
+    case kNumberTypeFloat16:
+      *dtype = {kDLFloat, 16, 1};
+      return true;
+    case kNumberTypeFloat32:
+      *dtype = {kDLFloat, 32, 1};
+      return true;
+    case kNumberTypeFloat64:
+      *dtype = {kDLFloat, 64, 1};
+      return true;
+    default:
+      return false;
+  }
+}
+
+inline TypeId DLDataTypeToTypeId(const DLDataType &dtype) {
+  static const TypeId int_types[] = {kNumberTypeInt8, kNumberTypeInt16, kNumberTypeInt32, kNumberTypeInt64};
+  static const TypeId uint_types[] = {kNumberTypeUInt8, kNumberTypeUInt16, kNumberTypeUInt32, kNumberTypeUInt64};
+  static const TypeId float_types[] = {kTypeUnknown, kNumberTypeFloat16, kNumberTypeFloat32, kNumberTypeFloat64};
+  int index = dtype.bits == 8 ? 0 : dtype.bits == 16 ? 1 : dtype.bits == 32 ? 2 : dtype.bits == 64 ? 3 : -1;
+  if (dtype.lanes != 1 || index < 0) {
+    return kTypeUnknown;
+  }
+  switch (dtype.code) {
+    case kDLBool:
+      return index == 0 ? kNumberTypeBool : kTypeUnknown;
+    case kDLInt:
+      return int_types[index];
+    case kDLUInt:
+      return uint_types[index];
+    case kDLFloat:
+      return float_types[index];
+    default:
+      return kTypeUnknown;
+  }
+}
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CORE_UTILS_DLPACK_H_
@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CORE_UTILS_SIGNAL_H_
 #define MINDSPORE_CORE_UTILS_SIGNAL_H_
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -50,9 +51,14 @@ class Signal {
     }
   }
 
-  void add_slot(const std::function<FuncType> &func) {
+  std::shared_ptr<Slot<FuncType>> add_slot(const std::function<FuncType> &func) {
     auto slot = std::make_shared<Slot<FuncType>>(func);
     slots_.push_back(slot);
+    return slot;
+  }
+
+  void remove_slot(const std::shared_ptr<Slot<FuncType>> &slot) {
+    slots_.erase(std::remove(slots_.begin(), slots_.end(), slot), slots_.end());
   }
 
   // signal connect to a class member func
@@ -23,13 +23,18 @@ import mindspore._c_dataengine as cde
 
 __all__ = ['set_seed', 'get_seed', 'set_prefetch_size', 'get_prefetch_size', 'set_num_parallel_workers',
            'get_num_parallel_workers', 'set_monitor_sampling_interval', 'get_monitor_sampling_interval', 'load',
-           'get_callback_timeout', 'set_auto_num_workers', 'get_auto_num_workers']
+           'get_callback_timeout', 'set_auto_num_workers', 'get_auto_num_workers', 'set_numa_placement',
+           'get_numa_placement']
 
 INT32_MAX = 2147483647
 UINT32_MAX = 4294967295
 
 _config = cde.GlobalContext.config_manager()
 
+_NUMA_PLACEMENT_MODES = {"none": cde.NumaPlacementMode.DE_NUMA_PLACEMENT_NONE,
+                         "local": cde.NumaPlacementMode.DE_NUMA_PLACEMENT_LOCAL,
+                         "spread": cde.NumaPlacementMode.DE_NUMA_PLACEMENT_SPREAD}
+
 
 def _init_device_info():
     """
@@ -198,6 +203,50 @@ def get_numa_enable():
     return _config.get_numa_enable()
 
 
+def set_numa_placement(mode, tenants_per_node=1):
+    """
+    Set where the threads of the dataset pipeline run (This feature is turned off by default).
+    The home numa node of a process is rank_id % number of numa nodes. Every thread is pinned to one cpu, so the
+    rows it produces are allocated on the numa node of that cpu, and the batches are always produced on the home node,
+    which is the one closest to the device of the process. Processes which share a home node are given disjoint cpus.
+    Only supported on Linux, it replaces the process level bind of set_numa_enable.
+
+    Args:
+        mode (str): "none" to let the os place the threads, "local" to keep all of them on the home node or "spread"
+            to spread the workers of the ops over all the numa nodes.
+        tenants_per_node (int, optional): How many processes share a numa node (default=1).
+
+    Raises:
+        TypeError: If mode is not a str or tenants_per_node is not an int.
+        ValueError: If mode is not supported or tenants_per_node is not positive.
+
+    Examples:
+        >>> # Four processes on a 2-socket host, two of them on each socket
+        >>> ds.config.set_numa_placement("local", tenants_per_node=2)
+    """
+    if not isinstance(mode, str):
+        raise TypeError("mode must be a str.")
+    if mode not in _NUMA_PLACEMENT_MODES:
+        raise ValueError("mode must be one of {}.".format(list(_NUMA_PLACEMENT_MODES)))
+    if not isinstance(tenants_per_node, int) or isinstance(tenants_per_node, bool):
+        raise TypeError("tenants_per_node must be an int.")
+    if tenants_per_node <= 0 or tenants_per_node > INT32_MAX:
+        raise ValueError("tenants_per_node given is not within the required range.")
+    _config.set_numa_placement(_NUMA_PLACEMENT_MODES[mode], tenants_per_node)
+
+
+def get_numa_placement():
+    """
+    Get the numa placement of the threads of the dataset pipeline.
+
+    Returns:
+        tuple, the mode as a str and the number of processes which share a numa node.
+    """
+    mode = _config.get_numa_placement()
+    name = [k for k, v in _NUMA_PLACEMENT_MODES.items() if v == mode][0]
+    return name, _config.get_numa_tenants_per_node()
+
+
 def set_monitor_sampling_interval(interval):
     """
     Set the default interval (in milliseconds) for monitor sampling.
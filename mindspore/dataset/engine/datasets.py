@@ -386,7 +386,7 @@ class Dataset:
         return SyncWaitDataset(self, condition_name, num_batch, callback)
 
     @check_shuffle
-    def shuffle(self, buffer_size):
+    def shuffle(self, buffer_size, block_size=1, row_pool_size=0):
         """
         Randomly shuffles the rows of this dataset using the following algorithm:
 
@@ -399,10 +399,21 @@ class Dataset:
         A seed can be provided to be used on the first epoch. In every subsequent
         epoch, the seed is changed to a new one, randomly generated value.
 
+        With a block_size larger than 1, the shuffle buffer holds blocks of block_size
+        consecutive rows instead. A random block is replaced by the next block of the
+        parent node and its rows are propagated in a random order.
+
         Args:
             buffer_size (int): The size of the buffer (must be larger than 1) for
                 shuffling. Setting buffer_size equal to the number of rows in the entire
                 dataset will result in a global shuffle.
+            block_size (int, optional): Number of consecutive rows shuffled as a block (default=1,
+                rows are shuffled one by one).
+            row_pool_size (int, optional): Size in MB of a memory pool the rows of the shuffle
+                buffer are packed into (default=0, no pool). Packed rows take less memory than
+                their tensors, which allows larger buffers when the rows are small, e.g. when
+                shuffling encoded images before decoding them. Rows which do not fit in the pool
+                are kept as they are.
 
         Returns:
             ShuffleDataset, dataset shuffled.
@@ -419,8 +430,11 @@ class Dataset:
             >>>
             >>> # Create a shuffled dataset using a shuffle buffer of size 4
             >>> data = data.shuffle(4)
+            >>>
+            >>> # Shuffle blocks of 16 rows in a buffer of 4096 rows packed into a pool of 512 MB
+            >>> data = data.shuffle(4096, block_size=16, row_pool_size=512)
         """
-        return ShuffleDataset(self, buffer_size)
+        return ShuffleDataset(self, buffer_size, block_size, row_pool_size)
 
     def flat_map(self, func):
         """
@@ -2163,25 +2177,32 @@ class ShuffleDataset(Dataset):
     Args:
         input_dataset (Dataset): Input Dataset to be shuffled.
         buffer_size (int): Size of the buffer.
+        block_size (int, optional): Number of consecutive rows shuffled as a block (default=1).
+        row_pool_size (int, optional): Size in MB of the pool the rows of the buffer are packed into (default=0).
 
     Raises:
         RuntimeError: If exist sync operators before shuffle.
     """
 
-    def __init__(self, input_dataset, buffer_size):
+    def __init__(self, input_dataset, buffer_size, block_size=1, row_pool_size=0):
         super().__init__(children=input_dataset)
         self.buffer_size = buffer_size
+        self.block_size = block_size
+        self.row_pool_size = row_pool_size
         self.reshuffle_each_epoch = True
 
         if self.is_sync():
             raise RuntimeError("No shuffle after sync operators.")
 
     def parse(self, children=None):
-        return cde.ShuffleNode(children[0], self.buffer_size, self.reshuffle_each_epoch)
+        return cde.ShuffleNode(children[0], self.buffer_size, self.reshuffle_each_epoch, self.block_size,
+                               self.row_pool_size)
 
     def get_args(self):
         args = super().get_args()
         args["buffer_size"] = self.buffer_size
+        args["block_size"] = self.block_size
+        args["row_pool_size"] = self.row_pool_size
         if self.reshuffle_each_epoch is not None:
             args["reshuffle_each_epoch"] = self.reshuffle_each_epoch
 
@@ -200,7 +200,7 @@ def create_node(node):
                                  True, node.get('cache'), node.get('callbacks'))
 
     elif dataset_op == 'Shuffle':
-        pyobj = de.Dataset().shuffle(node.get('buffer_size'))
+        pyobj = de.Dataset().shuffle(node.get('buffer_size'), node.get('block_size', 1), node.get('row_pool_size', 0))
 
     elif dataset_op == 'Batch':
         pyobj = de.Dataset().batch(node['batch_size'], node.get('drop_remainder'))
@@ -605,11 +605,15 @@ def check_shuffle(method):
 
     @wraps(method)
     def new_method(self, *args, **kwargs):
-        [buffer_size], _ = parse_user_args(method, *args, **kwargs)
+        [buffer_size, block_size, row_pool_size], _ = parse_user_args(method, *args, **kwargs)
 
         type_check(buffer_size, (int,), "buffer_size")
+        type_check(block_size, (int,), "block_size")
+        type_check(row_pool_size, (int,), "row_pool_size")
 
         check_value(buffer_size, [2, INT32_MAX], "buffer_size")
+        check_value(block_size, [1, INT32_MAX], "block_size")
+        check_value(row_pool_size, [0, INT32_MAX], "row_pool_size")
 
         return method(self, *args, **kwargs)
 
@@ -0,0 +1,73 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_INCLUDE_BATCH_SCHEDULER_H
+#define MINDSPORE_LITE_INCLUDE_BATCH_SCHEDULER_H
+
+#include <vector>
+#include "include/ms_tensor.h"
+#include "include/model.h"
+#include "include/context.h"
+
+namespace mindspore {
+namespace session {
+/// \brief BatchScheduler defined a serving layer in MindSpore Lite which gathers the single sample requests of many
+/// threads into batches and runs each batch once.
+///
+/// \note Every input and output of the model must have the batch as its first dimension.
+class MS_API BatchScheduler {
+ public:
+  /// \brief Static method to create a BatchScheduler pointer.
+  ///
+  /// \param[in] model Define the model to be served, it must stay alive as long as the scheduler.
+  /// \param[in] context Define the context of the session of each batch size.
+  /// \param[in] batch_sizes Define the batch sizes a session is compiled and resized for once.
+  /// \param[in] max_delay_us Define how long a request may wait for others to join its batch.
+  ///
+  /// \return Pointer of MindSpore Lite BatchScheduler.
+  static BatchScheduler *CreateScheduler(lite::Model *model, const lite::Context *context,
+                                         const std::vector<int> &batch_sizes, int max_delay_us);
+
+  /// \brief Destructor of MindSpore Lite BatchScheduler, the pending requests are run first.
+  virtual ~BatchScheduler() = default;
+
+  /// \brief Run the inference of one sample and wait for the batch it joins.
+  ///
+  /// \param[in] inputs Define the data of the sample for each input, in the order of LiteSession::GetInputs.
+  /// \param[out] outputs Define the buffers the sample of each output is copied to, in the order of
+  /// LiteSession::GetOutputTensorNames.
+  ///
+  /// \return STATUS as an error code of the inference, STATUS is defined in errorcode.h.
+  virtual int Predict(const std::vector<const void *> &inputs, const std::vector<void *> &outputs) = 0;
+
+  /// \brief Get the bytes of one sample of each input.
+  ///
+  /// \return The vector of sizes.
+  virtual std::vector<size_t> GetInputSampleSizes() const = 0;
+
+  /// \brief Get the bytes of one sample of each output.
+  ///
+  /// \return The vector of sizes.
+  virtual std::vector<size_t> GetOutputSampleSizes() const = 0;
+
+  /// \brief Get the data type of each input.
+  ///
+  /// \return The vector of data types.
+  virtual std::vector<TypeId> GetInputDataTypes() const = 0;
+};
+}  // namespace session
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_INCLUDE_BATCH_SCHEDULER_H
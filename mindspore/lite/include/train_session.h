@@ -83,6 +83,15 @@ class TrainSession : public session::LiteSession {
   /// \return boolean indication if model is in eval mode
   bool IsEval() { return train_mode_ == false; }
 
+  /// \brief Free the activations between checkpoints after the forward pass of train mode and recompute them during
+  /// the backward pass, trading compute for memory
+  ///
+  /// \param[in] enable Whether to recompute activations
+  /// \param[in] checkpoint_names Names of the kernels whose outputs are kept, empty picks them by memory cost
+  ///
+  /// \return STATUS as an error code of compiling the recompute plan, STATUS is defined in errorcode.h
+  virtual int SetRecompute(bool enable, const std::vector<std::string> &checkpoint_names = {}) = 0;
+
  protected:
   bool train_mode_ = false;
 };
@@ -882,6 +882,10 @@ void MatMulOpt(const float *a, const float *b, float *c, const float *bias, ActT
 #elif ENABLE_AVX
   if (out_type == OutType_C8) {
     MatmulFloatSse64(a, b, c, bias, (int)act_type, deep, row, col, stride, 0, 0);
+#ifdef ENABLE_X86_64_CPU_DISPATCH
+  } else if (X86SupportAvx512F()) {
+    MatmulFloatAvx512Opt(a, b, c, bias, (size_t)act_type, deep, row, col, stride, (size_t)(out_type));
+#endif
   } else {
     MatmulFloatAvxOpt(a, b, c, bias, (size_t)act_type, deep, row, col, stride, (size_t)(out_type));
   }
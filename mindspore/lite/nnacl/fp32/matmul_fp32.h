@@ -22,6 +22,7 @@
 #include "nnacl/errorcode.h"
 #include "nnacl/matmul_parameter.h"
 #include "nnacl/op_base.h"
+#include "nnacl/x86_cpu_info.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -64,6 +65,10 @@ void MatmulFloatSse64Opt(const float *a, const float *b, float *c, const float *
 #ifdef ENABLE_AVX
 void MatmulFloatAvxOpt(const float *a, const float *b, float *c, const float *bias, size_t act_type, size_t depth,
                        size_t row, size_t col, size_t stride, size_t write_mode);
+#ifdef ENABLE_X86_64_CPU_DISPATCH
+void MatmulFloatAvx512Opt(const float *a, const float *b, float *c, const float *bias, size_t act_type, size_t depth,
+                          size_t row, size_t col, size_t stride, size_t write_mode);
+#endif
 #endif
 #endif
 
@@ -86,7 +86,7 @@ void ConvInt8(int8_t *input_data, int8_t *packed_input, int8_t *matmul_input, in
                          conv_param->conv_quant_arg_.right_shift_, real_cal_num, out_channel, out_channel, per_channel);
       }
 #else
-      MatMulInt8_8x8_r(
+      MatMulInt8_16x4_r(
         gemm_input, packed_weight, gemm_output, real_cal_num, out_channel, unit_size, out_channel, tmp_input_sum,
         bias_data, conv_param->conv_quant_arg_.left_shift_, conv_param->conv_quant_arg_.right_shift_,
         conv_param->conv_quant_arg_.quant_multiplier_, conv_param->conv_quant_arg_.output_quant_args_[0].zp_,
@@ -16,6 +16,7 @@
 
 #include "nnacl/int8/matmul_int8.h"
 #include "nnacl/int8/fixed_point.h"
+#include "nnacl/int8/matmul_int8_x86.h"
 
 void RowMajor2Row2x16MajorInt8(int8_t *src_ptr, int8_t *dst_ptr, int row, int col) {
   int col16 = UP_ROUND(col, C16NUM);
@@ -182,35 +183,64 @@ void MatMulInt8_16x4(const int8_t *a, const int8_t *b, int *dst, int row_4, int
   return;
 }
 
+void MatMulInt8Tile16x4(const int8_t *a, const int8_t *b, int deep16, int32_t *dst) {
+  /*  row4x16-major * row16x4-major => row-major 4x4  */
+  for (int r = 0; r < C4NUM; r++) {
+    for (int c = 0; c < C4NUM; c++) {
+      int32_t value = 0;
+      for (int d = 0; d < deep16; d++) {
+        int d16div = d / C16NUM, d16mod = d % C16NUM;
+        size_t ai = d16div * C4NUM * C16NUM + r * C16NUM + d16mod;
+        size_t bi = d16div * C4NUM * C16NUM + c * C16NUM + d16mod;
+        value = value + a[ai] * b[bi];
+      }
+      dst[r * C4NUM + c] = value;
+    }
+  }
+  return;
+}
+
+MATMUL_INT8_TILE_FUNC GetMatMulInt8Tile16x4Func(void) {
+#ifdef ENABLE_X86_64_CPU_DISPATCH
+  MATMUL_INT8_TILE_FUNC x86_func = GetMatMulInt8Tile16x4X86();
+  if (x86_func != NULL) {
+    return x86_func;
+  }
+#endif
+  return MatMulInt8Tile16x4;
+}
+
 void MatMulInt8_16x4_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_16,
                        size_t stride, const int32_t *input_sum, const int32_t *bias, int32_t *left_shift,
                        int32_t *right_shift, int32_t *multiplier, int32_t output_zp, int32_t mini, int32_t maxi,
                        bool peroc) {
   /* support per-layer && weight per-channel */
   /*  row4x16-major * row16x4-major => (int8)row-major*/
-  for (int r = 0; r < row; r++) {
-    for (int c = 0; c < col; c++) {
-      int r4div = r / C4NUM, r4mod = r % C4NUM;
-      int c4div = c / C4NUM, c4mod = c % C4NUM;
-      size_t ci = r * stride + c;
-      int32_t value = 0;
-      for (int d = 0; d < deep_16; d++) {
-        int d16div = d / C16NUM, d16mod = d % C16NUM;
-        size_t ai = r4div * deep_16 * C4NUM + d16div * C4NUM * C16NUM + r4mod * C16NUM + d16mod;
-        size_t bi = c4div * deep_16 * C4NUM + d16div * C4NUM * C16NUM + c4mod * C16NUM + d16mod;
-        value = value + a[ai] * b[bi];
+  MATMUL_INT8_TILE_FUNC tile_func = GetMatMulInt8Tile16x4Func();
+  int32_t tile[C4NUM * C4NUM];
+  for (int r4 = 0; r4 < row; r4 += C4NUM) {
+    for (int c4 = 0; c4 < col; c4 += C4NUM) {
+      tile_func(a + r4 * deep_16, b + c4 * deep_16, deep_16, tile);
+      int row_end = MSMIN(r4 + C4NUM, (int)row);
+      int col_end = MSMIN(c4 + C4NUM, (int)col);
+      for (int r = r4; r < row_end; r++) {
+        for (int c = c4; c < col_end; c++) {
+          int c4div = c / C4NUM, c4mod = c % C4NUM;
+          size_t ci = r * stride + c;
+          int32_t value = tile[(r - r4) * C4NUM + c4mod];
+          int32_t cur_input_sum =
+            peroc ? input_sum[c4div * UP_ROUND(row, C4NUM) * C4NUM + r * C4NUM + c4mod] : input_sum[r];
+          value -= cur_input_sum;
+          value += bias[c];
+          int32_t cur_left_shift = peroc ? left_shift[c] : left_shift[0];
+          int32_t cur_right_shift = peroc ? right_shift[c] : right_shift[0];
+          int32_t cur_multiplier = peroc ? multiplier[c] : multiplier[0];
+          value = MultiplyByQuantizedMultiplier(value, cur_multiplier, cur_left_shift, cur_right_shift) + output_zp;
+          value = MSMIN(maxi, value);
+          value = MSMAX(mini, value);
+          dst[ci] = (int8_t)value;
+        }
       }
-      int32_t cur_input_sum =
-        peroc ? input_sum[c4div * UP_ROUND(row, C4NUM) * C4NUM + r * C4NUM + c4mod] : input_sum[r];
-      value -= cur_input_sum;
-      value += bias[c];
-      int32_t cur_left_shift = peroc ? left_shift[c] : left_shift[0];
-      int32_t cur_right_shift = peroc ? right_shift[c] : right_shift[0];
-      int32_t cur_multiplier = peroc ? multiplier[c] : multiplier[0];
-      value = MultiplyByQuantizedMultiplier(value, cur_multiplier, cur_left_shift, cur_right_shift) + output_zp;
-      value = MSMIN(maxi, value);
-      value = MSMAX(mini, value);
-      dst[ci] = (int8_t)value;
     }
   }
   return;
@@ -260,28 +290,29 @@ void MatmulInt8Opt(const int8_t *a, const int8_t *b, int8_t *dst, int row, int c
    * a_sums is  perT  : input_row_sum * filter_zp
    *            perOc : input_row_sum
    * */
-  for (int r = 0; r < row; r++) {
-    for (int c = 0; c < col; c++) {
-      int r4div = r / C4NUM, r4mod = r % C4NUM;
-      int c4div = c / C4NUM, c4mod = c % C4NUM;
-      size_t ci = r * stride + c;
-      int32_t value = 0;
-      for (int d = 0; d < deep16; d++) {
-        int d16div = d / C16NUM, d16mod = d % C16NUM;
-        size_t ai = r4div * deep16 * C4NUM + d16div * C4NUM * C16NUM + r4mod * C16NUM + d16mod;
-        size_t bi = c4div * deep16 * C4NUM + d16div * C4NUM * C16NUM + c4mod * C16NUM + d16mod;
-        value = value + a[ai] * b[bi];
+  MATMUL_INT8_TILE_FUNC tile_func = GetMatMulInt8Tile16x4Func();
+  int32_t tile[C4NUM * C4NUM];
+  for (int r4 = 0; r4 < row; r4 += C4NUM) {
+    for (int c4 = 0; c4 < col; c4 += C4NUM) {
+      tile_func(a + r4 * deep16, b + c4 * deep16, deep16, tile);
+      int row_end = MSMIN(r4 + C4NUM, row);
+      int col_end = MSMIN(c4 + C4NUM, col);
+      for (int r = r4; r < row_end; r++) {
+        for (int c = c4; c < col_end; c++) {
+          size_t ci = r * stride + c;
+          int32_t value = tile[(r - r4) * C4NUM + c - c4];
+          int32_t cur_input_sum = filter_peroc ? a_sums[r] * filter_zp[c] : a_sums[r];
+          value -= cur_input_sum;
+          value += bias[c];
+          int32_t cur_left_shift = filter_peroc ? left_shift[c] : left_shift[0];
+          int32_t cur_right_shift = filter_peroc ? right_shift[c] : right_shift[0];
+          int32_t cur_multiplier = filter_peroc ? multiplier[c] : multiplier[0];
+          value = MultiplyByQuantizedMultiplier(value, cur_multiplier, cur_left_shift, cur_right_shift) + out_zp;
+          value = MSMIN(maxi, value);
+          value = MSMAX(mini, value);
+          dst[ci] = (int8_t)value;
+        }
       }
-      int32_t cur_input_sum = filter_peroc ? a_sums[r] * filter_zp[c] : a_sums[r];
-      value -= cur_input_sum;
-      value += bias[c];
-      int32_t cur_left_shift = filter_peroc ? left_shift[c] : left_shift[0];
-      int32_t cur_right_shift = filter_peroc ? right_shift[c] : right_shift[0];
-      int32_t cur_multiplier = filter_peroc ? multiplier[c] : multiplier[0];
-      value = MultiplyByQuantizedMultiplier(value, cur_multiplier, cur_left_shift, cur_right_shift) + out_zp;
-      value = MSMIN(maxi, value);
-      value = MSMAX(mini, value);
-      dst[ci] = (int8_t)value;
     }
   }
   return;
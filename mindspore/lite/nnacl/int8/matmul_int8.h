@@ -21,10 +21,15 @@
 #include "nnacl/op_base.h"
 #include "nnacl/matmul_parameter.h"
 
+/* 4x4 int32 tile of a row4x16-major block row of a and a row16x4-major block column of b */
+typedef void (*MATMUL_INT8_TILE_FUNC)(const int8_t *a, const int8_t *b, int deep16, int32_t *dst);
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 /* 4x16 16x4 -> 4x4 */
+void MatMulInt8Tile16x4(const int8_t *a, const int8_t *b, int deep16, int32_t *dst);
+MATMUL_INT8_TILE_FUNC GetMatMulInt8Tile16x4Func(void);
 void MatMulInt8_16x4(const int8_t *a, const int8_t *b, int *dst, int row_4, int col_4, int deep_16,
                      const int *input_sum, const int *bias);
 void MatMulInt8_16x4_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_16,
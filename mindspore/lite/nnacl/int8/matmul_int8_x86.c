@@ -0,0 +1,83 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/int8/matmul_int8_x86.h"
+
+#ifdef ENABLE_X86_64_CPU_DISPATCH
+#include <immintrin.h>
+
+__attribute__((target("avx2"))) void MatMulInt8Tile16x4Avx2(const int8_t *a, const int8_t *b, int deep16,
+                                                            int32_t *dst) {
+  __m256i acc[C4NUM];
+  for (int r = 0; r < C4NUM; r++) {
+    acc[r] = _mm256_setzero_si256();
+  }
+  for (int d = 0; d < deep16; d += C16NUM) {
+    const int8_t *a_d = a + d * C4NUM;
+    const int8_t *b_d = b + d * C4NUM;
+    __m256i b0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_d)));
+    __m256i b1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_d + C16NUM)));
+    __m256i b2 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_d + 2 * C16NUM)));
+    __m256i b3 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_d + 3 * C16NUM)));
+    for (int r = 0; r < C4NUM; r++) {
+      __m256i a_r = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(a_d + r * C16NUM)));
+      /* each 128-bit lane ends up with the 4 columns of its 8 depths */
+      __m256i sum01 = _mm256_hadd_epi32(_mm256_madd_epi16(a_r, b0), _mm256_madd_epi16(a_r, b1));
+      __m256i sum23 = _mm256_hadd_epi32(_mm256_madd_epi16(a_r, b2), _mm256_madd_epi16(a_r, b3));
+      acc[r] = _mm256_add_epi32(acc[r], _mm256_hadd_epi32(sum01, sum23));
+    }
+  }
+  for (int r = 0; r < C4NUM; r++) {
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc[r]), _mm256_extracti128_si256(acc[r], 1));
+    _mm_storeu_si128((__m128i *)(dst + r * C4NUM), sum);
+  }
+}
+
+__attribute__((target("avx512f,avx512vnni"))) void MatMulInt8Tile16x4Vnni(const int8_t *a, const int8_t *b,
+                                                                          int deep16, int32_t *dst) {
+  /* vpdpbusd multiplies uint8 by int8, so a + 128 is used and 128 times the sum of b is taken back */
+  const __m512i offset = _mm512_set1_epi8((char)0x80);
+  __m512i b_sum = _mm512_setzero_si512();
+  __m512i acc[C4NUM];
+  for (int r = 0; r < C4NUM; r++) {
+    acc[r] = _mm512_setzero_si512();
+  }
+  for (int d = 0; d < deep16; d += C16NUM) {
+    const int8_t *a_d = a + d * C4NUM;
+    /* the 4 columns of b, one in each 128-bit lane */
+    __m512i b_d = _mm512_loadu_si512(b + d * C4NUM);
+    b_sum = _mm512_dpbusd_epi32(b_sum, offset, b_d);
+    for (int r = 0; r < C4NUM; r++) {
+      __m512i a_r = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)(a_d + r * C16NUM)));
+      acc[r] = _mm512_dpbusd_epi32(acc[r], _mm512_xor_si512(a_r, offset), b_d);
+    }
+  }
+  int32_t lanes[C16NUM];
+  for (int r = 0; r < C4NUM; r++) {
+    _mm512_storeu_si512(lanes, _mm512_sub_epi32(acc[r], b_sum));
+    for (int c = 0; c < C4NUM; c++) {
+      dst[r * C4NUM + c] = lanes[c * C4NUM] + lanes[c * C4NUM + 1] + lanes[c * C4NUM + 2] + lanes[c * C4NUM + 3];
+    }
+  }
+}
+
+MATMUL_INT8_TILE_FUNC GetMatMulInt8Tile16x4X86(void) {
+  if (X86SupportAvx512Vnni()) {
+    return MatMulInt8Tile16x4Vnni;
+  }
+  return X86SupportAvx2() ? MatMulInt8Tile16x4Avx2 : NULL;
+}
+#endif
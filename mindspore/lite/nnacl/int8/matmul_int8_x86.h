@@ -0,0 +1,40 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_NNACL_INT8_MATMUL_INT8_X86_H_
+#define MINDSPORE_LITE_NNACL_INT8_MATMUL_INT8_X86_H_
+
+#include "nnacl/int8/matmul_int8.h"
+#include "nnacl/x86_cpu_info.h"
+
+#ifdef ENABLE_X86_64_CPU_DISPATCH
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* 4x16 16x4 -> 4x4, vpmaddwd on the inputs widened to int16 */
+void MatMulInt8Tile16x4Avx2(const int8_t *a, const int8_t *b, int deep16, int32_t *dst);
+
+/* 4x16 16x4 -> 4x4, vpdpbusd on a shifted to uint8, the shift is taken back with the column sums of b */
+void MatMulInt8Tile16x4Vnni(const int8_t *a, const int8_t *b, int deep16, int32_t *dst);
+
+/* The tile of the best instruction set of the cpu, NULL if it has neither avx2 nor avx512 vnni */
+MATMUL_INT8_TILE_FUNC GetMatMulInt8Tile16x4X86(void);
+#ifdef __cplusplus
+}
+#endif
+#endif
+
+#endif  // MINDSPORE_LITE_NNACL_INT8_MATMUL_INT8_X86_H_
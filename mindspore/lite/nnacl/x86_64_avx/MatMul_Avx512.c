@@ -0,0 +1,139 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/fp32/matmul_fp32.h"
+
+#if defined(ENABLE_AVX) && defined(ENABLE_X86_64_CPU_DISPATCH)
+#include <immintrin.h>
+
+#define AVX512_TARGET __attribute__((target("avx512f")))
+
+static inline AVX512_TARGET __mmask16 ColMask(size_t col) {
+  return col >= C16NUM ? (__mmask16)0xFFFF : (__mmask16)((1u << col) - 1);
+}
+
+/* the accumulators are named so that they stay in registers, arrays of them end up on the stack */
+static inline AVX512_TARGET void MatmulAvx512Compute6x32(const float *a, const float *b, size_t depth, __m512 *acc) {
+  __m512 c00 = acc[0], c01 = acc[1], c10 = acc[2], c11 = acc[3], c20 = acc[4], c21 = acc[5];
+  __m512 c30 = acc[6], c31 = acc[7], c40 = acc[8], c41 = acc[9], c50 = acc[10], c51 = acc[11];
+  const float *b1 = b + depth * C16NUM;
+  for (size_t d = 0; d < depth; d++, a += C6NUM, b += C16NUM, b1 += C16NUM) {
+    __m512 w0 = _mm512_loadu_ps(b);
+    __m512 w1 = _mm512_loadu_ps(b1);
+    __m512 x = _mm512_set1_ps(a[0]);
+    c00 = _mm512_fmadd_ps(x, w0, c00);
+    c01 = _mm512_fmadd_ps(x, w1, c01);
+    x = _mm512_set1_ps(a[1]);
+    c10 = _mm512_fmadd_ps(x, w0, c10);
+    c11 = _mm512_fmadd_ps(x, w1, c11);
+    x = _mm512_set1_ps(a[2]);
+    c20 = _mm512_fmadd_ps(x, w0, c20);
+    c21 = _mm512_fmadd_ps(x, w1, c21);
+    x = _mm512_set1_ps(a[3]);
+    c30 = _mm512_fmadd_ps(x, w0, c30);
+    c31 = _mm512_fmadd_ps(x, w1, c31);
+    x = _mm512_set1_ps(a[4]);
+    c40 = _mm512_fmadd_ps(x, w0, c40);
+    c41 = _mm512_fmadd_ps(x, w1, c41);
+    x = _mm512_set1_ps(a[5]);
+    c50 = _mm512_fmadd_ps(x, w0, c50);
+    c51 = _mm512_fmadd_ps(x, w1, c51);
+  }
+  acc[0] = c00, acc[1] = c01, acc[2] = c10, acc[3] = c11, acc[4] = c20, acc[5] = c21;
+  acc[6] = c30, acc[7] = c31, acc[8] = c40, acc[9] = c41, acc[10] = c50, acc[11] = c51;
+}
+
+static inline AVX512_TARGET void MatmulAvx512Compute6x16(const float *a, const float *b, size_t depth, __m512 *acc) {
+  __m512 c0 = acc[0], c1 = acc[2], c2 = acc[4], c3 = acc[6], c4 = acc[8], c5 = acc[10];
+  for (size_t d = 0; d < depth; d++, a += C6NUM, b += C16NUM) {
+    __m512 w = _mm512_loadu_ps(b);
+    c0 = _mm512_fmadd_ps(_mm512_set1_ps(a[0]), w, c0);
+    c1 = _mm512_fmadd_ps(_mm512_set1_ps(a[1]), w, c1);
+    c2 = _mm512_fmadd_ps(_mm512_set1_ps(a[2]), w, c2);
+    c3 = _mm512_fmadd_ps(_mm512_set1_ps(a[3]), w, c3);
+    c4 = _mm512_fmadd_ps(_mm512_set1_ps(a[4]), w, c4);
+    c5 = _mm512_fmadd_ps(_mm512_set1_ps(a[5]), w, c5);
+  }
+  acc[0] = c0, acc[2] = c1, acc[4] = c2, acc[6] = c3, acc[8] = c4, acc[10] = c5;
+}
+
+/* 6 rows of a by block_num 16-column blocks of b, acc[r * 2 + k] holds row r of block k. col is what is left of
+ * the columns from this tile on and row_stride is the distance between two rows of c. */
+static inline AVX512_TARGET void MatmulAvx512Tile(const float *a, const float *b, float *c, const float *bias,
+                                                  size_t act_type, size_t depth, size_t row, size_t col, size_t stride,
+                                                  size_t row_stride, size_t write_mode, size_t block_num) {
+  __m512 acc[C6NUM * C2NUM];
+  for (size_t k = 0; k < block_num; k++) {
+    __m512 init = _mm512_setzero_ps();
+    if (bias != NULL) {
+      init = _mm512_maskz_loadu_ps(ColMask(col - k * C16NUM), bias + k * C16NUM);
+    }
+    for (int r = 0; r < C6NUM; r++) {
+      acc[r * C2NUM + k] = init;
+    }
+  }
+  if (block_num == C2NUM) {
+    MatmulAvx512Compute6x32(a, b, depth, acc);
+  } else {
+    MatmulAvx512Compute6x16(a, b, depth, acc);
+  }
+  for (size_t r = 0; r < row && r < C6NUM; r++) {
+    for (size_t k = 0; k < block_num && k * C16NUM < col; k++) {
+      __m512 value = acc[r * C2NUM + k];
+      if (act_type == ActType_Relu6) {
+        value = _mm512_min_ps(value, _mm512_set1_ps(6.0f));
+      }
+      if (act_type == ActType_Relu6 || act_type == ActType_Relu) {
+        value = _mm512_max_ps(value, _mm512_setzero_ps());
+      }
+      size_t cur_col = col - k * C16NUM;
+      if (write_mode == OutType_TileC8) {
+        /* each 8 columns go to their own block of the winograd output */
+        float tmp[C16NUM];
+        _mm512_storeu_ps(tmp, value);
+        float *dst = c + r * row_stride + k * C2NUM * C8NUM * stride;
+        memcpy(dst, tmp, C8NUM * sizeof(float));
+        if (cur_col > C8NUM) {
+          memcpy(dst + C8NUM * stride, tmp + C8NUM, C8NUM * sizeof(float));
+        }
+      } else {
+        _mm512_mask_storeu_ps(c + r * row_stride + k * C16NUM, ColMask(cur_col), value);
+      }
+    }
+  }
+}
+
+AVX512_TARGET void MatmulFloatAvx512Opt(const float *a, const float *b, float *c, const float *bias, size_t act_type,
+                                        size_t depth, size_t row, size_t col, size_t stride, size_t write_mode) {
+  /* winograd writes each 8 columns of a row to their own block, stride apart */
+  bool is_wino = write_mode == OutType_TileC8;
+  size_t row_stride = is_wino ? col * stride : stride;
+  size_t col_stride = is_wino ? stride : 1;
+  for (size_t r = 0; r < row; r += C6NUM) {
+    const float *a_r = a + r * depth;
+    float *c_r = c + r * row_stride;
+    size_t ci = 0;
+    for (; ci + C16NUM < col; ci += C2NUM * C16NUM) {
+      MatmulAvx512Tile(a_r, b + ci * depth, c_r + ci * col_stride, bias == NULL ? NULL : bias + ci, act_type, depth,
+                       row - r, col - ci, stride, row_stride, write_mode, C2NUM);
+    }
+    if (ci < col) {
+      MatmulAvx512Tile(a_r, b + ci * depth, c_r + ci * col_stride, bias == NULL ? NULL : bias + ci, act_type, depth,
+                       row - r, col - ci, stride, row_stride, write_mode, 1);
+    }
+  }
+}
+#endif
@@ -0,0 +1,80 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/x86_cpu_info.h"
+
+#ifdef ENABLE_X86_64_CPU_DISPATCH
+#include <cpuid.h>
+
+#define CPUID_ECX_OSXSAVE (1u << 27)
+#define CPUID_EBX_AVX2 (1u << 5)
+#define CPUID_EBX_AVX512F (1u << 16)
+#define CPUID_ECX_AVX512VNNI (1u << 11)
+/* xmm and ymm states */
+#define XCR0_AVX_STATE 0x6
+/* xmm, ymm, opmask and zmm states */
+#define XCR0_AVX512_STATE 0xE6
+
+typedef enum X86Isa {
+  X86Isa_Avx2 = 1,
+  X86Isa_Avx512F = 1 << 1,
+  X86Isa_Avx512Vnni = 1 << 2,
+} X86Isa;
+
+/* the registers the os saves on a context switch */
+static uint32_t GetXcr0(void) {
+  uint32_t eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return eax;
+}
+
+static int DetectX86Isa(void) {
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || (ecx & CPUID_ECX_OSXSAVE) == 0) {
+    return 0;
+  }
+  uint32_t xcr0 = GetXcr0();
+  if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+    return 0;
+  }
+  int isa = 0;
+  if ((ebx & CPUID_EBX_AVX2) != 0 && (xcr0 & XCR0_AVX_STATE) == XCR0_AVX_STATE) {
+    isa |= X86Isa_Avx2;
+  }
+  if ((ebx & CPUID_EBX_AVX512F) != 0 && (xcr0 & XCR0_AVX512_STATE) == XCR0_AVX512_STATE) {
+    isa |= X86Isa_Avx512F;
+    if ((ecx & CPUID_ECX_AVX512VNNI) != 0) {
+      isa |= X86Isa_Avx512Vnni;
+    }
+  }
+  return isa;
+}
+
+/* cpuid may trap to the hypervisor, so it runs once, threads racing here all store the same value */
+static int GetX86Isa(void) {
+  static int isa = -1;
+  if (isa < 0) {
+    isa = DetectX86Isa();
+  }
+  return isa;
+}
+
+bool X86SupportAvx2(void) { return (GetX86Isa() & X86Isa_Avx2) != 0; }
+
+bool X86SupportAvx512F(void) { return (GetX86Isa() & X86Isa_Avx512F) != 0; }
+
+bool X86SupportAvx512Vnni(void) { return (GetX86Isa() & X86Isa_Avx512Vnni) != 0; }
+#endif
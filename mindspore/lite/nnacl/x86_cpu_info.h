@@ -0,0 +1,41 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_NNACL_X86_CPU_INFO_H_
+#define MINDSPORE_LITE_NNACL_X86_CPU_INFO_H_
+
+#include "nnacl/op_base.h"
+
+/* Kernels built with function target attributes are picked by the cpu they run on, so a build of any X86_64_SIMD
+ * level still uses the wider instruction sets when the cpu has them. */
+#if defined(__x86_64__) && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 8))
+#define ENABLE_X86_64_CPU_DISPATCH
+#endif
+
+#ifdef ENABLE_X86_64_CPU_DISPATCH
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* whether both the cpu and the os support the instruction set, checked once */
+bool X86SupportAvx2(void);
+bool X86SupportAvx512F(void);
+bool X86SupportAvx512Vnni(void);
+#ifdef __cplusplus
+}
+#endif
+#endif
+
+#endif  // MINDSPORE_LITE_NNACL_X86_CPU_INFO_H_
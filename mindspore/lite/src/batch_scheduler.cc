@@ -0,0 +1,234 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/batch_scheduler.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include "src/common/log_adapter.h"
+
+namespace mindspore {
+namespace lite {
+BatchScheduler::~BatchScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  request_cond_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+  {
+    // the callers of the last batch still leave Predict through mutex_ and done_cond_
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cond_.wait(lock, [this] { return active_predicts_ == 0; });
+  }
+  for (auto &session : sessions_) {
+    delete session.second;
+  }
+  sessions_.clear();
+}
+
+int BatchScheduler::CompileSession(Model *model, const Context *context, int batch_size) {
+  auto session = session::LiteSession::CreateSession(context);
+  if (session == nullptr) {
+    MS_LOG(ERROR) << "Create the session of batch " << batch_size << " failed.";
+    return RET_ERROR;
+  }
+  sessions_.emplace_back(batch_size, session);
+  auto ret = session->CompileGraph(model);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Compile the session of batch " << batch_size << " failed: " << ret;
+    return ret;
+  }
+
+  auto inputs = session->GetInputs();
+  std::vector<std::vector<int>> dims;
+  bool need_resize = false;
+  for (auto input : inputs) {
+    auto shape = input->shape();
+    if (shape.empty()) {
+      MS_LOG(ERROR) << "An input of the model has no batch dimension.";
+      return RET_PARAM_INVALID;
+    }
+    need_resize = need_resize || shape.front() != batch_size;
+    shape.front() = batch_size;
+    dims.push_back(shape);
+  }
+  if (need_resize) {
+    ret = session->Resize(inputs, dims);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Resize the session to batch " << batch_size << " failed: " << ret;
+      return ret;
+    }
+  }
+
+  std::vector<size_t> input_sample_sizes;
+  std::vector<TypeId> input_data_types;
+  for (auto input : inputs) {
+    input_sample_sizes.push_back(input->Size() / batch_size);
+    input_data_types.push_back(input->data_type());
+  }
+  std::vector<size_t> output_sample_sizes;
+  for (auto &name : session->GetOutputTensorNames()) {
+    auto output = session->GetOutputByTensorName(name);
+    if (output == nullptr || output->shape().empty() || output->shape().front() != batch_size) {
+      MS_LOG(ERROR) << "The output " << name << " does not have the batch as its first dimension.";
+      return RET_PARAM_INVALID;
+    }
+    output_sample_sizes.push_back(output->Size() / batch_size);
+  }
+  if (sessions_.size() == 1) {
+    input_sample_sizes_ = input_sample_sizes;
+    output_sample_sizes_ = output_sample_sizes;
+    input_data_types_ = input_data_types;
+  } else if (input_sample_sizes != input_sample_sizes_ || output_sample_sizes != output_sample_sizes_) {
+    MS_LOG(ERROR) << "The samples of the session of batch " << batch_size << " differ from the others.";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+int BatchScheduler::Init(Model *model, const Context *context, const std::vector<int> &batch_sizes,
+                         int max_delay_us) {
+  if (model == nullptr || context == nullptr) {
+    MS_LOG(ERROR) << "The model or the context is nullptr.";
+    return RET_NULL_PTR;
+  }
+  auto sizes = batch_sizes;
+  std::sort(sizes.begin(), sizes.end());
+  sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+  if (sizes.empty() || sizes.front() <= 0 || max_delay_us < 0) {
+    MS_LOG(ERROR) << "The batch sizes must be positive and the max delay must not be negative.";
+    return RET_PARAM_INVALID;
+  }
+  for (auto batch_size : sizes) {
+    auto ret = CompileSession(model, context, batch_size);
+    if (ret != RET_OK) {
+      return ret;
+    }
+  }
+  max_delay_ = std::chrono::microseconds(max_delay_us);
+  worker_ = std::thread(&BatchScheduler::Loop, this);
+  return RET_OK;
+}
+
+int BatchScheduler::Predict(const std::vector<const void *> &inputs, const std::vector<void *> &outputs) {
+  if (inputs.size() != input_sample_sizes_.size() || outputs.size() != output_sample_sizes_.size()) {
+    MS_LOG(ERROR) << "The model has " << input_sample_sizes_.size() << " inputs and " << output_sample_sizes_.size()
+                  << " outputs, got " << inputs.size() << " and " << outputs.size();
+    return RET_PARAM_INVALID;
+  }
+  BatchRequest request;
+  request.inputs_ = &inputs;
+  request.outputs_ = &outputs;
+  request.arrival_ = std::chrono::steady_clock::now();
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (stop_) {
+    MS_LOG(ERROR) << "The scheduler is stopped.";
+    return RET_ERROR;
+  }
+  active_predicts_++;
+  requests_.push_back(&request);
+  request_cond_.notify_all();
+  done_cond_.wait(lock, [&request] { return request.done_; });
+  if (--active_predicts_ == 0 && stop_) {
+    done_cond_.notify_all();
+  }
+  return request.status_;
+}
+
+void BatchScheduler::Loop() {
+  size_t max_batch = sessions_.back().first;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    request_cond_.wait(lock, [this] { return stop_ || !requests_.empty(); });
+    if (requests_.empty()) {
+      break;
+    }
+    // the oldest request sets the deadline of the batch, a full batch runs at once
+    auto deadline = requests_.front()->arrival_ + max_delay_;
+    request_cond_.wait_until(lock, deadline, [this, max_batch] { return stop_ || requests_.size() >= max_batch; });
+    auto count = std::min(requests_.size(), max_batch);
+    std::vector<BatchRequest *> batch(requests_.begin(), requests_.begin() + count);
+    requests_.erase(requests_.begin(), requests_.begin() + count);
+    lock.unlock();
+    auto status = RunBatch(batch);
+    lock.lock();
+    for (auto request : batch) {
+      request->status_ = status;
+      request->done_ = true;
+    }
+    done_cond_.notify_all();
+  }
+}
+
+int BatchScheduler::RunBatch(const std::vector<BatchRequest *> &batch) {
+  auto iter = std::find_if(sessions_.begin(), sessions_.end(),
+                           [&batch](const std::pair<int, session::LiteSession *> &session) {
+                             return static_cast<size_t>(session.first) >= batch.size();
+                           });
+  MS_ASSERT(iter != sessions_.end());
+  size_t batch_size = iter->first;
+  auto session = iter->second;
+
+  auto inputs = session->GetInputs();
+  for (size_t i = 0; i < inputs.size(); i++) {
+    auto data = reinterpret_cast<char *>(inputs[i]->MutableData());
+    if (data == nullptr) {
+      MS_LOG(ERROR) << "Malloc the input data of batch " << batch_size << " failed.";
+      return RET_MEMORY_FAILED;
+    }
+    auto sample_size = input_sample_sizes_[i];
+    for (size_t j = 0; j < batch.size(); j++) {
+      memcpy(data + j * sample_size, batch[j]->inputs_->at(i), sample_size);
+    }
+    memset(data + batch.size() * sample_size, 0, (batch_size - batch.size()) * sample_size);
+  }
+  auto ret = session->RunGraph();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Run the batch of " << batch.size() << " requests failed: " << ret;
+    return ret;
+  }
+  auto names = session->GetOutputTensorNames();
+  for (size_t i = 0; i < names.size(); i++) {
+    auto data = reinterpret_cast<const char *>(session->GetOutputByTensorName(names[i])->MutableData());
+    auto sample_size = output_sample_sizes_[i];
+    for (size_t j = 0; j < batch.size(); j++) {
+      memcpy(batch[j]->outputs_->at(i), data + j * sample_size, sample_size);
+    }
+  }
+  return RET_OK;
+}
+}  // namespace lite
+
+session::BatchScheduler *session::BatchScheduler::CreateScheduler(lite::Model *model, const lite::Context *context,
+                                                                  const std::vector<int> &batch_sizes,
+                                                                  int max_delay_us) {
+  auto scheduler = new (std::nothrow) lite::BatchScheduler();
+  if (scheduler == nullptr) {
+    MS_LOG(ERROR) << "create batch scheduler failed";
+    return nullptr;
+  }
+  auto ret = scheduler->Init(model, context, batch_sizes, max_delay_us);
+  if (ret != lite::RET_OK) {
+    MS_LOG(ERROR) << "init batch scheduler failed";
+    delete scheduler;
+    return nullptr;
+  }
+  return scheduler;
+}
+}  // namespace mindspore
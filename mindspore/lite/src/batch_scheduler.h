@@ -0,0 +1,85 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_BATCH_SCHEDULER_H_
+#define MINDSPORE_LITE_SRC_BATCH_SCHEDULER_H_
+
+#include <condition_variable>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "include/batch_scheduler.h"
+#include "include/errorcode.h"
+#include "include/lite_session.h"
+
+namespace mindspore {
+namespace lite {
+struct BatchRequest {
+  const std::vector<const void *> *inputs_;
+  const std::vector<void *> *outputs_;
+  std::chrono::steady_clock::time_point arrival_;
+  int status_ = RET_OK;
+  bool done_ = false;
+};
+
+// One worker thread takes the requests in arrival order. The oldest request waits at most max_delay_us for others,
+// then all the waiting requests up to the largest batch size are run by the session of the smallest batch size
+// which holds them, the rest of the batch is padded.
+class BatchScheduler : public session::BatchScheduler {
+ public:
+  BatchScheduler() = default;
+  ~BatchScheduler() override;
+
+  int Init(Model *model, const Context *context, const std::vector<int> &batch_sizes, int max_delay_us);
+
+  int Predict(const std::vector<const void *> &inputs, const std::vector<void *> &outputs) override;
+
+  std::vector<size_t> GetInputSampleSizes() const override { return input_sample_sizes_; }
+
+  std::vector<size_t> GetOutputSampleSizes() const override { return output_sample_sizes_; }
+
+  std::vector<TypeId> GetInputDataTypes() const override { return input_data_types_; }
+
+ private:
+  int CompileSession(Model *model, const Context *context, int batch_size);
+
+  void Loop();
+
+  // Copy the requests into the inputs of the session, run it and copy the outputs back
+  int RunBatch(const std::vector<BatchRequest *> &batch);
+
+  // sessions sorted by their batch size
+  std::vector<std::pair<int, session::LiteSession *>> sessions_;
+  std::vector<size_t> input_sample_sizes_;
+  std::vector<size_t> output_sample_sizes_;
+  std::vector<TypeId> input_data_types_;
+  std::chrono::microseconds max_delay_{0};
+
+  std::mutex mutex_;
+  std::condition_variable request_cond_;
+  std::condition_variable done_cond_;
+  std::deque<BatchRequest *> requests_;
+  // Predict calls which have not returned yet, the destructor waits for them
+  int active_predicts_ = 0;
+  bool stop_ = false;
+  std::thread worker_;
+};
+}  // namespace lite
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_SRC_BATCH_SCHEDULER_H_
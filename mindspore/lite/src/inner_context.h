@@ -17,7 +17,9 @@
 #ifndef MINDSPORE_LITE_SRC_INNER_CONTEXT_H
 #define MINDSPORE_LITE_SRC_INNER_CONTEXT_H
 
+#include <memory>
 #include "include/context.h"
+#include "src/packed_weight_store.h"
 #include "src/runtime/runtime_api.h"
 #include "src/runtime/allocator.h"
 
@@ -25,6 +27,8 @@ namespace mindspore::lite {
 struct InnerContext : public Context {
  public:
   struct ThreadPool *thread_pool_ = nullptr;
+  // packed weights of the model the session is compiled from, nullptr if the kernels pack their own
+  std::shared_ptr<PackedWeightStore> weight_store_ = nullptr;
 
  public:
   InnerContext() = default;
@@ -336,6 +336,7 @@ Model *ImportFromBuffer(const char *model_buf, size_t size, bool take_buf) {
     memcpy(model->buf, model_buf, size);
   }
   model->buf_size_ = size;
+  model->weight_store_ = std::make_shared<PackedWeightStore>(model->buf, size);
   auto status = model->ConstructModel();
   if (status != RET_OK) {
     MS_LOG(ERROR) << "construct model failed.";
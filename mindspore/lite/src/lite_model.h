@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_LITE_SRC_LITE_MODEL_H_
 #define MINDSPORE_LITE_SRC_LITE_MODEL_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 #include "include/model.h"
@@ -25,6 +26,7 @@
 #include "schema/model_generated.h"
 #include "src/common/common.h"
 #include "src/common/version_manager.h"
+#include "src/packed_weight_store.h"
 #ifndef PRIMITIVE_WRITEABLE
 #include "src/ops/ops_register.h"
 #endif
@@ -217,6 +219,8 @@ class LiteModel : public Model {
 
  public:
   size_t buf_size_ = 0;
+  // packed weights shared by the sessions compiled from the model
+  std::shared_ptr<PackedWeightStore> weight_store_;
 
  protected:
   std::vector<char *> attr_tensor_bufs_;
@@ -371,6 +371,10 @@ int LiteSession::CompileGraph(Model *model) {
     is_running_.store(false);
     return ret;
   }
+#ifndef SUPPORT_TRAIN
+  // the kernels of all the inference sessions of the model share their packed weights, training updates the weights
+  context_->weight_store_ = reinterpret_cast<LiteModel *>(model)->weight_store_;
+#endif
   // scheduler kernels
   Scheduler scheduler(context_, model, &tensors_);
   ret = scheduler.Schedule(&kernels_);
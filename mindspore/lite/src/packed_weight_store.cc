@@ -0,0 +1,70 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/packed_weight_store.h"
+#include <cstdlib>
+#include "include/errorcode.h"
+#include "src/common/log_adapter.h"
+
+namespace mindspore::lite {
+PackedWeightStore::~PackedWeightStore() {
+  for (auto &packed_weight : packed_weights_) {
+    free(packed_weight.second.first);
+  }
+  packed_weights_.clear();
+}
+
+bool PackedWeightStore::IsShareable(const void *weight) const {
+  auto data = reinterpret_cast<const char *>(weight);
+  return data != nullptr && data >= buf_begin_ && data < buf_end_;
+}
+
+void *PackedWeightStore::GetPackedWeight(const void *weight, const std::string &layout, size_t size,
+                                         const std::function<int(void *)> &pack) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto key = std::make_pair(weight, layout);
+  auto iter = packed_weights_.find(key);
+  if (iter != packed_weights_.end()) {
+    if (iter->second.second != size) {
+      MS_LOG(ERROR) << "The " << layout << " weight is packed into " << iter->second.second << " bytes, not " << size;
+      return nullptr;
+    }
+    return iter->second.first;
+  }
+  auto packed = malloc(size);
+  if (packed == nullptr) {
+    MS_LOG(ERROR) << "Malloc packed weight failed.";
+    return nullptr;
+  }
+  auto ret = pack(packed);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Pack the " << layout << " weight failed: " << ret;
+    free(packed);
+    return nullptr;
+  }
+  packed_weights_[key] = std::make_pair(packed, size);
+  return packed;
+}
+
+size_t PackedWeightStore::PackedSize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t total = 0;
+  for (auto &packed_weight : packed_weights_) {
+    total += packed_weight.second.second;
+  }
+  return total;
+}
+}  // namespace mindspore::lite
@@ -0,0 +1,56 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_PACKED_WEIGHT_STORE_H_
+#define MINDSPORE_LITE_SRC_PACKED_WEIGHT_STORE_H_
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace mindspore::lite {
+// Weights packed by the kernels of the sessions compiled from one model. A weight in the model buffer is packed the
+// same way by every session, so the first kernel packs it and the kernels of the other sessions read it, which keeps
+// one copy of the packed weights however many sessions serve the model. The store is owned by the model and by the
+// contexts of its sessions, a packed weight lives until the last of them is gone.
+class PackedWeightStore {
+ public:
+  PackedWeightStore(const char *buf, size_t size) : buf_begin_(buf), buf_end_(buf + size) {}
+  ~PackedWeightStore();
+
+  // Whether the weight data is in the model buffer, weights copied or dequantized by a session are its own
+  bool IsShareable(const void *weight) const;
+
+  // The packed weight of a weight of the model, pack fills it on the first call for the weight and layout.
+  // @param layout names the kernel packing, the size of a layout must not change
+  // @return nullptr if the size does not match or pack fails, the packed weight must not be freed
+  void *GetPackedWeight(const void *weight, const std::string &layout, size_t size,
+                        const std::function<int(void *)> &pack);
+
+  // Bytes of all the packed weights
+  size_t PackedSize();
+
+ private:
+  const char *buf_begin_;
+  const char *buf_end_;
+  std::mutex mutex_;
+  std::map<std::pair<const void *, std::string>, std::pair<void *, size_t>> packed_weights_;
+};
+}  // namespace mindspore::lite
+
+#endif  // MINDSPORE_LITE_SRC_PACKED_WEIGHT_STORE_H_
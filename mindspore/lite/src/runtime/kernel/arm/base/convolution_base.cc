@@ -35,6 +35,33 @@ ConvolutionBaseCPUKernel::~ConvolutionBaseCPUKernel() {
   }
 }
 
+void *ConvolutionBaseCPUKernel::MallocPackedWeight(const std::string &layout, size_t size,
+                                                  const std::function<int(void *)> &pack) {
+  auto weight = in_tensors_.at(kWeightIndex)->data_c();
+  auto store = ctx_->weight_store_;
+  if (store != nullptr && store->IsShareable(weight)) {
+    is_weight_shared_ = true;
+    return store->GetPackedWeight(weight, layout, size, pack);
+  }
+  is_weight_shared_ = false;
+  auto packed_weight = malloc(size);
+  if (packed_weight == nullptr) {
+    MS_LOG(ERROR) << "Malloc packed weight failed.";
+    return nullptr;
+  }
+  if (pack(packed_weight) != RET_OK) {
+    free(packed_weight);
+    return nullptr;
+  }
+  return packed_weight;
+}
+
+void ConvolutionBaseCPUKernel::FreePackedWeight(void *packed_weight) {
+  if (packed_weight != nullptr && !is_weight_shared_) {
+    free(packed_weight);
+  }
+}
+
 void ConvolutionBaseCPUKernel::FreeQuantParam() {
   ConvQuantArg *conv_quant_arg_ = &conv_param_->conv_quant_arg_;
   if (conv_quant_arg_ == nullptr) {
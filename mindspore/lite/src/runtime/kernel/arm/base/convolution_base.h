@@ -18,6 +18,7 @@
 #define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_BASE_CONVOLUTION_BASE_H_
 
 #include <unistd.h>
+#include <functional>
 #include <vector>
 #include <string>
 #include <limits>
@@ -58,6 +59,12 @@ class ConvolutionBaseCPUKernel : public LiteKernel {
   void FreeQuantParam();
 
  protected:
+  // Malloc the packed weight and fill it with pack. A weight in the model buffer is packed once and shared by all
+  // the sessions of the model, the store owns it then and FreePackedWeight leaves it alone.
+  void *MallocPackedWeight(const std::string &layout, size_t size, const std::function<int(void *)> &pack);
+  void FreePackedWeight(void *packed_weight);
+
+  bool is_weight_shared_ = false;
   void *bias_data_ = nullptr;
   const InnerContext *ctx_ = nullptr;
   ConvParameter *conv_param_ = nullptr;
@@ -24,10 +24,8 @@ using mindspore::lite::RET_OK;
 namespace mindspore::kernel {
 Convolution1x1CPUKernel::~Convolution1x1CPUKernel() {
   FreeTmpBuffer();
-  if (weight_ptr_ != nullptr) {
-    free(weight_ptr_);
-    weight_ptr_ = nullptr;
-  }
+  FreePackedWeight(weight_ptr_);
+  weight_ptr_ = nullptr;
   if (matmul_param_ != nullptr) {
     delete matmul_param_;
     matmul_param_ = nullptr;
@@ -104,19 +102,23 @@ int Convolution1x1CPUKernel::InitConv1x1BiasWeight() {
 
   int size = input_channel * UP_ROUND(output_channel, col_tile_) * sizeof(float);
   int down_size = input_channel * DOWN_DIV(output_channel, col_tile_) * col_tile_ * sizeof(float);
-  weight_ptr_ = reinterpret_cast<float *>(malloc(size));
-  if (weight_ptr_ == nullptr) {
-    MS_LOG(ERROR) << "Conv1x1 Malloc weight_ptr_ error!";
-    return RET_ERROR;
-  }
-  memset(reinterpret_cast<char *>(weight_ptr_) + down_size, 0, size - down_size);
+  auto pack_weight = [&](void *dst) {
+    auto weight_ptr = reinterpret_cast<float *>(dst);
+    memset(reinterpret_cast<char *>(weight_ptr) + down_size, 0, size - down_size);
 #ifdef ENABLE_AVX
-  RowMajor2Col16Major(origin_weight_, weight_ptr_, output_channel, input_channel);
+    RowMajor2Col16Major(origin_weight_, weight_ptr, output_channel, input_channel);
 #elif defined(ENABLE_ARM32)
-  RowMajor2Col4Major(origin_weight_, weight_ptr_, output_channel, input_channel);
+    RowMajor2Col4Major(origin_weight_, weight_ptr, output_channel, input_channel);
 #else
-  RowMajor2Col8Major(origin_weight_, weight_ptr_, output_channel, input_channel);
+    RowMajor2Col8Major(origin_weight_, weight_ptr, output_channel, input_channel);
 #endif
+    return RET_OK;
+  };
+  weight_ptr_ = reinterpret_cast<float *>(MallocPackedWeight("conv_fp32_1x1", size, pack_weight));
+  if (weight_ptr_ == nullptr) {
+    MS_LOG(ERROR) << "Conv1x1 Malloc weight_ptr_ error!";
+    return RET_ERROR;
+  }
   return RET_OK;
 }
 
@@ -48,19 +48,24 @@ int ConvolutionCPUKernel::InitWeightBias() {
   int oc_block_num = UP_ROUND(out_channel, oc_block);
   int pack_weight_size = oc_block_num * in_channel * kernel_plane;
 
-  packed_weight_ = reinterpret_cast<float *>(malloc(pack_weight_size * sizeof(float)));
-  if (packed_weight_ == nullptr) {
-    MS_LOG(ERROR) << "malloc packed weight failed.";
-    return RET_ERROR;
-  }
-  memset(packed_weight_, 0, pack_weight_size * sizeof(float));
+  auto pack_weight = [&](void *dst) {
+    auto packed_weight = reinterpret_cast<float *>(dst);
+    memset(packed_weight, 0, pack_weight_size * sizeof(float));
 #ifdef ENABLE_AVX
-  RowMajor2Col16Major(origin_weight_, packed_weight_, out_channel, in_channel * kernel_plane);
+    RowMajor2Col16Major(origin_weight_, packed_weight, out_channel, in_channel * kernel_plane);
 #elif ENABLE_ARM32
-  RowMajor2Col4Major(origin_weight_, packed_weight_, out_channel, in_channel * kernel_plane);
+    RowMajor2Col4Major(origin_weight_, packed_weight, out_channel, in_channel * kernel_plane);
 #else
-  RowMajor2Col8Major(origin_weight_, packed_weight_, out_channel, in_channel * kernel_plane);
+    RowMajor2Col8Major(origin_weight_, packed_weight, out_channel, in_channel * kernel_plane);
 #endif
+    return RET_OK;
+  };
+  packed_weight_ = reinterpret_cast<float *>(
+    MallocPackedWeight("conv_fp32_im2col", pack_weight_size * sizeof(float), pack_weight));
+  if (packed_weight_ == nullptr) {
+    MS_LOG(ERROR) << "malloc packed weight failed.";
+    return RET_ERROR;
+  }
 
   bias_data_ = reinterpret_cast<float *>(malloc(oc_block_num * sizeof(float)));
   if (bias_data_ == nullptr) {
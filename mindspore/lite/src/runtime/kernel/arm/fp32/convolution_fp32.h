@@ -33,10 +33,8 @@ class ConvolutionCPUKernel : public ConvolutionBaseCPUKernel {
         origin_weight_(origin_weight),
         origin_bias_(origin_bias) {}
   ~ConvolutionCPUKernel() override {
-    if (packed_weight_ != nullptr) {
-      free(packed_weight_);
-      packed_weight_ = nullptr;
-    }
+    FreePackedWeight(packed_weight_);
+    packed_weight_ = nullptr;
   }
 
   int Init() override;
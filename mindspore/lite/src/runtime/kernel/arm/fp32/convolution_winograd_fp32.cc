@@ -31,13 +31,13 @@ using mindspore::schema::PrimitiveType_Conv2D;
 
 namespace mindspore::kernel {
 int ConvolutionWinogradCPUKernel::WinogradFilterTransform(const float *weight_data, float *matrix_g, float *matrix_gt,
-                                                          int oc_block) {
+                                                          int oc_block, float *trans_weight) {
   if (oc_block == 0) {
     MS_LOG(ERROR) << "Divide by zero";
     return RET_ERROR;
   }
 
-  return WinogradWeightTransform(weight_data, trans_weight_, matrix_g, matrix_gt, oc_block, input_unit_, kernel_unit_,
+  return WinogradWeightTransform(weight_data, trans_weight, matrix_g, matrix_gt, oc_block, input_unit_, kernel_unit_,
                                  conv_param_->input_channel_, conv_param_->output_channel_, true);
 }
 
@@ -56,15 +56,6 @@ int ConvolutionWinogradCPUKernel::InitWeightBias() {
 #endif
   int oc_block_num = UP_DIV(out_channel, oc_block);
 
-  // set data
-  auto trans_matrix_data_size = input_unit_ * input_unit_ * in_channel * oc_block_num * oc_block * sizeof(float);
-  trans_weight_ = reinterpret_cast<float *>(malloc(trans_matrix_data_size));
-  if (trans_weight_ == nullptr) {
-    MS_LOG(ERROR) << "malloc matrix_buffer failed.";
-    return RET_MEMORY_FAILED;
-  }
-  memset(trans_weight_, 0, trans_matrix_data_size);
-
   float matrix_g[64];
   float matrix_gt[64];
   float matrix_a[64];
@@ -81,10 +72,19 @@ int ConvolutionWinogradCPUKernel::InitWeightBias() {
     MS_LOG(ERROR) << "get matrix g from CookToomFilter failed.";
     return ret;
   }
-  ret = WinogradFilterTransform(origin_weight_, matrix_g, matrix_gt, oc_block);
-  if (ret != RET_OK) {
+
+  // set data
+  auto trans_matrix_data_size = input_unit_ * input_unit_ * in_channel * oc_block_num * oc_block * sizeof(float);
+  auto pack_weight = [&](void *dst) {
+    memset(dst, 0, trans_matrix_data_size);
+    return WinogradFilterTransform(origin_weight_, matrix_g, matrix_gt, oc_block, reinterpret_cast<float *>(dst));
+  };
+  // the transformed weight depends on the input unit picked for the shapes of the session
+  trans_weight_ = reinterpret_cast<float *>(MallocPackedWeight(
+    "conv_fp32_winograd_" + std::to_string(input_unit_), trans_matrix_data_size, pack_weight));
+  if (trans_weight_ == nullptr) {
     MS_LOG(ERROR) << "winograd filter transfrom failed.";
-    return ret;
+    return RET_ERROR;
   }
 
   // init bias
@@ -35,10 +35,8 @@ class ConvolutionWinogradCPUKernel : public ConvolutionBaseCPUKernel {
         origin_weight_(origin_weight),
         origin_bias_(origin_bias) {}
   ~ConvolutionWinogradCPUKernel() override {
-    if (trans_weight_ != nullptr) {
-      free(trans_weight_);
-      trans_weight_ = nullptr;
-    }
+    FreePackedWeight(trans_weight_);
+    trans_weight_ = nullptr;
   };
   int Init() override;
   int ReSize() override;
@@ -47,7 +45,8 @@ class ConvolutionWinogradCPUKernel : public ConvolutionBaseCPUKernel {
   int InitWeightBias();
   int InitTmpBuffer();
   int ConfigInputOutput();
-  int WinogradFilterTransform(const float *weight_data, float *matrix_g, float *matrix_gt, int oc_block);
+  int WinogradFilterTransform(const float *weight_data, float *matrix_g, float *matrix_gt, int oc_block,
+                              float *trans_weight);
 
  private:
   void FreeTmpBuffer() {
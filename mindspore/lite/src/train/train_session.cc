@@ -17,6 +17,7 @@
 #include "src/train/train_session.h"
 #include <sys/stat.h>
 #include <algorithm>
+#include <cmath>
 #include <utility>
 #include <vector>
 #include <iostream>
@@ -103,7 +104,7 @@ int TrainSession::CompileTrainGraph(mindspore::lite::TrainModel *model) {
   CompileEvalOutputs();       // prepare outputs in eval mode
   AllocWorkSpace();
 
-  return RET_OK;
+  return CompileRecompute();
 }
 
 TrainSession::~TrainSession() {
@@ -127,6 +128,9 @@ int TrainSession::RunGraph(const KernelCallBack &before, const KernelCallBack &a
     MS_LOG(ERROR) << "context is null";
     return lite::RET_NULL_PTR;
   }
+  if (train_mode_ && recompute_) {
+    return RunRecompute(before, after);
+  }
   auto run_kernel = (train_mode_) ? train_kernels_ : inference_kernels_;
   lite::CpuExecutor executor;
   if (before == nullptr && after == nullptr) {
@@ -302,6 +306,248 @@ void TrainSession::CompileOptimizedKernels() {
   }
 }
 
+int TrainSession::SetRecompute(bool enable, const std::vector<std::string> &checkpoint_names) {
+  recompute_ = enable;
+  checkpoint_names_ = checkpoint_names;
+  auto ret = CompileRecompute();
+  if (ret != RET_OK) {
+    recompute_ = false;
+    checkpoint_names_.clear();
+    CompileRecompute();
+  }
+  return ret;
+}
+
+// Close a segment once the outputs since the last checkpoint exceed total / sqrt(n), which keeps about sqrt(n)
+// checkpoints alive and recomputes each activation at most once per step
+std::vector<bool> TrainSession::SelectCheckpoints(const std::vector<kernel::LiteKernel *> &forward) const {
+  std::vector<size_t> costs;
+  size_t total_cost = 0;
+  for (auto kernel : forward) {
+    size_t cost = 0;
+    for (auto tensor : kernel->out_tensors()) {
+      cost += tensor->Size();
+    }
+    costs.push_back(cost);
+    total_cost += cost;
+  }
+  std::vector<bool> checkpoints(forward.size(), false);
+  auto budget = static_cast<size_t>(total_cost / std::sqrt(static_cast<double>(forward.size())));
+  size_t cost = 0;
+  for (size_t i = 0; i < forward.size(); i++) {
+    cost += costs[i];
+    if (cost >= budget) {
+      checkpoints[i] = true;
+      cost = 0;
+    }
+  }
+  return checkpoints;
+}
+
+int TrainSession::CompileRecompute() {
+  forward_kernels_.clear();
+  segments_.clear();
+  tensor_segment_.clear();
+  free_after_.clear();
+  segment_last_use_.clear();
+  open_segment_ = 0;
+  if (!recompute_) {
+    return RET_OK;
+  }
+  if (std::none_of(train_kernels_.begin(), train_kernels_.end(),
+                   [this](kernel::LiteKernel *kernel) { return IsLossKernel(kernel); })) {
+    MS_LOG(ERROR) << "Recompute needs a loss to tell the forward kernels from the backward ones";
+    return RET_ERROR;
+  }
+  // inference kernels are the forward pass of the loss in train order
+  const auto &forward = inference_kernels_;
+  forward_kernels_.insert(forward.begin(), forward.end());
+
+  std::vector<bool> checkpoints;
+  if (checkpoint_names_.empty()) {
+    checkpoints = SelectCheckpoints(forward);
+  } else {
+    checkpoints.resize(forward.size(), false);
+    for (auto &name : checkpoint_names_) {
+      auto iter = std::find_if(forward.begin(), forward.end(),
+                               [&name](kernel::LiteKernel *kernel) { return kernel->name() == name; });
+      if (iter == forward.end()) {
+        MS_LOG(ERROR) << "Checkpoint " << name << " is not a forward kernel";
+        return RET_PARAM_INVALID;
+      }
+      checkpoints[iter - forward.begin()] = true;
+    }
+  }
+
+  // outputs read by the user are never freed
+  std::unordered_set<lite::Tensor *> kept;
+  for (auto outputs : {&train_output_tensor_map_, &eval_output_tensor_map_, &orig_output_tensor_map_}) {
+    for (auto &output : *outputs) {
+      kept.insert(static_cast<lite::Tensor *>(output.second));
+    }
+  }
+  std::vector<kernel::LiteKernel *> segment;
+  for (size_t i = 0; i < forward.size(); i++) {
+    auto kernel = forward[i];
+    // running a stateful kernel twice would update its state twice, so its outputs are kept instead
+    if (checkpoints[i] || IsStateful(kernel) || kernel->is_model_output()) {
+      if (!segment.empty()) {
+        segments_.push_back(segment);
+        segment.clear();
+      }
+      continue;
+    }
+    segment.push_back(kernel);
+    for (auto tensor : kernel->out_tensors()) {
+      if (kept.find(tensor) == kept.end() && tensor->root_tensor() == tensor) {
+        tensor_segment_[tensor] = segments_.size();
+      }
+    }
+  }
+  // the last segment is not freed in forward since backward needs it first
+  open_segment_ = segments_.size();
+  if (!segment.empty()) {
+    segments_.push_back(segment);
+  }
+
+  // free an activation after its last forward reader, or after its producer if only backward reads it
+  for (size_t i = 0; i < forward.size(); i++) {
+    for (auto tensor : forward[i]->out_tensors()) {
+      auto iter = tensor_segment_.find(tensor);
+      if (iter == tensor_segment_.end() || iter->second == open_segment_) {
+        continue;
+      }
+      size_t last = i;
+      for (size_t j = i + 1; j < forward.size(); j++) {
+        if (IsContain(forward[j]->in_tensors(), tensor)) {
+          last = j;
+        }
+      }
+      free_after_[forward[last]].push_back(tensor);
+    }
+  }
+
+  segment_last_use_.resize(segments_.size(), -1);
+  for (size_t i = 0; i < train_kernels_.size(); i++) {
+    if (forward_kernels_.find(train_kernels_[i]) != forward_kernels_.end()) {
+      continue;
+    }
+    for (auto tensor : train_kernels_[i]->in_tensors()) {
+      auto iter = tensor_segment_.find(tensor);
+      if (iter != tensor_segment_.end()) {
+        segment_last_use_[iter->second] = static_cast<int>(i);
+      }
+    }
+  }
+  MS_LOG(INFO) << "Recompute " << tensor_segment_.size() << " activations in " << segments_.size() << " segments";
+  return RET_OK;
+}
+
+int TrainSession::RunKernel(kernel::LiteKernel *kernel, const KernelCallBack &before, const KernelCallBack &after) {
+  auto ret = kernel->PreProcess();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "PreProcess kernel failed, name: " << kernel->name();
+    return ret;
+  }
+  ret = kernel->Run(before, after);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "run kernel failed, name: " << kernel->name();
+    return ret;
+  }
+  ret = kernel->PostProcess();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "PostProcess kernel failed, name: " << kernel->name();
+  }
+  return ret;
+}
+
+int TrainSession::RecomputeSegment(size_t segment, std::vector<bool> *live, const KernelCallBack &before,
+                                   const KernelCallBack &after) {
+  for (auto kernel : segments_[segment]) {
+    // a skip connection may read a freed activation of an earlier segment
+    for (auto tensor : kernel->in_tensors()) {
+      auto iter = tensor_segment_.find(tensor);
+      if (iter != tensor_segment_.end() && iter->second != segment && tensor->data_c() == nullptr) {
+        auto ret = RecomputeSegment(iter->second, live, before, after);
+        if (ret != RET_OK) {
+          return ret;
+        }
+      }
+    }
+    auto ret = RunKernel(kernel, before, after);
+    if (ret != RET_OK) {
+      return ret;
+    }
+  }
+  live->at(segment) = true;
+  return RET_OK;
+}
+
+void TrainSession::FreeSegment(size_t segment) {
+  for (auto kernel : segments_[segment]) {
+    for (auto tensor : kernel->out_tensors()) {
+      if (tensor_segment_.find(tensor) != tensor_segment_.end()) {
+        tensor->FreeData();
+      }
+    }
+  }
+}
+
+int TrainSession::RunRecompute(const KernelCallBack &before, const KernelCallBack &after) {
+  std::vector<bool> live(segments_.size(), false);
+  if (open_segment_ < segments_.size()) {
+    live[open_segment_] = true;
+  }
+  // weights are updated after the whole backward pass so that recomputed activations see the weights of forward
+  std::vector<kernel::LiteKernel *> updates;
+  for (size_t i = 0; i < train_kernels_.size(); i++) {
+    auto kernel = train_kernels_[i];
+    if (IsMaskOutput(kernel)) {
+      updates.push_back(kernel);
+      continue;
+    }
+    if (forward_kernels_.find(kernel) != forward_kernels_.end()) {
+      auto ret = RunKernel(kernel, before, after);
+      if (ret != RET_OK) {
+        return ret;
+      }
+      auto iter = free_after_.find(kernel);
+      if (iter != free_after_.end()) {
+        for (auto tensor : iter->second) {
+          tensor->FreeData();
+        }
+      }
+      continue;
+    }
+    for (auto tensor : kernel->in_tensors()) {
+      auto iter = tensor_segment_.find(tensor);
+      if (iter != tensor_segment_.end() && tensor->data_c() == nullptr) {
+        auto ret = RecomputeSegment(iter->second, &live, before, after);
+        if (ret != RET_OK) {
+          return ret;
+        }
+      }
+    }
+    auto ret = RunKernel(kernel, before, after);
+    if (ret != RET_OK) {
+      return ret;
+    }
+    for (size_t segment = 0; segment < segments_.size(); segment++) {
+      if (live[segment] && segment_last_use_[segment] <= static_cast<int>(i)) {
+        FreeSegment(segment);
+        live[segment] = false;
+      }
+    }
+  }
+  for (auto kernel : updates) {
+    auto ret = RunKernel(kernel, before, after);
+    if (ret != RET_OK) {
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
 bool TrainSession::IsLossKernel(const kernel::LiteKernel *kernel) const {
   return (kernel->Type() == schema::PrimitiveType_SoftmaxCrossEntropy ||
           kernel->Type() == schema::PrimitiveType_SparseSoftmaxCrossEntropy ||
@@ -315,6 +561,11 @@ bool TrainSession::IsOptimizer(kernel::LiteKernel *kernel) const {
   return ((kernel->Type() == schema::PrimitiveType_Adam) || (kernel->Type() == schema::PrimitiveType_Sgd) ||
           (kernel->Type() == schema::PrimitiveType_ApplyMomentum));
 }
+bool TrainSession::IsStateful(const kernel::LiteKernel *kernel) const {
+  return (kernel->Type() == schema::PrimitiveType_BatchNorm || kernel->Type() == schema::PrimitiveType_FusedBatchNorm ||
+          kernel->Type() == schema::PrimitiveType_Dropout);
+}
+
 bool TrainSession::IsMaskOutput(kernel::LiteKernel *kernel) const {
   return (IsOptimizer(kernel) || (kernel->Type() == schema::PrimitiveType_Assign));
 }
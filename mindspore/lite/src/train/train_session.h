@@ -19,6 +19,7 @@
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include "src/ops/primitive_c.h"
 #include "include/train_session.h"
 #include "src/train/train_model.h"
@@ -59,6 +60,7 @@ class TrainSession : virtual public session::TrainSession, virtual public lite::
 
   int Train() override;
   int Eval() override;
+  int SetRecompute(bool enable, const std::vector<std::string> &checkpoint_names = {}) override;
 
   void BindThread(bool if_bind) override { return lite::LiteSession::BindThread(if_bind); }
   std::vector<tensor::MSTensor *> GetInputs() const override { return lite::LiteSession::GetInputs(); }
@@ -92,6 +94,8 @@ class TrainSession : virtual public session::TrainSession, virtual public lite::
   virtual void CompileOptimizedKernels();
   virtual void CompileTrainOutputs();
   virtual void CompileEvalOutputs();
+  virtual int CompileRecompute();
+  bool IsStateful(const kernel::LiteKernel *kernel) const;
 
   TrainModel *model_ = nullptr;
   std::unordered_map<std::string, std::vector<mindspore::tensor::MSTensor *>> orig_output_node_map_;
@@ -106,8 +110,24 @@ class TrainSession : virtual public session::TrainSession, virtual public lite::
   std::vector<kernel::LiteKernel *> inference_kernels_;
   std::vector<kernel::LiteKernel *> train_kernels_;
 
+  // Recompute: forward kernels between checkpoints form segments which are re-run together during backward
+  bool recompute_ = false;
+  std::vector<std::string> checkpoint_names_;
+  std::unordered_set<kernel::LiteKernel *> forward_kernels_;
+  std::vector<std::vector<kernel::LiteKernel *>> segments_;
+  std::unordered_map<lite::Tensor *, size_t> tensor_segment_;
+  std::unordered_map<kernel::LiteKernel *, std::vector<lite::Tensor *>> free_after_;
+  std::vector<int> segment_last_use_;
+  size_t open_segment_ = 0;
+
  private:
   void BuildInferenceKernelsRecursive(kernel::LiteKernel *ker, std::vector<kernel::LiteKernel *> *req_kernels);
+  std::vector<bool> SelectCheckpoints(const std::vector<kernel::LiteKernel *> &forward) const;
+  int RunKernel(kernel::LiteKernel *kernel, const KernelCallBack &before, const KernelCallBack &after);
+  int RecomputeSegment(size_t segment, std::vector<bool> *live, const KernelCallBack &before,
+                       const KernelCallBack &after);
+  void FreeSegment(size_t segment);
+  int RunRecompute(const KernelCallBack &before, const KernelCallBack &after);
 };
 }  // namespace lite
 }  // namespace mindspore
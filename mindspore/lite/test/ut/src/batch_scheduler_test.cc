@@ -0,0 +1,217 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "schema/inner/model_generated.h"
+#include "common/common_test.h"
+#include "include/batch_scheduler.h"
+#include "include/context.h"
+#include "include/errorcode.h"
+#include "include/lite_session.h"
+#include "include/model.h"
+#define private public
+#include "src/batch_scheduler.h"
+#undef private
+
+namespace mindspore {
+namespace {
+constexpr int kSampleSize = 4;
+
+// A model of one sigmoid, the input and the output are {1, kSampleSize} floats
+lite::Model *ImportSigmoidModel() {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0};
+  node->outputIndex = {1};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Activation;
+  auto primitive = new schema::ActivationT;
+  primitive->type = schema::ActivationType_SIGMOID;
+  node->primitive->value.value = primitive;
+  node->name = "Sigmoid";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {1};
+
+  for (auto node_type : {schema::NodeType::NodeType_ValueNode, schema::NodeType::NodeType_Parameter}) {
+    auto tensor = std::make_unique<schema::TensorT>();
+    tensor->nodeType = node_type;
+    tensor->format = schema::Format_NHWC;
+    tensor->dataType = TypeId::kNumberTypeFloat32;
+    tensor->dims = {1, kSampleSize};
+    tensor->offset = -1;
+    meta_graph->allTensors.emplace_back(std::move(tensor));
+  }
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  return lite::Model::Import(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+}
+
+// The input of request i
+std::vector<float> MakeSample(int i) {
+  std::vector<float> sample(kSampleSize);
+  for (int j = 0; j < kSampleSize; j++) {
+    sample[j] = 0.05f * i - 0.7f * j;
+  }
+  return sample;
+}
+}  // namespace
+
+class BatchSchedulerTest : public mindspore::CommonTest {
+ public:
+  BatchSchedulerTest() {}
+
+  void SetUp() override {
+    model_ = ImportSigmoidModel();
+    ASSERT_NE(model_, nullptr);
+    context_.thread_num_ = 2;
+  }
+
+  void TearDown() override { delete model_; }
+
+  // The outputs of a session of batch 1 for the given requests
+  std::vector<std::vector<float>> RunSingle(int num_requests) {
+    std::vector<std::vector<float>> outputs;
+    auto session = session::LiteSession::CreateSession(&context_);
+    EXPECT_NE(session, nullptr);
+    EXPECT_EQ(session->CompileGraph(model_), lite::RET_OK);
+    for (int i = 0; i < num_requests; i++) {
+      auto input = MakeSample(i);
+      memcpy(session->GetInputs().front()->MutableData(), input.data(), kSampleSize * sizeof(float));
+      EXPECT_EQ(session->RunGraph(), lite::RET_OK);
+      auto output = reinterpret_cast<float *>(session->GetOutputs().begin()->second->MutableData());
+      outputs.emplace_back(output, output + kSampleSize);
+    }
+    delete session;
+    return outputs;
+  }
+
+  static int Predict(session::BatchScheduler *scheduler, int i, std::vector<float> *output) {
+    auto input = MakeSample(i);
+    output->resize(kSampleSize);
+    return scheduler->Predict({input.data()}, {output->data()});
+  }
+
+  static void ExpectNear(const std::vector<float> &output, const std::vector<float> &expect) {
+    ASSERT_EQ(output.size(), expect.size());
+    for (size_t j = 0; j < output.size(); j++) {
+      EXPECT_NEAR(output[j], expect[j], 1e-6);
+    }
+  }
+
+  lite::Model *model_ = nullptr;
+  lite::Context context_;
+};
+
+TEST_F(BatchSchedulerTest, InitAndSampleSizes) {
+  auto scheduler = session::BatchScheduler::CreateScheduler(model_, &context_, {4, 1}, 1000);
+  ASSERT_NE(scheduler, nullptr);
+  EXPECT_EQ(scheduler->GetInputSampleSizes(), std::vector<size_t>({kSampleSize * sizeof(float)}));
+  EXPECT_EQ(scheduler->GetOutputSampleSizes(), std::vector<size_t>({kSampleSize * sizeof(float)}));
+  EXPECT_EQ(scheduler->GetInputDataTypes(), std::vector<TypeId>({kNumberTypeFloat32}));
+  std::vector<float> output;
+  EXPECT_EQ(scheduler->Predict({}, {output.data()}), lite::RET_PARAM_INVALID);
+  delete scheduler;
+
+  EXPECT_EQ(session::BatchScheduler::CreateScheduler(model_, &context_, {}, 1000), nullptr);
+  EXPECT_EQ(session::BatchScheduler::CreateScheduler(model_, &context_, {0, 4}, 1000), nullptr);
+  EXPECT_EQ(session::BatchScheduler::CreateScheduler(model_, &context_, {4}, -1), nullptr);
+}
+
+TEST_F(BatchSchedulerTest, PredictFromThreads) {
+  const int num_threads = 16;
+  const int requests_per_thread = 8;
+  auto expect = RunSingle(num_threads * requests_per_thread);
+  auto scheduler = session::BatchScheduler::CreateScheduler(model_, &context_, {1, 4, 8}, 2000);
+  ASSERT_NE(scheduler, nullptr);
+
+  std::vector<std::vector<float>> outputs(num_threads * requests_per_thread);
+  std::vector<int> status(outputs.size(), lite::RET_ERROR);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int k = 0; k < requests_per_thread; k++) {
+        int i = t * requests_per_thread + k;
+        status[i] = Predict(scheduler, i, &outputs[i]);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  // every request gets the output of its own sample, whichever batch it joined
+  for (size_t i = 0; i < outputs.size(); i++) {
+    EXPECT_EQ(status[i], lite::RET_OK);
+    ExpectNear(outputs[i], expect[i]);
+  }
+  delete scheduler;
+}
+
+TEST_F(BatchSchedulerTest, MaxDelayFlush) {
+  auto expect = RunSingle(1);
+  const int max_delay_us = 50000;
+  auto scheduler = session::BatchScheduler::CreateScheduler(model_, &context_, {8}, max_delay_us);
+  ASSERT_NE(scheduler, nullptr);
+  // a lone request does not wait for a full batch, it runs padded once the max delay has passed
+  std::vector<float> output;
+  auto begin = std::chrono::steady_clock::now();
+  EXPECT_EQ(Predict(scheduler, 0, &output), lite::RET_OK);
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+  EXPECT_GE(elapsed.count(), max_delay_us);
+  EXPECT_LT(elapsed.count(), 100 * max_delay_us);
+  ExpectNear(output, expect[0]);
+  delete scheduler;
+}
+
+TEST_F(BatchSchedulerTest, ShutdownWithPending) {
+  const int num_requests = 3;
+  auto expect = RunSingle(num_requests);
+  // the batch is never full and the delay far longer than the test
+  auto scheduler = session::BatchScheduler::CreateScheduler(model_, &context_, {8}, 60 * 1000 * 1000);
+  ASSERT_NE(scheduler, nullptr);
+  std::vector<std::vector<float>> outputs(num_requests);
+  std::vector<int> status(num_requests, lite::RET_ERROR);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_requests; i++) {
+    threads.emplace_back([&, i]() { status[i] = Predict(scheduler, i, &outputs[i]); });
+  }
+  // every Predict signals request_cond_ once its request is queued
+  auto impl = static_cast<lite::BatchScheduler *>(scheduler);
+  {
+    std::unique_lock<std::mutex> lock(impl->mutex_);
+    impl->request_cond_.wait(lock, [impl] { return impl->requests_.size() == static_cast<size_t>(num_requests); });
+  }
+
+  // the pending requests are run when the scheduler is deleted
+  auto begin = std::chrono::steady_clock::now();
+  delete scheduler;
+  EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::seconds(10));
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (int i = 0; i < num_requests; i++) {
+    EXPECT_EQ(status[i], lite::RET_OK);
+    ExpectNear(outputs[i], expect[i]);
+  }
+}
+}  // namespace mindspore
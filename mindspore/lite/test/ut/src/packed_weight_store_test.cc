@@ -0,0 +1,224 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "schema/inner/model_generated.h"
+#include "common/common_test.h"
+#include "include/context.h"
+#include "include/errorcode.h"
+#include "include/lite_session.h"
+#include "include/model.h"
+#include "src/lite_model.h"
+#include "src/packed_weight_store.h"
+#define private public
+#define protected public
+#include "src/lite_session.h"
+#include "src/sub_graph_kernel.h"
+#include "src/runtime/kernel/arm/fp32/convolution_delegate_fp32.h"
+#include "src/runtime/kernel/arm/fp32/convolution_1x1_fp32.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+#ifndef SUPPORT_TRAIN
+namespace {
+constexpr int kPlane = 4 * 4;
+constexpr int kInChannel = 3;
+constexpr int kOutChannel = 8;
+
+// A model of one 1x1 convolution without bias, the input is {1, 4, 4, kInChannel} and the weight is in the model
+lite::Model *ImportConv1x1Model(const std::vector<float> &weight_data) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Conv2D;
+  auto primitive = new schema::Conv2DT;
+  primitive->group = 1;
+  primitive->padMode = schema::PadMode_SAME_UPPER;
+  primitive->channelIn = kInChannel;
+  primitive->channelOut = kOutChannel;
+  primitive->format = schema::Format_NHWC;
+  primitive->strideH = 1;
+  primitive->strideW = 1;
+  primitive->kernelH = 1;
+  primitive->kernelW = 1;
+  primitive->dilateH = 1;
+  primitive->dilateW = 1;
+  node->primitive->value.value = primitive;
+  node->name = "Conv2D";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {2};
+
+  auto input = std::make_unique<schema::TensorT>();
+  input->nodeType = schema::NodeType::NodeType_ValueNode;
+  input->format = schema::Format_NHWC;
+  input->dataType = TypeId::kNumberTypeFloat32;
+  input->dims = {1, 4, 4, kInChannel};
+  input->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(input));
+
+  auto weight = std::make_unique<schema::TensorT>();
+  weight->nodeType = schema::NodeType::NodeType_ValueNode;
+  weight->format = schema::Format_KHWC;
+  weight->dataType = TypeId::kNumberTypeFloat32;
+  weight->dims = {kOutChannel, 1, 1, kInChannel};
+  weight->data.resize(weight_data.size() * sizeof(float));
+  memcpy(weight->data.data(), weight_data.data(), weight->data.size());
+  weight->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(weight));
+
+  auto output = std::make_unique<schema::TensorT>();
+  output->nodeType = schema::NodeType::NodeType_Parameter;
+  output->format = schema::Format_NHWC;
+  output->dataType = TypeId::kNumberTypeFloat32;
+  output->dims = {1, 4, 4, kOutChannel};
+  output->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(output));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  return lite::Model::Import(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+}
+
+// The packed weight the 1x1 convolution of the session runs with
+float *GetConv1x1PackedWeight(session::LiteSession *session) {
+  for (auto kernel : static_cast<lite::LiteSession *>(session)->kernels_) {
+    auto nodes = kernel->subgraph_type() == kernel::kNotSubGraph
+                   ? std::vector<kernel::LiteKernel *>{kernel}
+                   : reinterpret_cast<kernel::SubGraphKernel *>(kernel)->nodes();
+    for (auto node : nodes) {
+      if (node->Type() == schema::PrimitiveType_Conv2D) {
+        auto conv_kernel = reinterpret_cast<kernel::ConvolutionDelegateCPUKernel *>(node)->conv_kernel_;
+        return reinterpret_cast<kernel::Convolution1x1CPUKernel *>(conv_kernel)->weight_ptr_;
+      }
+    }
+  }
+  return nullptr;
+}
+
+// Runs the session on the input and checks the output against the convolution computed here
+void RunAndCheck(session::LiteSession *session, const std::vector<float> &input, const std::vector<float> &weight) {
+  memcpy(session->GetInputs().front()->MutableData(), input.data(), input.size() * sizeof(float));
+  ASSERT_EQ(session->RunGraph(), lite::RET_OK);
+  auto output = reinterpret_cast<float *>(session->GetOutputs().begin()->second->MutableData());
+  for (int p = 0; p < kPlane; p++) {
+    for (int o = 0; o < kOutChannel; o++) {
+      float expect = 0;
+      for (int c = 0; c < kInChannel; c++) {
+        expect += input[p * kInChannel + c] * weight[o * kInChannel + c];
+      }
+      EXPECT_NEAR(output[p * kOutChannel + o], expect, 1e-5);
+    }
+  }
+}
+}  // namespace
+#endif
+
+class PackedWeightStoreTest : public mindspore::CommonTest {
+ public:
+  PackedWeightStoreTest() {}
+};
+
+TEST_F(PackedWeightStoreTest, PackOnce) {
+  std::vector<char> buf(64);
+  lite::PackedWeightStore store(buf.data(), buf.size());
+  int pack_count = 0;
+  auto pack = [&pack_count](void *dst) {
+    pack_count++;
+    reinterpret_cast<float *>(dst)[0] = 1.0f;
+    return lite::RET_OK;
+  };
+  auto packed = store.GetPackedWeight(buf.data() + 8, "layout", 16, pack);
+  ASSERT_NE(packed, nullptr);
+  EXPECT_EQ(store.GetPackedWeight(buf.data() + 8, "layout", 16, pack), packed);
+  EXPECT_EQ(pack_count, 1);
+  EXPECT_EQ(reinterpret_cast<float *>(packed)[0], 1.0f);
+
+  // another layout of the same weight is packed again
+  auto other = store.GetPackedWeight(buf.data() + 8, "other", 32, pack);
+  ASSERT_NE(other, nullptr);
+  EXPECT_NE(other, packed);
+  EXPECT_EQ(pack_count, 2);
+  EXPECT_EQ(store.PackedSize(), 48);
+
+  // a layout does not change its size
+  EXPECT_EQ(store.GetPackedWeight(buf.data() + 8, "layout", 20, pack), nullptr);
+}
+
+TEST_F(PackedWeightStoreTest, Shareable) {
+  std::vector<char> buf(64);
+  std::vector<char> copy(64);
+  lite::PackedWeightStore store(buf.data(), buf.size());
+  EXPECT_TRUE(store.IsShareable(buf.data()));
+  EXPECT_TRUE(store.IsShareable(buf.data() + 63));
+  EXPECT_FALSE(store.IsShareable(buf.data() + 64));
+  EXPECT_FALSE(store.IsShareable(copy.data()));
+  EXPECT_FALSE(store.IsShareable(nullptr));
+}
+
+TEST_F(PackedWeightStoreTest, PackFailed) {
+  std::vector<char> buf(64);
+  lite::PackedWeightStore store(buf.data(), buf.size());
+  auto fail = [](void *dst) { return lite::RET_ERROR; };
+  EXPECT_EQ(store.GetPackedWeight(buf.data(), "layout", 16, fail), nullptr);
+  EXPECT_EQ(store.PackedSize(), 0);
+}
+
+#ifndef SUPPORT_TRAIN
+TEST_F(PackedWeightStoreTest, SessionsShareConvWeight) {
+  std::vector<float> weight(kOutChannel * kInChannel);
+  for (size_t i = 0; i < weight.size(); i++) {
+    weight[i] = 0.1f * (i % 7) - 0.3f;
+  }
+  std::vector<float> input(kPlane * kInChannel);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = 0.25f * (i % 5) - 0.5f;
+  }
+  auto model = ImportConv1x1Model(weight);
+  ASSERT_NE(model, nullptr);
+  lite::Context context;
+  auto session1 = session::LiteSession::CreateSession(&context);
+  ASSERT_NE(session1, nullptr);
+  ASSERT_EQ(session1->CompileGraph(model), lite::RET_OK);
+  auto store = reinterpret_cast<lite::LiteModel *>(model)->weight_store_;
+  auto packed_size = store->PackedSize();
+  EXPECT_GT(packed_size, 0);
+
+  // the second session packs nothing, its convolution runs on the weight packed by the first
+  auto session2 = session::LiteSession::CreateSession(&context);
+  ASSERT_NE(session2, nullptr);
+  ASSERT_EQ(session2->CompileGraph(model), lite::RET_OK);
+  EXPECT_EQ(store->PackedSize(), packed_size);
+  auto packed_weight = GetConv1x1PackedWeight(session1);
+  ASSERT_NE(packed_weight, nullptr);
+  EXPECT_EQ(GetConv1x1PackedWeight(session2), packed_weight);
+
+  RunAndCheck(session1, input, weight);
+  RunAndCheck(session2, input, weight);
+  // the packed weight outlives the session that packed it
+  delete session1;
+  RunAndCheck(session2, input, weight);
+  delete session2;
+  delete model;
+}
+#endif
+}  // namespace mindspore
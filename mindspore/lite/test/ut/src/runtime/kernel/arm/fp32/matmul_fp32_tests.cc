@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <iostream>
+#include <vector>
 #include "src/common/log_adapter.h"
 #include "common/common_test.h"
 #include "mindspore/lite/src/runtime/kernel/arm/fp32/matmul_fp32.h"
@@ -353,4 +354,33 @@ TEST_F(TestMatMulFp32, batch) {
   for (auto t : inputs_) delete t;
   for (auto t : outputs_) delete t;
 }
+
+#if defined(ENABLE_AVX) && defined(ENABLE_X86_64_CPU_DISPATCH)
+TEST_F(TestMatMulFp32, Avx512Opt) {
+  if (!X86SupportAvx512F()) {
+    return;
+  }
+  const int row = 13, col = 40, deep = 19;
+  std::vector<float> a(UP_ROUND(row, C6NUM) * deep);
+  std::vector<float> b(UP_ROUND(col, C16NUM) * deep);
+  std::vector<float> bias(UP_ROUND(col, C16NUM));
+  for (size_t i = 0; i < a.size(); i++) a[i] = static_cast<float>(i % 13) / 13 - 0.5f;
+  for (size_t i = 0; i < b.size(); i++) b[i] = static_cast<float>(i % 7) / 7 - 0.5f;
+  for (size_t i = 0; i < bias.size(); i++) bias[i] = static_cast<float>(i % 5) / 5;
+  // nhwc with a padded row, then the winograd layout
+  const size_t strides[] = {col + 3, 2};
+  for (size_t mode = OutType_Nhwc; mode <= OutType_TileC8; mode++) {
+    for (size_t act : {ActType_No, ActType_Relu, ActType_Relu6}) {
+      size_t stride = strides[mode - OutType_Nhwc];
+      size_t size = mode == OutType_Nhwc ? row * stride : row * col * stride;
+      // the assembly writes the winograd output of whole 6-row tiles
+      std::vector<float> expect(UP_ROUND(row, C6NUM) * col * stride, 0);
+      std::vector<float> output(UP_ROUND(row, C6NUM) * col * stride, 0);
+      MatmulFloatAvxOpt(a.data(), b.data(), expect.data(), bias.data(), act, deep, row, col, stride, mode);
+      MatmulFloatAvx512Opt(a.data(), b.data(), output.data(), bias.data(), act, deep, row, col, stride, mode);
+      ASSERT_EQ(0, CompareOutputData(output.data(), expect.data(), size, 0.0001));
+    }
+  }
+}
+#endif
 }  // namespace mindspore
@@ -36,6 +36,7 @@ namespace mindspore {
 class NetworkTest : public mindspore::CommonTest {
  public:
   NetworkTest() {}
+  void TuningLayer(bool recompute);
 };
 
 int32_t runNet(mindspore::session::LiteSession *session, const std::string &in, const std::string &out,
@@ -75,7 +76,7 @@ int32_t runNet(mindspore::session::LiteSession *session, const std::string &in,
 //        +-------------+               |
 //               V dw(9)                |
 //               +-----------Update-----+
-TEST_F(NetworkTest, tuning_layer) {
+void NetworkTest::TuningLayer(bool recompute) {
   const int BATCH_SIZE = 32;
   const int NUM_CLASSES = 10;
   const int FEATURE_SIZE = 1000;
@@ -364,6 +365,11 @@ TEST_F(NetworkTest, tuning_layer) {
   context.thread_num_ = 1;
   auto session = session::TrainSession::CreateSession(content, size, &context);
   ASSERT_NE(nullptr, session);
+  if (recompute) {
+    ASSERT_NE(lite::RET_OK, session->SetRecompute(true, {"BiasGrad"}));
+    // ReLU is freed after MatMul1 and recomputed for the gradient of the weights
+    ASSERT_EQ(lite::RET_OK, session->SetRecompute(true, {"MatMul1"}));
+  }
   session->Train();
   session->Train();  // Just double check that calling Train twice does not cause a problem
 
@@ -454,6 +460,10 @@ TEST_F(NetworkTest, tuning_layer) {
   EXPECT_LT(error, 2e-3);
 }
 
+TEST_F(NetworkTest, tuning_layer) { TuningLayer(false); }
+
+TEST_F(NetworkTest, tuning_layer_recompute) { TuningLayer(true); }
+
 int32_t fileIterator(mindspore::session::TrainSession *session, const std::string &path,
                      std::function<int32_t(mindspore::session::TrainSession *session, const std::string &)> cb) {
   int32_t res = 0;
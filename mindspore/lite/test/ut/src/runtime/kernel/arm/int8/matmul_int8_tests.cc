@@ -21,6 +21,7 @@
 #include "mindspore/lite/nnacl/int8/quantize.h"
 #include "nnacl/common_func.h"
 #include "nnacl/int8/matmul_int8.h"
+#include "nnacl/int8/matmul_int8_x86.h"
 #include "mindspore/lite/src/kernel_registry.h"
 #include "mindspore/lite/src/lite_kernel.h"
 
@@ -311,4 +312,31 @@ TEST_F(TestMatmulInt8, mmtest2) {
   delete[] out;
 }
 
+#ifdef ENABLE_X86_64_CPU_DISPATCH
+TEST_F(TestMatmulInt8, Tile16x4X86) {
+  const int deep16 = 80;
+  std::vector<int8_t> a(C4NUM * deep16);
+  std::vector<int8_t> b(C4NUM * deep16);
+  for (size_t i = 0; i < a.size(); i++) {
+    a[i] = static_cast<int8_t>((i * 37 + 11) % 256 - 128);
+    b[i] = static_cast<int8_t>((i * 53 + 7) % 256 - 128);
+  }
+  // the extremes of both signs
+  a[0] = INT8_MIN;
+  b[0] = INT8_MIN;
+  a[1] = INT8_MAX;
+  b[1] = INT8_MIN;
+  int32_t expect[C4NUM * C4NUM];
+  int32_t output[C4NUM * C4NUM];
+  MatMulInt8Tile16x4(a.data(), b.data(), deep16, expect);
+  if (X86SupportAvx2()) {
+    MatMulInt8Tile16x4Avx2(a.data(), b.data(), deep16, output);
+    ASSERT_EQ(0, memcmp(expect, output, sizeof(expect)));
+  }
+  if (X86SupportAvx512Vnni()) {
+    MatMulInt8Tile16x4Vnni(a.data(), b.data(), deep16, output);
+    ASSERT_EQ(0, memcmp(expect, output, sizeof(expect)));
+  }
+}
+#endif
 }  // namespace mindspore
@@ -0,0 +1,261 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <sys/stat.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "schema/inner/model_generated.h"
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "tools/converter/model_parser.h"
+#include "tools/converter/quantizer/quantize_util.h"
+#define private public
+#define protected public
+#include "tools/converter/quantizer/post_training_quantizer.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace {
+constexpr int kBinNum = 2048;
+constexpr int kImageNum = 7;
+constexpr int kImageSize = 1 * 5 * 5 * 3;
+
+// A conv followed by a relu, the input is {1, 5, 5, 3}
+schema::MetaGraphT *BuildConvReluGraph() {
+  auto meta_graph = new schema::MetaGraphT;
+  meta_graph->name = "graph";
+  auto conv_node = std::make_unique<schema::CNodeT>();
+  conv_node->inputIndex = {0, 1};
+  conv_node->outputIndex = {2};
+  conv_node->primitive = std::make_unique<schema::PrimitiveT>();
+  conv_node->primitive->value.type = schema::PrimitiveType_Conv2D;
+  auto conv = new schema::Conv2DT;
+  conv->group = 1;
+  conv->padMode = schema::PadMode_SAME_UPPER;
+  conv->format = schema::Format_NHWC;
+  conv->strideH = 1;
+  conv->strideW = 1;
+  conv->kernelH = 3;
+  conv->kernelW = 3;
+  conv->dilateH = 1;
+  conv->dilateW = 1;
+  conv->channelIn = 3;
+  conv->channelOut = 8;
+  conv_node->primitive->value.value = conv;
+  conv_node->name = "conv";
+  meta_graph->nodes.emplace_back(std::move(conv_node));
+
+  auto relu_node = std::make_unique<schema::CNodeT>();
+  relu_node->inputIndex = {2};
+  relu_node->outputIndex = {3};
+  relu_node->primitive = std::make_unique<schema::PrimitiveT>();
+  relu_node->primitive->value.type = schema::PrimitiveType_Activation;
+  auto relu = new schema::ActivationT;
+  relu->type = schema::ActivationType_RELU;
+  relu_node->primitive->value.value = relu;
+  relu_node->name = "relu";
+  meta_graph->nodes.emplace_back(std::move(relu_node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {3};
+
+  auto input = std::make_unique<schema::TensorT>();
+  input->nodeType = schema::NodeType::NodeType_ValueNode;
+  input->format = schema::Format_NHWC;
+  input->dataType = TypeId::kNumberTypeFloat32;
+  input->dims = {1, 5, 5, 3};
+  input->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(input));
+
+  auto weight = std::make_unique<schema::TensorT>();
+  weight->nodeType = schema::NodeType::NodeType_ValueNode;
+  weight->format = schema::Format_KHWC;
+  weight->dataType = TypeId::kNumberTypeFloat32;
+  weight->dims = {8, 3, 3, 3};
+  std::vector<float> weight_data(8 * 3 * 3 * 3);
+  for (size_t i = 0; i < weight_data.size(); i++) {
+    weight_data[i] = 0.05f * (i % 11) - 0.25f;
+  }
+  weight->data.resize(weight_data.size() * sizeof(float));
+  memcpy(weight->data.data(), weight_data.data(), weight->data.size());
+  meta_graph->allTensors.emplace_back(std::move(weight));
+
+  for (int i = 0; i < 2; i++) {
+    auto output = std::make_unique<schema::TensorT>();
+    output->nodeType = schema::NodeType::NodeType_Parameter;
+    output->format = schema::Format_NHWC;
+    output->dataType = TypeId::kNumberTypeFloat32;
+    output->dims = {1, 5, 5, 8};
+    meta_graph->allTensors.emplace_back(std::move(output));
+  }
+  return meta_graph;
+}
+
+// Random data with some zeros, which the histogram does not count
+std::vector<float> RandomData(size_t size, std::mt19937 *gen) {
+  std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+  std::vector<float> data(size);
+  for (size_t i = 0; i < size; i++) {
+    data[i] = i % 5 == 3 ? 0.0f : dist(*gen);
+  }
+  return data;
+}
+}  // namespace
+
+class PostTrainingQuantizerTest : public mindspore::CommonTest {
+ public:
+  PostTrainingQuantizerTest() = default;
+
+  // The calibration images and a config file running them on parallel_num sessions
+  void WriteCalibration(const std::string &config_path, uint32_t parallel_num) {
+    mkdir(image_dir_.c_str(), S_IRWXU);
+    std::mt19937 gen(1);
+    for (int i = 0; i < kImageNum; i++) {
+      auto image = RandomData(kImageSize, &gen);
+      std::ofstream ofs(image_dir_ + "/" + std::to_string(i) + ".bin", std::ios::binary);
+      ofs.write(reinterpret_cast<const char *>(image.data()), image.size() * sizeof(float));
+    }
+    std::ofstream ofs(config_path);
+    ofs << "image_path=" << image_dir_ << "\n"
+        << "batch_count=" << kImageNum << "\n"
+        << "thread_num=1\n"
+        << "method_x=KL\n"
+        << "parallel_num=" << parallel_num << "\n";
+  }
+
+  void RemoveCalibration(const std::string &config_path) {
+    for (int i = 0; i < kImageNum; i++) {
+      (void)remove((image_dir_ + "/" + std::to_string(i) + ".bin").c_str());
+    }
+    (void)rmdir(image_dir_.c_str());
+    (void)remove(config_path.c_str());
+  }
+
+  // The steps of DoQuantize which collect the statistics of the calibration images
+  static void Calibrate(lite::quant::PostTrainingQuantizer *quantizer, size_t expect_sessions) {
+    quantizer->flags.fmk = lite::converter::FmkType_MS;
+    quantizer->flags.quantType = schema::QuantType_QUANT_NONE;
+    ASSERT_EQ(quantizer->calibrator_->ReadConfig(), lite::RET_OK);
+    ASSERT_EQ(quantizer->PreProcess(), lite::RET_OK);
+    auto sm = lite::quant::CreateSessionByFuncGraph(quantizer->funcGraph, quantizer->flags, 1);
+    quantizer->fp32_session_ = sm.session;
+    quantizer->fp32_model_ = sm.model;
+    ASSERT_NE(quantizer->fp32_session_, nullptr);
+    ASSERT_EQ(quantizer->CreateCalibSessions(quantizer->funcGraph), lite::RET_OK);
+    ASSERT_EQ(quantizer->calib_sessions_.size() + 1, expect_sessions);
+    ASSERT_EQ(quantizer->DoInference(), lite::RET_OK);
+    ASSERT_EQ(quantizer->UpdateDivergInverval(), lite::RET_OK);
+    ASSERT_EQ(quantizer->CollectDataFrequency(), lite::RET_OK);
+    ASSERT_TRUE(quantizer->calib_sessions_.empty());
+  }
+
+  static void ExpectSameInfos(const lite::quant::DivergInfoMap &infos, const lite::quant::DivergInfoMap &expect) {
+    ASSERT_EQ(infos.size(), expect.size());
+    for (auto &kv : expect) {
+      ASSERT_EQ(infos.count(kv.first), 1);
+      auto &node_infos = infos.at(kv.first);
+      ASSERT_EQ(node_infos.size(), kv.second.size());
+      for (size_t i = 0; i < node_infos.size(); i++) {
+        EXPECT_EQ(node_infos[i]->max, kv.second[i]->max);
+        EXPECT_EQ(node_infos[i]->min, kv.second[i]->min);
+        EXPECT_EQ(node_infos[i]->max_datas, kv.second[i]->max_datas);
+        EXPECT_EQ(node_infos[i]->min_datas, kv.second[i]->min_datas);
+        EXPECT_EQ(node_infos[i]->interval, kv.second[i]->interval);
+        ASSERT_EQ(node_infos[i]->histogram.size(), kv.second[i]->histogram.size());
+        // the counts match, only the order the 1e-7 start value is added in differs
+        for (size_t bin = 0; bin < node_infos[i]->histogram.size(); bin++) {
+          EXPECT_NEAR(node_infos[i]->histogram[bin], kv.second[i]->histogram[bin], 1e-3);
+        }
+      }
+    }
+  }
+
+  std::string image_dir_ = "./post_training_quantizer_test_images";
+};
+
+TEST_F(PostTrainingQuantizerTest, MaxMinMatchesScalar) {
+  std::mt19937 gen(0);
+  // sizes below, at and between multiples of the vector width
+  for (size_t size = 1; size <= 37; size++) {
+    lite::quant::DivergInfo info(nullptr, kBinNum, 8, 127, -127, lite::quant::kMethodKL);
+    auto first = RandomData(size, &gen);
+    auto second = RandomData(size, &gen);
+    ASSERT_EQ(info.RecordMaxValue(first.data(), first.size()), lite::RET_OK);
+    ASSERT_EQ(info.RecordMaxValue(second.data(), second.size()), lite::RET_OK);
+    auto first_max = *std::max_element(first.begin(), first.end());
+    auto first_min = *std::min_element(first.begin(), first.end());
+    auto second_max = *std::max_element(second.begin(), second.end());
+    auto second_min = *std::min_element(second.begin(), second.end());
+    EXPECT_EQ(info.max_datas, std::vector<float>({first_max, second_max}));
+    EXPECT_EQ(info.min_datas, std::vector<float>({first_min, second_min}));
+    EXPECT_EQ(info.max, std::max(first_max, second_max));
+    EXPECT_EQ(info.min, std::min(first_min, second_min));
+  }
+  lite::quant::DivergInfo info(nullptr, kBinNum, 8, 127, -127, lite::quant::kMethodKL);
+  EXPECT_NE(info.RecordMaxValue(nullptr, 4), lite::RET_OK);
+}
+
+TEST_F(PostTrainingQuantizerTest, HistogramMatchesScalar) {
+  std::mt19937 gen(0);
+  for (size_t size = 1; size <= 37; size++) {
+    lite::quant::DivergInfo info(nullptr, kBinNum, 8, 127, -127, lite::quant::kMethodKL);
+    auto data = RandomData(size, &gen);
+    ASSERT_EQ(info.RecordMaxValue(data.data(), data.size()), lite::RET_OK);
+    info.UpdateInterval();
+    ASSERT_GT(info.interval, 0);
+    auto expect = info.histogram;
+    const float inv_interval = 1.0f / info.interval;
+    for (auto value : data) {
+      if (value != 0) {
+        expect[std::min(static_cast<int>(std::fabs(value) * inv_interval), kBinNum - 1)]++;
+      }
+    }
+    ASSERT_EQ(info.UpdateHistogram(data.data(), data.size()), lite::RET_OK);
+    EXPECT_EQ(info.histogram, expect);
+  }
+}
+
+TEST_F(PostTrainingQuantizerTest, ParallelCalibrationMatchesSerial) {
+  const std::string serial_config = "./post_training_quantizer_test_serial.cfg";
+  const std::string parallel_config = "./post_training_quantizer_test_parallel.cfg";
+  WriteCalibration(serial_config, 1);
+  WriteCalibration(parallel_config, 3);
+
+  std::unique_ptr<schema::MetaGraphT> serial_graph(BuildConvReluGraph());
+  lite::quant::PostTrainingQuantizer serial(lite::ModelParser::Fb2Anf(serial_graph.get()), serial_config, 8,
+                                            kNumberTypeInt8);
+  Calibrate(&serial, 1);
+  std::unique_ptr<schema::MetaGraphT> parallel_graph(BuildConvReluGraph());
+  lite::quant::PostTrainingQuantizer parallel(lite::ModelParser::Fb2Anf(parallel_graph.get()), parallel_config, 8,
+                                              kNumberTypeInt8);
+  Calibrate(&parallel, 3);
+
+  // the images are sharded over three sessions, the statistics are those of running them one by one
+  ASSERT_FALSE(serial.calibrator_->GetInputDivergInfo()->empty());
+  ASSERT_EQ(serial.calibrator_->GetInputDivergInfo()->begin()->second.front()->max_datas.size(), kImageNum);
+  ExpectSameInfos(*parallel.calibrator_->GetInputDivergInfo(), *serial.calibrator_->GetInputDivergInfo());
+  ExpectSameInfos(*parallel.calibrator_->GetOutputDivergInfo(), *serial.calibrator_->GetOutputDivergInfo());
+
+  RemoveCalibration(serial_config);
+  RemoveCalibration(parallel_config);
+}
+}  // namespace mindspore
@@ -19,6 +19,8 @@
 #include <cinttypes>
 #undef __STDC_FORMAT_MACROS
 #include <algorithm>
+#include <atomic>
+#include <thread>
 #include <utility>
 #include <functional>
 #include "include/context.h"
@@ -514,6 +516,92 @@ int Benchmark::PrintInputData() {
   return RET_OK;
 }
 
+int Benchmark::MarkBatchServing(Model *model, const Context *context) {
+  auto scheduler = std::unique_ptr<session::BatchScheduler>(
+    session::BatchScheduler::CreateScheduler(model, context, flags_->batch_sizes_, flags_->max_delay_us_));
+  if (scheduler == nullptr) {
+    MS_LOG(ERROR) << "CreateScheduler failed";
+    std::cerr << "CreateScheduler failed" << std::endl;
+    return RET_ERROR;
+  }
+  // every request sends the same random sample
+  auto input_sizes = scheduler->GetInputSampleSizes();
+  auto input_types = scheduler->GetInputDataTypes();
+  std::vector<std::vector<char>> input_data(input_sizes.size());
+  std::vector<const void *> inputs;
+  for (size_t i = 0; i < input_sizes.size(); i++) {
+    input_data[i].resize(input_sizes[i]);
+    GenerateRandomData(input_sizes[i], input_data[i].data(), input_types[i]);
+    inputs.push_back(input_data[i].data());
+  }
+  auto output_sizes = scheduler->GetOutputSampleSizes();
+  auto run_client = [&](int count, std::vector<uint64_t> *latencies) {
+    std::vector<std::vector<char>> output_data(output_sizes.size());
+    std::vector<void *> outputs;
+    for (size_t i = 0; i < output_sizes.size(); i++) {
+      output_data[i].resize(output_sizes[i]);
+      outputs.push_back(output_data[i].data());
+    }
+    for (int i = 0; i < count; i++) {
+      auto start = GetTimeUs();
+      if (scheduler->Predict(inputs, outputs) != RET_OK) {
+        return false;
+      }
+      latencies->push_back(GetTimeUs() - start);
+    }
+    return true;
+  };
+
+  std::vector<uint64_t> warm_up_latencies;
+  if (!run_client(flags_->warm_up_loop_count_, &warm_up_latencies)) {
+    std::cerr << "Inference error" << std::endl;
+    return RET_ERROR;
+  }
+  std::cout << "Batch sizes = " << flags_->batch_sizes_in_ << ", MaxDelay = " << flags_->max_delay_us_ << " us"
+            << std::endl;
+  printf("%-10s %-18s %-10s %-10s %-10s\n", "clients", "throughput(req/s)", "avg(ms)", "p50(ms)", "p99(ms)");
+  for (int clients = 1;; clients = std::min(clients * 2, flags_->client_threads_)) {
+    std::vector<std::vector<uint64_t>> latencies(clients);
+    std::atomic<bool> success(true);
+    std::vector<std::thread> threads;
+    auto start = GetTimeUs();
+    for (int i = 0; i < clients; i++) {
+      threads.emplace_back([&, i] {
+        if (!run_client(flags_->loop_count_, &latencies[i])) {
+          success = false;
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    auto elapsed = GetTimeUs() - start;
+    if (!success) {
+      MS_LOG(ERROR) << "Inference error with " << clients << " clients";
+      std::cerr << "Inference error with " << clients << " clients" << std::endl;
+      return RET_ERROR;
+    }
+    std::vector<uint64_t> all;
+    for (auto &client_latencies : latencies) {
+      all.insert(all.end(), client_latencies.begin(), client_latencies.end());
+    }
+    if (!all.empty()) {
+      std::sort(all.begin(), all.end());
+      double total = 0;
+      for (auto latency : all) {
+        total += latency;
+      }
+      auto percentile = [&all](double p) { return all[std::min(all.size() - 1, size_t(all.size() * p))] / 1000.0; };
+      printf("%-10d %-18.1f %-10.3f %-10.3f %-10.3f\n", clients, all.size() * 1000000.0 / elapsed,
+             total / all.size() / 1000.0, percentile(0.5), percentile(0.99));
+    }
+    if (clients >= flags_->client_threads_) {
+      break;
+    }
+  }
+  return RET_OK;
+}
+
 int Benchmark::RunBenchmark() {
   auto start_prepare_time = GetTimeUs();
   // Load graph
@@ -566,6 +654,10 @@ int Benchmark::RunBenchmark() {
 
   context->thread_num_ = flags_->num_threads_;
 
+  if (!flags_->batch_sizes_.empty()) {
+    return MarkBatchServing(model.get(), context.get());
+  }
+
   session_ = session::LiteSession::CreateSession(context.get());
   if (session_ == nullptr) {
     MS_LOG(ERROR) << "CreateSession failed while running ", model_name.c_str();
@@ -639,6 +731,12 @@ void BenchmarkFlags::InitInputDataList() {
   delete[] input_list;
 }
 
+void BenchmarkFlags::InitBatchSizeList() {
+  for (const auto &size_str : StringSplit(this->batch_sizes_in_, std::string(DELIM_COMMA))) {
+    this->batch_sizes_.emplace_back(static_cast<int>(std::stoi(size_str)));
+  }
+}
+
 void BenchmarkFlags::InitResizeDimsList() {
   std::string content;
   content = this->resize_dims_in_;
@@ -865,6 +963,12 @@ int Benchmark::Init() {
   }
   flags_->InitInputDataList();
   flags_->InitResizeDimsList();
+  flags_->InitBatchSizeList();
+  if (!flags_->batch_sizes_.empty() && (flags_->client_threads_ <= 0 || flags_->max_delay_us_ < 0)) {
+    MS_LOG(ERROR) << "clientThreads should be positive and maxDelayUs should not be negative";
+    std::cerr << "clientThreads should be positive and maxDelayUs should not be negative" << std::endl;
+    return RET_ERROR;
+  }
   if (!flags_->resize_dims_.empty() && !flags_->input_data_list_.empty() &&
       flags_->resize_dims_.size() != flags_->input_data_list_.size()) {
     MS_LOG(ERROR) << "Size of input resizeDims should be equal to size of input inDataPath";
@@ -35,6 +35,7 @@
 #include "src/common/file_utils.h"
 #include "src/common/utils.h"
 #include "include/lite_session.h"
+#include "include/batch_scheduler.h"
 
 namespace mindspore::lite {
 enum MS_API InDataType { kImage = 0, kBinary = 1 };
@@ -92,6 +93,11 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
     AddFlag(&BenchmarkFlags::accuracy_threshold_, "accuracyThreshold", "Threshold of accuracy", 0.5);
     AddFlag(&BenchmarkFlags::resize_dims_in_, "inputShapes",
             "Shape of input data, the format should be NHWC. e.g. 1,32,32,32:1,1,32,32,1", "");
+    // MarkBatchServing
+    AddFlag(&BenchmarkFlags::batch_sizes_in_, "batchSizes",
+            "Serve single samples in batches of these sizes and report throughput and latency. e.g. 1,2,4,8,16", "");
+    AddFlag(&BenchmarkFlags::max_delay_us_, "maxDelayUs", "Max time a request waits for its batch to fill", 2000);
+    AddFlag(&BenchmarkFlags::client_threads_, "clientThreads", "Max concurrent clients of batch serving", 16);
   }
 
   ~BenchmarkFlags() override = default;
@@ -100,6 +106,8 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
 
   void InitResizeDimsList();
 
+  void InitBatchSizeList();
+
  public:
   // common
   std::string model_file_;
@@ -123,6 +131,11 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
   // Resize
   std::string resize_dims_in_;
   std::vector<std::vector<int>> resize_dims_;
+  // MarkBatchServing
+  std::string batch_sizes_in_;
+  std::vector<int> batch_sizes_;
+  int max_delay_us_ = 2000;
+  int client_threads_ = 16;
 
   std::string device_ = "CPU";
 };
@@ -260,6 +273,9 @@ class MS_API Benchmark {
 
   int MarkAccuracy();
 
+  // Requests of loopCount single samples from 1, 2, 4 ... clientThreads clients
+  int MarkBatchServing(Model *model, const Context *context);
+
  private:
   BenchmarkFlags *flags_;
   session::LiteSession *session_{nullptr};
@@ -411,6 +411,11 @@ int NetTrain::RunNetTrain() {
     std::cout << "CreateSession failed while running ", model_name.c_str();
     return RET_ERROR;
   }
+  if (flags_->recompute_ && session_->SetRecompute(true) != RET_OK) {
+    MS_LOG(ERROR) << "SetRecompute failed while running " << model_name.c_str();
+    std::cout << "SetRecompute failed while running " << model_name.c_str() << std::endl;
+    return RET_ERROR;
+  }
 
   session_->Train();
 
@@ -59,6 +59,7 @@ class MS_API NetTrainFlags : public virtual FlagParser {
     AddFlag(&NetTrainFlags::warm_up_loop_count_, "warmUpLoopCount", "Run warm up loop", 0);
     AddFlag(&NetTrainFlags::time_profiling_, "timeProfiling", "Run time profiling", false);
     AddFlag(&NetTrainFlags::epochs_, "epochs", "Number of training epochs to run", 1);
+    AddFlag(&NetTrainFlags::recompute_, "recompute", "Recompute activations to save memory", false);
     // MarkAccuracy
     AddFlag(&NetTrainFlags::data_file_, "expectedDataFile", "Expected results data file path", "");
     AddFlag(&NetTrainFlags::export_file_, "exportFile", "MS File to export trained model into", "");
@@ -84,6 +85,7 @@ class MS_API NetTrainFlags : public virtual FlagParser {
   int warm_up_loop_count_ = 0;
   bool time_profiling_;
   int epochs_ = 1;
+  bool recompute_ = false;
   // MarkAccuracy
   std::string data_file_;
   std::string data_type_ = "FLOAT";
@@ -40,29 +40,54 @@
 #include "src/common/file_utils.h"
 #include "src/common/utils.h"
 #include "tools/converter/quantizer/weight_quantizer.h"
+#include "nnacl/op_base.h"
 
 using std::string;
 using std::vector;
 
 namespace mindspore::lite::quant {
-STATUS DivergInfo::RecordMaxValue(const std::vector<float> &datas) {
-  for (float data : datas) {
-    max = std::max(data, max);
-    min = std::min(data, min);
+namespace {
+void GetMaxMin(const float *data, size_t size, float *max_num, float *min_num) {
+  float max_value = data[0];
+  float min_value = data[0];
+  size_t i = 0;
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
+  if (size >= C4NUM) {
+    MS_FLOAT32X4 max_vec = MS_LDQ_F32(data);
+    MS_FLOAT32X4 min_vec = max_vec;
+    for (i = C4NUM; i + C4NUM <= size; i += C4NUM) {
+      MS_FLOAT32X4 value_vec = MS_LDQ_F32(data + i);
+      max_vec = MS_MAXQ_F32(max_vec, value_vec);
+      min_vec = MS_MINQ_F32(min_vec, value_vec);
+    }
+    float max_lanes[C4NUM];
+    float min_lanes[C4NUM];
+    MS_STQ_F32(max_lanes, max_vec);
+    MS_STQ_F32(min_lanes, min_vec);
+    for (int j = 0; j < C4NUM; j++) {
+      max_value = std::max(max_lanes[j], max_value);
+      min_value = std::min(min_lanes[j], min_value);
+    }
   }
-  return RET_OK;
+#endif
+  for (; i < size; i++) {
+    max_value = std::max(data[i], max_value);
+    min_value = std::min(data[i], min_value);
+  }
+  *max_num = max_value;
+  *min_num = min_value;
 }
+}  // namespace
 
-STATUS DivergInfo::RecordMaxValueArray(const std::vector<float> &datas) {
-  if (datas.empty()) {
+STATUS DivergInfo::RecordMaxValue(const float *data, size_t size) {
+  if (data == nullptr || size == 0) {
     return RET_ERROR;
   }
-  float max_num = datas.at(0);
-  float min_num = datas.at(0);
-  for (float data : datas) {
-    max_num = std::max(data, max_num);
-    min_num = std::min(data, min_num);
-  }
+  float max_num;
+  float min_num;
+  GetMaxMin(data, size, &max_num, &min_num);
+  max = std::max(max_num, max);
+  min = std::min(min_num, min);
   this->max_datas.emplace_back(max_num);
   this->min_datas.emplace_back(min_num);
   return RET_OK;
@@ -74,21 +99,65 @@ void DivergInfo::UpdateInterval() {
   this->interval = max_value / static_cast<float>(bin_num);
 }
 
-STATUS DivergInfo::UpdateHistogram(const std::vector<float> &data) {
-  for (auto value : data) {
-    if (value == 0) {
-      continue;
-    }
-    if (this->interval == 0) {
+STATUS DivergInfo::UpdateHistogram(const float *data, size_t size) {
+  if (this->interval == 0) {
+    // only zeros have been recorded, which are not counted
+    if (std::any_of(data, data + size, [](float value) { return value != 0; })) {
       MS_LOG(ERROR) << "divisor 'interval' cannot be 0.";
       return RET_ERROR;
     }
-    int bin_index = std::min(static_cast<int>(std::fabs(value) / this->interval), bin_num - 1);
+    return RET_OK;
+  }
+  const float inv_interval = 1.0f / this->interval;
+  size_t i = 0;
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
+  const MS_FLOAT32X4 zero_vec = MS_MOVQ_F32(0.0f);
+  float bins[C4NUM];
+  for (; i + C4NUM <= size; i += C4NUM) {
+    MS_FLOAT32X4 value_vec = MS_LDQ_F32(data + i);
+    MS_FLOAT32X4 abs_vec = MS_MAXQ_F32(value_vec, MS_SUBQ_F32(zero_vec, value_vec));
+    MS_STQ_F32(bins, MS_MULQ_F32(abs_vec, inv_interval));
+    for (int j = 0; j < C4NUM; j++) {
+      if (data[i + j] != 0) {
+        this->histogram[std::min(static_cast<int>(bins[j]), bin_num - 1)]++;
+      }
+    }
+  }
+#endif
+  for (; i < size; i++) {
+    if (data[i] == 0) {
+      continue;
+    }
+    int bin_index = std::min(static_cast<int>(std::fabs(data[i]) * inv_interval), bin_num - 1);
     this->histogram[bin_index]++;
   }
   return RET_OK;
 }
 
+std::unique_ptr<DivergInfo> DivergInfo::CloneEmpty() const {
+  auto info = std::make_unique<DivergInfo>(*this);
+  info->max = -FLT_MAX;
+  info->min = FLT_MAX;
+  info->max_datas.clear();
+  info->min_datas.clear();
+  std::fill(info->histogram.begin(), info->histogram.end(), 0.0f);
+  return info;
+}
+
+void DivergInfo::MergeMaxValue(const DivergInfo &other) {
+  max = std::max(other.max, max);
+  min = std::min(other.min, min);
+  max_datas.insert(max_datas.end(), other.max_datas.begin(), other.max_datas.end());
+  min_datas.insert(min_datas.end(), other.min_datas.begin(), other.min_datas.end());
+}
+
+void DivergInfo::MergeHistogram(const DivergInfo &other) {
+  MS_ASSERT(histogram.size() == other.histogram.size());
+  for (size_t i = 0; i < histogram.size(); i++) {
+    histogram[i] += other.histogram[i];
+  }
+}
+
 void DivergInfo::DumpHistogram() {
   MS_LOG(INFO) << "Print node " << cnode->fullname_with_scope() << " histogram";
   for (float item : this->histogram) {
@@ -301,10 +370,9 @@ std::unordered_map<std::string, std::vector<std::unique_ptr<DivergInfo>>> *Calib
   return &this->outputs_diverg_info_;
 }
 
-STATUS Calibrator::RecordMaxValue(const vector<float> &data, const std::unique_ptr<DivergInfo> &diverg_info) {
-  diverg_info->RecordMaxValue(data);
-  diverg_info->RecordMaxValueArray(data);
-  return RET_OK;
+STATUS Calibrator::RecordMaxValue(const float *data, size_t size, const std::unique_ptr<DivergInfo> &diverg_info) {
+  MS_ASSERT(diverg_info != nullptr);
+  return diverg_info->RecordMaxValue(data, size);
 }
 
 STATUS Calibrator::ComputeThreshold() {
@@ -359,10 +427,10 @@ STATUS Calibrator::UpdateDivergInverval(
   return RET_OK;
 }
 
-STATUS Calibrator::UpdateDataFrequency(const vector<float> &data, const std::unique_ptr<DivergInfo> &diverg_info) {
+STATUS Calibrator::UpdateDataFrequency(const float *data, size_t size,
+                                       const std::unique_ptr<DivergInfo> &diverg_info) {
   MS_ASSERT(diverg_info != nullptr);
-  diverg_info->UpdateHistogram(data);
-  return RET_OK;
+  return diverg_info->UpdateHistogram(data, size);
 }
 
 STATUS Calibrator::AddQuantizedOp(const CNodePtr &node) {
@@ -423,6 +491,7 @@ PostTrainingQuantizer::~PostTrainingQuantizer() {
   delete fp32_model_;
   delete int8_session_;
   delete int8_model_;
+  ReleaseCalibSessions();
 }
 
 STATUS PostTrainingQuantizer::DoQuantInput(double scale, int32_t zeropoint, struct MaxMin *max_min,
@@ -883,20 +952,115 @@ STATUS PostTrainingQuantizer::CheckFp32TensorVec(const std::string &node_name,
   return RET_OK;
 }
 
+STATUS PostTrainingQuantizer::CreateCalibSessions(const FuncGraphPtr &func_graph) {
+  size_t session_num = std::min(static_cast<size_t>(calibrator_->GetParallelNum()), calibrator_->GetBatchNum());
+  for (size_t i = 1; i < session_num; i++) {
+    auto sm = CreateSessionByFuncGraph(func_graph, flags, calibrator_->GetThreadNum());
+    if (sm.session == nullptr || sm.model == nullptr) {
+      delete sm.session;
+      delete sm.model;
+      MS_LOG(ERROR) << "create calibration session " << i << " failed!";
+      return RET_ERROR;
+    }
+    calib_sessions_.push_back(sm);
+  }
+  return RET_OK;
+}
+
+void PostTrainingQuantizer::ReleaseCalibSessions() {
+  for (auto &sm : calib_sessions_) {
+    delete sm.session;
+    delete sm.model;
+  }
+  calib_sessions_.clear();
+}
+
 /**
  * 1. create input tensor
  * 2. insert callback to session
  * 3. run session
  **/
-STATUS PostTrainingQuantizer::DoInference() {
+STATUS PostTrainingQuantizer::RunCalibration(session::LiteSession *session, size_t begin, size_t end,
+                                             CalibStage stage, DivergInfoMap *input_infos,
+                                             DivergInfoMap *output_infos, bool expand) {
+  MS_ASSERT(session != nullptr);
+  MS_ASSERT(input_infos != nullptr);
+  MS_ASSERT(output_infos != nullptr);
   // get input tensor
-  vector<mindspore::tensor::MSTensor *> inputs = fp32_session_->GetInputs();
+  vector<mindspore::tensor::MSTensor *> inputs = session->GetInputs();
   if (inputs.size() != calibrator_->GetInputNum()) {
     MS_LOG(ERROR) << "model's input tensor cnt: " << inputs.size() << " != " << calibrator_->GetInputNum();
     return RET_ERROR;
   }
+  // the statistics are taken straight from the tensors of the session
+  auto record = [stage](mindspore::tensor::MSTensor *tensor, const std::unique_ptr<DivergInfo> &info) {
+    MS_ASSERT(tensor != nullptr);
+    const auto *tensor_data = static_cast<const float *>(tensor->MutableData());
+    size_t elem_count = tensor->ElementsNum();
+    if (tensor_data == nullptr || elem_count == 0) {
+      return RET_OK;
+    }
+    if (stage == RECORD_MAX_MIN) {
+      return Calibrator::RecordMaxValue(tensor_data, elem_count, info);
+    }
+    return Calibrator::UpdateDataFrequency(tensor_data, elem_count, info);
+  };
+
+  KernelCallBack beforeCallBack = [&](const std::vector<mindspore::tensor::MSTensor *> &beforeInputs,
+                                      const std::vector<mindspore::tensor::MSTensor *> &beforeOutputs,
+                                      const CallBackParam &callParam) -> bool {
+    auto iter = input_infos->find(callParam.node_name);
+    if (iter == input_infos->end()) {
+      return true;
+    }
+    if (PostTrainingQuantizer::CheckFp32TensorVec(callParam.node_name, beforeInputs) != RET_OK) {
+      return false;
+    }
+    auto &infos = iter->second;
+    if (expand && infos.size() == 1 && (callParam.node_type == kTypeConcat || callParam.node_type == kTypeAdd)) {
+      for (size_t i = 1; i < beforeInputs.size(); i++) {
+        auto input_diverg = std::make_unique<DivergInfo>();
+        *input_diverg = *infos[0];
+        infos.push_back(std::move(input_diverg));
+      }
+    }
+    for (size_t i = 0; i < infos.size() && i < beforeInputs.size(); i++) {
+      if (record(beforeInputs[i], infos[i]) != RET_OK) {
+        MS_LOG(ERROR) << "record input " << i << " of " << callParam.node_name << " failed";
+        return false;
+      }
+    }
+    return true;
+  };
+  // func
+  KernelCallBack afterCallBack = [&](const std::vector<mindspore::tensor::MSTensor *> &afterInputs,
+                                     const std::vector<mindspore::tensor::MSTensor *> &afterOutputs,
+                                     const CallBackParam &callParam) -> bool {
+    auto iter = output_infos->find(callParam.node_name);
+    if (iter == output_infos->end()) {
+      return true;
+    }
+    if (PostTrainingQuantizer::CheckFp32TensorVec(callParam.node_name, afterOutputs) != RET_OK) {
+      return false;
+    }
+    auto &infos = iter->second;
+    if (expand && infos.size() == 1 && afterOutputs.size() > 1) {
+      for (size_t i = 1; i < afterOutputs.size(); i++) {
+        auto output_diverg = std::make_unique<DivergInfo>();
+        *output_diverg = *infos[0];
+        infos.push_back(std::move(output_diverg));
+      }
+    }
+    for (size_t i = 0; i < infos.size() && i < afterOutputs.size(); i++) {
+      if (record(afterOutputs[i], infos[i]) != RET_OK) {
+        MS_LOG(ERROR) << "record output " << i << " of " << callParam.node_name << " failed";
+        return false;
+      }
+    }
+    return true;
+  };
 
-  for (size_t i = 0; i < calibrator_->GetBatchNum(); i++) {
+  for (size_t i = begin; i < end; i++) {
     // set multi-input data
     for (size_t input_index = 0; input_index < inputs.size(); input_index++) {
       STATUS status = calibrator_->GenerateInputData(input_index, i, inputs[input_index]);
@@ -905,73 +1069,95 @@ STATUS PostTrainingQuantizer::DoInference() {
         return RET_ERROR;
       }
     }
+    auto status = session->RunGraph(beforeCallBack, afterCallBack);
+    if (status != RET_OK) {
+      MS_LOG(ERROR) << "run model failed!";
+      return RET_ERROR;
+    }
+  }
+  return RET_OK;
+}
 
-    KernelCallBack beforeCallBack = [&](const std::vector<mindspore::tensor::MSTensor *> &beforeInputs,
-                                        const std::vector<mindspore::tensor::MSTensor *> &beforeOutputs,
-                                        const CallBackParam &callParam) -> bool {
-      auto diverg_info_map = calibrator_->GetInputDivergInfo();
-      if (diverg_info_map->find(callParam.node_name) == diverg_info_map->end()) {
-        return true;
-      }
-      if (PostTrainingQuantizer::CheckFp32TensorVec(callParam.node_name, beforeInputs) != RET_OK) {
-        return false;
-      }
-      if ((*diverg_info_map)[callParam.node_name].size() == 1 &&
-          (callParam.node_type == kTypeConcat || callParam.node_type == kTypeAdd)) {
-        for (size_t i = 1; i < beforeInputs.size(); i++) {
-          auto input_diverg = std::make_unique<DivergInfo>();
-          *input_diverg = *((*diverg_info_map)[callParam.node_name][0]);
-          (*diverg_info_map)[callParam.node_name].push_back(std::move(input_diverg));
-        }
-      }
-      for (size_t i = 0; i < (*diverg_info_map)[callParam.node_name].size(); i++) {
-        auto tensor = beforeInputs[i];
-        MS_ASSERT(tensor != nullptr);
-        const auto *tensor_data = static_cast<const float *>(tensor->MutableData());
-        MS_ASSERT(tensor_data != nullptr);
-        size_t elem_count = tensor->ElementsNum();
-        vector<float> data(tensor_data, tensor_data + elem_count);
-        this->calibrator_->RecordMaxValue(data, (*diverg_info_map)[callParam.node_name][i]);
-      }
-      return true;
-    };
-    // func
-    KernelCallBack afterCallBack = [&](const std::vector<mindspore::tensor::MSTensor *> &afterInputs,
-                                       const std::vector<mindspore::tensor::MSTensor *> &afterOutputs,
-                                       const CallBackParam &callParam) -> bool {
-      auto diverg_info_map = calibrator_->GetOutputDivergInfo();
-      if (diverg_info_map->find(callParam.node_name) == diverg_info_map->end()) {
-        return true;
-      }
-      if (PostTrainingQuantizer::CheckFp32TensorVec(callParam.node_name, afterOutputs) != RET_OK) {
-        return false;
+STATUS PostTrainingQuantizer::ParallelCalibration(size_t begin, CalibStage stage) {
+  size_t batch_num = calibrator_->GetBatchNum();
+  if (begin >= batch_num) {
+    return RET_OK;
+  }
+  std::vector<session::LiteSession *> sessions = {fp32_session_};
+  for (auto &sm : calib_sessions_) {
+    sessions.push_back(sm.session);
+  }
+  size_t worker_num = std::min(sessions.size(), batch_num - begin);
+  if (worker_num == 1) {
+    return RunCalibration(fp32_session_, begin, batch_num, stage, calibrator_->GetInputDivergInfo(),
+                          calibrator_->GetOutputDivergInfo(), false);
+  }
+
+  // every worker records into its own copy of the diverg infos, which are merged once all the images are run
+  auto clone_infos = [](const DivergInfoMap &src, DivergInfoMap *dst) {
+    for (auto &kv : src) {
+      auto &infos = (*dst)[kv.first];
+      for (auto &info : kv.second) {
+        infos.push_back(info->CloneEmpty());
       }
-      if ((*diverg_info_map)[callParam.node_name].size() == 1 && afterOutputs.size() > 1) {
-        for (size_t i = 1; i < afterOutputs.size(); i++) {
-          auto output_diverg = std::make_unique<DivergInfo>();
-          *output_diverg = *((*diverg_info_map)[callParam.node_name][0]);
-          (*diverg_info_map)[callParam.node_name].push_back(std::move(output_diverg));
+    }
+  };
+  auto merge_infos = [stage](const DivergInfoMap &src, DivergInfoMap *dst) {
+    for (auto &kv : src) {
+      auto &infos = dst->at(kv.first);
+      for (size_t i = 0; i < kv.second.size(); i++) {
+        if (stage == RECORD_MAX_MIN) {
+          infos[i]->MergeMaxValue(*kv.second[i]);
+        } else {
+          infos[i]->MergeHistogram(*kv.second[i]);
         }
       }
-      size_t output_i = 0;
-      for (const auto &tensor : afterOutputs) {
-        const auto *tensor_data = static_cast<const float *>(tensor->MutableData());
-        size_t elem_count = tensor->ElementsNum();
-        vector<float> data(tensor_data, tensor_data + elem_count);
-        this->calibrator_->RecordMaxValue(data, (*diverg_info_map)[callParam.node_name][output_i]);
-        output_i++;
-      }
-      return true;
-    };
-    auto status = fp32_session_->RunGraph(beforeCallBack, afterCallBack);
-    if (status != RET_OK) {
-      MS_LOG(ERROR) << "run model failed!";
-      return RET_ERROR;
+    }
+  };
+  std::vector<DivergInfoMap> worker_input_infos(worker_num);
+  std::vector<DivergInfoMap> worker_output_infos(worker_num);
+  std::vector<std::future<STATUS>> futures;
+  size_t shard = (batch_num - begin + worker_num - 1) / worker_num;
+  for (size_t w = 0; w < worker_num; w++) {
+    clone_infos(*calibrator_->GetInputDivergInfo(), &worker_input_infos[w]);
+    clone_infos(*calibrator_->GetOutputDivergInfo(), &worker_output_infos[w]);
+    size_t shard_begin = std::min(begin + w * shard, batch_num);
+    size_t shard_end = std::min(shard_begin + shard, batch_num);
+    futures.push_back(std::async(std::launch::async, &PostTrainingQuantizer::RunCalibration, this, sessions[w],
+                                 shard_begin, shard_end, stage, &worker_input_infos[w], &worker_output_infos[w],
+                                 false));
+  }
+  STATUS ret = RET_OK;
+  for (auto &future : futures) {
+    if (future.get() != RET_OK) {
+      ret = RET_ERROR;
     }
   }
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "parallel calibration failed!";
+    return ret;
+  }
+  // merge in the image order so that the per image max and min keep it
+  for (size_t w = 0; w < worker_num; w++) {
+    merge_infos(worker_input_infos[w], calibrator_->GetInputDivergInfo());
+    merge_infos(worker_output_infos[w], calibrator_->GetOutputDivergInfo());
+  }
   return RET_OK;
 }
 
+STATUS PostTrainingQuantizer::DoInference() {
+  if (calibrator_->GetBatchNum() == 0) {
+    return RET_OK;
+  }
+  // the first image also tells which nodes have several inputs or outputs to record
+  auto status = RunCalibration(fp32_session_, 0, 1, RECORD_MAX_MIN, calibrator_->GetInputDivergInfo(),
+                               calibrator_->GetOutputDivergInfo(), true);
+  if (status != RET_OK) {
+    return status;
+  }
+  return ParallelCalibration(1, RECORD_MAX_MIN);
+}
+
 STATUS PostTrainingQuantizer::Int8Inference() {
   // int8 inference
   vector<mindspore::tensor::MSTensor *> inputs = int8_session_->GetInputs();
@@ -1331,74 +1517,9 @@ STATUS PostTrainingQuantizer::BiasCorrection(const FuncGraphPtr &func_graph) {
 }
 
 STATUS PostTrainingQuantizer::CollectDataFrequency() {
-  // get input tensor
-  vector<mindspore::tensor::MSTensor *> inputs = fp32_session_->GetInputs();
-  if (inputs.size() != calibrator_->GetInputNum()) {
-    MS_LOG(ERROR) << "model's input tensor cnt: " << inputs.size() << " != " << calibrator_->GetInputNum();
-    return RET_ERROR;
-  }
-
-  for (size_t i = 0; i < calibrator_->GetBatchNum(); i++) {
-    // set multi-input data
-    for (size_t input_index = 0; input_index < inputs.size(); input_index++) {
-      STATUS status = calibrator_->GenerateInputData(input_index, i, inputs[input_index]);
-      if (status != RET_OK) {
-        MS_LOG(ERROR) << "generate input data from images failed!";
-        return RET_ERROR;
-      }
-    }
-
-    KernelCallBack beforeCallBack = [&](const std::vector<mindspore::tensor::MSTensor *> &beforeInputs,
-                                        const std::vector<mindspore::tensor::MSTensor *> &beforeOutputs,
-                                        const CallBackParam &callParam) {
-      auto diverg_info_map = calibrator_->GetInputDivergInfo();
-      if (diverg_info_map->find(callParam.node_name) == diverg_info_map->end()) {
-        return true;
-      }
-      if (PostTrainingQuantizer::CheckFp32TensorVec(callParam.node_name, beforeInputs) != RET_OK) {
-        return false;
-      }
-      for (size_t i = 0; i < (*diverg_info_map)[callParam.node_name].size(); i++) {
-        auto tensor = beforeInputs[i];
-        MS_ASSERT(tensor != nullptr);
-        const auto *tensor_data = static_cast<const float *>(tensor->MutableData());
-        MS_ASSERT(tensor_data != nullptr);
-        size_t elem_count = tensor->ElementsNum();
-        vector<float> data(tensor_data, tensor_data + elem_count);
-        this->calibrator_->UpdateDataFrequency(data, (*diverg_info_map)[callParam.node_name][i]);
-      }
-      return true;
-    };
-
-    KernelCallBack afterCallBack = [&](const std::vector<mindspore::tensor::MSTensor *> &after_inputs,
-                                       const std::vector<mindspore::tensor::MSTensor *> &after_outputs,
-                                       const CallBackParam &call_param) {
-      auto diverg_info_map = calibrator_->GetOutputDivergInfo();
-      if (diverg_info_map->find(call_param.node_name) == diverg_info_map->end()) {
-        return true;
-      }
-      if (PostTrainingQuantizer::CheckFp32TensorVec(call_param.node_name, after_outputs) != RET_OK) {
-        return false;
-      }
-      int output_i = 0;
-      for (const auto &tensor : after_outputs) {
-        const auto *tensor_data = static_cast<const float *>(tensor->MutableData());
-        MS_ASSERT(tensor_data != nullptr);
-        size_t elem_count = tensor->ElementsNum();
-        vector<float> data(tensor_data, tensor_data + elem_count);
-        this->calibrator_->UpdateDataFrequency(data, (*diverg_info_map)[call_param.node_name][output_i]);
-        output_i++;
-      }
-      return true;
-    };
-    auto status = fp32_session_->RunGraph(beforeCallBack, afterCallBack);
-    if (status != RET_OK) {
-      MS_LOG(ERROR) << "run model failed!";
-      return RET_ERROR;
-    }
-  }
-
-  return RET_OK;
+  auto status = ParallelCalibration(0, COLLECT_HISTOGRAM);
+  ReleaseCalibSessions();
+  return status;
 }
 
 STATUS PostTrainingQuantizer::ComputeThreshold() { return this->calibrator_->ComputeThreshold(); }
@@ -1449,6 +1570,10 @@ STATUS PostTrainingQuantizer::DoQuantize(FuncGraphPtr func_graph) {
     MS_LOG(ERROR) << "create session failed!";
     return RET_ERROR;
   }
+  status = CreateCalibSessions(func_graph);
+  if (status != RET_OK) {
+    return status;
+  }
 
   MS_LOG(INFO) << "start to update divergence's max value";
   status = DoInference();
@@ -33,6 +33,9 @@
 
 namespace mindspore::lite::quant {
 class Calibrator;
+struct DivergInfo;
+
+using DivergInfoMap = std::unordered_map<std::string, std::vector<std::unique_ptr<DivergInfo>>>;
 
 struct MaxMin {
  public:
@@ -67,6 +70,8 @@ class PostTrainingQuantizer : public Quantizer {
   Model *fp32_model_{nullptr};
   session::LiteSession *int8_session_{nullptr};
   Model *int8_model_{nullptr};
+  // sessions which calibrate along with fp32_session_, released once the histograms are collected
+  std::vector<SessionModel> calib_sessions_;
 
   std::map<std::string, std::vector<float>> fp32_op_input_map;           // concurency
   std::map<std::string, std::vector<float>> fp32_op_output_ch_mean_map;  // concurency
@@ -92,6 +97,23 @@ class PostTrainingQuantizer : public Quantizer {
   STATUS CheckFp32TensorVec(const std::string &node_name,
                             const std::vector<mindspore::tensor::MSTensor *> &tensor_vec) const;
 
+  enum CalibStage {
+    RECORD_MAX_MIN,
+    COLLECT_HISTOGRAM,
+  };
+
+  STATUS CreateCalibSessions(const FuncGraphPtr &func_graph);
+
+  void ReleaseCalibSessions();
+
+  // Run the images [begin, end) on session and record their statistics of the stage into the diverg infos, expand
+  // creates the diverg infos of the extra inputs and outputs of a node the first time it runs
+  STATUS RunCalibration(session::LiteSession *session, size_t begin, size_t end, CalibStage stage,
+                        DivergInfoMap *input_infos, DivergInfoMap *output_infos, bool expand);
+
+  // Shard the images [begin, batch_num) over the calibration sessions and merge what each of them recorded
+  STATUS ParallelCalibration(size_t begin, CalibStage stage);
+
   STATUS DoInference();
 
   STATUS UpdateDivergInverval();
@@ -145,13 +167,19 @@ struct DivergInfo {
     std::fill(histogram.begin(), histogram.end(), 1.0e-7);
   }
 
-  STATUS RecordMaxValue(const std::vector<float> &datas);
-
-  STATUS RecordMaxValueArray(const std::vector<float> &datas);
+  // Update max and min with the data of one image and keep its own max and min for the outlier method
+  STATUS RecordMaxValue(const float *data, size_t size);
 
   void UpdateInterval();
 
-  STATUS UpdateHistogram(const std::vector<float> &data);
+  STATUS UpdateHistogram(const float *data, size_t size);
+
+  // A diverg info of the same node and interval which has not recorded any data yet
+  std::unique_ptr<DivergInfo> CloneEmpty() const;
+
+  void MergeMaxValue(const DivergInfo &other);
+
+  void MergeHistogram(const DivergInfo &other);
 
   void DumpHistogram();
 
@@ -180,18 +208,20 @@ class Calibrator {
 
   std::string GetMethodX() const { return config_param_.method_x; }
 
+  uint32_t GetParallelNum() const { return config_param_.parallel_num; }
+
   bool GetBiasCorrection() const { return config_param_.bias_correction; }
 
   size_t GetInputNum() const { return config_param_.image_paths.size(); }
 
   STATUS AddQuantizedOp(const CNodePtr &node);
 
-  static STATUS RecordMaxValue(const std::vector<float> &data, const std::unique_ptr<DivergInfo> &diverg_info);
+  static STATUS RecordMaxValue(const float *data, size_t size, const std::unique_ptr<DivergInfo> &diverg_info);
 
   static STATUS UpdateDivergInverval(
     std::unordered_map<std::string, std::vector<std::unique_ptr<DivergInfo>>> *diverg_info);
 
-  static STATUS UpdateDataFrequency(const std::vector<float> &data, const std::unique_ptr<DivergInfo> &diverg_info);
+  static STATUS UpdateDataFrequency(const float *data, size_t size, const std::unique_ptr<DivergInfo> &diverg_info);
   void Dump();
 
   STATUS ComputeThreshold();
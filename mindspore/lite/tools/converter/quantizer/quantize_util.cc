@@ -583,6 +583,8 @@ STATUS ParseConfigFile(std::string config_file, PostQuantConfig *post_quant_conf
       post_quant_config->batch_count = std::stoul(value);
     } else if (key == "thread_num") {
       post_quant_config->thread_num = std::stoul(value);
+    } else if (key == "parallel_num") {
+      post_quant_config->parallel_num = std::max(std::stoul(value), 1UL);
     } else if (key == "method_x") {
       if (value != kMethodKL && value != kMethodMaxMin && value != kMethodOutlier) {
         MS_LOG(WARNING) << "unsupported method_x: " << value << ". Use default value.";
@@ -626,6 +628,7 @@ STATUS ParseConfigFile(std::string config_file, PostQuantConfig *post_quant_conf
   MS_LOG(DEBUG) << "batch_count: " << post_quant_config->batch_count << "\n"
                 << "method_x: " << post_quant_config->method_x << "\n"
                 << "thread_num: " << post_quant_config->thread_num << "\n"
+                << "parallel_num: " << post_quant_config->parallel_num << "\n"
                 << "bias_correction: " << post_quant_config->bias_correction << "\n"
                 << "mixed: " << post_quant_config->mixed << "\n"
                 << "mean_error_threshold: " << post_quant_config->mean_error_threshold;
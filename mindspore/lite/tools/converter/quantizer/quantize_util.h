@@ -54,6 +54,8 @@ struct PostQuantConfig {
   uint32_t batch_count{100};
   std::string method_x{kMethodKL};
   uint32_t thread_num{1};
+  // fp32 sessions which run the calibration images concurrently, each with thread_num threads
+  uint32_t parallel_num{1};
   bool bias_correction{false};
   bool mixed{false};
   float mean_error_threshold{0.04};
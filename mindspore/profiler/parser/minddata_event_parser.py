@@ -0,0 +1,136 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Minddata op event parser."""
+import numpy as np
+
+from mindspore.profiler.common.validator.validate_path import \
+    validate_and_normalize_path
+
+_MAGIC = 0x5645444D
+_VERSION = 1
+_BLOCK_EVENTS = 1
+_BLOCK_HISTOGRAM = 2
+_BLOCK_DROPPED = 3
+_INT32_COLUMNS = ["op_id", "consumer_id", "worker_id", "wait_us", "busy_us", "rows", "queue_depth"]
+
+
+class MinddataEventParser:
+    """
+    Reader of the op event file written by the dataset engine when profiling is on.
+
+    Every event is one buffer popped from the output connector of op_id by worker worker_id of op consumer_id
+    (-1 for the iterator). wait_us is how long the worker waited for it, busy_us how long the worker worked since
+    its previous buffer, and queue_depth the number of buffers left in the connector.
+
+    Args:
+        event_file_path (str): path of op_event_profiling_{device_id}.bin.
+    """
+    def __init__(self, event_file_path):
+        self._path = validate_and_normalize_path(event_file_path)
+        self._events = None
+        self._histograms = {}
+        self._dropped = 0
+        self._parse()
+
+    def _parse(self):
+        """Read all blocks of the file."""
+        with open(self._path, "rb") as f:
+            data = f.read()
+        header = np.frombuffer(data, dtype="<u4", count=2)
+        if header[0] != _MAGIC or header[1] != _VERSION:
+            raise ValueError("Invalid op event file: " + self._path)
+        blocks = []
+        offset = 8
+        while offset + 8 <= len(data):
+            kind, count = (int(x) for x in np.frombuffer(data, dtype="<u4", count=2, offset=offset))
+            offset += 8
+            if kind == _BLOCK_EVENTS:
+                block = {"timestamp_us": np.frombuffer(data, dtype="<i8", count=count, offset=offset)}
+                offset += 8 * count
+                for name in _INT32_COLUMNS:
+                    block[name] = np.frombuffer(data, dtype="<i4", count=count, offset=offset)
+                    offset += 4 * count
+                blocks.append(block)
+            elif kind == _BLOCK_HISTOGRAM:
+                # histograms are cumulative, the last block wins
+                self._histograms = {}
+                for _ in range(count):
+                    op_id, buckets = (int(x) for x in np.frombuffer(data, dtype="<i4", count=2, offset=offset))
+                    offset += 8
+                    self._histograms[op_id] = np.frombuffer(data, dtype="<u8", count=buckets, offset=offset)
+                    offset += 8 * buckets
+            elif kind == _BLOCK_DROPPED:
+                self._dropped += count
+            else:
+                raise ValueError("Invalid block kind {} in op event file: {}".format(kind, self._path))
+        names = ["timestamp_us"] + _INT32_COLUMNS
+        if blocks:
+            self._events = {name: np.concatenate([block[name] for block in blocks]) for name in names}
+        else:
+            self._events = {name: np.array([], dtype=np.int64) for name in names}
+
+    @property
+    def events(self):
+        """dict[str, numpy.ndarray], one array per event column."""
+        return self._events
+
+    @property
+    def dropped(self):
+        """int, number of events dropped because the monitor could not keep up."""
+        return self._dropped
+
+    def row_latency_histogram(self, op_id):
+        """
+        Histogram of the time op_id spends per input row.
+
+        Args:
+            op_id (int): the consuming op.
+
+        Returns:
+            numpy.ndarray, bucket i counts rows whose time in ns is in [2^(i-1), 2^i).
+        """
+        return self._histograms.get(op_id)
+
+    def queue_depth(self, op_id):
+        """
+        Time series of the output connector depth of an op.
+
+        Args:
+            op_id (int): the producing op.
+
+        Returns:
+            tuple[numpy.ndarray, numpy.ndarray], timestamps in us and depths.
+        """
+        mask = self._events["op_id"] == op_id
+        order = np.argsort(self._events["timestamp_us"][mask], kind="stable")
+        return self._events["timestamp_us"][mask][order], self._events["queue_depth"][mask][order]
+
+    def worker_utilization(self, consumer_id):
+        """
+        Busy and idle time of every worker of an op.
+
+        Args:
+            consumer_id (int): the consuming op, -1 for the iterator.
+
+        Returns:
+            dict[int, tuple[int, int]], busy and idle us per worker id.
+        """
+        mask = self._events["consumer_id"] == consumer_id
+        result = {}
+        for worker_id in np.unique(self._events["worker_id"][mask]):
+            worker_mask = mask & (self._events["worker_id"] == worker_id)
+            result[int(worker_id)] = (int(self._events["busy_us"][worker_mask].sum()),
+                                      int(self._events["wait_us"][worker_mask].sum()))
+        return result
@@ -15,6 +15,7 @@
 """Dataset help for minddata dataset"""
 import math
 import os
+import sys
 
 from mindspore._checkparam import Validator
 from mindspore.common.dtype import pytype_to_dtype
@@ -123,8 +124,8 @@ def connect_network_with_dataset(network, dataset_helper):
 
         return network
 
-    if not hasattr(dataset, '__me_inited__') and (context.get_context("device_target") == "Ascend" or \
-            context.get_context("device_target") == "GPU") and not context.get_context("enable_ge"):
+    if not hasattr(dataset, '__me_inited__') and context.get_context("device_target") in ("Ascend", "GPU", "CPU") \
+            and not context.get_context("enable_ge"):
         dataset.__me_inited__ = True
 
         dataset_types, dataset_shapes = dataset_helper.types_shapes()
@@ -180,12 +181,11 @@ class DatasetHelper:
                         iterclass = _DatasetIterPSServer
                     elif ms_role == "MS_WORKER":
                         iterclass = _DatasetIterPSWork
-                    elif (context.get_context("device_target") == "Ascend") or \
-                         (context.get_context("device_target") == "GPU"):
-                        iterclass = _DatasetIterMSLoopSink
-                    elif context.get_context("device_target") == "CPU":
+                    elif context.get_context("device_target") == "CPU" and sys.platform == "win32":
                         raise RuntimeError(
-                            "Currently dataset sink mode is not supported when the device target is CPU.")
+                            "Currently dataset sink mode is not supported when the device target is CPU on Windows.")
+                    elif context.get_context("device_target") in ("Ascend", "GPU", "CPU"):
+                        iterclass = _DatasetIterMSLoopSink
                 else:
                     iterclass = _DatasetIterPyNative
             self.iter = iterclass(dataset, sink_size, epoch_num)
@@ -284,8 +284,7 @@ class _DatasetIter:
             # PS mode does not support loop sink.
             sink_size = 1
         else:
-            if context.get_context("enable_ge") or context.get_context("device_target") == "Ascend" \
-                    or context.get_context("device_target") == "GPU":
+            if context.get_context("enable_ge") or context.get_context("device_target") in ("Ascend", "GPU", "CPU"):
                 if self.sink_size > 0:
                     sink_size = self.sink_size
                 else:
@@ -327,7 +326,7 @@ class _DatasetIterPyNative(_DatasetIter):
 
 
 class _DatasetIterMSLoopSink(_DatasetIter):
-    """Iter for context (device_target=Ascend)"""
+    """Iter for context (device_target=Ascend, GPU or CPU)"""
 
     def __init__(self, dataset, sink_size, epoch_num):
         super().__init__(dataset, sink_size, epoch_num)
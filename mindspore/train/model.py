@@ -16,6 +16,7 @@
 from collections.abc import Iterable
 
 import os
+import sys
 import math
 import numpy as np
 
@@ -349,8 +350,8 @@ class Model:
             callbacks (list): List of callback objects which should be executed while training. Default: None.
             dataset_sink_mode (bool): Determine whether the data should be passed through the dataset channel.
                                       Default: True.
-                                      Configure pynative mode or CPU, the training process will be performed with
-                                      dataset not sink.
+                                      Configure pynative mode or CPU on Windows, the training process will be
+                                      performed with dataset not sink.
             sink_size (int): Control the amount of data in each sink. Default: -1.
         """
         epoch = Validator.check_positive_int(epoch)
@@ -383,8 +384,8 @@ class Model:
         with _CallbackManager(callbacks) as list_callback:
             if not dataset_sink_mode:
                 self._train_process(epoch, train_dataset, list_callback, cb_params)
-            elif context.get_context("device_target") == "CPU":
-                logger.warning("The CPU cannot support dataset sink mode currently."
+            elif context.get_context("device_target") == "CPU" and sys.platform == "win32":
+                logger.warning("The CPU cannot support dataset sink mode on Windows currently."
                                "So the training process will be performed with dataset not sink.")
                 self._train_process(epoch, train_dataset, list_callback, cb_params)
             else:
@@ -537,7 +538,7 @@ class Model:
         """
         Training API where the iteration is controlled by python front-end.
 
-        When setting pynative mode or CPU, the training process will be performed with dataset not sink.
+        When setting pynative mode or CPU on Windows, the training process will be performed with dataset not sink.
 
         Note:
             If dataset_sink_mode is True, data will be sent to device. If device is Ascend, features
@@ -557,8 +558,8 @@ class Model:
             callbacks (list, object): List of callback objects or callback object, which should be executed
                                       while training. Default: None.
             dataset_sink_mode (bool): Determines whether to pass the data through dataset channel. Default: True.
-                                      Configure pynative mode or CPU, the training process will be performed with
-                                      dataset not sink.
+                                      Configure pynative mode or CPU on Windows, the training process will be
+                                      performed with dataset not sink.
             sink_size (int): Control the amount of data in each sink.
                              If sink_size = -1, sink the complete dataset for each epoch.
                              If sink_size > 0, sink sink_size data for each epoch.
@@ -671,7 +672,8 @@ class Model:
         """
         Evaluation API where the iteration is controlled by python front-end.
 
-        Configure to pynative mode or CPU, the evaluating process will be performed with dataset non-sink mode.
+        Configure to pynative mode or CPU on Windows, the evaluating process will be performed with dataset non-sink
+        mode.
 
         Note:
             If dataset_sink_mode is True, data will be sent to device. If device is Ascend, features
@@ -708,9 +710,9 @@ class Model:
 
         self._clear_metrics()
 
-        if context.get_context("device_target") == "CPU" and dataset_sink_mode:
+        if context.get_context("device_target") == "CPU" and sys.platform == "win32" and dataset_sink_mode:
             dataset_sink_mode = False
-            logger.warning("CPU cannot support dataset sink mode currently."
+            logger.warning("CPU cannot support dataset sink mode on Windows currently."
                            "So the evaluating process will be performed with dataset non-sink mode.")
 
         with _CallbackManager(callbacks) as list_callback:
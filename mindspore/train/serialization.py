@@ -16,12 +16,14 @@
 import os
 import stat
 import math
+import struct
+from concurrent.futures import ThreadPoolExecutor
 from threading import Thread, Lock
 import numpy as np
 import mindspore.nn as nn
 import mindspore.context as context
 from mindspore import log as logger
-from mindspore.train.checkpoint_pb2 import Checkpoint
+from mindspore.train.checkpoint_pb2 import Checkpoint, CheckpointIndex
 from mindspore.train.print_pb2 import Print
 from mindspore.train.node_strategy_pb2 import ParallelStrategyMap, ParallelLayouts
 from mindspore.common.tensor import Tensor
@@ -46,6 +48,10 @@ tensor_to_np_type = {"Int8": np.int8, "Uint8": np.uint8, "Int16": np.int16, "Uin
 
 _ckpt_mutex = Lock()
 SLICE_SIZE = 512 * 1024 * 1024
+RAW_CKPT_MAGIC = b"MSCKPTR1"
+RAW_CKPT_ALIGN = 64
+RAW_CKPT_CHUNK_SIZE = 64 * 1024 * 1024
+RAW_CKPT_WRITERS = 8
 
 
 def _special_process_par(par, new_par):
@@ -142,7 +148,130 @@ def _exec_save(ckpt_file_name, data_list):
         raise e
 
 
-def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=False):
+def _align_raw_ckpt(size):
+    """Round size up to the alignment of tensor data in raw checkpoint files."""
+    return (size + RAW_CKPT_ALIGN - 1) // RAW_CKPT_ALIGN * RAW_CKPT_ALIGN
+
+
+def _write_at(fd, buf, pos):
+    """Write the whole buffer at the given file position."""
+    view = memoryview(buf)
+    while view:
+        if hasattr(os, "pwrite"):
+            written = os.pwrite(fd, view, pos)
+        else:
+            os.lseek(fd, pos, os.SEEK_SET)
+            written = os.write(fd, view)
+        view = view[written:]
+        pos += written
+
+
+def _exec_save_raw(ckpt_file_name, data_list):
+    """
+    Execute the process of saving checkpoint into file in raw format.
+
+    The file is RAW_CKPT_MAGIC, the uint64 size of a CheckpointIndex, the CheckpointIndex, then the data of every
+    tensor aligned to RAW_CKPT_ALIGN. The data is written straight from the tensor memory in chunks by a thread pool,
+    os.pwrite releases the GIL so the chunks are written in parallel.
+    """
+
+    try:
+        with _ckpt_mutex:
+            index = CheckpointIndex()
+            chunks = []
+            offset = 0
+            for name, value in data_list.items():
+                data = np.ascontiguousarray(value[2]).reshape(-1).view(np.uint8)
+                entry = index.entry.add()
+                entry.tag = name
+                entry.dims.extend(value[0])
+                entry.tensor_type = value[1]
+                entry.offset = offset
+                entry.size = data.nbytes
+                for start in range(0, data.nbytes, RAW_CKPT_CHUNK_SIZE):
+                    chunks.append((offset + start, data[start:start + RAW_CKPT_CHUNK_SIZE]))
+                offset = _align_raw_ckpt(offset + data.nbytes)
+            index_content = index.SerializeToString()
+            header = RAW_CKPT_MAGIC + struct.pack("<Q", len(index_content)) + index_content
+            data_start = _align_raw_ckpt(len(header))
+
+            if os.path.exists(ckpt_file_name):
+                os.remove(ckpt_file_name)
+            fd = os.open(ckpt_file_name, os.O_WRONLY | os.O_CREAT | os.O_TRUNC | getattr(os, "O_BINARY", 0),
+                         stat.S_IRUSR | stat.S_IWUSR)
+            try:
+                _write_at(fd, header, 0)
+                # size the file first so that the chunks can land in any order
+                os.ftruncate(fd, data_start + offset)
+                with ThreadPoolExecutor(max_workers=RAW_CKPT_WRITERS) as pool:
+                    list(pool.map(lambda chunk: _write_at(fd, chunk[1], data_start + chunk[0]), chunks))
+            finally:
+                os.close(fd)
+
+        os.chmod(ckpt_file_name, stat.S_IRUSR)
+
+    except BaseException as e:
+        logger.error("Failed to save the checkpoint file %s.", ckpt_file_name)
+        raise e
+
+
+def _is_raw_checkpoint(ckpt_file_name):
+    """Whether the checkpoint file is in raw format."""
+    with open(ckpt_file_name, "rb") as f:
+        return f.read(len(RAW_CKPT_MAGIC)) == RAW_CKPT_MAGIC
+
+
+def _read_raw_checkpoint_index(ckpt_file_name):
+    """Read the index of a raw checkpoint file and memory map its tensor data."""
+    with open(ckpt_file_name, "rb") as f:
+        f.seek(len(RAW_CKPT_MAGIC))
+        index_size = struct.unpack("<Q", f.read(8))[0]
+        index = CheckpointIndex()
+        index.ParseFromString(f.read(index_size))
+    data_start = _align_raw_ckpt(len(RAW_CKPT_MAGIC) + 8 + index_size)
+    if os.path.getsize(ckpt_file_name) <= data_start:
+        return index, np.zeros(0, np.uint8)
+    return index, np.memmap(ckpt_file_name, dtype=np.uint8, mode="r", offset=data_start)
+
+
+def _make_parameter(tag, data_type, dims, param_data):
+    """Build a parameter from the flat data of a checkpoint tensor."""
+    ms_type = tensor_to_ms_type[data_type]
+    if dims == [0]:
+        if 'Float' in data_type:
+            param_data = float(param_data[0])
+        elif 'Int' in data_type:
+            param_data = int(param_data[0])
+        return Parameter(Tensor(param_data, ms_type), name=tag)
+    if dims == [1]:
+        return Parameter(Tensor(param_data, ms_type), name=tag)
+    return Parameter(Tensor(param_data.reshape(list(dims)), ms_type), name=tag)
+
+
+def _raw_entry_to_parameter(entry, data):
+    """Build a parameter from an entry of a raw checkpoint file, only its own pages are read."""
+    param_data = data[entry.offset:entry.offset + entry.size].view(tensor_to_np_type[entry.tensor_type])
+    return _make_parameter(entry.tag, entry.tensor_type, entry.dims, param_data)
+
+
+def _load_raw_checkpoint(ckpt_file_name, filter_prefix):
+    """Load the parameters of a raw checkpoint file."""
+    parameter_dict = {}
+    try:
+        index, data = _read_raw_checkpoint_index(ckpt_file_name)
+        for entry in index.entry:
+            if filter_prefix is not None and _check_param_prefix(filter_prefix, entry.tag):
+                continue
+            parameter_dict[entry.tag] = _raw_entry_to_parameter(entry, data)
+        logger.info("Loading checkpoint files process is finished.")
+
+    except BaseException as e:
+        logger.error("Failed to load the checkpoint file `%s`.", ckpt_file_name)
+        raise RuntimeError(e.__str__())
+    return parameter_dict
+
+
+def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=False, raw_format=False):
     """
     Saves checkpoint info to a specified file.
 
@@ -153,16 +282,20 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=F
         ckpt_file_name (str): Checkpoint file name. If the file name already exists, it will be overwritten.
         integrated_save (bool): Whether to integrated save in automatic model parallel scene. Default: True
         async_save (bool): Whether asynchronous execution saves the checkpoint to a file. Default: False
+        raw_format (bool): Whether to save the tensors as an index followed by aligned raw data instead of protobuf.
+            The raw format is not limited to 2GB, is written in parallel straight from the tensor memory, and is
+            memory mapped by load_checkpoint. Default: False
 
     Raises:
-        TypeError: If the parameter save_obj is not nn.Cell or list type.And if the parameter integrated_save and
-                   async_save are not bool type.
+        TypeError: If the parameter save_obj is not nn.Cell or list type.And if the parameter integrated_save,
+                   async_save and raw_format are not bool type.
     """
 
     if not isinstance(save_obj, nn.Cell) and not isinstance(save_obj, list):
         raise TypeError("The parameter save_obj should be nn.Cell or list, but got {}".format(type(save_obj)))
     integrated_save = Validator.check_bool(integrated_save)
     async_save = Validator.check_bool(async_save)
+    raw_format = Validator.check_bool(raw_format)
 
     logger.info("Execute the process of saving checkpoint files.")
 
@@ -204,11 +337,12 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=F
             data = param["data"].asnumpy().reshape(-1)
             data_list[key].append(data)
 
+    exec_save = _exec_save_raw if raw_format else _exec_save
     if async_save:
-        thr = Thread(target=_exec_save, args=(ckpt_file_name, data_list), name="asyn_save_ckpt")
+        thr = Thread(target=exec_save, args=(ckpt_file_name, data_list), name="asyn_save_ckpt")
         thr.start()
     else:
-        _exec_save(ckpt_file_name, data_list)
+        exec_save(ckpt_file_name, data_list)
 
     logger.info("Saving checkpoint process is finished.")
 
@@ -270,6 +404,22 @@ def load_checkpoint(ckpt_file_name, net=None, strict_load=False, filter_prefix=N
                                 f"but got {str(type(prefix))} at index {index}.")
 
     logger.info("Execute the process of loading checkpoint files.")
+    if _is_raw_checkpoint(ckpt_file_name):
+        parameter_dict = _load_raw_checkpoint(ckpt_file_name, filter_prefix)
+    else:
+        parameter_dict = _load_proto_checkpoint(ckpt_file_name, filter_prefix)
+
+    if not parameter_dict:
+        raise ValueError(f"The loaded parameter dict is empty after filtering, please check filter_prefix.")
+
+    if net is not None:
+        load_param_into_net(net, parameter_dict, strict_load)
+
+    return parameter_dict
+
+
+def _load_proto_checkpoint(ckpt_file_name, filter_prefix):
+    """Load the parameters of a protobuf checkpoint file."""
     checkpoint_list = Checkpoint()
 
     try:
@@ -289,42 +439,20 @@ def load_checkpoint(ckpt_file_name, net=None, strict_load=False, filter_prefix=N
             data = element.tensor.tensor_content
             data_type = element.tensor.tensor_type
             np_type = tensor_to_np_type[data_type]
-            ms_type = tensor_to_ms_type[data_type]
             element_data = np.frombuffer(data, np_type)
             param_data_list.append(element_data)
             if (element_id == len(checkpoint_list.value) - 1) or \
                     (element.tag != checkpoint_list.value[element_id + 1].tag):
                 param_data = np.concatenate((param_data_list), axis=0)
                 param_data_list.clear()
-                dims = element.tensor.dims
-
-                if dims == [0]:
-                    if 'Float' in data_type:
-                        param_data = float(param_data[0])
-                    elif 'Int' in data_type:
-                        param_data = int(param_data[0])
-                    parameter_dict[element.tag] = Parameter(Tensor(param_data, ms_type), name=element.tag)
-                elif dims == [1]:
-                    parameter_dict[element.tag] = Parameter(Tensor(param_data, ms_type), name=element.tag)
-                else:
-                    param_dim = []
-                    for dim in dims:
-                        param_dim.append(dim)
-                    param_value = param_data.reshape(param_dim)
-                    parameter_dict[element.tag] = Parameter(Tensor(param_value, ms_type), name=element.tag)
+                parameter_dict[element.tag] = _make_parameter(element.tag, data_type, list(element.tensor.dims),
+                                                              param_data)
 
         logger.info("Loading checkpoint files process is finished.")
 
     except BaseException as e:
         logger.error("Failed to load the checkpoint file `%s`.", ckpt_file_name)
         raise RuntimeError(e.__str__())
-
-    if not parameter_dict:
-        raise ValueError(f"The loaded parameter dict is empty after filtering, please check filter_prefix.")
-
-    if net is not None:
-        load_param_into_net(net, parameter_dict, strict_load)
-
     return parameter_dict
 
 
@@ -1050,6 +1178,13 @@ def _merge_and_split(sliced_params, train_strategy, predict_strategy):
 def _load_single_param(ckpt_file_name, param_name):
     """Load a parameter from checkpoint."""
     logger.info("Execute the process of loading checkpoint files.")
+    if _is_raw_checkpoint(ckpt_file_name):
+        index, data = _read_raw_checkpoint_index(ckpt_file_name)
+        for entry in index.entry:
+            if entry.tag == param_name:
+                return _raw_entry_to_parameter(entry, data)
+        raise ValueError(f"There is no parameter named {param_name} in this checkpoint file {ckpt_file_name}, "
+                         f"please check parameter name or checkpoint file.")
     checkpoint_list = Checkpoint()
 
     try:
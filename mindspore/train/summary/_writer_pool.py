@@ -69,15 +69,20 @@ class WriterPool(ctx.Process):
         raise_exception (bool, optional): Sets whether to throw an exception when an RuntimeError exception occurs
             in recording data. Default: False, this means that error logs are printed and no exception is thrown.
         export_options (Union[None, dict]): Perform custom operations on the export data. Default: None.
+        max_pending_bytes (Optional[int]): The bytes of records allowed to wait for the writer thread of each file.
+            Default: None, use the default of the event writer.
+        drop_when_full (bool): Drop a record instead of waiting when `max_pending_bytes` is reached. Default: False.
         filedict (dict): The mapping from plugin to filename.
     """
 
-    def __init__(self, base_dir, max_file_size, raise_exception=False, **filedict) -> None:
+    def __init__(self, base_dir, max_file_size, raise_exception=False, max_pending_bytes=None, drop_when_full=False,
+                 **filedict) -> None:
         super().__init__()
         self._base_dir, self._filedict = base_dir, filedict
         self._queue, self._writers_ = ctx.Queue(ctx.cpu_count() * 2), None
         self._max_file_size = max_file_size
         self._raise_exception = raise_exception
+        self._max_pending_bytes, self._drop_when_full = max_pending_bytes, drop_when_full
         self.start()
 
     def run(self):
@@ -124,11 +129,14 @@ class WriterPool(ctx.Process):
         for plugin, filename in self._filedict.items():
             filepath = os.path.join(self._base_dir, filename)
             if plugin == WriterPluginEnum.SUMMARY.value:
-                self._writers_.append(SummaryWriter(filepath, self._max_file_size))
+                self._writers_.append(SummaryWriter(filepath, self._max_file_size, self._max_pending_bytes,
+                                                    self._drop_when_full))
             elif plugin == WriterPluginEnum.LINEAGE.value:
-                self._writers_.append(LineageWriter(filepath, self._max_file_size))
+                self._writers_.append(LineageWriter(filepath, self._max_file_size, self._max_pending_bytes,
+                                                    self._drop_when_full))
             elif plugin == WriterPluginEnum.EXPLAINER.value:
-                self._writers_.append(ExplainWriter(filepath, self._max_file_size))
+                self._writers_.append(ExplainWriter(filepath, self._max_file_size, self._max_pending_bytes,
+                                                    self._drop_when_full))
             elif plugin == WriterPluginEnum.EXPORTER.value:
                 self._writers_.append(ExportWriter(filepath, self._max_file_size))
         return self._writers_
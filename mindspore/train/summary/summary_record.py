@@ -114,6 +114,11 @@ class SummaryRecord:
             - tensor_format (Union[str, None]): Customize the export tensor format.
               Default: None, it means there is no export tensor.
 
+        max_pending_bytes (int, optional): The bytes of records allowed to wait for the background thread which writes
+            each file, 0 writes the records on the recording thread. Default: None, it means 64MB.
+        drop_when_full (bool, optional): Sets whether to drop a record instead of waiting when `max_pending_bytes`
+            is reached. Default: False, this means that recording waits for the pending records to be written.
+
     Raises:
         TypeError: If the parameter type is incorrect.
 
@@ -131,7 +136,8 @@ class SummaryRecord:
     """
 
     def __init__(self, log_dir, file_prefix="events", file_suffix="_MS",
-                 network=None, max_file_size=None, raise_exception=False, export_options=None):
+                 network=None, max_file_size=None, raise_exception=False, export_options=None,
+                 max_pending_bytes=None, drop_when_full=False):
 
         self._closed, self._event_writer = False, None
         self._mode, self._data_pool = 'train', defaultdict(list)
@@ -152,6 +158,12 @@ class SummaryRecord:
             max_file_size = None
 
         Validator.check_value_type(arg_name='raise_exception', arg_value=raise_exception, valid_types=bool)
+        Validator.check_value_type(arg_name='max_pending_bytes', arg_value=max_pending_bytes,
+                                   valid_types=[int, type(None)])
+        if max_pending_bytes is not None and max_pending_bytes < 0:
+            raise ValueError(f"The 'max_pending_bytes' should be greater than or equal to 0, "
+                             f"but got {max_pending_bytes}.")
+        Validator.check_value_type(arg_name='drop_when_full', arg_value=drop_when_full, valid_types=bool)
 
         self.prefix = file_prefix
         self.suffix = file_suffix
@@ -175,6 +187,8 @@ class SummaryRecord:
         self._event_writer = WriterPool(log_dir,
                                         max_file_size,
                                         raise_exception,
+                                        max_pending_bytes,
+                                        drop_when_full,
                                         **filename_dict)
         _get_summary_tensor_data()
         atexit.register(self.close)
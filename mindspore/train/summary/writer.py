@@ -31,10 +31,20 @@ FILE_MODE = 0o600
 
 
 class BaseWriter:
-    """BaseWriter to be subclass."""
-
-    def __init__(self, filepath, max_file_size=None) -> None:
+    """
+    BaseWriter to be subclass.
+
+    Args:
+        filepath (str): The file to write.
+        max_file_size (Optional[int]): The maximum size of the file in bytes.
+        max_pending_bytes (Optional[int]): The bytes of records allowed to wait for the background writer thread,
+            0 writes on the caller thread. Default: None, use the default of the event writer.
+        drop_when_full (bool): Drop a record instead of waiting when `max_pending_bytes` is reached. Default: False.
+    """
+
+    def __init__(self, filepath, max_file_size=None, max_pending_bytes=None, drop_when_full=False) -> None:
         self._filepath, self._max_file_size = filepath, max_file_size
+        self._max_pending_bytes, self._drop_when_full = max_pending_bytes, drop_when_full
         self._writer: EventWriter_ = None
 
     def init_writer(self):
@@ -48,7 +58,10 @@ class BaseWriter:
 
         with open(self._filepath, 'w'):
             os.chmod(self._filepath, stat.S_IWUSR | stat.S_IRUSR)
-        self._writer = EventWriter_(self._filepath)
+        if self._max_pending_bytes is None:
+            self._writer = EventWriter_(self._filepath)
+        else:
+            self._writer = EventWriter_(self._filepath, self._max_pending_bytes, self._drop_when_full)
         self.init_writer()
         return self._writer
 
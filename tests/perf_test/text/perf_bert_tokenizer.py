@@ -0,0 +1,73 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""test throughput of mindspore.dataset.text.BertTokenizer and WordpieceTokenizer + Lookup on a text corpus
+
+Usage: python perf_bert_tokenizer.py --corpus wiki.train.raw --vocab vocab.txt
+e.g. the raw WikiText-103 training split with the vocab of bert-base-uncased.
+"""
+import argparse
+import time
+
+import mindspore.dataset as ds
+import mindspore.dataset.text as text
+
+print_step = 100000
+
+
+def print_log(count):
+    if count % print_step == 0:
+        print("Tokenized {} lines ...".format(count))
+
+
+def run(data_set, name, corpus_bytes):
+    start = time.time()
+    num_iter = 0
+    num_tokens = 0
+    for item in data_set.create_tuple_iterator(num_epochs=1, output_numpy=True):
+        num_iter += 1
+        num_tokens += item[0].size
+        print_log(num_iter)
+    cost = time.time() - start
+    print("{} - total lines: {}, tokens: {}, cost time: {:.2f}s, {:.2f} MB/s, {:.0f} tokens/s".format(
+        name, num_iter, num_tokens, cost, corpus_bytes / cost / 1024 / 1024, num_tokens / cost))
+
+
+def use_bert_tokenizer(corpus, vocab, num_workers):
+    data_set = ds.TextFileDataset(corpus, shuffle=False)
+    tokenizer = text.BertTokenizer(vocab=vocab, lower_case=True)
+    data_set = data_set.map(operations=tokenizer, num_parallel_workers=num_workers)
+    return data_set
+
+
+def use_wordpiece_lookup(corpus, vocab, num_workers):
+    data_set = ds.TextFileDataset(corpus, shuffle=False)
+    ops = [text.WhitespaceTokenizer(), text.WordpieceTokenizer(vocab=vocab), text.Lookup(vocab, "[UNK]")]
+    data_set = data_set.map(operations=ops, num_parallel_workers=num_workers)
+    return data_set
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='tokenizer throughput')
+    parser.add_argument('--corpus', type=str, required=True, help='text corpus, one sentence per line')
+    parser.add_argument('--vocab', type=str, required=True, help='wordpiece vocab file, one token per line')
+    parser.add_argument('--num_workers', type=int, default=1, help='num_parallel_workers of map')
+    args = parser.parse_args()
+
+    with open(args.corpus, 'rb') as f:
+        total_bytes = sum(len(line) for line in f)
+    bert_vocab = text.Vocab.from_file(args.vocab)
+
+    run(use_bert_tokenizer(args.corpus, bert_vocab, args.num_workers), "BertTokenizer", total_bytes)
+    run(use_wordpiece_lookup(args.corpus, bert_vocab, args.num_workers), "WordpieceTokenizer + Lookup", total_bytes)
@@ -0,0 +1,65 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+import time
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.dataset as ds
+import mindspore.nn as nn
+from mindspore.ops import operations as P
+from mindspore.train import Model
+from mindspore.train.callback import Callback
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+
+class ReduceNet(nn.Cell):
+    def __init__(self):
+        super(ReduceNet, self).__init__()
+        self.reduce_sum = P.ReduceSum()
+
+    def construct(self, x):
+        return self.reduce_sum(x)
+
+
+class OutputRecorder(Callback):
+    def __init__(self):
+        super(OutputRecorder, self).__init__()
+        self.outputs = []
+
+    def step_end(self, run_context):
+        self.outputs.append(run_context.original_args().net_outputs.asnumpy())
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_train_twice_with_sink():
+    # the sum of row i is 2 * i
+    data = np.repeat(np.arange(4, dtype=np.float32).reshape(4, 1), 2, axis=1)
+    dataset = ds.NumpySlicesDataset({"x": data}, shuffle=False)
+    model = Model(ReduceNet())
+
+    for _ in range(2):
+        recorder = OutputRecorder()
+        start = time.time()
+        model.train(1, dataset, callbacks=[recorder], dataset_sink_mode=True, sink_size=2)
+        # each call takes rows 0 and 1 from a fresh queue, not the rows the last call left in it
+        assert len(recorder.outputs) == 1
+        assert np.allclose(recorder.outputs[0], 2.0)
+        # the queue is closed once the dataset is done, nothing waits out the timeout of the GetNext
+        assert time.time() - start < 30
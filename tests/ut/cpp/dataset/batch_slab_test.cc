@@ -0,0 +1,158 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/core/batch_slab.h"
+#include "minddata/dataset/core/client.h"
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/engine/datasetops/batch_op.h"
+#include "minddata/dataset/engine/datasetops/map_op/cpu_map_job.h"
+#include "minddata/dataset/kernels/image/normalize_hwc_to_chw_op.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestBatchSlab : public UT::Common {
+ public:
+  MindDataTestBatchSlab() {}
+
+  void SetUp() { GlobalInit(); }
+};
+
+// Rows allocated from their claimed slots are batched without a copy
+TEST_F(MindDataTestBatchSlab, TestBatchInPlace) {
+  auto pool = std::make_shared<BatchSlabPool>(4, 2);
+  std::unique_ptr<TensorQTable> src = std::make_unique<TensorQTable>();
+  for (int64_t row = 0; row < 4; row++) {
+    TensorSlot slot(pool, 0, row);
+    ASSERT_TRUE(slot.active());
+    std::shared_ptr<MemoryPool> region = slot.Claim(2 * 3 * sizeof(int32_t));
+    ASSERT_NE(region, nullptr);
+    // a slot is claimed once
+    EXPECT_EQ(slot.Claim(2 * 3 * sizeof(int32_t)), nullptr);
+    std::shared_ptr<Tensor> t;
+    ASSERT_OK(Tensor::CreateEmpty(TensorShape({2, 3}), DataType(DataType::DE_INT32), region, &t));
+    ASSERT_OK(t->Fill<int32_t>(static_cast<int32_t>(row)));
+    EXPECT_TRUE(slot.Holds(t->GetBuffer()));
+    pool->RecordHit(true);
+    src->push_back(TensorRow(row, {t}));
+  }
+  const unsigned char *first_row = src->front().at(0)->GetBuffer();
+
+  std::shared_ptr<BatchSlab> slab = pool->TakeSlab(0, 0);
+  ASSERT_NE(slab, nullptr);
+  EXPECT_EQ(pool->TakeSlab(0, 0), nullptr);
+  std::unique_ptr<TensorQTable> dest = std::make_unique<TensorQTable>();
+  ASSERT_OK(BatchOp::BatchRows(&src, &dest, 4, slab));
+  std::shared_ptr<Tensor> batch = dest->front().at(0);
+  EXPECT_EQ(batch->shape(), TensorShape({4, 2, 3}));
+  EXPECT_EQ(batch->GetBuffer(), first_row);
+  for (int64_t row = 0; row < 4; row++) {
+    int32_t value = 0;
+    ASSERT_OK(batch->GetItemAt<int32_t>(&value, {row, 1, 2}));
+    EXPECT_EQ(value, row);
+  }
+}
+
+// A row which was not written into its slot makes the batch op copy the rows
+TEST_F(MindDataTestBatchSlab, TestBatchFallback) {
+  auto pool = std::make_shared<BatchSlabPool>(2, 2);
+  std::unique_ptr<TensorQTable> src = std::make_unique<TensorQTable>();
+  for (int64_t row = 0; row < 2; row++) {
+    // only the first row is allocated from its slot
+    std::shared_ptr<Tensor> t;
+    if (row == 0) {
+      TensorSlot slot(pool, 0, row);
+      std::shared_ptr<MemoryPool> region = slot.Claim(3 * sizeof(float));
+      ASSERT_OK(Tensor::CreateEmpty(TensorShape({3}), DataType(DataType::DE_FLOAT32), region, &t));
+    } else {
+      ASSERT_OK(Tensor::CreateEmpty(TensorShape({3}), DataType(DataType::DE_FLOAT32), &t));
+    }
+    ASSERT_OK(t->Fill<float>(static_cast<float>(row)));
+    src->push_back(TensorRow(row, {t}));
+  }
+
+  std::unique_ptr<TensorQTable> dest = std::make_unique<TensorQTable>();
+  ASSERT_OK(BatchOp::BatchRows(&src, &dest, 2, pool->TakeSlab(0, 0)));
+  std::shared_ptr<Tensor> batch = dest->front().at(0);
+  EXPECT_EQ(batch->shape(), TensorShape({2, 3}));
+  float value = 0;
+  ASSERT_OK(batch->GetItemAt<float>(&value, {1, 2}));
+  EXPECT_EQ(value, 1.0);
+}
+
+// Slabs are turned off after outputs keep missing their slots
+TEST_F(MindDataTestBatchSlab, TestDisable) {
+  auto pool = std::make_shared<BatchSlabPool>(2, 2);
+  for (int32_t i = 0; i < 64; i++) {
+    EXPECT_TRUE(pool->enabled());
+    pool->RecordHit(false);
+  }
+  EXPECT_FALSE(pool->enabled());
+  TensorSlot slot(pool, 0, 0);
+  EXPECT_FALSE(slot.active());
+}
+
+// A slab keeps the slot size of the first row of its batch, a row of another size does not get a slot
+TEST_F(MindDataTestBatchSlab, TestClaimSlotSize) {
+  auto pool = std::make_shared<BatchSlabPool>(2, 2);
+  TensorSlot first(pool, 0, 0);
+  ASSERT_NE(first.Claim(12), nullptr);
+  TensorSlot second(pool, 0, 1);
+  EXPECT_EQ(second.Claim(16), nullptr);
+  TensorSlot inactive(nullptr, 0, 1);
+  EXPECT_EQ(inactive.Claim(12), nullptr);
+}
+
+// The last TensorOp of a map job writes only its output into the slots, the batch then takes the slab as it is
+TEST_F(MindDataTestBatchSlab, TestMapJobComputeInto) {
+  auto pool = std::make_shared<BatchSlabPool>(2, 2);
+  auto op = std::make_shared<NormalizeHwcToChwOp>(std::vector<float>{0, 0, 0}, std::vector<float>{1, 1, 1});
+  ASSERT_TRUE(op->CanComputeInto());
+  CpuMapJob job({op});
+  job.SetBatchSlab(pool, 0, 0);
+
+  std::vector<TensorRow> in;
+  for (int64_t row = 0; row < 2; row++) {
+    std::shared_ptr<Tensor> image;
+    ASSERT_OK(Tensor::CreateEmpty(TensorShape({2, 2, 3}), DataType(DataType::DE_UINT8), &image));
+    ASSERT_OK(image->Fill<uint8_t>(static_cast<uint8_t>(row + 1)));
+    in.push_back(TensorRow(row, {image}));
+  }
+  std::vector<TensorRow> out;
+  ASSERT_OK(job.Run(in, &out));
+  ASSERT_EQ(out.size(), 2);
+  EXPECT_EQ(out[0][0]->shape(), TensorShape({3, 2, 2}));
+
+  std::shared_ptr<BatchSlab> slab = pool->TakeSlab(0, 0);
+  ASSERT_NE(slab, nullptr);
+  EXPECT_EQ(slab->slot_size(), 3 * 2 * 2 * sizeof(float));
+  EXPECT_EQ(out[0][0]->GetBuffer(), slab->slot(0));
+  EXPECT_EQ(out[1][0]->GetBuffer(), slab->slot(1));
+
+  std::unique_ptr<TensorQTable> src = std::make_unique<TensorQTable>();
+  for (auto &row : out) {
+    src->push_back(row);
+  }
+  std::unique_ptr<TensorQTable> dest = std::make_unique<TensorQTable>();
+  ASSERT_OK(BatchOp::BatchRows(&src, &dest, 2, slab));
+  std::shared_ptr<Tensor> batch = dest->front().at(0);
+  EXPECT_EQ(batch->shape(), TensorShape({2, 3, 2, 2}));
+  EXPECT_EQ(batch->GetBuffer(), slab->slot(0));
+  float value = 0;
+  ASSERT_OK(batch->GetItemAt<float>(&value, {1, 2, 1, 1}));
+  EXPECT_EQ(value, 2.0);
+}
@@ -13,8 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "minddata/dataset/core/client.h"
@@ -120,3 +122,54 @@ TEST_F(MindDataTestCSVOp, TestTotalRows) {
   ASSERT_EQ(total_rows, 8);
   files.clear();
 }
+
+TEST_F(MindDataTestCSVOp, TestCSVShardSeek) {
+  // Enough rows for the last shard to start from an indexed row offset instead of the first row
+  std::string dataset_path = "csv_shard_seek_test.csv";
+  const int64_t num_rows = 10000;
+  {
+    std::ofstream ofs(dataset_path, std::ios::trunc);
+    for (int64_t i = 0; i < num_rows; i++) {
+      ofs << i << ",\"a," << i << "\"\r\n";
+    }
+  }
+
+  std::vector<std::shared_ptr<CsvOp::BaseRecord>> column_default_list;
+  column_default_list.push_back(std::make_shared<CsvOp::Record<int>>(CsvOp::INT, 0));
+  column_default_list.push_back(std::make_shared<CsvOp::Record<std::string>>(CsvOp::STRING, ""));
+  auto tree = std::make_shared<ExecutionTree>();
+  std::shared_ptr<CsvOp> op;
+  CsvOp::Builder builder;
+  builder.SetCsvFilesList({dataset_path})
+    .SetRowsPerBuffer(16)
+    .SetNumWorkers(1)
+    .SetShuffleFiles(false)
+    .SetNumDevices(3)
+    .SetDeviceId(2)
+    .SetFieldDelim(',')
+    .SetColumDefault(column_default_list)
+    .SetColumName({"col1", "col2"});
+  ASSERT_OK(builder.Build(&op));
+  ASSERT_OK(tree->AssociateNode(op));
+  ASSERT_OK(tree->AssignRoot(op));
+  ASSERT_OK(tree->Prepare());
+  ASSERT_OK(tree->Launch());
+
+  DatasetIterator di(tree);
+  TensorRow tensor_list;
+  ASSERT_OK(di.FetchNextTensorRow(&tensor_list));
+  // shards hold ceil(10000 / 3) rows, the last one starts at row 6668
+  int64_t expected = 6668;
+  while (!tensor_list.empty()) {
+    int32_t col1;
+    std::string_view col2;
+    ASSERT_OK(tensor_list[0]->GetItemAt(&col1, {}));
+    ASSERT_OK(tensor_list[1]->GetItemAt(&col2, {}));
+    ASSERT_EQ(col1, expected);
+    ASSERT_EQ(std::string(col2), "a," + std::to_string(expected));
+    expected++;
+    ASSERT_OK(di.FetchNextTensorRow(&tensor_list));
+  }
+  ASSERT_EQ(expected, num_rows);
+  remove(dataset_path.c_str());
+}
@@ -22,6 +22,7 @@
 #include "gtest/gtest.h"
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/engine/gnn/node.h"
+#include "minddata/dataset/engine/gnn/graph_csr.h"
 #include "minddata/dataset/engine/gnn/graph_data_impl.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
 
@@ -40,6 +41,57 @@ class MindDataTestGNNGraph : public UT::Common {
   MindDataTestGNNGraph() = default;
 };
 
+TEST_F(MindDataTestGNNGraph, TestGraphCsr) {
+  // node 10, 30 are of type 1, node 20, 40 are of type 2
+  std::vector<std::pair<NodeIdType, NodeType>> nodes = {{40, 2}, {10, 1}, {30, 1}, {20, 2}};
+  std::vector<std::pair<NodeIdType, NodeIdType>> edges = {{10, 40}, {10, 30}, {10, 20}, {30, 10}, {40, 10}};
+  GraphCsr csr;
+  Status s = csr.Build(nodes, edges);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(csr.NodeCount(), 4);
+
+  DenseIdType dense_id;
+  s = csr.GetDenseId(10, &dense_id);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(dense_id, 0);
+  EXPECT_EQ(csr.GetNodeId(dense_id), 10);
+  s = csr.GetDenseId(25, &dense_id);
+  EXPECT_TRUE(s.ToString().find("Invalid node id:25") != std::string::npos);
+
+  std::vector<NodeIdType> neighbors;
+  csr.GetDenseId(10, &dense_id);
+  // neighbors come in the order their edges were added, not in node id order
+  csr.GetAllNeighbors(dense_id, 2, false, &neighbors);
+  EXPECT_EQ(neighbors, std::vector<NodeIdType>({10, 40, 20}));
+  csr.GetAllNeighbors(dense_id, 1, true, &neighbors);
+  EXPECT_EQ(neighbors, std::vector<NodeIdType>({30}));
+  csr.GetDenseId(20, &dense_id);
+  csr.GetAllNeighbors(dense_id, 1, false, &neighbors);
+  EXPECT_EQ(neighbors, std::vector<NodeIdType>({20}));
+
+  // sampling more neighbors than exist goes over all of them before repeating any
+  std::mt19937 rnd(0);
+  std::vector<DenseIdType> scratch;
+  std::vector<DenseIdType> samples(5);
+  csr.GetDenseId(10, &dense_id);
+  csr.SampleNeighbors(dense_id, 2, 5, &rnd, &scratch, samples.data());
+  std::sort(samples.begin(), samples.begin() + 2);
+  EXPECT_EQ(csr.GetNodeId(samples[0]), 20);
+  EXPECT_EQ(csr.GetNodeId(samples[1]), 40);
+  csr.GetDenseId(20, &dense_id);
+  csr.SampleNeighbors(dense_id, 1, 5, &rnd, &scratch, samples.data());
+  EXPECT_EQ(samples, std::vector<DenseIdType>(5, kNoDenseId));
+
+  // node ids far apart are looked up without a direct table
+  s = csr.Build({{1, 1}, {1000000, 1}}, {{1, 1000000}});
+  EXPECT_TRUE(s.IsOk());
+  s = csr.GetDenseId(1000000, &dense_id);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(dense_id, 1);
+  s = csr.Build({{1, 1}, {1, 2}}, {});
+  EXPECT_TRUE(s.ToString().find("Duplicate node id:1") != std::string::npos);
+}
+
 TEST_F(MindDataTestGNNGraph, TestGetAllNeighbors) {
   std::string path = "data/mindrecord/testGraphData/testdata";
   GraphDataImpl graph(path, 1);
@@ -99,3 +99,36 @@ TEST_F(MindDataTestTensorOpFusionPass, RandomCropDecodeResizeEnabled) {
   // EXPECT_EQ(++func_it, tfuncs.end());
 }
 
+
+TEST_F(MindDataTestTensorOpFusionPass, NormalizeHwcToChwEnabled) {
+  MS_LOG(INFO) << "Doing MindDataTestTensorOpFusionPass-NormalizeHwcToChwEnabled";
+
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, SequentialSampler(0, 11));
+
+  // Create objects for the tensor ops
+  std::shared_ptr<TensorOperation> decode = vision::Decode();
+  std::shared_ptr<TensorOperation> rescale = vision::Rescale(1.0 / 255, 0.0);
+  std::shared_ptr<TensorOperation> normalize = vision::Normalize({0.485, 0.456, 0.406}, {0.229, 0.224, 0.225});
+  std::shared_ptr<TensorOperation> hwc2chw = vision::HWC2CHW();
+  std::shared_ptr<TensorOperation> type_cast = transforms::TypeCast("float16");
+  ds = ds->Map({decode, rescale, normalize, hwc2chw, type_cast}, {"image"});
+
+  std::shared_ptr<DatasetNode> node = ds->IRNode();
+  auto ir_tree = std::make_shared<TreeAdapter>();
+  // Enable IR optimization pass
+  ir_tree->SetOptimize(true);
+  Status rc;
+  rc = ir_tree->Compile(node);
+  EXPECT_TRUE(rc);
+  auto root_op = ir_tree->GetRoot();
+
+  auto tree = std::make_shared<ExecutionTree>();
+  auto it = tree->begin(static_cast<std::shared_ptr<DatasetOp>>(root_op));
+  ++it;
+  auto *map_op = &(*it);
+  auto tfuncs = static_cast<MapOp *>(map_op)->TFuncs();
+  ASSERT_EQ(tfuncs.size(), 2);
+  EXPECT_EQ(tfuncs[0]->Name(), kDecodeOp);
+  EXPECT_EQ(tfuncs[1]->Name(), kNormalizeHwcToChwOp);
+}
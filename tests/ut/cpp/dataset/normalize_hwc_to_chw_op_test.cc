@@ -0,0 +1,108 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/kernels/data/type_cast_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/rescale_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+class MindDataTestNormalizeHwcToChwOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestNormalizeHwcToChwOp() : CVOpCommon() {}
+
+  // Run Rescale, Normalize, HwcToChw one by one
+  void RunUnfused(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+    std::shared_ptr<Tensor> rescaled, normalized;
+    ASSERT_OK(RescaleOp(rescale_, shift_).Compute(input, &rescaled));
+    ASSERT_OK(NormalizeOp(mean_[0], mean_[1], mean_[2], std_[0], std_[1], std_[2]).Compute(rescaled, &normalized));
+    ASSERT_OK(HwcToChwOp().Compute(normalized, output));
+  }
+
+  float rescale_ = 1.0 / 255;
+  float shift_ = 0.0;
+  std::vector<float> mean_ = {0.485, 0.456, 0.406};
+  std::vector<float> std_ = {0.229, 0.224, 0.225};
+};
+
+TEST_F(MindDataTestNormalizeHwcToChwOp, TestImage) {
+  MS_LOG(INFO) << "Doing MindDataTestNormalizeHwcToChwOp-TestImage.";
+  std::shared_ptr<Tensor> expected, output;
+  RunUnfused(input_tensor_, &expected);
+  NormalizeHwcToChwOp op(mean_, std_, rescale_, shift_);
+  ASSERT_OK(op.Compute(input_tensor_, &output));
+  ASSERT_EQ(output->shape(), expected->shape());
+  ASSERT_EQ(output->type(), DataType(DataType::DE_FLOAT32));
+  auto expected_it = expected->begin<float>();
+  for (auto it = output->begin<float>(); it != output->end<float>(); ++it, ++expected_it) {
+    ASSERT_NEAR(*it, *expected_it, 1e-4);
+  }
+}
+
+TEST_F(MindDataTestNormalizeHwcToChwOp, TestBatchFloat16) {
+  MS_LOG(INFO) << "Doing MindDataTestNormalizeHwcToChwOp-TestBatchFloat16.";
+  // a batch of the image and its rescaled float copy
+  TensorShape shape = input_tensor_->shape();
+  std::shared_ptr<Tensor> batch;
+  ASSERT_OK(Tensor::CreateEmpty(shape.PrependDim(2), input_tensor_->type(), &batch));
+  ASSERT_OK(batch->InsertTensor({0}, input_tensor_));
+  ASSERT_OK(batch->InsertTensor({1}, input_tensor_));
+  std::shared_ptr<Tensor> expected;
+  RunUnfused(input_tensor_, &expected);
+
+  NormalizeHwcToChwOp op(mean_, std_, rescale_, shift_, DataType(DataType::DE_FLOAT16));
+  std::vector<TensorShape> out_shapes;
+  ASSERT_OK(op.OutputShape({batch->shape()}, out_shapes));
+  std::shared_ptr<Tensor> output;
+  ASSERT_OK(op.Compute(batch, &output));
+  ASSERT_EQ(output->shape(), out_shapes[0]);
+  ASSERT_EQ(output->shape(), expected->shape().PrependDim(2));
+  ASSERT_EQ(output->type(), DataType(DataType::DE_FLOAT16));
+  for (dsize_t n = 0; n < 2; n++) {
+    auto expected_it = expected->begin<float>();
+    for (dsize_t i = 0; i < expected->Size(); i++, ++expected_it) {
+      float16 value = *(output->begin<float16>() + (n * expected->Size() + i));
+      ASSERT_NEAR(static_cast<float>(value), *expected_it, 1e-2);
+    }
+  }
+}
+
+TEST_F(MindDataTestNormalizeHwcToChwOp, TestFloatInput) {
+  MS_LOG(INFO) << "Doing MindDataTestNormalizeHwcToChwOp-TestFloatInput.";
+  std::shared_ptr<Tensor> rescaled, expected, output;
+  ASSERT_OK(RescaleOp(rescale_, shift_).Compute(input_tensor_, &rescaled));
+  RunUnfused(input_tensor_, &expected);
+  ASSERT_OK(NormalizeHwcToChwOp(mean_, std_).Compute(rescaled, &output));
+  auto expected_it = expected->begin<float>();
+  for (auto it = output->begin<float>(); it != output->end<float>(); ++it, ++expected_it) {
+    ASSERT_NEAR(*it, *expected_it, 1e-4);
+  }
+}
+
+TEST_F(MindDataTestNormalizeHwcToChwOp, TestWrongShape) {
+  MS_LOG(INFO) << "Doing MindDataTestNormalizeHwcToChwOp-TestWrongShape.";
+  std::shared_ptr<Tensor> input, output;
+  ASSERT_OK(Tensor::CreateEmpty(TensorShape({4, 4, 4}), DataType(DataType::DE_UINT8), &input));
+  EXPECT_FALSE(NormalizeHwcToChwOp(mean_, std_).Compute(input, &output).IsOk());
+}
@@ -0,0 +1,121 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <set>
+#include <vector>
+#include "minddata/dataset/util/numa_placement.h"
+#include "common/common.h"
+#include "gtest/gtest.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestNumaPlacement : public UT::Common {
+ public:
+  MindDataTestNumaPlacement() {}
+
+  // Two nodes of 8 cpus each
+  std::vector<std::vector<int32_t>> node_cpus_ = {{0, 1, 2, 3, 4, 5, 6, 7}, {8, 9, 10, 11, 12, 13, 14, 15}};
+};
+
+TEST_F(MindDataTestNumaPlacement, TestParseCpuList) {
+  std::vector<int32_t> cpus;
+  ASSERT_TRUE(NumaPlacement::ParseCpuList("0-3,8,10-11\n", &cpus).IsOk());
+  ASSERT_EQ(cpus, std::vector<int32_t>({0, 1, 2, 3, 8, 10, 11}));
+  ASSERT_TRUE(NumaPlacement::ParseCpuList("5", &cpus).IsOk());
+  ASSERT_EQ(cpus, std::vector<int32_t>({5}));
+  ASSERT_TRUE(NumaPlacement::ParseCpuList("", &cpus).IsOk());
+  ASSERT_TRUE(cpus.empty());
+  ASSERT_TRUE(NumaPlacement::ParseCpuList("3-1", &cpus).IsError());
+  ASSERT_TRUE(NumaPlacement::ParseCpuList("a", &cpus).IsError());
+}
+
+TEST_F(MindDataTestNumaPlacement, TestLocal) {
+  NumaPlacement placement;
+  ASSERT_TRUE(placement.Init(node_cpus_, 3, 1, false).IsOk());
+  ASSERT_EQ(placement.home_node(), 1);
+  for (int32_t worker = 0; worker < 20; ++worker) {
+    ASSERT_EQ(placement.CpuOfWorker(worker, false), 8 + worker % 8);
+  }
+}
+
+TEST_F(MindDataTestNumaPlacement, TestSpread) {
+  NumaPlacement placement;
+  ASSERT_TRUE(placement.Init(node_cpus_, 1, 1, true).IsOk());
+  // Starts at the home node and alternates
+  ASSERT_EQ(placement.CpuOfWorker(0, false), 8);
+  ASSERT_EQ(placement.CpuOfWorker(1, false), 0);
+  ASSERT_EQ(placement.CpuOfWorker(2, false), 9);
+  ASSERT_EQ(placement.CpuOfWorker(3, false), 1);
+  // The workers near the consumer stay at home
+  ASSERT_EQ(placement.CpuOfWorker(1, true), 9);
+}
+
+TEST_F(MindDataTestNumaPlacement, TestSeveralOps) {
+  // The workers of a source, a map and a batch op on a node of 16 cpus each get a cpu of their own
+  NumaPlacement placement;
+  ASSERT_TRUE(placement.Init({{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}}, 0, 1, false).IsOk());
+  std::set<int32_t> used;
+  for (bool near_consumer : {false, false, true}) {
+    int32_t first = placement.ReserveWorkers(4);
+    for (int32_t worker = 0; worker < 4; ++worker) {
+      ASSERT_TRUE(used.insert(placement.CpuOfWorker(first + worker, near_consumer)).second);
+    }
+  }
+  ASSERT_EQ(used.size(), 12);
+
+  // Same with the workers spread over two nodes
+  ASSERT_TRUE(placement.Init(node_cpus_, 0, 1, true).IsOk());
+  used.clear();
+  for (int32_t op = 0; op < 3; ++op) {
+    int32_t first = placement.ReserveWorkers(4);
+    for (int32_t worker = 0; worker < 4; ++worker) {
+      ASSERT_TRUE(used.insert(placement.CpuOfWorker(first + worker, false)).second);
+    }
+  }
+  ASSERT_EQ(used.size(), 12);
+}
+
+TEST_F(MindDataTestNumaPlacement, TestTenants) {
+  // Ranks 0 to 3 on 2 nodes with 2 tenants per node, every rank gets 4 cpus of its own
+  std::set<int32_t> used;
+  for (int32_t rank = 0; rank < 4; ++rank) {
+    NumaPlacement placement;
+    ASSERT_TRUE(placement.Init(node_cpus_, rank, 2, false).IsOk());
+    ASSERT_EQ(placement.home_node(), rank % 2);
+    std::set<int32_t> mine;
+    for (int32_t worker = 0; worker < 8; ++worker) {
+      mine.insert(placement.CpuOfWorker(worker, false));
+    }
+    ASSERT_EQ(mine.size(), 4);
+    for (auto cpu : mine) {
+      ASSERT_TRUE(used.insert(cpu).second);
+    }
+  }
+  ASSERT_EQ(used.size(), 16);
+
+  // More tenants than cpus share them
+  NumaPlacement placement;
+  ASSERT_TRUE(placement.Init({{0, 1}}, 5, 4, false).IsOk());
+  ASSERT_EQ(placement.CpuOfWorker(0, false), 1);
+  ASSERT_TRUE(placement.Init({{0, 1}}, 0, 0, false).IsError());
+}
+
+TEST_F(MindDataTestNumaPlacement, TestEmptyNode) {
+  // Nodes without a cpu, e.g. memory only nodes, are skipped
+  NumaPlacement placement;
+  ASSERT_TRUE(placement.Init({{0, 1}, {}, {2, 3}}, 1, 1, false).IsOk());
+  ASSERT_EQ(placement.home_node(), 2);
+  ASSERT_TRUE(placement.Init({{}, {}}, 0, 1, false).IsError());
+}
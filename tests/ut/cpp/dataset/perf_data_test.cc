@@ -18,6 +18,7 @@
 #include "gtest/gtest.h"
 #include "securec.h"
 #include "minddata/dataset/engine/perf/cyclic_array.h"
+#include "minddata/dataset/engine/perf/event_ring.h"
 #include "minddata/dataset/engine/perf/perf_data.h"
 
 using namespace mindspore::dataset;
@@ -73,4 +74,36 @@ TEST_F(MindDataTestPerfData, Test2) {
   EXPECT_EQ(pd[0][1], 4);
   EXPECT_EQ(pd[1][1], 5);
   EXPECT_EQ(pd[2][1], 6);
-}
\ No newline at end of file
+}
+
+TEST_F(MindDataTestPerfData, TestOpEventRing) {
+  OpEventRing ring(3, 4, 1, 3);
+  EXPECT_EQ(ring.op_id(), 3);
+  EXPECT_EQ(ring.consumer_id(), 4);
+  EXPECT_EQ(ring.worker_id(), 1);
+
+  // first pop has no busy time, later ones are busy since the end of the previous wait
+  ring.Record(100, 110, 32, 2);
+  ring.Record(150, 151, 32, 1);
+  std::vector<OpEvent> events;
+  EXPECT_EQ(ring.Drain(&events), 2);
+  EXPECT_EQ(events[0].timestamp_us, 110);
+  EXPECT_EQ(events[0].wait_us, 10);
+  EXPECT_EQ(events[0].busy_us, 0);
+  EXPECT_EQ(events[0].rows, 32);
+  EXPECT_EQ(events[0].queue_depth, 2);
+  EXPECT_EQ(events[1].wait_us, 1);
+  EXPECT_EQ(events[1].busy_us, 40);
+  EXPECT_EQ(events[1].queue_depth, 1);
+
+  // capacity is rounded up to 4, the rest is dropped until drained
+  for (int i = 0; i < 6; i++) {
+    ring.Record(200 + i, 200 + i, 1, 0);
+  }
+  EXPECT_EQ(ring.TakeDropped(), 2);
+  EXPECT_EQ(ring.TakeDropped(), 0);
+  events.clear();
+  EXPECT_EQ(ring.Drain(&events), 4);
+  EXPECT_EQ(events[3].timestamp_us, 203);
+  EXPECT_EQ(ring.Drain(&events), 0);
+}
@@ -333,3 +333,57 @@ TEST_F(MindDataTestShuffleOp, TestRepeatShuffle) {
   }
   ASSERT_EQ(row_count, 20);
 }
+
+// Shuffle in blocks of 2 rows with the rows packed into a pool. Every row still comes out exactly once.
+TEST_F(MindDataTestShuffleOp, TestShuffleBlockPool) {
+  Status rc;
+  MS_LOG(INFO) << "UT test TestShuffleBlockPool.";
+
+  auto my_tree = std::make_shared<ExecutionTree>();
+
+  std::string dataset_path;
+  dataset_path = datasets_root_path_ + "/testDataset1/testDataset1.data";
+  std::shared_ptr<TFReaderOp> my_tfreader_op;
+  rc = TFReaderOp::Builder()
+      .SetDatasetFilesList({dataset_path})
+      .SetRowsPerBuffer(2)
+      .SetWorkerConnectorSize(16)
+      .SetNumWorkers(1)
+      .Build(&my_tfreader_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_tfreader_op);
+  EXPECT_TRUE(rc.IsOk());
+  std::shared_ptr<ShuffleOp> my_shuffle_op;
+  rc = ShuffleOp::Builder()
+         .SetShuffleSize(6)
+         .SetShuffleBlockSize(2)
+         .SetRowPoolSize(1)
+         .SetShuffleSeed(100)
+         .SetRowsPerBuffer(3)
+         .Build(&my_shuffle_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_shuffle_op);
+  EXPECT_TRUE(rc.IsOk());
+
+  rc = my_shuffle_op->AddChild(my_tfreader_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssignRoot(my_shuffle_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Launch();
+  EXPECT_TRUE(rc.IsOk());
+
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  EXPECT_TRUE(rc.IsOk());
+
+  int row_count = 0;
+  while (!tensor_list.empty()) {
+    rc = di.FetchNextTensorRow(&tensor_list);
+    EXPECT_TRUE(rc.IsOk());
+    row_count++;
+  }
+  ASSERT_EQ(row_count, 10);
+}
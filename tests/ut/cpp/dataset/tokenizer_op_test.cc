@@ -26,6 +26,8 @@
 #include "minddata/dataset/text/kernels/unicode_char_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/unicode_script_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/whitespace_tokenizer_op.h"
+#include "minddata/dataset/text/kernels/wordpiece_tokenizer_op.h"
+#include "minddata/dataset/text/vocab.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
 
@@ -358,4 +360,68 @@ std::shared_ptr<Tensor> input;
   TensorRow output;
   Status s = basic_tokenizer->Compute(TensorRow(0, {input}), &output);
   EXPECT_TRUE(s.IsOk());
-}
\ No newline at end of file
+}
+
+TEST_F(MindDataTestTokenizerOp, TestVocabTrie) {
+  MS_LOG(INFO) << "Doing TestVocabTrie.";
+  std::vector<std::string> words = {"favor", "fav", "##ite", "中国", "中"};
+  std::shared_ptr<Vocab> vocab;
+  Status s = Vocab::BuildFromVector(words, {"[UNK]"}, true, &vocab);
+  EXPECT_TRUE(s.IsOk());
+  std::shared_ptr<const VocabTrie> trie = vocab->GetTrie();
+  for (const auto &word : words) {
+    EXPECT_EQ(trie->Lookup(word), vocab->Lookup(word));
+  }
+  EXPECT_EQ(trie->Lookup("[UNK]"), 0);
+  EXPECT_EQ(trie->Lookup("fa"), Vocab::kNoTokenExists);
+  EXPECT_EQ(trie->Lookup("favorite"), Vocab::kNoTokenExists);
+  EXPECT_EQ(trie->Lookup(""), Vocab::kNoTokenExists);
+
+  // appending a word must not be missed by later lookups
+  vocab->append_word("fa");
+  EXPECT_EQ(vocab->GetTrie()->Lookup("fa"), vocab->Lookup("fa"));
+  EXPECT_EQ(trie->Lookup("fa"), Vocab::kNoTokenExists);
+}
+
+TEST_F(MindDataTestTokenizerOp, TestWordpieceTokenizer) {
+  MS_LOG(INFO) << "Doing TestWordpieceTokenizer.";
+  std::vector<std::string> words = {"favor", "fav", "##ite", "##orite", "中", "##国"};
+  std::shared_ptr<Vocab> vocab;
+  Status s = Vocab::BuildFromVector(words, {}, true, &vocab);
+  EXPECT_TRUE(s.IsOk());
+  std::unique_ptr<WordpieceTokenizerOp> op(new WordpieceTokenizerOp(vocab, "##", 100, "[UNK]", true));
+  std::shared_ptr<Tensor> input;
+  Tensor::CreateFromVector(std::vector<std::string>{"favorite", "中国", "xyz"}, &input);
+  TensorRow output;
+  s = op->Compute(TensorRow(0, {input}), &output);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(output.size(), 3);
+  EXPECT_EQ(output[0]->Size(), 5);
+  MS_LOG(INFO) << "Out tensor: " << output[0]->ToString();
+  CheckEqual(output[0], {0}, "favor");
+  CheckEqual(output[0], {1}, "##ite");
+  CheckEqual(output[0], {2}, "中");
+  CheckEqual(output[0], {3}, "##国");
+  CheckEqual(output[0], {4}, "[UNK]");
+  uint32_t offset = 0;
+  EXPECT_TRUE(output[1]->GetItemAt<uint32_t>(&offset, {1}).IsOk());
+  EXPECT_EQ(offset, 5);
+  EXPECT_TRUE(output[2]->GetItemAt<uint32_t>(&offset, {3}).IsOk());
+  EXPECT_EQ(offset, 6);
+}
+
+TEST_F(MindDataTestTokenizerOp, TestWordpieceTokenizerInvalidUtf8) {
+  MS_LOG(INFO) << "Doing TestWordpieceTokenizerInvalidUtf8.";
+  std::vector<std::string> words = {"fav", "##orite"};
+  std::shared_ptr<Vocab> vocab;
+  Status s = Vocab::BuildFromVector(words, {}, true, &vocab);
+  EXPECT_TRUE(s.IsOk());
+  std::unique_ptr<WordpieceTokenizerOp> op(new WordpieceTokenizerOp(vocab, "##", 100, "[UNK]", false));
+  // a truncated multi-byte character after a prefix found in the vocab
+  std::shared_ptr<Tensor> input;
+  Tensor::CreateFromVector(std::vector<std::string>{"fav\xe4\xb8"}, &input);
+  TensorRow output;
+  s = op->Compute(TensorRow(0, {input}), &output);
+  EXPECT_FALSE(s.IsOk());
+  EXPECT_NE(s.ToString().find("Decode utf8 string failed."), std::string::npos);
+}
@@ -0,0 +1,120 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/device/cpu/cpu_data_queue.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestCPUDataQueue : public UT::Common {
+ public:
+  TestCPUDataQueue() = default;
+  virtual ~TestCPUDataQueue() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+
+  static DataBatch Batch(int value) {
+    auto data = std::make_shared<std::vector<int>>(4, value);
+    DataBatch batch;
+    batch.items_.push_back({data->data(), data->size() * sizeof(int)});
+    batch.holder_ = data;
+    return batch;
+  }
+};
+
+TEST_F(TestCPUDataQueue, PushPopInOrder) {
+  CPUDataQueue queue(2);
+  EXPECT_EQ(queue.Push(Batch(1), 0), DataQueueStatus::kSuccess);
+  EXPECT_EQ(queue.Push(Batch(2), 0), DataQueueStatus::kSuccess);
+  // full
+  EXPECT_EQ(queue.Push(Batch(3), 1), DataQueueStatus::kTimeout);
+  EXPECT_EQ(queue.Size(), 2);
+
+  DataBatch batch;
+  EXPECT_EQ(queue.Pop(&batch, 0), DataQueueStatus::kSuccess);
+  EXPECT_EQ(*static_cast<int *>(batch.items_[0].data_ptr_), 1);
+  EXPECT_EQ(queue.Push(Batch(3), 0), DataQueueStatus::kSuccess);
+  EXPECT_EQ(queue.Pop(&batch, 0), DataQueueStatus::kSuccess);
+  EXPECT_EQ(*static_cast<int *>(batch.items_[0].data_ptr_), 2);
+  EXPECT_EQ(queue.Pop(&batch, 0), DataQueueStatus::kSuccess);
+  EXPECT_EQ(*static_cast<int *>(batch.items_[0].data_ptr_), 3);
+  EXPECT_EQ(queue.Pop(&batch, 0), DataQueueStatus::kTimeout);
+}
+
+TEST_F(TestCPUDataQueue, ProducerConsumer) {
+  CPUDataQueue queue(2);
+  const int batch_num = 100;
+  std::thread producer([&queue]() {
+    for (int i = 0; i < batch_num; i++) {
+      while (queue.Push(Batch(i), 10) == DataQueueStatus::kTimeout) {
+      }
+    }
+  });
+  for (int i = 0; i < batch_num; i++) {
+    DataBatch batch;
+    EXPECT_EQ(queue.Pop(&batch, 10), DataQueueStatus::kSuccess);
+    EXPECT_EQ(batch.items_[0].data_len_, 4 * sizeof(int));
+    EXPECT_EQ(*static_cast<int *>(batch.items_[0].data_ptr_), i);
+  }
+  producer.join();
+}
+
+TEST_F(TestCPUDataQueue, Close) {
+  CPUDataQueue queue(1);
+  EXPECT_EQ(queue.Push(Batch(1), 0), DataQueueStatus::kSuccess);
+  std::thread closer([&queue]() { queue.Close(); });
+  // wakes up once the queue is closed
+  EXPECT_EQ(queue.Push(Batch(2), 10000), DataQueueStatus::kClosed);
+  closer.join();
+  // the batches left are still read
+  DataBatch batch;
+  EXPECT_EQ(queue.Pop(&batch, 0), DataQueueStatus::kSuccess);
+  EXPECT_EQ(queue.Pop(&batch, 0), DataQueueStatus::kClosed);
+}
+
+TEST_F(TestCPUDataQueue, Manager) {
+  auto &mgr = CPUDataQueueMgr::GetInstance();
+  EXPECT_EQ(mgr.Get("test_channel"), nullptr);
+  auto queue = mgr.Create("test_channel", 3);
+  EXPECT_EQ(queue->Capacity(), 3);
+  EXPECT_EQ(mgr.Create("test_channel", 5), queue);
+  EXPECT_EQ(mgr.Get("test_channel"), queue);
+  mgr.Destroy("test_channel");
+  EXPECT_TRUE(queue->IsClosed());
+  EXPECT_EQ(mgr.Get("test_channel"), nullptr);
+}
+
+TEST_F(TestCPUDataQueue, ManagerReplacesClosedQueue) {
+  auto &mgr = CPUDataQueueMgr::GetInstance();
+  auto queue = mgr.Create("test_channel", 2);
+  EXPECT_EQ(queue->Push(Batch(1), 0), DataQueueStatus::kSuccess);
+  // the last send closed the queue with a batch left
+  queue->Close();
+  auto new_queue = mgr.Create("test_channel", 2);
+  EXPECT_NE(new_queue, queue);
+  EXPECT_FALSE(new_queue->IsClosed());
+  EXPECT_EQ(new_queue->Size(), 0);
+  EXPECT_EQ(mgr.Get("test_channel"), new_queue);
+  mgr.Destroy("test_channel");
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,129 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "backend/session/kernel_graph.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "runtime/device/cpu/cpu_device_address.h"
+#define private public
+#define protected public
+#include "runtime/device/cpu/cpu_memory_manager.h"
+#include "runtime/device/cpu/cpu_kernel_runtime.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr size_t kElementNum = 4;
+constexpr size_t kDataSize = kElementNum * sizeof(float);
+
+// Returns its own buffer as output, like the GetNext returns the batch of the dataset
+class FakeSourceCPUKernel : public kernel::CPUKernel {
+ public:
+  FakeSourceCPUKernel() { output_size_list_ = {kDataSize}; }
+  ~FakeSourceCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &) override {}
+
+  bool Launch(const std::vector<kernel::AddressPtr> &, const std::vector<kernel::AddressPtr> &,
+              const std::vector<kernel::AddressPtr> &) override {
+    ++step_;
+    for (size_t i = 0; i < kElementNum; ++i) {
+      data_[i] = static_cast<float>(step_ * 10 + i);
+    }
+    return true;
+  }
+
+  std::vector<void *> OutputBuffers() const override { return {const_cast<float *>(data_.data())}; }
+
+  std::vector<float> data_ = std::vector<float>(kElementNum);
+  size_t step_{0};
+};
+
+class FakeCopyCPUKernel : public kernel::CPUKernel {
+ public:
+  FakeCopyCPUKernel() {
+    input_size_list_ = {kDataSize};
+    output_size_list_ = {kDataSize};
+  }
+  ~FakeCopyCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &) override {}
+
+  bool Launch(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &,
+              const std::vector<kernel::AddressPtr> &outputs) override {
+    return memcpy_s(outputs[0]->addr, outputs[0]->size, inputs[0]->addr, inputs[0]->size) == EOK;
+  }
+};
+}  // namespace
+
+class TestCPUKernelRuntime : public UT::Common {
+ public:
+  TestCPUKernelRuntime() = default;
+  virtual ~TestCPUKernelRuntime() = default;
+
+  void SetUp() override {
+    graph_ = std::make_shared<session::KernelGraph>();
+    source_ = std::make_shared<FakeSourceCPUKernel>();
+    auto source = NewKernel({NewValueNode(std::make_shared<Primitive>("FakeSource"))}, source_);
+    copy_ = NewKernel({NewValueNode(std::make_shared<Primitive>("FakeCopy")), source},
+                      std::make_shared<FakeCopyCPUKernel>());
+    graph_->set_output(copy_);
+    graph_->set_execution_order({source, copy_});
+  }
+
+  CNodePtr NewKernel(const std::vector<AnfNodePtr> &inputs, const kernel::KernelModPtr &kernel_mod) {
+    auto node = graph_->NewCNode(inputs);
+    node->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{kElementNum}));
+    AnfAlgo::SetKernelMod(kernel_mod, node.get());
+    AnfAlgo::SetOutputAddr(std::make_shared<CPUDeviceAddress>(nullptr, kDataSize), 0, node.get());
+    return node;
+  }
+
+  std::shared_ptr<session::KernelGraph> graph_;
+  std::shared_ptr<FakeSourceCPUKernel> source_;
+  CNodePtr copy_;
+};
+
+TEST_F(TestCPUKernelRuntime, KernelOutputBuffersWithDynamicMemory) {
+  CPUKernelRuntime runtime;
+  ASSERT_TRUE(runtime.Init());
+  auto mem_manager = static_cast<CPUMemoryManager *>(runtime.mem_manager_.get());
+  mem_manager->dynamic_malloc_ = true;
+
+  size_t allocated = 0;
+  for (size_t step = 1; step <= 5; ++step) {
+    ASSERT_TRUE(runtime.Run(graph_.get(), false));
+    auto output = static_cast<float *>(AnfAlgo::GetOutputAddr(copy_, 0)->GetMutablePtr());
+    for (size_t i = 0; i < kElementNum; ++i) {
+      EXPECT_EQ(output[i], static_cast<float>(step * 10 + i));
+    }
+    // the memory allocated for the source output each step is freed once the buffer of the kernel is used instead
+    if (step == 1) {
+      allocated = mem_manager->static_mem_.size();
+    }
+    EXPECT_EQ(mem_manager->static_mem_.size(), allocated);
+    EXPECT_TRUE(runtime.swapped_addresses_.empty());
+  }
+  EXPECT_EQ(source_->step_, 5);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
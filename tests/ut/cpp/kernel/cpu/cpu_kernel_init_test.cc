@@ -0,0 +1,137 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/session/kernel_graph.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// Init only records when and where it ran, and fails for the kernels asked to
+class FakeCPUKernel : public CPUKernel {
+ public:
+  FakeCPUKernel(size_t id, bool fail, std::atomic<size_t> *init_count)
+      : id_(id), fail_(fail), init_count_(init_count) {}
+  ~FakeCPUKernel() override = default;
+
+  void Init(const CNodePtr &kernel_node) override {
+    thread_id_ = std::this_thread::get_id();
+    init_seq_ = (*init_count_)++;
+    InitKernel(kernel_node);
+  }
+
+  void InitKernel(const CNodePtr &) override {
+    if (fail_) {
+      MS_LOG(EXCEPTION) << "Init of fake kernel " << id_ << " failed";
+    }
+  }
+
+  bool Launch(const std::vector<AddressPtr> &, const std::vector<AddressPtr> &,
+              const std::vector<AddressPtr> &) override {
+    return true;
+  }
+
+  size_t id_;
+  bool fail_;
+  std::atomic<size_t> *init_count_;
+  std::thread::id thread_id_;
+  size_t init_seq_{0};
+};
+}  // namespace
+
+class CPUKernelInitTest : public UT::Common {
+ public:
+  CPUKernelInitTest() = default;
+
+  void SetUp() override {
+    graph_ = std::make_shared<session::KernelGraph>();
+    init_count_ = 0;
+    nodes_.clear();
+    fakes_.clear();
+  }
+
+  void AddKernel(const std::string &name, bool fail = false) {
+    nodes_.push_back(graph_->NewCNode({NewValueNode(std::make_shared<Primitive>(name))}));
+    fakes_.push_back(std::make_shared<FakeCPUKernel>(fakes_.size(), fail, &init_count_));
+  }
+
+  std::vector<std::shared_ptr<CPUKernel>> Kernels() const {
+    return std::vector<std::shared_ptr<CPUKernel>>(fakes_.begin(), fakes_.end());
+  }
+
+  std::shared_ptr<session::KernelGraph> graph_;
+  std::atomic<size_t> init_count_{0};
+  std::vector<CNodePtr> nodes_;
+  std::vector<std::shared_ptr<FakeCPUKernel>> fakes_;
+};
+
+TEST_F(CPUKernelInitTest, TestInitAll) {
+  for (size_t i = 0; i < 64; ++i) {
+    AddKernel("Fake");
+  }
+  CPUKernelUtils::InitKernels(nodes_, Kernels());
+  EXPECT_EQ(init_count_, 64);
+}
+
+TEST_F(CPUKernelInitTest, TestFirstErrorRaised) {
+  for (size_t i = 0; i < 64; ++i) {
+    AddKernel("Fake", i == 10 || i == 37);
+  }
+  std::string error;
+  try {
+    CPUKernelUtils::InitKernels(nodes_, Kernels());
+  } catch (std::runtime_error &e) {
+    error = e.what();
+  }
+  // the error of the first failed kernel in node order is raised, after every kernel ran its Init
+  EXPECT_NE(error.find("Init of fake kernel 10 failed"), std::string::npos);
+  EXPECT_EQ(error.find("Init of fake kernel 37 failed"), std::string::npos);
+  EXPECT_EQ(init_count_, 64);
+}
+
+TEST_F(CPUKernelInitTest, TestSerialKernels) {
+  for (size_t i = 0; i < 32; ++i) {
+    AddKernel(i % 8 == 0 ? "Push" : (i % 8 == 4 ? "Pull" : "Fake"));
+  }
+  AddKernel("EmbeddingLookupProxy");
+  CPUKernelUtils::InitKernels(nodes_, Kernels());
+  EXPECT_EQ(init_count_, 33);
+  // the parameter server kernels are initialized on the calling thread, in node order, before the others
+  std::vector<size_t> serial_seqs;
+  for (size_t i = 0; i < fakes_.size(); ++i) {
+    if (AnfAlgo::GetCNodeName(nodes_[i]) != "Fake") {
+      EXPECT_EQ(fakes_[i]->thread_id_, std::this_thread::get_id());
+      serial_seqs.push_back(fakes_[i]->init_seq_);
+    }
+  }
+  EXPECT_EQ(serial_seqs, std::vector<size_t>({0, 1, 2, 3, 4, 5, 6, 7, 8}));
+}
+
+TEST_F(CPUKernelInitTest, TestSizeMismatch) {
+  AddKernel("Fake");
+  AddKernel("Fake");
+  auto kernels = Kernels();
+  kernels.pop_back();
+  EXPECT_THROW(CPUKernelUtils::InitKernels(nodes_, kernels), std::runtime_error);
+  EXPECT_EQ(init_count_, 0);
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,139 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_CPU
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/session/kernel_graph.h"
+#include "runtime/device/kernel_info.h"
+#include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/mkldnn/softmax_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+using KernelBuildInfoBuilder = KernelBuildInfo::KernelBuildInfoBuilder;
+
+class MKLPrimitiveCacheTest : public UT::Common {
+ public:
+  MKLPrimitiveCacheTest() = default;
+
+  void SetUp() override {
+    graph_ = std::make_shared<session::KernelGraph>();
+    create_count_ = 0;
+  }
+
+  // A softmax primitive over a {rows, cols} float matrix, counted in create_count_
+  std::shared_ptr<dnnl::primitive> CreateSoftmax(int64_t rows, int64_t cols) {
+    ++create_count_;
+    dnnl::memory::desc src_desc({rows, cols}, dnnl::memory::data_type::f32, dnnl::memory::format_tag::ab);
+    dnnl::softmax_forward::desc desc(dnnl::prop_kind::forward_training, src_desc, 1);
+    auto prim_desc = dnnl::softmax_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
+    return std::make_shared<dnnl::softmax_forward>(prim_desc);
+  }
+
+  CNodePtr CreateSoftmaxNode(const std::vector<int64_t> &shape, int64_t axis) {
+    auto prim = std::make_shared<Primitive>("Softmax");
+    prim->AddAttr(AXIS, MakeValue(std::vector<int64_t>{axis}));
+    auto abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shape);
+    auto x = graph_->NewParameter();
+    x->set_abstract(abstract);
+    auto node = graph_->NewCNode({NewValueNode(prim), x});
+    node->set_abstract(abstract);
+    node->set_kernel_info(std::make_shared<device::KernelInfo>());
+    KernelBuildInfoBuilder builder;
+    builder.SetInputsFormat({kOpFormat_DEFAULT});
+    builder.SetInputsDeviceType({kNumberTypeFloat32});
+    builder.SetOutputsFormat({kOpFormat_DEFAULT});
+    builder.SetOutputsDeviceType({kNumberTypeFloat32});
+    AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), node.get());
+    return node;
+  }
+
+  std::shared_ptr<SoftmaxCPUKernel> InitSoftmax(const std::vector<int64_t> &shape, int64_t axis) {
+    auto kernel = std::make_shared<SoftmaxCPUKernel>();
+    kernel->Init(CreateSoftmaxNode(shape, axis));
+    return kernel;
+  }
+
+  std::shared_ptr<session::KernelGraph> graph_;
+  int create_count_{0};
+};
+
+TEST_F(MKLPrimitiveCacheTest, TestGetPrimitive) {
+  auto &engine = MKLKernelEngine::Get();
+  auto first = engine.GetPrimitive("MKLPrimitiveCacheTest.GetPrimitive 3x5", [this]() { return CreateSoftmax(3, 5); });
+  auto hit = engine.GetPrimitive("MKLPrimitiveCacheTest.GetPrimitive 3x5", [this]() { return CreateSoftmax(3, 5); });
+  EXPECT_EQ(first, hit);
+  EXPECT_EQ(create_count_, 1);
+  auto miss = engine.GetPrimitive("MKLPrimitiveCacheTest.GetPrimitive 5x3", [this]() { return CreateSoftmax(5, 3); });
+  EXPECT_NE(first, miss);
+  EXPECT_EQ(create_count_, 2);
+}
+
+TEST_F(MKLPrimitiveCacheTest, TestCreatorFails) {
+  auto &engine = MKLKernelEngine::Get();
+  const std::string key = "MKLPrimitiveCacheTest.CreatorFails";
+  auto failing = []() -> std::shared_ptr<dnnl::primitive> { throw std::invalid_argument("bad desc"); };
+  EXPECT_THROW(engine.GetPrimitive(key, failing), std::invalid_argument);
+  EXPECT_THROW(engine.GetPrimitive(key, []() { return std::shared_ptr<dnnl::primitive>(nullptr); }),
+               std::runtime_error);
+  // nothing is cached for a failed creation
+  auto primitive = engine.GetPrimitive(key, [this]() { return CreateSoftmax(2, 2); });
+  EXPECT_NE(primitive, nullptr);
+  EXPECT_EQ(create_count_, 1);
+}
+
+TEST_F(MKLPrimitiveCacheTest, TestSoftmaxKernels) {
+  auto softmax = InitSoftmax({6, 10}, -1);
+  // same op type, attributes and shapes share the primitive
+  auto same = InitSoftmax({6, 10}, -1);
+  EXPECT_EQ(softmax->primitive_, same->primitive_);
+  // other attributes or shapes do not
+  auto other_axis = InitSoftmax({6, 10}, 0);
+  EXPECT_NE(softmax->primitive_, other_axis->primitive_);
+  auto other_shape = InitSoftmax({10, 6}, -1);
+  EXPECT_NE(softmax->primitive_, other_shape->primitive_);
+  EXPECT_NE(other_axis->primitive_, other_shape->primitive_);
+
+  // a kernel with a shared primitive computes on its own arguments
+  std::vector<float> x(60);
+  for (size_t i = 0; i < x.size(); ++i) {
+    x[i] = static_cast<float>(i % 7);
+  }
+  std::vector<float> y(60, 0);
+  std::vector<float> y_same(60, 0);
+  auto input = std::make_shared<Address>(x.data(), x.size() * sizeof(float));
+  softmax->Launch({input}, {}, {std::make_shared<Address>(y.data(), y.size() * sizeof(float))});
+  same->Launch({input}, {}, {std::make_shared<Address>(y_same.data(), y_same.size() * sizeof(float))});
+  EXPECT_EQ(y, y_same);
+  for (size_t row = 0; row < 6; ++row) {
+    float sum = 0;
+    for (size_t col = 0; col < 10; ++col) {
+      sum += y[row * 10 + col];
+    }
+    EXPECT_LT(std::fabs(sum - 1.0f), 1e-5);
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
+#endif
@@ -32,7 +32,9 @@
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
 #include "minddata/mindrecord/include/shard_index.h"
+#include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_statistics.h"
+#include "minddata/mindrecord/include/shard_writer.h"
 #include "securec.h"
 #include "ut_common.h"
 
@@ -81,5 +83,84 @@ TEST_F(TestShardIndexGenerator, TakeFieldType) {
   auto type5 = ShardIndexGenerator::TakeFieldType("label", schema2);
   ASSERT_EQ("array", type5);
 }
+
+TEST_F(TestShardIndexGenerator, WriteRowsInBatches) {
+  MS_LOG(INFO) << FormatInfo("Test ShardIndexGenerator: write the index rows in batches");
+
+  mindrecord::ShardHeader header_data;
+  json schema_json = R"({"file_name": {"type": "string"}, "label": {"type": "int32"}})"_json;
+  std::shared_ptr<mindrecord::Schema> schema = mindrecord::Schema::Build("annotation", schema_json);
+  ASSERT_TRUE(schema != nullptr);
+  int schema_id = header_data.AddSchema(schema);
+  ASSERT_EQ(schema_id, 0);
+  std::vector<std::pair<uint64_t, std::string>> fields = {{schema_id, "file_name"}, {schema_id, "label"}};
+  ASSERT_EQ(header_data.AddIndexFields(fields), SUCCESS);
+
+  // 12 columns a row, so a page holds several full batches of 999 / 12 rows and a remainder
+  const int num_rows = 3000;
+  std::vector<json> annotations;
+  for (int i = 0; i < num_rows; ++i) {
+    annotations.push_back(json{{"file_name", "sample_" + std::to_string(i) + ".jpg"}, {"label", i % 7}});
+  }
+  std::map<std::uint64_t, std::vector<json>> rawdatas = {{schema_id, annotations}};
+  std::vector<std::vector<uint8_t>> bin_data;
+
+  // small pages, the rows are spread over several of them
+  std::string file_name = "./index_batch.mindrecord";
+  mindrecord::ShardWriter fw;
+  ASSERT_EQ(fw.Open({file_name}), SUCCESS);
+  ASSERT_EQ(fw.SetPageSize(1 << 15), SUCCESS);
+  ASSERT_EQ(fw.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data)), SUCCESS);
+  ASSERT_EQ(fw.WriteRawData(rawdatas, bin_data), SUCCESS);
+  ASSERT_EQ(fw.Commit(), SUCCESS);
+
+  mindrecord::ShardIndexGenerator sg{file_name};
+  ASSERT_EQ(sg.Build(), SUCCESS);
+  ASSERT_EQ(sg.WriteToDatabase(), SUCCESS);
+
+  // every row is in the index db once, with its own fields
+  sqlite3 *db = nullptr;
+  ASSERT_EQ(sqlite3_open_v2(common::SafeCStr(file_name + ".db"), &db, SQLITE_OPEN_READONLY, nullptr), SQLITE_OK);
+  sqlite3_stmt *stmt = nullptr;
+  std::string sql = "SELECT ROW_ID, INC_0, file_name_0, INC_1, label_0 FROM INDEXES ORDER BY ROW_ID;";
+  ASSERT_EQ(sqlite3_prepare_v2(db, common::SafeCStr(sql), -1, &stmt, nullptr), SQLITE_OK);
+  int row = 0;
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    ASSERT_EQ(sqlite3_column_int64(stmt, 0), row);
+    ASSERT_EQ(sqlite3_column_int64(stmt, 1), 0);
+    ASSERT_EQ(std::string(reinterpret_cast<const char *>(sqlite3_column_text(stmt, 2))),
+              "sample_" + std::to_string(row) + ".jpg");
+    ASSERT_EQ(sqlite3_column_int64(stmt, 3), 0);
+    ASSERT_EQ(sqlite3_column_int64(stmt, 4), row % 7);
+    ++row;
+  }
+  ASSERT_EQ(row, num_rows);
+  (void)sqlite3_finalize(stmt);
+
+  // the key index is created once the rows are in
+  sql = "SELECT COUNT(*) FROM sqlite_master WHERE type = 'index' AND name = 'INDEXES_KEY';";
+  ASSERT_EQ(sqlite3_prepare_v2(db, common::SafeCStr(sql), -1, &stmt, nullptr), SQLITE_OK);
+  ASSERT_EQ(sqlite3_step(stmt), SQLITE_ROW);
+  ASSERT_EQ(sqlite3_column_int(stmt, 0), 1);
+  (void)sqlite3_finalize(stmt);
+  (void)sqlite3_close(db);
+
+  // the rows were indexed page by page
+  ShardReader reader;
+  ASSERT_EQ(reader.Open({file_name}, true, 4, {"label"}), SUCCESS);
+  auto header = reader.GetShardHeader();
+  int raw_pages = 0;
+  for (int64_t page_id = 0; page_id <= header->GetLastPageId(0); ++page_id) {
+    auto page = header->GetPage(0, page_id);
+    if (page.second == SUCCESS && page.first->GetPageType() == kPageTypeRaw) {
+      ++raw_pages;
+    }
+  }
+  reader.Close();
+  ASSERT_GT(raw_pages, 1);
+
+  remove(common::SafeCStr(file_name + ".db"));
+  remove(common::SafeCStr(file_name));
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <iostream>
@@ -199,7 +200,10 @@ TEST_F(TestShardWriter, TestShardWriterShiftRawPage) {
 
     // set shardHeader
     fw.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data));
-    fw.WriteRawData(rawdatas, bin_data);
+    // WriteRawData consumes the blobs, the same images are appended again below
+    std::vector<std::vector<uint8_t>> first_bin_data = bin_data;
+    fw.WriteRawData(rawdatas, first_bin_data);
+    ASSERT_TRUE(first_bin_data.empty());
     fw.Commit();
   }
 
@@ -866,6 +870,69 @@ TEST_F(TestShardWriter, TestShardNoBlob) {
   }
 }
 
+TEST_F(TestShardWriter, TestShardNoBlobWriteInSteps) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test no-blob written by several calls"));
+
+  // create schema
+  mindrecord::ShardHeader header_data;
+  json anno_schema_json = R"({"file_name": {"type": "string"}, "label": {"type": "int32"}})"_json;
+  std::shared_ptr<mindrecord::Schema> anno_schema = mindrecord::Schema::Build("annotation", anno_schema_json);
+  ASSERT_TRUE(anno_schema != nullptr);
+  int anno_schema_id = header_data.AddSchema(anno_schema);
+  ASSERT_EQ(anno_schema_id, 0);
+
+  // load  meta data
+  std::vector<json> annotations;
+  LoadDataFromImageNet("./data/mindrecord/testImageNetData/annotation.txt", annotations, 10);
+
+  // init file_writer
+  std::vector<std::string> file_names;
+  for (int i = 1; i <= 4; i++) {
+    file_names.emplace_back(std::string("./imagenet.shard0") + std::to_string(i));
+  }
+  mindrecord::ShardWriter fw_init;
+  ASSERT_TRUE(fw_init.Open(file_names) == SUCCESS);
+  ASSERT_TRUE(fw_init.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data)) == SUCCESS);
+
+  // write 4 + 4 + 2 rows, each call overlaps the write of the previous one
+  for (size_t start = 0; start < annotations.size(); start += 4) {
+    size_t end = std::min(start + 4, annotations.size());
+    std::map<std::uint64_t, std::vector<json>> rawdatas;
+    rawdatas.insert(pair<uint64_t, vector<json>>(
+      anno_schema_id, std::vector<json>(annotations.begin() + start, annotations.begin() + end)));
+    std::vector<std::vector<uint8_t>> bin_data;
+    ASSERT_TRUE(fw_init.WriteRawData(rawdatas, bin_data) == SUCCESS);
+  }
+  ASSERT_TRUE(fw_init.Commit() == SUCCESS);
+
+  // create the index file
+  std::string filename = "./imagenet.shard01";
+  mindrecord::ShardIndexGenerator sg{filename};
+  sg.Build();
+  ASSERT_TRUE(sg.WriteToDatabase() == SUCCESS);
+
+  // read the mindrecord file
+  auto column_list = std::vector<std::string>{"label", "file_name"};
+  ShardReader dataset;
+  MSRStatus ret = dataset.Open({filename}, true, 4, column_list);
+  ASSERT_EQ(ret, SUCCESS);
+  dataset.Launch();
+
+  int count = 0;
+  while (true) {
+    auto x = dataset.GetNext();
+    if (x.empty()) break;
+    count += x.size();
+  }
+  ASSERT_TRUE(count == 10);
+  dataset.Close();
+  for (const auto &filename : file_names) {
+    auto filename_db = filename + ".db";
+    remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename));
+  }
+}
+
 TEST_F(TestShardWriter, TestShardReaderStringAndNumberNotColumnInIndex) {
   MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test read imageNet int32 is in index"));
 
@@ -177,6 +177,25 @@ TEST_F(TestOptOpt, ConstantVariable) {
   ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({Qct_to_P})));
 }
 
+// Q(1) becomes P(1) after the chain of P above it was visited, the P users must be revisited from the worklist
+TEST_F(TestOptOpt, WorklistRevisitsUsers) {
+  auto make_chain = [](const PrimitivePtr &first, int num_p) {
+    auto fg = std::make_shared<FuncGraph>();
+    AnfNodePtr node = fg->NewCNode({NewValueNode(first), NewValueNode(static_cast<int64_t>(1))});
+    for (int i = 0; i < num_p; i++) {
+      node = fg->NewCNode({NewValueNode(P), node});
+    }
+    fg->set_output(node);
+    return fg;
+  };
+  FuncGraphPtr before = make_chain(Q, 3);
+  FuncGraphPtr after = make_chain(P, 0);
+
+  ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({idempotent_P, Qct_to_P})));
+  ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({Qct_to_P, idempotent_P})));
+  ASSERT_FALSE(CheckOpt(before, after, std::vector<SubstitutionPtr>({idempotent_P})));
+}
+
 TEST_F(TestOptOpt, CSE) {
   // test a simple cse testcase test_f1
   FuncGraphPtr test_graph1 = getPyFun.CallAndParseRet("test_cse", "test_f1");
@@ -0,0 +1,172 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <dirent.h>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common_test.h"
+#include "pipeline/jit/compile_cache.h"
+#include "ir/func_graph.h"
+#include "ir/tensor.h"
+#include "frontend/operator/ops.h"
+
+namespace mindspore {
+namespace pipeline {
+class TestCompileCache : public UT::Common {
+ public:
+  TestCompileCache() {}
+
+  // x + w, w being a weight, and the attribute of Add set to attr
+  static FuncGraphPtr MakeGraph(int64_t attr) {
+    auto func_graph = std::make_shared<FuncGraph>();
+    auto x = func_graph->add_parameter();
+    x->set_name("x");
+    auto w = func_graph->add_parameter();
+    w->set_name("w");
+    w->set_default_param(std::make_shared<tensor::Tensor>(kNumberTypeFloat32, std::vector<int64_t>{2, 3}));
+    auto add = std::make_shared<Primitive>("Add");
+    add->AddAttr("test_attr", MakeValue(attr));
+    auto cnode = func_graph->NewCNode({NewValueNode(add), x, w});
+    func_graph->set_output(cnode);
+    return func_graph;
+  }
+
+  static abstract::AbstractBasePtrList Args(int64_t dim) {
+    auto tensor = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, std::vector<int64_t>{dim, 3});
+    return {tensor->ToAbstract()};
+  }
+
+  static ParameterPtr MakeWeight(const FuncGraphPtr &func_graph, const std::string &name) {
+    auto tensor = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, std::vector<int64_t>{2, 3});
+    auto weight = func_graph == nullptr ? std::make_shared<Parameter>(nullptr) : func_graph->add_parameter();
+    weight->set_name(name);
+    weight->set_default_param(tensor);
+    weight->set_abstract(tensor->ToAbstract());
+    return weight;
+  }
+
+  // (x + w1) + w2, the input comes before the weights
+  static FuncGraphPtr MakeTwoWeightGraph() {
+    auto func_graph = std::make_shared<FuncGraph>();
+    auto x = func_graph->add_parameter();
+    x->set_name("x");
+    x->set_abstract(Args(2)[0]);
+    auto w1 = MakeWeight(func_graph, "w1");
+    auto w2 = MakeWeight(func_graph, "w2");
+    auto add1 = func_graph->NewCNode({NewValueNode(std::make_shared<Primitive>("Add")), x, w1});
+    add1->set_abstract(x->abstract());
+    auto add2 = func_graph->NewCNode({NewValueNode(std::make_shared<Primitive>("Add")), add1, w2});
+    add2->set_abstract(x->abstract());
+    func_graph->set_output(add2);
+    return func_graph;
+  }
+
+  // Meta files of a cache directory
+  static std::vector<std::string> MetaFiles(const std::string &dir) {
+    std::vector<std::string> files;
+    DIR *dp = opendir(dir.c_str());
+    if (dp == nullptr) {
+      return files;
+    }
+    for (struct dirent *entry = readdir(dp); entry != nullptr; entry = readdir(dp)) {
+      std::string name = entry->d_name;
+      if (name.size() > 5 && name.substr(name.size() - 5) == ".meta") {
+        files.push_back(dir + "/" + name);
+      }
+    }
+    (void)closedir(dp);
+    return files;
+  }
+};
+
+TEST_F(TestCompileCache, TestKeyIgnoresNodeIds) {
+  // the second graph gets other node and graph ids
+  std::string key = CompileCache::Key(MakeGraph(1), Args(2));
+  ASSERT_EQ(key, CompileCache::Key(MakeGraph(1), Args(2)));
+}
+
+TEST_F(TestCompileCache, TestKeyChanges) {
+  std::string key = CompileCache::Key(MakeGraph(1), Args(2));
+  ASSERT_NE(key, CompileCache::Key(MakeGraph(2), Args(2)));
+  ASSERT_NE(key, CompileCache::Key(MakeGraph(1), Args(4)));
+}
+
+TEST_F(TestCompileCache, TestLoadMiss) {
+  std::string key = CompileCache::Key(MakeGraph(1), Args(2));
+  ASSERT_EQ(CompileCache("./compile_cache_test_missing").Load(key, {}), nullptr);
+}
+
+TEST_F(TestCompileCache, TestSaveLoad) {
+  const std::string dir = "./compile_cache_test_save_load";
+  auto func_graph = MakeTwoWeightGraph();
+  std::string key = CompileCache::Key(func_graph, Args(2));
+  CompileCache(dir).Save(key, func_graph);
+
+  // the weights of the new network, given in another order than the graph uses them
+  auto w2 = MakeWeight(nullptr, "w2");
+  auto w1 = MakeWeight(nullptr, "w1");
+  auto loaded = CompileCache(dir).Load(key, {w2, w1});
+  ASSERT_NE(loaded, nullptr);
+  const auto &params = loaded->parameters();
+  ASSERT_EQ(params.size(), 3);
+  auto x = params[0]->cast<ParameterPtr>();
+  ASSERT_NE(x, nullptr);
+  ASSERT_FALSE(x->has_default());
+  auto loaded_w1 = params[1]->cast<ParameterPtr>();
+  auto loaded_w2 = params[2]->cast<ParameterPtr>();
+  ASSERT_NE(loaded_w1, nullptr);
+  ASSERT_NE(loaded_w2, nullptr);
+  ASSERT_EQ(loaded_w1->name(), "w1");
+  ASSERT_EQ(loaded_w2->name(), "w2");
+  ASSERT_EQ(loaded_w1->default_param(), w1->default_param());
+  ASSERT_EQ(loaded_w2->default_param(), w2->default_param());
+
+  // a weight missing from the network is a miss
+  ASSERT_EQ(CompileCache(dir).Load(key, {w1}), nullptr);
+}
+
+TEST_F(TestCompileCache, TestLoadCorruptMeta) {
+  const std::string dir = "./compile_cache_test_corrupt";
+  auto func_graph = MakeTwoWeightGraph();
+  std::string key = CompileCache::Key(func_graph, Args(2));
+  CompileCache(dir).Save(key, func_graph);
+  auto w1 = MakeWeight(nullptr, "w1");
+  auto w2 = MakeWeight(nullptr, "w2");
+  auto files = MetaFiles(dir);
+  ASSERT_EQ(files.size(), 1);
+
+  std::vector<std::string> broken_metas = {
+    "",                               // empty
+    "3",                              // truncated after the parameter number
+    "abc\n",                          // not a number
+    "99999999999999999999999\n",      // out of range
+    "3\ni\nw w1\n",                   // truncated parameter list
+    "3\ni\n\nw w2\n" + key,           // empty parameter line
+    "3\ni\nw\nw w2\n" + key,          // weight without a name
+    "3\ni\nx w1\nw w2\n" + key,       // unknown parameter kind
+    "2\ni\nw w1\n" + key,             // parameter number does not match the graph
+  };
+  for (auto &broken : broken_metas) {
+    std::ofstream ofs(files[0], std::ios::binary | std::ios::trunc);
+    ofs << broken;
+    ofs.close();
+    ASSERT_EQ(CompileCache(dir).Load(key, {w1, w2}), nullptr);
+  }
+}
+}  // namespace pipeline
+}  // namespace mindspore
@@ -18,6 +18,7 @@
 #include "common/common_test.h"
 
 #include <memory>
+#include <string>
 #include <thread>
 
 namespace mindspore {
@@ -31,133 +32,100 @@ class TestTcpMessageHandler : public UT::Common {
 
   void SetUp() override {}
   void TearDown() override {}
-};
 
-TEST_F(TestTcpMessageHandler, 8_Header_1003_Data) {
-  TcpMessageHandler handler;
-  handler.SetCallback([this](std::shared_ptr<CommMessage> message) { EXPECT_EQ(message->data().size(), 1000); });
-
-  std::string data(1000, 'a');
-  CommMessage message;
-  message.set_data(data);
-  size_t buf_size = message.ByteSizeLong();
-  char result[1011];
-  int ret = memcpy_s(result, kHeaderLen, &buf_size, kHeaderLen);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
+  // The bytes sent for a message with data of the given size
+  static std::string Frame(size_t data_size) {
+    CommMessage message;
+    message.mutable_pb_meta()->set_request_id(data_size);
+    message.set_data(std::string(data_size, 'a'));
+    struct evbuffer *output = evbuffer_new();
+    EXPECT_TRUE(TcpMessageHandler::WriteMessage(output, message));
+    std::string frame(evbuffer_get_length(output), '\0');
+    evbuffer_remove(output, &frame[0], frame.size());
+    evbuffer_free(output);
+    return frame;
   }
+};
 
-  std::vector<char> serialized(buf_size);
-  message.SerializeToArray(serialized.data(), static_cast<int>(buf_size));
-  memcpy_s(result + kHeaderLen, buf_size, serialized.data(), buf_size);
-  handler.ReceiveMessage(result, buf_size + kHeaderLen);
+TEST_F(TestTcpMessageHandler, 16_Header_1000_Data) {
+  TcpMessageHandler handler;
+  int count = 0;
+  handler.SetCallback([&count](std::shared_ptr<CommMessage> message) {
+    EXPECT_EQ(message->data().size(), 1000);
+    EXPECT_EQ(message->pb_meta().request_id(), 1000);
+    ++count;
+  });
+
+  std::string frame = Frame(1000);
+  handler.ReceiveMessage(frame.data(), frame.size());
+  EXPECT_EQ(count, 1);
 }
 
-TEST_F(TestTcpMessageHandler, 8_Header_1003_Data_8_Header_1003_Data) {
+TEST_F(TestTcpMessageHandler, 16_Header_1000_Data_16_Header_1000_Data) {
   TcpMessageHandler handler;
-  handler.SetCallback([this](std::shared_ptr<CommMessage> message) { EXPECT_EQ(message->data().size(), 1000); });
-
-  std::string data(1000, 'a');
-  CommMessage message;
-  message.set_data(data);
-  size_t buf_size = message.ByteSizeLong();
-  char result[2022] = {0};
-  int ret = memcpy_s(result, kHeaderLen, &buf_size, kHeaderLen);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
-  std::vector<char> serialized(buf_size);
-  message.SerializeToArray(serialized.data(), static_cast<int>(buf_size));
-  ret = memcpy_s(result + kHeaderLen, buf_size, serialized.data(), buf_size);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
-  ret = memcpy_s(result + kHeaderLen + buf_size, kHeaderLen, &buf_size, kHeaderLen);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
-  ret = memcpy_s(result + kHeaderLen + buf_size + kHeaderLen, buf_size, serialized.data(), buf_size);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
-
-  handler.ReceiveMessage(result, 2 * buf_size + kHeaderLen * 2);
+  int count = 0;
+  handler.SetCallback([&count](std::shared_ptr<CommMessage> message) {
+    EXPECT_EQ(message->data().size(), 1000);
+    ++count;
+  });
+
+  std::string frames = Frame(1000) + Frame(1000);
+  handler.ReceiveMessage(frames.data(), frames.size());
+  EXPECT_EQ(count, 2);
 }
 
-TEST_F(TestTcpMessageHandler, 8_Header_4084_Data_4_Header_4_header_4084_data) {
+TEST_F(TestTcpMessageHandler, Header_Split_Between_Reads) {
   TcpMessageHandler handler;
-  handler.SetCallback([this](std::shared_ptr<CommMessage> message) { EXPECT_EQ(message->data().size(), 4081); });
-
-  std::string data(4081, 'a');
-  CommMessage message;
-  message.set_data(data);
-  size_t buf_size = message.ByteSizeLong();
-  char result[4096] = {0};
-  int ret = memcpy_s(result, kHeaderLen, &buf_size, kHeaderLen);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
-  std::vector<char> serialized(buf_size);
-  message.SerializeToArray(serialized.data(), static_cast<int>(buf_size));
-  ret = memcpy_s(result + kHeaderLen, buf_size, serialized.data(), buf_size);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
-
-  ret = memcpy_s(result + kHeaderLen + buf_size, 4, &buf_size, 4);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
-
-  handler.ReceiveMessage(result, 4096);
-
-  auto temp = reinterpret_cast<char *>(&buf_size);
-  ret = memcpy_s(result, 4, temp + 4, 4);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
-  ret = memcpy_s(result + 4, buf_size, serialized.data(), buf_size);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
-
-  handler.ReceiveMessage(result, 4088);
+  int count = 0;
+  handler.SetCallback([&count](std::shared_ptr<CommMessage> message) {
+    EXPECT_EQ(message->data().size(), 4000);
+    ++count;
+  });
+
+  std::string frames = Frame(4000) + Frame(4000);
+  size_t first = Frame(4000).size() + kHeaderLen / 2;
+  handler.ReceiveMessage(frames.data(), first);
+  EXPECT_EQ(count, 1);
+  handler.ReceiveMessage(frames.data() + first, frames.size() - first);
+  EXPECT_EQ(count, 2);
 }
 
-TEST_F(TestTcpMessageHandler, 8_Header_4080_Data_8_Header_4080_data) {
+TEST_F(TestTcpMessageHandler, Byte_By_Byte_And_Empty_Data) {
   TcpMessageHandler handler;
-  handler.SetCallback([this](std::shared_ptr<CommMessage> message) { EXPECT_EQ(message->data().size(), 4077); });
-
-  std::string data(4077, 'a');
-  CommMessage message;
-  message.set_data(data);
-  size_t buf_size = message.ByteSizeLong();
-  char result[4096] = {0};
-  int ret = memcpy_s(result, kHeaderLen, &buf_size, kHeaderLen);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
-  std::vector<char> serialized(buf_size);
-  message.SerializeToArray(serialized.data(), static_cast<int>(buf_size));
-  ret = memcpy_s(result + kHeaderLen, buf_size, serialized.data(), buf_size);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
+  std::vector<size_t> sizes;
+  handler.SetCallback([&sizes](std::shared_ptr<CommMessage> message) { sizes.push_back(message->data().size()); });
 
-  ret = memcpy_s(result + kHeaderLen + buf_size, kHeaderLen, &buf_size, kHeaderLen);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
+  std::string frames = Frame(0) + Frame(10);
+  for (char c : frames) {
+    handler.ReceiveMessage(&c, 1);
   }
+  EXPECT_EQ(sizes, std::vector<size_t>({0, 10}));
+}
 
-  handler.ReceiveMessage(result, 4096);
+TEST_F(TestTcpMessageHandler, Shared_Message_Through_Event_Buffer) {
+  auto message = std::make_shared<CommMessage>();
+  message->set_user_cmd("push");
+  message->set_data(std::string(1 << 20, 'b'));
+  std::weak_ptr<CommMessage> weak = message;
 
-  ret = memcpy_s(result, buf_size, serialized.data(), buf_size);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
+  struct evbuffer *buffer = evbuffer_new();
+  ASSERT_TRUE(TcpMessageHandler::WriteMessage(buffer, message));
+  message.reset();
+  // the buffer references the data of the message instead of a copy
+  EXPECT_FALSE(weak.expired());
 
-  handler.ReceiveMessage(result, 4080);
+  TcpMessageHandler handler;
+  int count = 0;
+  handler.SetCallback([&count](std::shared_ptr<CommMessage> received) {
+    EXPECT_EQ(received->user_cmd(), "push");
+    EXPECT_EQ(received->data(), std::string(1 << 20, 'b'));
+    ++count;
+  });
+  handler.ReceiveMessage(buffer);
+  EXPECT_EQ(count, 1);
+  EXPECT_TRUE(weak.expired());
+  evbuffer_free(buffer);
 }
 }  // namespace core
 }  // namespace ps
-}  // namespace mindspore
\ No newline at end of file
+}  // namespace mindspore
@@ -0,0 +1,126 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "common/common_test.h"
+#include "ps/gradient_codec.h"
+
+namespace mindspore {
+namespace ps {
+class TestGradientCodec : public UT::Common {
+ public:
+  TestGradientCodec() = default;
+  virtual ~TestGradientCodec() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+
+  static std::vector<float> Grad(size_t n) {
+    std::vector<float> grad(n);
+    for (size_t i = 0; i < n; i++) {
+      grad[i] = std::sin(static_cast<float>(i)) * (i % 7 + 1);
+    }
+    return grad;
+  }
+
+  // Encode and decode onto accum
+  static std::vector<float> RoundTrip(const GradientCodec &codec, const std::vector<float> &grad,
+                                      std::vector<float> *residual, std::vector<float> accum) {
+    std::vector<float> payload(codec.EncodedSize(grad.size()));
+    codec.Encode(grad.data(), grad.size(), residual == nullptr ? nullptr : residual->data(), payload.data());
+    EXPECT_TRUE(codec.DecodeAccumulate(payload.data(), payload.size(), accum.data(), accum.size()));
+    return accum;
+  }
+};
+
+TEST_F(TestGradientCodec, Float16) {
+  std::vector<float> grad = Grad(101);
+  for (auto type : {GradCodecType::kFp16, GradCodecType::kBf16}) {
+    GradientCodec codec(type, kDefaultTopKRatio);
+    EXPECT_EQ(codec.EncodedSize(grad.size()), 51);
+    std::vector<float> decoded = RoundTrip(codec, grad, nullptr, std::vector<float>(grad.size(), 1));
+    float tolerance = type == GradCodecType::kFp16 ? 1e-3 : 1e-2;
+    for (size_t i = 0; i < grad.size(); i++) {
+      EXPECT_NEAR(decoded[i], grad[i] + 1, std::fabs(grad[i]) * tolerance + 1e-6);
+    }
+  }
+}
+
+TEST_F(TestGradientCodec, Int8ErrorFeedback) {
+  GradientCodec codec(GradCodecType::kInt8, kDefaultTopKRatio);
+  std::vector<float> grad = Grad(1001);
+  EXPECT_EQ(codec.EncodedSize(grad.size()), 252);
+  std::vector<float> residual(grad.size(), 0);
+  std::vector<float> decoded = RoundTrip(codec, grad, &residual, std::vector<float>(grad.size(), 0));
+  for (size_t i = 0; i < grad.size(); i++) {
+    // what was sent plus what was kept is the gradient
+    EXPECT_NEAR(decoded[i] + residual[i], grad[i], 1e-5);
+    EXPECT_LE(std::fabs(residual[i]), 7.0 / 127);
+  }
+}
+
+TEST_F(TestGradientCodec, TopKErrorFeedback) {
+  GradientCodec codec(GradCodecType::kTopK, 0.1);
+  std::vector<float> grad = Grad(100);
+  EXPECT_EQ(codec.EncodedSize(grad.size()), 20);
+  std::vector<float> residual(grad.size(), 0);
+  std::vector<float> sent = RoundTrip(codec, grad, &residual, std::vector<float>(grad.size(), 0));
+  size_t nonzero = 0;
+  float min_sent = 1e9;
+  float max_kept = 0;
+  for (size_t i = 0; i < grad.size(); i++) {
+    EXPECT_FLOAT_EQ(sent[i] + residual[i], grad[i]);
+    if (sent[i] != 0) {
+      nonzero++;
+      min_sent = std::min(min_sent, std::fabs(sent[i]));
+    }
+    max_kept = std::max(max_kept, std::fabs(residual[i]));
+  }
+  EXPECT_EQ(nonzero, 10);
+  EXPECT_GE(min_sent, max_kept);
+
+  // after enough steps of a zero gradient every value has been sent
+  std::vector<float> zeros(grad.size(), 0);
+  for (size_t step = 0; step < 9; step++) {
+    sent = RoundTrip(codec, zeros, &residual, sent);
+  }
+  for (size_t i = 0; i < grad.size(); i++) {
+    EXPECT_FLOAT_EQ(sent[i], grad[i]);
+  }
+}
+
+TEST_F(TestGradientCodec, DecodeSizeMismatch) {
+  GradientCodec codec(GradCodecType::kFp16, kDefaultTopKRatio);
+  std::vector<float> payload(10);
+  std::vector<float> accum(30);
+  EXPECT_FALSE(codec.DecodeAccumulate(payload.data(), payload.size(), accum.data(), accum.size()));
+}
+
+TEST_F(TestGradientCodec, ShapeEntry) {
+  GradientCodec codec(GradCodecType::kTopK, 0.05);
+  std::vector<float> entry = codec.ToShapeEntry();
+  GradientCodec parsed;
+  EXPECT_TRUE(GradientCodec::FromShapeEntry(entry.data(), entry.size(), &parsed));
+  EXPECT_EQ(parsed.type(), GradCodecType::kTopK);
+  EXPECT_FLOAT_EQ(parsed.topk_ratio(), 0.05);
+
+  std::vector<float> shape = {2, 3, 4};
+  EXPECT_FALSE(GradientCodec::FromShapeEntry(shape.data(), shape.size(), &parsed));
+}
+}  // namespace ps
+}  // namespace mindspore
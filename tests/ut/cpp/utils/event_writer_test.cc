@@ -0,0 +1,157 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "common/common_test.h"
+#include "utils/summary/event_writer.h"
+
+namespace mindspore {
+namespace summary {
+class TestEventWriter : public UT::Common {
+ public:
+  TestEventWriter() {}
+
+  // the event file has to exist before the writer opens it, as SummaryRecord does
+  void SetUp() override {
+    UT::Common::SetUp();
+    std::ofstream ofs(file_name_, std::ios::trunc);
+  }
+
+  void TearDown() override {
+    (void)std::remove(file_name_.c_str());
+    UT::Common::TearDown();
+  }
+
+  // The data of the records of a summary file, in file order
+  static std::vector<std::string> ReadRecords(const std::string &file_name) {
+    std::vector<std::string> records;
+    std::ifstream ifs(file_name, std::ios::binary);
+    uint64_t length = 0;
+    uint32_t crc = 0;
+    while (ifs.read(reinterpret_cast<char *>(&length), sizeof(length))) {
+      std::string data(length, '\0');
+      if (!ifs.read(reinterpret_cast<char *>(&crc), sizeof(crc)) || !ifs.read(&data[0], length) ||
+          !ifs.read(reinterpret_cast<char *>(&crc), sizeof(crc))) {
+        break;
+      }
+      records.push_back(data);
+    }
+    return records;
+  }
+
+  // Event i is the text of i padded to size bytes
+  static std::string MakeEvent(int i, size_t size) {
+    std::string event = std::to_string(i);
+    event.resize(size, ' ');
+    return event;
+  }
+
+  std::string file_name_ = "./event_writer_test.summary";
+};
+
+TEST_F(TestEventWriter, TestOrder) {
+  EventWriter writer(file_name_);
+  const int num_events = 1000;
+  for (int i = 0; i < num_events; ++i) {
+    writer.Write(MakeEvent(i, 64));
+  }
+  // Flush returns once every record is in the file
+  ASSERT_TRUE(writer.Flush());
+  auto records = ReadRecords(file_name_);
+  ASSERT_EQ(records.size(), num_events);
+  for (int i = 0; i < num_events; ++i) {
+    ASSERT_EQ(records[i], MakeEvent(i, 64));
+  }
+  ASSERT_EQ(writer.GetWriteEventCount(), num_events);
+  ASSERT_EQ(writer.GetDroppedEventCount(), 0);
+
+  // records written after a flush follow the flushed ones
+  writer.Write(MakeEvent(num_events, 64));
+  ASSERT_TRUE(writer.Flush());
+  records = ReadRecords(file_name_);
+  ASSERT_EQ(records.size(), num_events + 1);
+  ASSERT_EQ(records.back(), MakeEvent(num_events, 64));
+  ASSERT_TRUE(writer.Shut());
+}
+
+TEST_F(TestEventWriter, TestBlockWhenFull) {
+  // room for about one record, the caller waits for the writer thread instead of losing records
+  EventWriter writer(file_name_, 1024, false);
+  const int num_events = 200;
+  for (int i = 0; i < num_events; ++i) {
+    writer.Write(MakeEvent(i, 1000));
+  }
+  ASSERT_TRUE(writer.Flush());
+  auto records = ReadRecords(file_name_);
+  ASSERT_EQ(records.size(), num_events);
+  for (int i = 0; i < num_events; ++i) {
+    ASSERT_EQ(records[i], MakeEvent(i, 1000));
+  }
+  ASSERT_EQ(writer.GetDroppedEventCount(), 0);
+  ASSERT_TRUE(writer.Shut());
+}
+
+TEST_F(TestEventWriter, TestDropWhenFull) {
+  EventWriter writer(file_name_, 1024, true);
+  const int num_events = 200;
+  for (int i = 0; i < num_events; ++i) {
+    writer.Write(MakeEvent(i, 1000));
+  }
+  ASSERT_TRUE(writer.Flush());
+  // every record is either written or counted as dropped, the written ones keep their order
+  auto records = ReadRecords(file_name_);
+  ASSERT_EQ(records.size(), writer.GetWriteEventCount());
+  ASSERT_EQ(writer.GetWriteEventCount() + writer.GetDroppedEventCount(), num_events);
+  ASSERT_GE(records.size(), 1);
+  int last = -1;
+  for (auto &record : records) {
+    int i = std::stoi(record);
+    ASSERT_GT(i, last);
+    ASSERT_EQ(record, MakeEvent(i, 1000));
+    last = i;
+  }
+  ASSERT_TRUE(writer.Shut());
+}
+
+TEST_F(TestEventWriter, TestSyncWrite) {
+  // no pending buffer, the record is written by the caller
+  EventWriter writer(file_name_, 0, false);
+  writer.Write(MakeEvent(0, 16));
+  ASSERT_TRUE(writer.Flush());
+  auto records = ReadRecords(file_name_);
+  ASSERT_EQ(records.size(), 1);
+  ASSERT_EQ(records[0], MakeEvent(0, 16));
+  ASSERT_TRUE(writer.Shut());
+}
+
+TEST_F(TestEventWriter, TestShutDrains) {
+  {
+    EventWriter writer(file_name_);
+    for (int i = 0; i < 100; ++i) {
+      writer.Write(MakeEvent(i, 32));
+    }
+    // Shut writes the pending records before closing the file
+    ASSERT_TRUE(writer.Shut());
+  }
+  auto records = ReadRecords(file_name_);
+  ASSERT_EQ(records.size(), 100);
+  ASSERT_EQ(records.back(), MakeEvent(99, 32));
+}
+}  // namespace summary
+}  // namespace mindspore
@@ -14,7 +14,9 @@
 # ==============================================================================
 import numpy as np
 
+import mindspore as ms
 import mindspore._c_dataengine as cde
+import mindspore.dataset as ds
 
 
 def test_shape():
@@ -55,7 +57,31 @@ def test_strides():
     np.testing.assert_array_equal(x.transpose(), arr)
 
 
+def test_dlpack():
+    x = np.arange(12, dtype=np.float32).reshape(2, 2, 3)
+    data = ds.NumpySlicesDataset({"x": x}, shuffle=False)
+    itr = data.create_tuple_iterator(num_epochs=1)
+    # the dataset tensors of the first row
+    row = itr._iterator.GetNextAsList()  # pylint: disable=W0212
+    assert row[0].__dlpack_device__() == (1, 0)
+
+    t = ms.Tensor.from_dlpack(row[0])
+    assert t.dtype == ms.float32
+    assert t.shape == (2, 3)
+    np.testing.assert_array_equal(t.asnumpy(), x[0])
+    # 't' shares the data of the row
+    arr = np.array(row[0], copy=False)
+    assert np.asarray(t).__array_interface__['data'][0] == arr.__array_interface__['data'][0]
+    arr[0] = 7
+    np.testing.assert_array_equal(t.asnumpy()[0], [7, 7, 7])
+    # and keeps it alive once the row is gone
+    del row, arr
+    itr.stop()
+    np.testing.assert_array_equal(t.asnumpy()[1], x[0][1])
+
+
 if __name__ == '__main__':
     test_shape()
     test_strides()
     test_basic()
+    test_dlpack()
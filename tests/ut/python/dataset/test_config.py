@@ -19,6 +19,7 @@ import os
 import filecmp
 import glob
 import numpy as np
+import pytest
 
 import mindspore.dataset as ds
 import mindspore.dataset.transforms.py_transforms
@@ -386,6 +387,32 @@ def test_auto_num_workers():
     assert saved_config == ds.config.get_auto_num_workers()
 
 
+def test_numa_placement():
+    """
+    Test numa_placement can be set and a pipeline runs with it.
+    """
+    saved_config = ds.config.get_numa_placement()
+    assert saved_config == ("none", 1)
+
+    ds.config.set_numa_placement("spread", tenants_per_node=2)
+    assert ds.config.get_numa_placement() == ("spread", 2)
+    data = ds.GeneratorDataset(lambda: ((np.array([i]),) for i in range(10)), ["col"], num_parallel_workers=2)
+    data = data.batch(2, num_parallel_workers=2)
+    assert sum(1 for _ in data.create_tuple_iterator()) == 5
+
+    with pytest.raises(ValueError) as info:
+        ds.config.set_numa_placement("remote")
+    assert "mode must be one of" in str(info.value)
+    with pytest.raises(ValueError) as info:
+        ds.config.set_numa_placement("local", tenants_per_node=0)
+    assert "tenants_per_node" in str(info.value)
+    with pytest.raises(TypeError):
+        ds.config.set_numa_placement(1)
+
+    ds.config.set_numa_placement(*saved_config)
+    assert ds.config.get_numa_placement() == saved_config
+
+
 if __name__ == '__main__':
     test_basic()
     test_get_seed()
@@ -398,3 +425,4 @@ if __name__ == '__main__':
     test_deterministic_python_seed_multi_thread()
     test_auto_num_workers_error()
     test_auto_num_workers()
+    test_numa_placement()
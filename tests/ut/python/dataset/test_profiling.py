@@ -19,6 +19,7 @@ import json
 import os
 import numpy as np
 import mindspore.dataset as ds
+from mindspore.profiler.parser.minddata_event_parser import MinddataEventParser
 
 FILES = ["../data/dataset/testTFTestAllTypes/test.data"]
 DATASET_ROOT = "../data/dataset/testTFTestAllTypes/"
@@ -26,6 +27,7 @@ SCHEMA_FILE = "../data/dataset/testTFTestAllTypes/datasetSchema.json"
 
 PIPELINE_FILE = "./pipeline_profiling_1.json"
 DATASET_ITERATOR_FILE = "./dataset_iterator_profiling_1.txt"
+OP_EVENT_FILE = "./op_event_profiling_1.bin"
 
 
 def test_profiling_simple_pipeline():
@@ -46,6 +48,7 @@ def test_profiling_simple_pipeline():
     assert data1.get_dataset_size() == 32
     assert os.path.exists(PIPELINE_FILE) is False
     assert os.path.exists(DATASET_ITERATOR_FILE) is False
+    assert os.path.exists(OP_EVENT_FILE) is False
 
     for _ in data1:
         pass
@@ -54,6 +57,13 @@ def test_profiling_simple_pipeline():
     os.remove(PIPELINE_FILE)
     assert os.path.exists(DATASET_ITERATOR_FILE) is True
     os.remove(DATASET_ITERATOR_FILE)
+    assert os.path.exists(OP_EVENT_FILE) is True
+    parser = MinddataEventParser(OP_EVENT_FILE)
+    # every row goes through at least the batch and shuffle connectors
+    assert parser.dropped == 0
+    assert parser.events["rows"].sum() >= 1024
+    assert np.all(parser.events["wait_us"] >= 0)
+    os.remove(OP_EVENT_FILE)
     del os.environ['PROFILING_MODE']
     del os.environ['MINDDATA_PROFILING_DIR']
 
@@ -94,6 +104,8 @@ def test_profiling_complex_pipeline():
     os.remove(PIPELINE_FILE)
     assert os.path.exists(DATASET_ITERATOR_FILE) is True
     os.remove(DATASET_ITERATOR_FILE)
+    assert os.path.exists(OP_EVENT_FILE) is True
+    os.remove(OP_EVENT_FILE)
     del os.environ['PROFILING_MODE']
     del os.environ['MINDDATA_PROFILING_DIR']
 
@@ -123,6 +135,8 @@ def test_profiling_sampling_interval():
     os.remove(PIPELINE_FILE)
     assert os.path.exists(DATASET_ITERATOR_FILE) is True
     os.remove(DATASET_ITERATOR_FILE)
+    assert os.path.exists(OP_EVENT_FILE) is True
+    os.remove(OP_EVENT_FILE)
 
     ds.config.set_monitor_sampling_interval(interval_origin)
     del os.environ['PROFILING_MODE']
@@ -13,6 +13,7 @@
 # limitations under the License.
 # ==============================================================================
 import numpy as np
+import pytest
 import mindspore.dataset as ds
 from mindspore import log as logger
 from util import save_and_check_dict
@@ -134,6 +135,58 @@ def test_shuffle_06():
         np.testing.assert_equal(item1, item2)
 
 
+def test_shuffle_block():
+    """
+    Test shuffle: blocks of consecutive rows are sent together
+    """
+    logger.info("test_shuffle_block")
+    ds.config.set_seed(1)
+    data1 = ds.GeneratorDataset(lambda: ((np.array([i]),) for i in range(22)), ["col"], shuffle=False)
+    data1 = data1.shuffle(buffer_size=4, block_size=4)
+    rows = [item[0][0] for item in data1.create_tuple_iterator(num_epochs=1, output_numpy=True)]
+    assert len(rows) == 22
+    for i in range(0, 22, 4):
+        # the buffer holds a single block, so every block comes out whole
+        assert sorted(rows[i:i + 4]) == list(range(i, min(i + 4, 22)))
+    assert rows != list(range(22))
+
+
+def test_shuffle_row_pool():
+    """
+    Test shuffle: packing the rows into a pool gives back the same rows in the same order
+    """
+    logger.info("test_shuffle_row_pool")
+    for block_size in [1, 3]:
+        ds.config.set_seed(1)
+        data1 = ds.TFRecordDataset(DATA_DIR, shuffle=ds.Shuffle.FILES)
+        data1 = data1.shuffle(buffer_size=5, block_size=block_size)
+
+        ds.config.set_seed(1)
+        data2 = ds.TFRecordDataset(DATA_DIR, shuffle=ds.Shuffle.FILES)
+        data2 = data2.shuffle(buffer_size=5, block_size=block_size, row_pool_size=1)
+
+        num_rows = 0
+        for item1, item2 in zip(data1.create_dict_iterator(num_epochs=1, output_numpy=True),
+                                data2.create_dict_iterator(num_epochs=1, output_numpy=True)):
+            np.testing.assert_equal(item1, item2)
+            num_rows += 1
+        assert num_rows == 12
+
+
+def test_shuffle_exception_08():
+    """
+    Test shuffle exception: block_size and row_pool_size out of range
+    """
+    logger.info("test_shuffle_exception_08")
+    data1 = ds.TFRecordDataset(DATA_DIR)
+    with pytest.raises(ValueError) as info:
+        data1.shuffle(buffer_size=4, block_size=0)
+    assert "block_size" in str(info.value)
+    with pytest.raises(ValueError) as info:
+        data1.shuffle(buffer_size=4, row_pool_size=-1)
+    assert "row_pool_size" in str(info.value)
+
+
 def test_shuffle_exception_01():
     """
     Test shuffle exception: buffer_size<0
@@ -249,10 +302,13 @@ if __name__ == '__main__':
     test_shuffle_04()
     test_shuffle_05()
     test_shuffle_06()
+    test_shuffle_block()
+    test_shuffle_row_pool()
     test_shuffle_exception_01()
     test_shuffle_exception_02()
     test_shuffle_exception_03()
     test_shuffle_exception_05()
     test_shuffle_exception_06()
     test_shuffle_exception_07()
+    test_shuffle_exception_08()
     logger.info('\n')
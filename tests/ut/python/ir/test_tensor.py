@@ -493,3 +493,33 @@ def test_tensor_from_numpy():
     with pytest.raises(TypeError):
         # incorrect input.
         t = ms.Tensor.from_numpy([1, 2, 3])
+
+def test_tensor_dlpack():
+    a = np.arange(6, dtype=np.float32).reshape(2, 3)
+    t = ms.Tensor(a)
+    capsule = t.to_dlpack()
+    t2 = ms.Tensor.from_dlpack(capsule)
+    assert t2.dtype == ms.float32
+    assert t2.shape == (2, 3)
+    assert np.all(t2.asnumpy() == a)
+    # 't' and 't2' share same data.
+    t.asnumpy()[0] = 7
+    assert np.all(t2.asnumpy()[0] == 7)
+    # a capsule is consumed once.
+    with pytest.raises(RuntimeError):
+        ms.Tensor.from_dlpack(capsule)
+    # 't2' is still valid after 't' deleted.
+    del t
+    assert np.all(t2.asnumpy()[1] == a[1])
+    # objects with __dlpack__ are accepted.
+    t3 = ms.Tensor.from_dlpack(t2)
+    assert np.all(t3.asnumpy() == t2.asnumpy())
+    with pytest.raises(RuntimeError):
+        ms.Tensor.from_dlpack([1, 2, 3])
+
+def test_tensor_buffer_protocol():
+    t = ms.Tensor(np.ones((2, 3), np.int32))
+    view = memoryview(t)
+    assert view.shape == (2, 3)
+    assert view.format == 'i'
+    assert np.all(np.asarray(t) == 1)
@@ -78,3 +78,44 @@ class TestSummaryRecord:
         with pytest.raises(TypeError):
             with SummaryRecord(summary_dir) as sr:
                 sr.record(step)
+
+    @pytest.mark.parametrize("max_pending_bytes", ["", 1.0, True])
+    def test_max_pending_bytes_with_type_error(self, max_pending_bytes):
+        summary_dir = tempfile.mkdtemp(dir=self.base_summary_dir)
+        with pytest.raises(TypeError) as exc:
+            with SummaryRecord(log_dir=summary_dir, max_pending_bytes=max_pending_bytes):
+                pass
+
+        assert "max_pending_bytes" in str(exc.value)
+
+    def test_max_pending_bytes_with_value_error(self):
+        summary_dir = tempfile.mkdtemp(dir=self.base_summary_dir)
+        with pytest.raises(ValueError) as exc:
+            with SummaryRecord(log_dir=summary_dir, max_pending_bytes=-1):
+                pass
+
+        assert "max_pending_bytes" in str(exc.value)
+
+    @pytest.mark.parametrize("drop_when_full", ["", None, 1])
+    def test_drop_when_full_with_type_error(self, drop_when_full):
+        summary_dir = tempfile.mkdtemp(dir=self.base_summary_dir)
+        with pytest.raises(TypeError) as exc:
+            with SummaryRecord(log_dir=summary_dir, drop_when_full=drop_when_full):
+                pass
+
+        assert "drop_when_full" in str(exc.value)
+
+    @pytest.mark.parametrize("max_pending_bytes, drop_when_full", [(0, False), (16, False), (16, True)])
+    def test_record_with_pending_bytes(self, max_pending_bytes, drop_when_full):
+        summary_dir = tempfile.mkdtemp(dir=self.base_summary_dir)
+        with SummaryRecord(summary_dir, max_pending_bytes=max_pending_bytes,
+                           drop_when_full=drop_when_full) as summary_record:
+            for step in range(5):
+                for data in get_test_data(step):
+                    summary_record.add_value('scalar', data['name'], data['data'])
+                summary_record.record(step)
+            summary_record.flush()
+            file_name = summary_record.full_file_name
+
+        # the summary file is written in every mode, the ordering and dropping are covered by the C++ tests
+        assert os.path.getsize(file_name) > 0
@@ -293,6 +293,33 @@ def test_save_checkpoint_for_network():
     load_checkpoint("new_ckpt.ckpt")
 
 
+def test_save_and_load_checkpoint_raw_format():
+    """ test save_checkpoint and load_checkpoint in raw format"""
+    weight = np.random.randn(3, 5, 7).astype(np.float32)
+    mask = np.random.randn(4, 9) > 0
+    parameter_list = [{'name': "net.weight", 'data': Tensor(weight)},
+                      {'name': "net.mask", 'data': Tensor(mask)},
+                      {'name': "step", 'data': Tensor(7, mstype.int32)}]
+    ckpt_file_name = os.path.join(_cur_dir, './raw_parameters.ckpt')
+    save_checkpoint(parameter_list, ckpt_file_name, raw_format=True)
+
+    par_dict = load_checkpoint(ckpt_file_name)
+    assert len(par_dict) == 3
+    assert par_dict['net.weight'].data.dtype == mstype.float32
+    assert np.array_equal(par_dict['net.weight'].data.asnumpy(), weight)
+    assert np.array_equal(par_dict['net.mask'].data.asnumpy(), mask)
+    assert par_dict['step'].data.asnumpy() == 7
+
+    par_dict = load_checkpoint(ckpt_file_name, filter_prefix="net")
+    assert list(par_dict.keys()) == ["step"]
+
+    # saving again overwrites the read only file
+    save_checkpoint(parameter_list[:1], ckpt_file_name, raw_format=True)
+    assert len(load_checkpoint(ckpt_file_name)) == 1
+    os.chmod(ckpt_file_name, stat.S_IWRITE)
+    os.remove(ckpt_file_name)
+
+
 def test_load_checkpoint_empty_file():
     os.mknod("empty.ckpt")
     with pytest.raises(ValueError):